@@ -0,0 +1,368 @@
+#ifndef __DICOMDirectoryIndex_h
+#define __DICOMDirectoryIndex_h
+
+#include "itkGDCMImageIO.h"
+#include "itkGDCMSeriesFileNames.h"
+#include "itkMetaDataObject.h"
+#include "itkMultiThreaderBase.h"
+#include <itksys/Directory.hxx>
+#include <itksys/SystemTools.hxx>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <random>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+// Index of the DICOM series of a directory, kept in a file of the directory
+// so that the headers are parsed only once. The index maps the series UIDs,
+// as given by the GDCMSeriesFileNames, to their sorted slices, with the
+// position and the SOPInstanceUID of each slice. It is valid as long as the
+// names, sizes and modification times of the files of the directory are the
+// ones recorded in it, and rebuilt otherwise.
+class DICOMDirectoryIndex
+{
+public:
+  struct SliceType
+  {
+    std::string FileName;
+    std::string SOPInstanceUID;
+    double      Position[3];
+  };
+
+  using SliceContainerType = std::vector<SliceType>;
+
+  explicit DICOMDirectoryIndex(const std::string & directory)
+    : m_Directory(directory)
+  {}
+
+  // Load the index of the directory, or build it when it is missing or out
+  // of date. Returns false when the directory cannot be scanned.
+  bool
+  Update()
+  {
+    FileStatusContainerType files;
+    if (!this->GetFileStatus(files))
+    {
+      std::cerr << "Error opening " << m_Directory << std::endl;
+      return false;
+    }
+
+    if (this->Read(files))
+    {
+      std::cout << "Using the DICOM index " << this->GetIndexFileName() << std::endl;
+      return true;
+    }
+
+    std::cout << "Indexing the DICOM files of " << m_Directory << std::endl;
+    if (!this->Build())
+    {
+      return false;
+    }
+    if (!this->Write(files))
+    {
+      std::cerr << "Could not write the DICOM index " << this->GetIndexFileName() << std::endl;
+    }
+    return true;
+  }
+
+  const std::vector<std::string> &
+  GetSeriesUIDs() const
+  {
+    return m_SeriesUIDs;
+  }
+
+  // Slices of a series, sorted as by the GDCMSeriesFileNames.
+  const SliceContainerType &
+  GetSlices(const std::string & seriesUID) const
+  {
+    static const SliceContainerType noSlices;
+    for (unsigned int i = 0; i < m_SeriesUIDs.size(); ++i)
+    {
+      if (m_SeriesUIDs[i] == seriesUID)
+      {
+        return m_Slices[i];
+      }
+    }
+    return noSlices;
+  }
+
+  // Full paths of the files of a series, sorted as by the GDCMSeriesFileNames.
+  std::vector<std::string>
+  GetFileNames(const std::string & seriesUID) const
+  {
+    std::vector<std::string> fileNames;
+    for (const SliceType & slice : this->GetSlices(seriesUID))
+    {
+      fileNames.push_back(this->GetFullPath(slice.FileName));
+    }
+    return fileNames;
+  }
+
+  // First slice, in any series, whose file name contains the substring.
+  bool
+  FindSliceByFileName(const std::string & substring, SliceType & found) const
+  {
+    for (const SliceContainerType & slices : m_Slices)
+    {
+      for (const SliceType & slice : slices)
+      {
+        if (slice.FileName.find(substring) != std::string::npos && slice.FileName.find("vvi") == std::string::npos)
+        {
+          found = slice;
+          return true;
+        }
+      }
+    }
+    return false;
+  }
+
+  // First slice, in any series, whose SOPInstanceUID contains the substring.
+  bool
+  FindSliceBySOPInstanceUID(const std::string & substring, SliceType & found) const
+  {
+    for (const SliceContainerType & slices : m_Slices)
+    {
+      for (const SliceType & slice : slices)
+      {
+        if (slice.SOPInstanceUID.find(substring) != std::string::npos &&
+            slice.FileName.find("vvi") == std::string::npos)
+        {
+          found = slice;
+          return true;
+        }
+      }
+    }
+    return false;
+  }
+
+  std::string
+  GetFullPath(const std::string & fileName) const
+  {
+    return m_Directory + "/" + fileName;
+  }
+
+  std::string
+  GetIndexFileName() const
+  {
+    return this->GetFullPath(".LesionSizingToolkitDICOMIndex");
+  }
+
+protected:
+  // Size and modification time of each regular file of the directory.
+  using FileStatusType = std::pair<unsigned long, long>;
+  using FileStatusContainerType = std::map<std::string, FileStatusType>;
+
+  bool
+  GetFileStatus(FileStatusContainerType & files) const
+  {
+    itksys::Directory directory;
+    if (!directory.Load(m_Directory))
+    {
+      return false;
+    }
+
+    const std::string indexFileName = itksys::SystemTools::GetFilenameName(this->GetIndexFileName());
+    for (unsigned long i = 0; i < directory.GetNumberOfFiles(); ++i)
+    {
+      const std::string fileName = directory.GetFile(i);
+      const std::string path = this->GetFullPath(fileName);
+      // Skip the index, and the index files being written by other runs.
+      if (fileName.compare(0, indexFileName.size(), indexFileName) == 0 || itksys::SystemTools::FileIsDirectory(path))
+      {
+        continue;
+      }
+      files[fileName] = FileStatusType(itksys::SystemTools::FileLength(path), itksys::SystemTools::ModifiedTime(path));
+    }
+    return true;
+  }
+
+  // Parse the headers of the files of the directory.
+  bool
+  Build()
+  {
+    using NamesGeneratorType = itk::GDCMSeriesFileNames;
+    NamesGeneratorType::Pointer nameGenerator = NamesGeneratorType::New();
+
+    nameGenerator->SetUseSeriesDetails(true);
+    nameGenerator->AddSeriesRestriction("0008|0021");
+    nameGenerator->SetDirectory(m_Directory);
+
+    m_SeriesUIDs = nameGenerator->GetSeriesUIDs();
+    m_Slices.assign(m_SeriesUIDs.size(), SliceContainerType());
+
+    std::vector<std::pair<unsigned int, unsigned int>> slicesToRead;
+    for (unsigned int i = 0; i < m_SeriesUIDs.size(); ++i)
+    {
+      for (const std::string & path : nameGenerator->GetFileNames(m_SeriesUIDs[i]))
+      {
+        SliceType slice;
+        slice.FileName = itksys::SystemTools::GetFilenameName(path);
+        m_Slices[i].push_back(slice);
+        slicesToRead.emplace_back(i, static_cast<unsigned int>(m_Slices[i].size() - 1));
+      }
+    }
+
+    // The positions and SOPInstanceUIDs, read in parallel.
+    std::vector<std::string> errors(slicesToRead.size());
+
+    itk::MultiThreaderBase::Pointer multiThreader = itk::MultiThreaderBase::New();
+    multiThreader->ParallelizeArray(
+      0,
+      slicesToRead.size(),
+      [&](itk::SizeValueType i) {
+        SliceType & slice = m_Slices[slicesToRead[i].first][slicesToRead[i].second];
+        try
+        {
+          itk::GDCMImageIO::Pointer dicomIO = itk::GDCMImageIO::New();
+          dicomIO->SetFileName(this->GetFullPath(slice.FileName));
+          dicomIO->ReadImageInformation();
+          for (unsigned int d = 0; d < 3; ++d)
+          {
+            slice.Position[d] = dicomIO->GetOrigin(d);
+          }
+          itk::ExposeMetaData<std::string>(dicomIO->GetMetaDataDictionary(), "0008|0018", slice.SOPInstanceUID);
+        }
+        catch (itk::ExceptionObject & ex)
+        {
+          errors[i] = ex.what();
+        }
+      },
+      nullptr);
+
+    for (unsigned int i = 0; i < slicesToRead.size(); ++i)
+    {
+      if (!errors[i].empty())
+      {
+        std::cerr << "Failed to read "
+                  << m_Slices[slicesToRead[i].first][slicesToRead[i].second].FileName << ": " << errors[i]
+                  << std::endl;
+        return false;
+      }
+    }
+    return true;
+  }
+
+  // The index is a text file: a version line, then one line per file of the
+  // directory, with its size and modification time. The lines of the slices
+  // also give their series, position and SOPInstanceUID, and come in the
+  // order of the series. The series UIDs and the file names end the lines,
+  // since they may contain spaces.
+  bool
+  Write(const FileStatusContainerType & files) const
+  {
+    // Each run writes its own file, renamed once complete, so that the runs
+    // on the same directory neither share nor read a partial index.
+    std::random_device randomDevice;
+    std::ostringstream temporaryName;
+    temporaryName << this->GetIndexFileName() << "." << std::hex << randomDevice() << randomDevice() << ".tmp";
+    const std::string temporaryFileName = temporaryName.str();
+    {
+      std::ofstream output(temporaryFileName.c_str());
+      if (!output)
+      {
+        return false;
+      }
+      output.precision(17);
+      output << "LesionSizingToolkitDICOMIndex 1" << std::endl;
+
+      FileStatusContainerType otherFiles = files;
+      for (unsigned int i = 0; i < m_SeriesUIDs.size(); ++i)
+      {
+        output << "series " << m_SeriesUIDs[i] << std::endl;
+        for (const SliceType & slice : m_Slices[i])
+        {
+          const FileStatusType & status = files.at(slice.FileName);
+          output << "slice " << status.first << " " << status.second << " " << slice.Position[0] << " "
+                 << slice.Position[1] << " " << slice.Position[2] << " "
+                 << (slice.SOPInstanceUID.empty() ? "-" : slice.SOPInstanceUID) << " " << slice.FileName << std::endl;
+          otherFiles.erase(slice.FileName);
+        }
+      }
+      for (const auto & file : otherFiles)
+      {
+        output << "file " << file.second.first << " " << file.second.second << " " << file.first << std::endl;
+      }
+      if (!output)
+      {
+        output.close();
+        itksys::SystemTools::RemoveFile(temporaryFileName);
+        return false;
+      }
+    }
+    if (!itksys::SystemTools::RenameFile(temporaryFileName, this->GetIndexFileName()))
+    {
+      itksys::SystemTools::RemoveFile(temporaryFileName);
+      return false;
+    }
+    return true;
+  }
+
+  // Read the index, if it exists and matches the files of the directory.
+  bool
+  Read(const FileStatusContainerType & files)
+  {
+    std::ifstream input(this->GetIndexFileName().c_str());
+    std::string   line;
+    if (!input || !std::getline(input, line) || line != "LesionSizingToolkitDICOMIndex 1")
+    {
+      return false;
+    }
+
+    std::vector<std::string>        seriesUIDs;
+    std::vector<SliceContainerType> slices;
+    FileStatusContainerType         indexedFiles;
+
+    while (std::getline(input, line))
+    {
+      std::istringstream fields(line);
+      std::string        type;
+      FileStatusType     status;
+      SliceType          slice;
+      fields >> type;
+      if (type == "series" && fields.get() == ' ' && std::getline(fields, line))
+      {
+        seriesUIDs.push_back(line);
+        slices.emplace_back();
+        continue;
+      }
+      if (type == "slice" && !slices.empty() &&
+          (fields >> status.first >> status.second >> slice.Position[0] >> slice.Position[1] >> slice.Position[2] >>
+           slice.SOPInstanceUID) &&
+          fields.get() == ' ' && std::getline(fields, slice.FileName))
+      {
+        if (slice.SOPInstanceUID == "-")
+        {
+          slice.SOPInstanceUID.clear();
+        }
+        indexedFiles[slice.FileName] = status;
+        slices.back().push_back(slice);
+        continue;
+      }
+      if (type == "file" && (fields >> status.first >> status.second) && fields.get() == ' ' &&
+          std::getline(fields, line))
+      {
+        indexedFiles[line] = status;
+        continue;
+      }
+      return false;
+    }
+
+    if (indexedFiles != files)
+    {
+      return false;
+    }
+
+    m_SeriesUIDs.swap(seriesUIDs);
+    m_Slices.swap(slices);
+    return true;
+  }
+
+  std::string                     m_Directory;
+  std::vector<std::string>        m_SeriesUIDs;
+  std::vector<SliceContainerType> m_Slices;
+};
+
+#endif
@@ -2,17 +2,15 @@
 #include "itkImageFileWriter.h"
 #include "itkGDCMImageIO.h"
 #include "itkGDCMImageIOFactory.h"
-#include "itkGDCMSeriesFileNames.h"
 #include "itkMetaImageIOFactory.h"
 #include "itkImageSeriesReader.h"
+#include "itkMultiThreaderBase.h"
 #include "itkEventObject.h"
 #include "itkImageToVTKImageFilter.h"
-#include "vtkMassProperties.h"
 #include "vtkImageData.h"
 #include "vtkMarchingCubes.h"
 #include "vtkPolyData.h"
 #include "vtkSmartPointer.h"
-#include "vtkSTLWriter.h"
 #include "vtkRenderer.h"
 #include "vtkCamera.h"
 #include "vtkRenderWindow.h"
@@ -33,9 +31,16 @@
 #include "itkOrientImageFilter.h"
 #include "vtkVersion.h"
 
+#include <algorithm>
+#include <cmath>
+
 // This needs to come after the other includes to prevent the global definitions
 // of PixelType to be shadowed by other declarations.
 #include "itkLesionSegmentationImageFilter8.h"
+#include "itkIsoSurfaceSegmentationMorphometryEstimator.h"
+#include "itkIsoSurfaceMeshSource.h"
+#include "itkTriangleMeshFileWriter.h"
+#include "itkMesh.h"
 #include "itkLesionSegmentationCommandLineProgressReporter.h"
 #include "LesionSegmentationCLI.h"
 
@@ -76,8 +81,11 @@ protected:
 
 
 // --------------------------------------------------------------------------
+// Read the first DICOM series of a directory. When bounds are given, as
+// 6 physical coordinates, only the slices that intersect them are read. The
+// slices are decoded in parallel.
 LesionSegmentationCLI::InputImageType::Pointer
-GetImage(std::string dir, bool ignoreDirection)
+GetImage(std::string dir, bool ignoreDirection, const double * bounds)
 {
   const unsigned int Dimension = LesionSegmentationCLI::ImageDimension;
   using ImageType = itk::Image<LesionSegmentationCLI::PixelType, Dimension>;
@@ -90,12 +98,12 @@ GetImage(std::string dir, bool ignoreDirection)
 
   reader->SetImageIO(dicomIO);
 
-  using NamesGeneratorType = itk::GDCMSeriesFileNames;
-  NamesGeneratorType::Pointer nameGenerator = NamesGeneratorType::New();
-
-  nameGenerator->SetUseSeriesDetails(true);
-  nameGenerator->AddSeriesRestriction("0008|0021");
-  nameGenerator->SetDirectory(dir);
+  // The series and their sorted files, from the index of the directory.
+  DICOMDirectoryIndex index(dir);
+  if (!index.Update())
+  {
+    return NULL;
+  }
 
   try
   {
@@ -106,7 +114,7 @@ GetImage(std::string dir, bool ignoreDirection)
 
     using SeriesIdContainer = std::vector<std::string>;
 
-    const SeriesIdContainer & seriesUID = nameGenerator->GetSeriesUIDs();
+    const SeriesIdContainer & seriesUID = index.GetSeriesUIDs();
 
     SeriesIdContainer::const_iterator seriesItr = seriesUID.begin();
     SeriesIdContainer::const_iterator seriesEnd = seriesUID.end();
@@ -116,6 +124,11 @@ GetImage(std::string dir, bool ignoreDirection)
       seriesItr++;
     }
 
+    if (seriesUID.empty())
+    {
+      std::cerr << "No DICOM series found in " << dir << std::endl;
+      return NULL;
+    }
 
     std::string seriesIdentifier;
     seriesIdentifier = seriesUID.begin()->c_str();
@@ -130,23 +143,15 @@ GetImage(std::string dir, bool ignoreDirection)
     using FileNamesContainer = std::vector<std::string>;
     FileNamesContainer fileNames;
 
-    fileNames = nameGenerator->GetFileNames(seriesIdentifier);
-
-    FileNamesContainer::const_iterator fitr = fileNames.begin();
-    FileNamesContainer::const_iterator fend = fileNames.end();
-
-    while (fitr != fend)
-    {
-      std::cout << *fitr << std::endl;
-      ++fitr;
-    }
-
+    fileNames = index.GetFileNames(seriesIdentifier);
 
+    // The geometry of the series, computed from the headers of its first and
+    // last slices, without decoding any pixel.
     reader->SetFileNames(fileNames);
 
     try
     {
-      reader->Update();
+      reader->UpdateOutputInformation();
     }
     catch (itk::ExceptionObject & ex)
     {
@@ -154,11 +159,107 @@ GetImage(std::string dir, bool ignoreDirection)
       return NULL;
     }
 
+    const ImageType *           seriesImage = reader->GetOutput();
+    const ImageType::RegionType seriesRegion = seriesImage->GetLargestPossibleRegion();
+    const unsigned int          sliceAxis = Dimension - 1;
+
+    // Range of the slices to read, with one more slice on each side to cover
+    // the rounding of the ROI to pixel indices.
+    itk::IndexValueType firstSlice = seriesRegion.GetIndex(sliceAxis);
+    itk::IndexValueType lastSlice = seriesRegion.GetUpperIndex()[sliceAxis];
+    if (bounds)
+    {
+      double minimumSlice = itk::NumericTraits<double>::max();
+      double maximumSlice = itk::NumericTraits<double>::NonpositiveMin();
+      for (unsigned int corner = 0; corner < (1u << Dimension); ++corner)
+      {
+        ImageType::PointType point;
+        for (unsigned int i = 0; i < Dimension; ++i)
+        {
+          point[i] = bounds[2 * i + ((corner >> i) & 1)];
+        }
+        itk::ContinuousIndex<double, Dimension> index;
+        seriesImage->TransformPhysicalPointToContinuousIndex(point, index);
+        minimumSlice = std::min(minimumSlice, index[sliceAxis]);
+        maximumSlice = std::max(maximumSlice, index[sliceAxis]);
+      }
+      firstSlice = std::max(firstSlice, static_cast<itk::IndexValueType>(std::floor(minimumSlice)) - 1);
+      lastSlice = std::min(lastSlice, static_cast<itk::IndexValueType>(std::ceil(maximumSlice)) + 1);
+
+      if (firstSlice > lastSlice)
+      {
+        std::cerr << "The ROI does not intersect the DICOM series" << std::endl;
+        return NULL;
+      }
+    }
+
+    const itk::SizeValueType numberOfSlices = lastSlice - firstSlice + 1;
+    std::cout << "Reading " << numberOfSlices << " out of " << fileNames.size() << " slices" << std::endl;
+
+    // The image starts at the first slice read.
+    ImageType::IndexType firstSliceIndex = seriesRegion.GetIndex();
+    firstSliceIndex[sliceAxis] = firstSlice;
+    ImageType::PointType origin;
+    seriesImage->TransformIndexToPhysicalPoint(firstSliceIndex, origin);
+
+    ImageType::SizeType size = seriesRegion.GetSize();
+    size[sliceAxis] = numberOfSlices;
+
+    ImageType::Pointer image = ImageType::New();
+    image->CopyInformation(seriesImage);
+    image->SetOrigin(origin);
+    image->SetRegions(ImageType::RegionType(size));
+    image->Allocate();
+
+    ImageType::SizeType sliceSize = size;
+    sliceSize[sliceAxis] = 1;
+    const itk::SizeValueType numberOfSlicePixels = ImageType::RegionType(sliceSize).GetNumberOfPixels();
+
+    // Each slice is decoded by its own reader.
+    using SliceReaderType = itk::ImageFileReader<ImageType>;
+    std::vector<std::string> errors(numberOfSlices);
+
+    itk::MultiThreaderBase::Pointer multiThreader = itk::MultiThreaderBase::New();
+    multiThreader->ParallelizeArray(
+      0,
+      numberOfSlices,
+      [&](itk::SizeValueType slice) {
+        try
+        {
+          SliceReaderType::Pointer sliceReader = SliceReaderType::New();
+          sliceReader->SetImageIO(ImageIOType::New());
+          sliceReader->SetFileName(fileNames[firstSlice - seriesRegion.GetIndex(sliceAxis) + slice]);
+          sliceReader->Update();
+
+          const ImageType * sliceImage = sliceReader->GetOutput();
+          if (sliceImage->GetBufferedRegion().GetNumberOfPixels() != numberOfSlicePixels)
+          {
+            errors[slice] = "The size of the slice differs from the size of the series.";
+            return;
+          }
+          std::copy_n(sliceImage->GetBufferPointer(),
+                      numberOfSlicePixels,
+                      image->GetBufferPointer() + slice * numberOfSlicePixels);
+        }
+        catch (itk::ExceptionObject & ex)
+        {
+          errors[slice] = ex.what();
+        }
+      },
+      nullptr);
+
+    for (itk::SizeValueType slice = 0; slice < numberOfSlices; ++slice)
+    {
+      if (!errors[slice].empty())
+      {
+        std::cout << "Failed to read " << fileNames[firstSlice - seriesRegion.GetIndex(sliceAxis) + slice] << ": "
+                  << errors[slice] << std::endl;
+        return NULL;
+      }
+    }
 
-    ImageType::Pointer       image = reader->GetOutput();
     ImageType::DirectionType direction;
     direction.SetIdentity();
-    image->DisconnectPipeline();
     std::cout << "Image Direction:" << image->GetDirection() << std::endl;
 
 
@@ -407,7 +508,15 @@ main(int argc, char * argv[])
   if (!args.GetValueAsString("InputDICOMDir").empty())
   {
     std::cout << "Reading from DICOM dir " << args.GetValueAsString("InputDICOMDir") << ".." << std::endl;
-    image = GetImage(args.GetValueAsString("InputDICOMDir"), args.GetValueAsBool("IgnoreDirection"));
+
+    // The ROI is known before reading the image when the seeds are given in
+    // physical units. Only the slices that intersect it are read then, unless
+    // the whole series is requested.
+    const bool readFullSeries = args.GetValueAsBool("ReadFullSeries") || args.GetOptionWasSet("SeedUnitsInPixels") ||
+                                (!args.GetOptionWasSet("ROI") && !args.GetOptionWasSet("Seeds"));
+    image = GetImage(args.GetValueAsString("InputDICOMDir"),
+                     args.GetValueAsBool("IgnoreDirection"),
+                     readFullSeries ? nullptr : args.GetROI());
 
     if (!image)
     {
@@ -523,6 +632,13 @@ main(int argc, char * argv[])
     seg->SetSigma(args.GetSigmas());
   }
   seg->SetSigmoidBeta(args.GetValueAsBool("PartSolid") ? -500 : -200);
+  seg->SetSegmentOnNativeGrid(args.GetValueAsBool("SegmentOnNativeGrid"));
+  seg->SetUseParallelLevelSetSolver(args.GetValueAsBool("ParallelLevelSet"));
+  seg->SetAdaptiveRegionOfInterest(args.GetValueAsBool("AdaptiveROI"));
+  if (args.GetOptionWasSet("FeatureCacheDirectory"))
+  {
+    seg->SetFeatureCacheDirectory(args.GetValueAsString("FeatureCacheDirectory"));
+  }
   seg->Update();
 
 
@@ -538,56 +654,69 @@ main(int argc, char * argv[])
 
   // Compute volume
 
-  using RealITKToVTKFilterType = itk::ImageToVTKImageFilter<RealImageType>;
-  RealITKToVTKFilterType::Pointer itk2vtko = RealITKToVTKFilterType::New();
-  itk2vtko->SetInput(seg->GetOutput());
-  itk2vtko->Update();
+  std::cout << "Measuring the segmentation enclosed by the zero-level set (iso-value of -0.5)" << std::endl;
+  using RealImageSpatialObjectType = itk::ImageSpatialObject<ImageDimension, RealImageType::PixelType>;
+  RealImageSpatialObjectType::Pointer segmentationObject = RealImageSpatialObjectType::New();
+  segmentationObject->SetImage(seg->GetOutput());
 
-  std::cout << "Generating an isosurface of the zero-level set (iso-value of -0.5)" << std::endl;
-  vtkSmartPointer<vtkMarchingCubes> mc = vtkSmartPointer<vtkMarchingCubes>::New();
-#if VTK_MAJOR_VERSION <= 5
-  mc->SetInput(itk2vtko->GetOutput());
-#else
-  mc->SetInputData(itk2vtko->GetOutput());
-#endif
+  using MorphometryEstimatorType = itk::IsoSurfaceSegmentationMorphometryEstimator<ImageDimension>;
+  MorphometryEstimatorType::Pointer morphometryEstimator = MorphometryEstimatorType::New();
+  morphometryEstimator->SetInput(segmentationObject);
+  morphometryEstimator->SetIsoValue(-0.5);
+  morphometryEstimator->Update();
 
-  mc->SetValue(0, -0.5);
-  mc->Update();
+  const MorphometryEstimatorType::MorphometryType & morphometry = morphometryEstimator->GetMorphometry();
+  const double                                      volume = morphometry.Volume;
 
-  if (mc->GetOutput()->GetNumberOfCells() == 0)
+  if (volume <= 0.0)
   {
     std::cerr << "Segmentation failed !" << std::endl;
     return EXIT_FAILURE;
   }
 
-  std::cout << "Computing volume of mesh using discretized divergence" << std::endl;
-  vtkSmartPointer<vtkMassProperties> mp = vtkSmartPointer<vtkMassProperties>::New();
-#if VTK_MAJOR_VERSION <= 5
-  mp->SetInput(mc->GetOutput());
-#else
-  mp->SetInputData(mc->GetOutput());
-#endif
-  const double volume = mp->GetVolume();
-
   std::cout << "Volume of segmentation mm^3 = " << volume << std::endl;
+  std::cout << "Surface area of segmentation mm^2 = " << morphometry.SurfaceArea << std::endl;
+  std::cout << "Maximum diameter of segmentation mm = " << morphometry.MaximumDiameter << std::endl;
+  std::cout << "Sphericity of segmentation = " << morphometry.Sphericity << std::endl;
 
   if (args.GetOptionWasSet("OutputMesh"))
   {
-    VTK_CREATE(vtkSTLWriter, writer);
-    writer->SetFileName(args.GetValueAsString("OutputMesh").c_str());
-#if VTK_MAJOR_VERSION <= 5
-    writer->SetInput(mc->GetOutput());
-#else
-    writer->SetInputData(mc->GetOutput());
-#endif
-    writer->Write();
+    std::cout << "Writing the isosurface of the zero-level set (iso-value of -0.5) to "
+              << args.GetValueAsString("OutputMesh") << std::endl;
+
+    using MeshType = itk::Mesh<float, ImageDimension>;
+    using MeshSourceType = itk::IsoSurfaceMeshSource<RealImageType, MeshType>;
+    MeshSourceType::Pointer meshSource = MeshSourceType::New();
+    meshSource->SetInput(seg->GetOutput());
+    meshSource->SetIsoValue(-0.5);
+
+    using MeshWriterType = itk::TriangleMeshFileWriter<MeshType>;
+    MeshWriterType::Pointer meshWriter = MeshWriterType::New();
+    meshWriter->SetFileName(args.GetValueAsString("OutputMesh"));
+    meshWriter->SetInput(meshSource->GetOutput());
+    meshWriter->Write();
   }
 
-  if (args.GetOptionWasSet("Visualize"))
+  if (!args.GetOptionWasSet("Visualize"))
   {
-    return ViewImageAndSegmentationSurface(image, mc->GetOutput(), roi, args);
+    return EXIT_SUCCESS;
   }
 
+  using RealITKToVTKFilterType = itk::ImageToVTKImageFilter<RealImageType>;
+  RealITKToVTKFilterType::Pointer itk2vtko = RealITKToVTKFilterType::New();
+  itk2vtko->SetInput(seg->GetOutput());
+  itk2vtko->Update();
 
-  return EXIT_SUCCESS;
+  std::cout << "Generating an isosurface of the zero-level set (iso-value of -0.5)" << std::endl;
+  vtkSmartPointer<vtkMarchingCubes> mc = vtkSmartPointer<vtkMarchingCubes>::New();
+#if VTK_MAJOR_VERSION <= 5
+  mc->SetInput(itk2vtko->GetOutput());
+#else
+  mc->SetInputData(itk2vtko->GetOutput());
+#endif
+
+  mc->SetValue(0, -0.5);
+  mc->Update();
+
+  return ViewImageAndSegmentationSurface(image, mc->GetOutput(), roi, args);
 }
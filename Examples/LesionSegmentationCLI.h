@@ -10,15 +10,7 @@
 #include "itkImageFileReader.h"
 #include "itkMetaDataDictionary.h"
 #include "itkMetaDataObject.h"
-#include <vtksys/SystemTools.hxx>
-#include <fstream>
-#include <sys/types.h>
-#if !defined(_MSC_VER)
-#  include <dirent.h> // exists only on POSIX type compilers
-#else
-#  include "dirent_win.h" // exists only on POSIX type compilers
-#endif
-#include <cerrno>
+#include "DICOMDirectoryIndex.h"
 #include <vector>
 #include <string>
 #include <iostream>
@@ -43,7 +35,7 @@ public:
     this->AddArgument("InputImage", false, "Input image to be segmented.");
     this->AddArgument("InputDICOMDir", false, "DICOM directory containing series of the Input image to be segmented.");
     this->AddArgument("OutputImage", false, "Output segmented image");
-    this->AddArgument("OutputMesh", false, "Output segmented surface (STL filename expected)");
+    this->AddArgument("OutputMesh", false, "Output segmented surface (.stl or .ply filename expected)");
     this->AddArgument(
       "OutputROI", false, "Write the ROI within which the segmentation will be confined to (for debugging purposes)");
     this->AddArgument(
@@ -54,6 +46,12 @@ public:
                       "flag is also enabled.",
                       MetaCommand::BOOL,
                       "0");
+    this->AddArgument("ReadFullSeries",
+                      false,
+                      "Read every slice of the DICOM series. By default, only the slices that intersect the ROI are "
+                      "read when the ROI or the seeds are given in physical units.",
+                      MetaCommand::BOOL,
+                      "0");
     this->AddArgument("IgnoreDirection", false, "Ignore the direction of the DICOM image", MetaCommand::BOOL, "0");
     this->AddArgument("PartSolid",
                       false,
@@ -84,6 +82,28 @@ public:
                       "You specify a seed and a value of say 20mm, if you know the lesion is smaller than 20mm..",
                       MetaCommand::FLOAT,
                       "30");
+    this->AddArgument("SegmentOnNativeGrid",
+                      false,
+                      "Compute the features and the segmentation on the native grid of thick-slice data, and only "
+                      "upsample the final level set, instead of resampling the data first. This is faster and uses "
+                      "less memory.",
+                      MetaCommand::BOOL,
+                      "0");
+    this->AddArgument("ParallelLevelSet",
+                      false,
+                      "Run the level set evolution with the multithreaded sparse field solver.",
+                      MetaCommand::BOOL,
+                      "0");
+    this->AddArgument("AdaptiveROI",
+                      false,
+                      "Compute the features and the segmentation in a box around the seeds, grown until it contains "
+                      "the lesion, instead of in the whole ROI. This is faster for small lesions in large ROIs.",
+                      MetaCommand::BOOL,
+                      "0");
+    this->AddArgument("FeatureCacheDirectory",
+                      false,
+                      "Directory where the features are kept across runs. The features of an earlier run on the same "
+                      "ROI are read from it instead of being computed again.");
     this->AddArgument(
       "Screenshot", false, "Screenshot PNG file of the final segmented surface (requires \"Visualize\" to be ON.");
     this->AddArgument("ShowBoundingBox",
@@ -178,78 +198,53 @@ public:
         // Get the z spacing from the slice name regex..
         if (this->GetOptionWasSet("GetZSpacingFromSliceNameRegex"))
         {
-          std::string              substring = this->GetValueAsString("GetZSpacingFromSliceNameRegex");
-          std::vector<std::string> filesInDir = this->GetFilesInDirectory(this->GetValueAsString("InputDICOMDir"));
-          bool                     found = false;
-          for (std::vector<std::string>::iterator it = filesInDir.begin(); it != filesInDir.end(); ++it)
+          std::string         substring = this->GetValueAsString("GetZSpacingFromSliceNameRegex");
+          DICOMDirectoryIndex index(this->GetValueAsString("InputDICOMDir"));
+          if (!index.Update())
           {
-            if (it->find(substring) != std::string::npos && it->find("vvi") == std::string::npos)
-            {
-              std::string file = this->GetValueAsString("InputDICOMDir");
-              file += "/";
-              file += (*it);
-              if (vtksys::SystemTools::FileExists(file.c_str(), true))
-              {
-                found = true;
-                std::string sopInstanceUID;
-                sz = this->GetZPositionFromFile(file, sopInstanceUID);
-                std::cout << "Found matching filename: " << file << "\n  with SOPInstanceUID " << sopInstanceUID
-                          << "\n  matching string " << substring << std::endl;
-                break;
-              }
-            }
+            exit(-1);
           }
-          if (!found)
-          {
-            // Loop now and check the SOP instance UID. Some datasets in the
-            // biochange challenge rely on the filename, yet others rely on
-            // the SOP instance UID present in the file.
 
-            for (std::vector<std::string>::iterator it = filesInDir.begin(); it != filesInDir.end(); ++it)
-            {
-              if (it->find("vvi") == std::string::npos)
-              {
-                std::string file = this->GetValueAsString("InputDICOMDir");
-                file += "/";
-                file += (*it);
-                if (vtksys::SystemTools::FileExists(file.c_str(), true))
-                {
-                  std::string sopInstanceUID;
-                  sz = this->GetZPositionFromFile(file, sopInstanceUID);
-                  if (sopInstanceUID.find(substring) != std::string::npos)
-                  {
-                    std::cout << "Found file: " << file << "\n  with matching SOPInstanceUID " << sopInstanceUID
-                              << "\n  matching string " << substring << std::endl;
-                    found = true;
-                    break;
-                  }
-                }
-              }
-            }
-
-            if (!found)
-            {
-              std::cerr << "Could not find a file with matching SOP " << substring << std::endl;
-              exit(-1);
-            }
+          DICOMDirectoryIndex::SliceType slice;
+          if (index.FindSliceByFileName(substring, slice))
+          {
+            std::cout << "Found matching filename: " << index.GetFullPath(slice.FileName) << "\n  with SOPInstanceUID "
+                      << slice.SOPInstanceUID << "\n  matching string " << substring << std::endl;
           }
+          else if (index.FindSliceBySOPInstanceUID(substring, slice))
+          {
+            // Some datasets in the biochange challenge rely on the filename,
+            // yet others rely on the SOP instance UID present in the file.
+            std::cout << "Found file: " << index.GetFullPath(slice.FileName) << "\n  with matching SOPInstanceUID "
+                      << slice.SOPInstanceUID << "\n  matching string " << substring << std::endl;
+          }
+          else
+          {
+            std::cerr << "Could not find a file with matching SOP " << substring << std::endl;
+            exit(-1);
+          }
+          sz = slice.Position[2];
         }
       }
 
-      // Sanity check
+      // Sanity check, once the image is read. Physical seeds are also used
+      // to select the DICOM slices to read, before the image is known.
       std::cout << "Seed position in physical units: (" << sx << "," << sy << "," << sz << ")" << std::endl;
-      InputImageType::PointType pointSeed;
-      pointSeed[0] = sx;
-      pointSeed[1] = sy;
-      pointSeed[2] = sz;
-      IndexType indexSeed;
-      m_Image->TransformPhysicalPointToIndex(pointSeed, indexSeed);
-      if (!this->m_Image->GetBufferedRegion().IsInside(indexSeed))
+      if (this->m_Image)
       {
-        std::cerr << "Seed with pixel units of index: " << indexSeed
-                  << " does not lie within the image. The images extents are" << this->m_Image->GetBufferedRegion()
-                  << std::endl;
-        exit(-1);
+        InputImageType::PointType pointSeed;
+        pointSeed[0] = sx;
+        pointSeed[1] = sy;
+        pointSeed[2] = sz;
+        IndexType indexSeed;
+        m_Image->TransformPhysicalPointToIndex(pointSeed, indexSeed);
+        if (!this->m_Image->GetBufferedRegion().IsInside(indexSeed))
+        {
+          std::cerr << "Seed with pixel units of index: " << indexSeed
+                    << " does not lie within the image. The images extents are" << this->m_Image->GetBufferedRegion()
+                    << std::endl;
+          exit(-1);
+        }
       }
 
       seeds[i].SetPosition(sx, sy, sz);
@@ -280,44 +275,6 @@ protected:
   }
 
 
-  // get files in dir
-  std::vector<std::string>
-  GetFilesInDirectory(std::string dir)
-  {
-    std::vector<std::string> files;
-    DIR *                    dp;
-    struct dirent *          dirp;
-    if ((dp = opendir(dir.c_str())) == NULL)
-    {
-      std::cerr << "Error(" << errno << ") opening " << dir << std::endl;
-      return files;
-    }
-
-    while ((dirp = readdir(dp)) != NULL)
-    {
-      files.push_back(std::string(dirp->d_name));
-    }
-
-    closedir(dp);
-    return files;
-  }
-
-
-  double
-  GetZPositionFromFile(std::string file, std::string & sopInstanceUID)
-  {
-    using ReaderType = itk::ImageFileReader<InputImageType>;
-    ReaderType::Pointer reader = ReaderType::New();
-    reader->SetFileName(file);
-    reader->Update();
-
-    itk::MetaDataDictionary dict = reader->GetMetaDataDictionary();
-    itk::ExposeMetaData<std::string>(dict, "0008|0018", sopInstanceUID);
-
-    return reader->GetOutput()->GetOrigin()[2];
-  }
-
-
   double           ROI[6];
   InputImageType * m_Image;
 };
@@ -71,6 +71,10 @@ public:
   itkSetMacro(Threshold, double);
   itkGetMacro(Threshold, double);
 
+  /** Print the parameters that determine the feature. */
+  void
+  PrintParameters(std::ostream & os) const override;
+
 protected:
   BinaryThresholdFeatureGenerator();
   ~BinaryThresholdFeatureGenerator() override;
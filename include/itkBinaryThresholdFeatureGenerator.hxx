@@ -53,6 +53,18 @@ BinaryThresholdFeatureGenerator<NDimension>::PrintSelf(std::ostream & os, Indent
 }
 
 
+/**
+ * PrintParameters
+ */
+template <unsigned int NDimension>
+void
+BinaryThresholdFeatureGenerator<NDimension>::PrintParameters(std::ostream & os) const
+{
+  Superclass::PrintParameters(os);
+  os << "Threshold " << this->m_Threshold << std::endl;
+}
+
+
 template <unsigned int NDimension>
 void
 BinaryThresholdFeatureGenerator<NDimension>::GenerateData()
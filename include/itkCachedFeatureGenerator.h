@@ -0,0 +1,144 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkCachedFeatureGenerator_h
+#define itkCachedFeatureGenerator_h
+
+#include "itkFeatureGenerator.h"
+#include "itkImage.h"
+#include "itkImageSpatialObject.h"
+
+#include <cstdint>
+#include <string>
+
+namespace itk
+{
+
+/** \class CachedFeatureGenerator
+ * \brief Feature generator that keeps the features of another generator in
+ * a directory of files.
+ *
+ * The feature of the wrapped FeatureGenerator is stored in the
+ * CacheDirectory as a compressed MetaImage file, whose name is a 64 bits
+ * hash of the input image, pixels and geometry, and of the parameters of the
+ * generator given by FeatureGenerator::PrintParameters(). When the file
+ * already exists, the feature is read from it instead of being computed, so
+ * that the features of a region of interest are computed once across the
+ * executions that only change the parameters of the segmentation.
+ *
+ * Without a CacheDirectory, the feature of the wrapped generator is passed
+ * through. Only features that are images of floats are cached, and the
+ * input must be an image of signed shorts, as for the feature generators of
+ * this module.
+ *
+ * \ingroup SpatialObjectFilters
+ * \ingroup LesionSizingToolkit
+ */
+template <unsigned int NDimension>
+class ITK_TEMPLATE_EXPORT CachedFeatureGenerator : public FeatureGenerator<NDimension>
+{
+public:
+  ITK_DISALLOW_COPY_AND_MOVE(CachedFeatureGenerator);
+
+  /** Standard class type alias. */
+  using Self = CachedFeatureGenerator;
+  using Superclass = FeatureGenerator<NDimension>;
+  using Pointer = SmartPointer<Self>;
+  using ConstPointer = SmartPointer<const Self>;
+
+  /** Method for creation through the object factory. */
+  itkNewMacro(Self);
+
+  /** Run-time type information (and related methods). */
+  itkOverrideGetNameOfClassMacro(CachedFeatureGenerator);
+
+  /** Dimension of the space */
+  static constexpr unsigned int Dimension = NDimension;
+
+  /** Type of spatialObject that will be passed as input to this
+   * feature generator. */
+  using InputPixelType = signed short;
+  using InputImageType = Image<InputPixelType, Dimension>;
+  using InputImageSpatialObjectType = ImageSpatialObject<NDimension, InputPixelType>;
+  using SpatialObjectType = typename Superclass::SpatialObjectType;
+
+  /** Type of the feature images. */
+  using OutputPixelType = float;
+  using OutputImageType = Image<OutputPixelType, Dimension>;
+  using OutputImageSpatialObjectType = ImageSpatialObject<NDimension, OutputPixelType>;
+
+  /** Generator whose features are cached. */
+  using FeatureGeneratorType = FeatureGenerator<Dimension>;
+  itkSetObjectMacro(FeatureGenerator, FeatureGeneratorType);
+  itkGetModifiableObjectMacro(FeatureGenerator, FeatureGeneratorType);
+
+  /** Directory of the cached features. It is created when it does not
+   * exist. The features are not cached when it is empty, the default. */
+  itkSetStringMacro(CacheDirectory);
+  itkGetStringMacro(CacheDirectory);
+
+  /** Whether the last feature was read from the cache. */
+  itkGetConstMacro(CacheHit, bool);
+
+  /** Input data that will be used for generating the feature. */
+  using ProcessObject::SetInput;
+  void
+  SetInput(const SpatialObjectType * input);
+
+  /** Output data that carries the feature in the form of a
+   * SpatialObject. */
+  const SpatialObjectType *
+  GetFeature() const;
+
+  /** The parameters of the wrapped generator. */
+  void
+  PrintParameters(std::ostream & os) const override;
+
+  /** The MTime includes the one of the wrapped generator. */
+  ModifiedTimeType
+  GetMTime() const override;
+
+protected:
+  CachedFeatureGenerator();
+  ~CachedFeatureGenerator() override = default;
+  void
+  PrintSelf(std::ostream & os, Indent indent) const override;
+
+  void
+  GenerateData() override;
+
+private:
+  /** Name of the cache file of the feature of the input image. */
+  std::string
+  ComputeCacheFileName(const InputImageType * inputImage) const;
+
+  /** 64 bits FNV-1a hash, continued from the given hash. */
+  static std::uint64_t
+  Hash(const void * data, std::size_t size, std::uint64_t hash);
+
+  typename FeatureGeneratorType::Pointer m_FeatureGenerator;
+  std::string                            m_CacheDirectory;
+  bool                                   m_CacheHit;
+};
+
+} // end namespace itk
+
+#ifndef ITK_MANUAL_INSTANTIATION
+#  include "itkCachedFeatureGenerator.hxx"
+#endif
+
+#endif
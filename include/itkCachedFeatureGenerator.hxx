@@ -0,0 +1,291 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkCachedFeatureGenerator_hxx
+#define itkCachedFeatureGenerator_hxx
+
+#include "itkImageFileReader.h"
+#include "itkImageFileWriter.h"
+#include "itkProgressAccumulator.h"
+#include "itksys/SystemTools.hxx"
+
+#include <iomanip>
+#include <random>
+#include <sstream>
+
+namespace itk
+{
+
+/**
+ * Constructor
+ */
+template <unsigned int NDimension>
+CachedFeatureGenerator<NDimension>::CachedFeatureGenerator()
+{
+  this->SetNumberOfRequiredInputs(1);
+  this->SetNumberOfRequiredOutputs(1);
+
+  typename OutputImageSpatialObjectType::Pointer outputObject = OutputImageSpatialObjectType::New();
+
+  this->ProcessObject::SetNthOutput(0, outputObject.GetPointer());
+
+  this->m_CacheHit = false;
+}
+
+
+template <unsigned int NDimension>
+void
+CachedFeatureGenerator<NDimension>::SetInput(const SpatialObjectType * spatialObject)
+{
+  // Process object is not const-correct so the const casting is required.
+  this->SetNthInput(0, const_cast<SpatialObjectType *>(spatialObject));
+}
+
+template <unsigned int NDimension>
+const typename CachedFeatureGenerator<NDimension>::SpatialObjectType *
+CachedFeatureGenerator<NDimension>::GetFeature() const
+{
+  return static_cast<const SpatialObjectType *>(this->ProcessObject::GetOutput(0));
+}
+
+
+template <unsigned int NDimension>
+ModifiedTimeType
+CachedFeatureGenerator<NDimension>::GetMTime() const
+{
+  ModifiedTimeType mtime = this->Superclass::GetMTime();
+  if (this->m_FeatureGenerator && this->m_FeatureGenerator->GetMTime() > mtime)
+  {
+    mtime = this->m_FeatureGenerator->GetMTime();
+  }
+  return mtime;
+}
+
+
+/**
+ * PrintSelf
+ */
+template <unsigned int NDimension>
+void
+CachedFeatureGenerator<NDimension>::PrintSelf(std::ostream & os, Indent indent) const
+{
+  Superclass::PrintSelf(os, indent);
+  os << indent << "FeatureGenerator: " << this->m_FeatureGenerator.GetPointer() << std::endl;
+  os << indent << "CacheDirectory: " << this->m_CacheDirectory << std::endl;
+  os << indent << "CacheHit: " << this->m_CacheHit << std::endl;
+}
+
+
+/**
+ * PrintParameters
+ */
+template <unsigned int NDimension>
+void
+CachedFeatureGenerator<NDimension>::PrintParameters(std::ostream & os) const
+{
+  if (this->m_FeatureGenerator)
+  {
+    this->m_FeatureGenerator->PrintParameters(os);
+  }
+  else
+  {
+    Superclass::PrintParameters(os);
+  }
+}
+
+
+/**
+ * Hash
+ */
+template <unsigned int NDimension>
+std::uint64_t
+CachedFeatureGenerator<NDimension>::Hash(const void * data, std::size_t size, std::uint64_t hash)
+{
+  const auto * bytes = static_cast<const unsigned char *>(data);
+  for (std::size_t i = 0; i < size; ++i)
+  {
+    hash ^= bytes[i];
+    hash *= 0x100000001b3ULL;
+  }
+  return hash;
+}
+
+
+/**
+ * ComputeCacheFileName
+ */
+template <unsigned int NDimension>
+std::string
+CachedFeatureGenerator<NDimension>::ComputeCacheFileName(const InputImageType * inputImage) const
+{
+  // The geometry of the input and the parameters, with all the digits.
+  std::ostringstream key;
+  key << std::setprecision(17);
+  key << "LesionSizingToolkit feature 1" << std::endl;
+  key << "Size " << inputImage->GetBufferedRegion().GetSize() << std::endl;
+  key << "Index " << inputImage->GetBufferedRegion().GetIndex() << std::endl;
+  key << "Spacing " << inputImage->GetSpacing() << std::endl;
+  key << "Origin " << inputImage->GetOrigin() << std::endl;
+  key << "Direction " << inputImage->GetDirection() << std::endl;
+  this->m_FeatureGenerator->PrintParameters(key);
+
+  const std::string keyString = key.str();
+
+  std::uint64_t hash = 0xcbf29ce484222325ULL;
+  hash = Hash(keyString.data(), keyString.size(), hash);
+  hash = Hash(inputImage->GetBufferPointer(),
+              inputImage->GetBufferedRegion().GetNumberOfPixels() * sizeof(InputPixelType),
+              hash);
+
+  std::ostringstream fileName;
+  fileName << this->m_CacheDirectory << "/" << std::hex << std::setw(16) << std::setfill('0') << hash << ".mha";
+  return fileName.str();
+}
+
+
+/*
+ * Generate Data
+ */
+template <unsigned int NDimension>
+void
+CachedFeatureGenerator<NDimension>::GenerateData()
+{
+  if (!this->m_FeatureGenerator)
+  {
+    itkExceptionMacro("Missing feature generator");
+  }
+
+  typename InputImageSpatialObjectType::ConstPointer inputObject =
+    dynamic_cast<const InputImageSpatialObjectType *>(this->ProcessObject::GetInput(0));
+
+  if (!inputObject)
+  {
+    itkExceptionMacro("Missing input spatial object or incorrect type");
+  }
+
+  const InputImageType * inputImage = inputObject->GetImage();
+
+  if (!inputImage)
+  {
+    itkExceptionMacro("Missing input image");
+  }
+
+  auto * outputObject = dynamic_cast<OutputImageSpatialObjectType *>(this->ProcessObject::GetOutput(0));
+
+  this->m_CacheHit = false;
+
+  std::string cacheFileName;
+  if (!this->m_CacheDirectory.empty())
+  {
+    cacheFileName = this->ComputeCacheFileName(inputImage);
+
+    if (itksys::SystemTools::FileExists(cacheFileName, true))
+    {
+      using ReaderType = ImageFileReader<OutputImageType>;
+      typename ReaderType::Pointer reader = ReaderType::New();
+      reader->SetFileName(cacheFileName);
+
+      // A file that cannot be read is replaced by the computed feature.
+      try
+      {
+        reader->Update();
+
+        typename OutputImageType::Pointer outputImage = reader->GetOutput();
+        outputImage->DisconnectPipeline();
+
+        // MetaImage files do not keep the start index of the regions, which
+        // is restored from the input along with its geometry.
+        if (outputImage->GetBufferedRegion().GetSize() == inputImage->GetBufferedRegion().GetSize())
+        {
+          outputImage->CopyInformation(inputImage);
+          outputImage->SetBufferedRegion(inputImage->GetBufferedRegion());
+          outputImage->SetRequestedRegion(inputImage->GetBufferedRegion());
+          outputObject->SetImage(outputImage);
+          this->m_CacheHit = true;
+          this->UpdateProgress(1.0f);
+          return;
+        }
+      }
+      catch (ExceptionObject & excp)
+      {
+        itkWarningMacro("Could not read the cached feature " << cacheFileName << ": " << excp.GetDescription());
+      }
+    }
+  }
+
+  // Report progress.
+  ProgressAccumulator::Pointer progress = ProgressAccumulator::New();
+  progress->SetMiniPipelineFilter(this);
+  progress->RegisterInternalFilter(this->m_FeatureGenerator, 1.0);
+
+  this->m_FeatureGenerator->SetInput(inputObject);
+  this->m_FeatureGenerator->Update();
+
+  const auto * featureObject =
+    dynamic_cast<const OutputImageSpatialObjectType *>(this->m_FeatureGenerator->GetFeature());
+
+  if (!featureObject)
+  {
+    itkExceptionMacro("The feature of " << this->m_FeatureGenerator->GetNameOfClass()
+                                        << " is not an image of floats and cannot be cached");
+  }
+
+  outputObject->SetImage(featureObject->GetImage());
+
+  if (cacheFileName.empty())
+  {
+    return;
+  }
+
+  // Write to a file of a unique name, renamed once complete, so that
+  // concurrent executions never read a partial file.
+  if (!itksys::SystemTools::MakeDirectory(this->m_CacheDirectory))
+  {
+    itkWarningMacro("Could not create the cache directory " << this->m_CacheDirectory);
+    return;
+  }
+
+  std::random_device randomDevice;
+  std::ostringstream partialFileName;
+  partialFileName << cacheFileName.substr(0, cacheFileName.size() - 4) << "-" << std::hex << randomDevice() << ".mha";
+
+  using WriterType = ImageFileWriter<OutputImageType>;
+  typename WriterType::Pointer writer = WriterType::New();
+  writer->SetFileName(partialFileName.str());
+  writer->SetInput(featureObject->GetImage());
+  writer->UseCompressionOn();
+
+  try
+  {
+    writer->Update();
+  }
+  catch (ExceptionObject & excp)
+  {
+    itkWarningMacro("Could not write the cached feature " << cacheFileName << ": " << excp.GetDescription());
+    itksys::SystemTools::RemoveFile(partialFileName.str());
+    return;
+  }
+
+  if (!itksys::SystemTools::RenameFile(partialFileName.str(), cacheFileName))
+  {
+    itksys::SystemTools::RemoveFile(partialFileName.str());
+  }
+}
+
+} // end namespace itk
+
+#endif
@@ -80,6 +80,20 @@ CannyEdgesDistanceAdvectionFieldFeatureGenerator<NDimension>::PrintSelf(std::ost
 }
 
 
+/**
+ * PrintParameters
+ */
+template <unsigned int NDimension>
+void
+CannyEdgesDistanceAdvectionFieldFeatureGenerator<NDimension>::PrintParameters(std::ostream & os) const
+{
+  Superclass::PrintParameters(os);
+  os << "Sigma " << this->m_Sigma << std::endl;
+  os << "UpperThreshold " << this->m_UpperThreshold << std::endl;
+  os << "LowerThreshold " << this->m_LowerThreshold << std::endl;
+}
+
+
 /*
  * Generate Data
  */
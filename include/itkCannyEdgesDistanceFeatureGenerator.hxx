@@ -77,6 +77,20 @@ CannyEdgesDistanceFeatureGenerator<NDimension>::PrintSelf(std::ostream & os, Ind
 }
 
 
+/**
+ * PrintParameters
+ */
+template <unsigned int NDimension>
+void
+CannyEdgesDistanceFeatureGenerator<NDimension>::PrintParameters(std::ostream & os) const
+{
+  Superclass::PrintParameters(os);
+  os << "Sigma " << this->m_Sigma << std::endl;
+  os << "UpperThreshold " << this->m_UpperThreshold << std::endl;
+  os << "LowerThreshold " << this->m_LowerThreshold << std::endl;
+}
+
+
 /*
  * Generate Data
  */
@@ -119,6 +119,10 @@ public:
   itkSetMacro(LowerThreshold, double);
   itkGetMacro(LowerThreshold, double);
 
+  /** Print the parameters that determine the feature. */
+  void
+  PrintParameters(std::ostream & os) const override;
+
 protected:
   CannyEdgesFeatureGenerator();
   ~CannyEdgesFeatureGenerator() override;
@@ -83,6 +83,20 @@ CannyEdgesFeatureGenerator<NDimension>::PrintSelf(std::ostream & os, Indent inde
 }
 
 
+/**
+ * PrintParameters
+ */
+template <unsigned int NDimension>
+void
+CannyEdgesFeatureGenerator<NDimension>::PrintParameters(std::ostream & os) const
+{
+  Superclass::PrintParameters(os);
+  os << "Sigma " << this->m_Sigma << std::endl;
+  os << "UpperThreshold " << this->m_UpperThreshold << std::endl;
+  os << "LowerThreshold " << this->m_LowerThreshold << std::endl;
+}
+
+
 /*
  * Generate Data
  */
@@ -19,15 +19,21 @@
 #define itkConfidenceConnectedSegmentationModule_h
 
 #include "itkRegionGrowingSegmentationModule.h"
-#include "itkConfidenceConnectedImageFilter.h"
+#include "itkParallelConnectedThresholdImageFilter.h"
 
 namespace itk
 {
 
 /** \class ConfidenceConnectedSegmentationModule
- * \brief This class applies the connected threshold region growing
+ * \brief This class applies the confidence connected region growing
  * segmentation method.
  *
+ * As in the ConfidenceConnectedImageFilter, the intensity interval is
+ * estimated first in the neighborhoods of the seeds, then re-estimated from
+ * the mean and the variance of the region a few times. Every region is grown
+ * with the ParallelConnectedThresholdImageFilter, and the statistics of the
+ * region are computed with a multithreaded pass over the image.
+ *
  * SpatialObjects are used as inputs and outputs of this class.
  *
  * \ingroup SpatialObjectFilters
@@ -77,6 +83,15 @@ protected:
   GenerateData() override;
 
 private:
+  /** Mean and variance of the feature over the pixels of the region, that
+   * have the InsideValue in the output image. Returns the number of pixels
+   * of the region. */
+  SizeValueType
+  ComputeRegionStatistics(const FeatureImageType * featureImage,
+                          const OutputImageType *  outputImage,
+                          double &                 mean,
+                          double &                 variance);
+
   double m_SigmaMultiplier;
 };
 
@@ -18,7 +18,15 @@
 #ifndef itkConfidenceConnectedSegmentationModule_hxx
 #define itkConfidenceConnectedSegmentationModule_hxx
 
-#include "itkProgressAccumulator.h"
+#include "itkMath.h"
+#include "itkMeanImageFunction.h"
+#include "itkMultiThreaderBase.h"
+#include "itkNumericTraits.h"
+#include "itkVarianceImageFunction.h"
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
 
 
 namespace itk
@@ -50,6 +58,75 @@ ConfidenceConnectedSegmentationModule<NDimension>::PrintSelf(std::ostream & os,
 }
 
 
+/**
+ * Statistics of the region
+ */
+template <unsigned int NDimension>
+SizeValueType
+ConfidenceConnectedSegmentationModule<NDimension>::ComputeRegionStatistics(const FeatureImageType * featureImage,
+                                                                           const OutputImageType *  outputImage,
+                                                                           double &                 mean,
+                                                                           double &                 variance)
+{
+  const auto *        featureBuffer = featureImage->GetBufferPointer();
+  const auto *        outputBuffer = outputImage->GetBufferPointer();
+  const SizeValueType numberOfPixels = outputImage->GetBufferedRegion().GetNumberOfPixels();
+
+  // The sums are accumulated per block of fixed length, and then added in
+  // order, so that the statistics do not depend on the number of threads.
+  constexpr SizeValueType blockLength = 65536;
+  const SizeValueType     numberOfBlocks = (numberOfPixels + blockLength - 1) / blockLength;
+
+  std::vector<double>        sums(numberOfBlocks);
+  std::vector<double>        sumsOfSquares(numberOfBlocks);
+  std::vector<SizeValueType> counts(numberOfBlocks);
+
+  this->GetMultiThreader()->ParallelizeArray(
+    0,
+    numberOfBlocks,
+    [&](SizeValueType block) {
+      double        sum = 0.0;
+      double        sumOfSquares = 0.0;
+      SizeValueType count = 0;
+
+      const SizeValueType last = std::min(numberOfPixels, (block + 1) * blockLength);
+      for (SizeValueType i = block * blockLength; i < last; ++i)
+      {
+        if (Math::ExactlyEquals(outputBuffer[i], Superclass::InsideValue))
+        {
+          const double value = featureBuffer[i];
+          sum += value;
+          sumOfSquares += value * value;
+          ++count;
+        }
+      }
+
+      sums[block] = sum;
+      sumsOfSquares[block] = sumOfSquares;
+      counts[block] = count;
+    },
+    nullptr);
+
+  double        sum = 0.0;
+  double        sumOfSquares = 0.0;
+  SizeValueType count = 0;
+  for (SizeValueType block = 0; block < numberOfBlocks; ++block)
+  {
+    sum += sums[block];
+    sumOfSquares += sumsOfSquares[block];
+    count += counts[block];
+  }
+
+  if (count > 1)
+  {
+    mean = sum / count;
+    variance = (sumOfSquares - sum * sum / count) / (count - 1.0);
+  }
+
+  return count;
+}
+
+
 /**
  * Generate Data
  */
@@ -57,7 +134,12 @@ template <unsigned int NDimension>
 void
 ConfidenceConnectedSegmentationModule<NDimension>::GenerateData()
 {
-  using FilterType = ConfidenceConnectedImageFilter<FeatureImageType, OutputImageType>;
+  using FilterType = ParallelConnectedThresholdImageFilter<FeatureImageType, OutputImageType>;
+  using FeaturePixelType = typename FeatureImageType::PixelType;
+
+  // Same parameters as the ConfidenceConnectedImageFilter used previously.
+  constexpr unsigned int numberOfIterations = 5;
+  constexpr unsigned int initialNeighborhoodRadius = 2;
 
   typename FilterType::Pointer filter = FilterType::New();
 
@@ -74,26 +156,88 @@ ConfidenceConnectedSegmentationModule<NDimension>::GenerateData()
 
   const LandmarkPointListType & points = inputSeeds->GetPoints();
 
+  //
+  // Initial statistics in the neighborhoods of the seeds.
+  //
+  using MeanFunctionType = MeanImageFunction<FeatureImageType, double>;
+  using VarianceFunctionType = VarianceImageFunction<FeatureImageType, double>;
+
+  typename MeanFunctionType::Pointer meanFunction = MeanFunctionType::New();
+  meanFunction->SetInputImage(featureImage);
+  meanFunction->SetNeighborhoodRadius(initialNeighborhoodRadius);
+
+  typename VarianceFunctionType::Pointer varianceFunction = VarianceFunctionType::New();
+  varianceFunction->SetInputImage(featureImage);
+  varianceFunction->SetNeighborhoodRadius(initialNeighborhoodRadius);
+
+  double       mean = 0.0;
+  double       variance = 0.0;
+  double       lowestSeedValue = NumericTraits<double>::max();
+  double       highestSeedValue = NumericTraits<double>::NonpositiveMin();
+  unsigned int numberOfSeedsInside = 0;
+
   for (unsigned int i = 0; i < numberOfPoints; i++)
   {
     const IndexType index = featureImage->TransformPhysicalPointToIndex(points[i].GetPositionInObjectSpace());
     filter->AddSeed(index);
+
+    if (featureImage->GetBufferedRegion().IsInside(index))
+    {
+      mean += meanFunction->EvaluateAtIndex(index);
+      variance += varianceFunction->EvaluateAtIndex(index);
+
+      const double seedValue = featureImage->GetPixel(index);
+      lowestSeedValue = std::min(lowestSeedValue, seedValue);
+      highestSeedValue = std::max(highestSeedValue, seedValue);
+      ++numberOfSeedsInside;
+    }
   }
 
-  filter->SetMultiplier(this->m_SigmaMultiplier);
+  if (numberOfSeedsInside > 0)
+  {
+    mean /= numberOfSeedsInside;
+    variance /= numberOfSeedsInside;
+  }
 
-  filter->SetReplaceValue(1.0);
-  filter->SetNumberOfIterations(5);
-  filter->SetInitialNeighborhoodRadius(2);
+  filter->SetReplaceValue(Superclass::InsideValue);
+  filter->SetOutsideValue(Superclass::OutsideValue);
 
-  // Report progress.
-  ProgressAccumulator::Pointer progress = ProgressAccumulator::New();
-  progress->SetMiniPipelineFilter(this);
-  progress->RegisterInternalFilter(filter, 1.0);
+  // The interval always contains the intensities of the seeds, otherwise
+  // the region would be empty.
+  const double minimumValue = NumericTraits<FeaturePixelType>::NonpositiveMin();
+  const double maximumValue = NumericTraits<FeaturePixelType>::max();
 
+  auto setInterval = [&]() {
+    const double deviation = this->m_SigmaMultiplier * std::sqrt(variance);
+    const double lower = std::max(std::min(mean - deviation, lowestSeedValue), minimumValue);
+    const double upper = std::min(std::max(mean + deviation, highestSeedValue), maximumValue);
+    filter->SetLower(static_cast<FeaturePixelType>(lower));
+    filter->SetUpper(static_cast<FeaturePixelType>(upper));
+  };
+
+  setInterval();
   filter->Update();
 
-  this->PackOutputImageInOutputSpatialObject(filter->GetOutput());
+  //
+  // Re-estimate the interval from the statistics of the region.
+  //
+  for (unsigned int iteration = 0; iteration < numberOfIterations; ++iteration)
+  {
+    this->UpdateProgress(static_cast<float>(iteration + 1) / (numberOfIterations + 1));
+
+    if (this->ComputeRegionStatistics(featureImage, filter->GetOutput(), mean, variance) < 2 ||
+        Math::AlmostEquals(variance, 0.0))
+    {
+      break;
+    }
+
+    setInterval();
+    filter->Update();
+  }
+
+  this->UpdateProgress(1.0f);
+
+  this->PackCenteredRangeImageInOutputSpatialObject(filter->GetOutput());
 }
 
 } // end namespace itk
@@ -19,7 +19,7 @@
 #define itkConnectedThresholdSegmentationModule_h
 
 #include "itkRegionGrowingSegmentationModule.h"
-#include "itkConnectedThresholdImageFilter.h"
+#include "itkParallelConnectedThresholdImageFilter.h"
 
 namespace itk
 {
@@ -28,6 +28,9 @@ namespace itk
  * \brief This class applies the connected threshold region growing
  * segmentation method.
  *
+ * The region is grown with the ParallelConnectedThresholdImageFilter, which
+ * writes the values of the output directly.
+ *
  * SpatialObjects are used as inputs and outputs of this class.
  *
  * \ingroup SpatialObjectFilters
@@ -57,7 +57,7 @@ template <unsigned int NDimension>
 void
 ConnectedThresholdSegmentationModule<NDimension>::GenerateData()
 {
-  using FilterType = ConnectedThresholdImageFilter<FeatureImageType, OutputImageType>;
+  using FilterType = ParallelConnectedThresholdImageFilter<FeatureImageType, OutputImageType>;
 
   typename FilterType::Pointer filter = FilterType::New();
 
@@ -80,9 +80,12 @@ ConnectedThresholdSegmentationModule<NDimension>::GenerateData()
     filter->AddSeed(index);
   }
 
-  filter->SetLower(this->m_LowerThreshold);
-  filter->SetUpper(this->m_UpperThreshold);
-  filter->SetReplaceValue(1.0);
+  using FeaturePixelType = typename FeatureImageType::PixelType;
+
+  filter->SetLower(static_cast<FeaturePixelType>(this->m_LowerThreshold));
+  filter->SetUpper(static_cast<FeaturePixelType>(this->m_UpperThreshold));
+  filter->SetReplaceValue(Superclass::InsideValue);
+  filter->SetOutsideValue(Superclass::OutsideValue);
 
   // Report progress.
   ProgressAccumulator::Pointer progress = ProgressAccumulator::New();
@@ -91,7 +94,7 @@ ConnectedThresholdSegmentationModule<NDimension>::GenerateData()
 
   filter->Update();
 
-  this->PackOutputImageInOutputSpatialObject(filter->GetOutput());
+  this->PackCenteredRangeImageInOutputSpatialObject(filter->GetOutput());
 }
 
 } // end namespace itk
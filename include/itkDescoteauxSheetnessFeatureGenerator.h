@@ -23,7 +23,7 @@
 #include "itkImageSpatialObject.h"
 #include "itkHessianRecursiveGaussianImageFilter.h"
 #include "itkSymmetricSecondRankTensor.h"
-#include "itkSymmetricEigenAnalysisImageFilter.h"
+#include "itkHessianEigenvalueMeasureImageFilter.h"
 #include "itkDescoteauxSheetnessImageFilter.h"
 #include "itkRescaleIntensityImageFilter.h"
 
@@ -99,12 +99,22 @@ public:
   itkSetMacro(NoiseNormalization, double);
   itkGetMacro(NoiseNormalization, double);
 
+  /** Use a fast polynomial approximation of the exponentials of the measure,
+   * with a relative error below 1e-9. Off by default. */
+  itkSetMacro(UseFastApproximation, bool);
+  itkGetMacro(UseFastApproximation, bool);
+  itkBooleanMacro(UseFastApproximation);
+
   /** Defines whether the filter will look for Bright sheets over a Dark
    * background or for Dark sheets over a Bright background. */
   itkSetMacro(DetectBrightSheets, bool);
   itkGetMacro(DetectBrightSheets, bool);
   itkBooleanMacro(DetectBrightSheets);
 
+  /** Print the parameters that determine the feature. */
+  void
+  PrintParameters(std::ostream & os) const override;
+
 protected:
   DescoteauxSheetnessFeatureGenerator();
   ~DescoteauxSheetnessFeatureGenerator() override;
@@ -130,24 +140,23 @@ private:
   using HessianPixelType = typename HessianImageType::PixelType;
 
   using EigenValueArrayType = FixedArray<double, HessianPixelType::Dimension>;
-  using EigenValueImageType = Image<EigenValueArrayType, Dimension>;
-
-  using EigenAnalysisFilterType = SymmetricEigenAnalysisImageFilter<HessianImageType, EigenValueImageType>;
+  using SheetnessFunctionType = Function::Sheetness<EigenValueArrayType, OutputPixelType>;
 
-  using SheetnessFilterType = DescoteauxSheetnessImageFilter<EigenValueImageType, OutputImageType>;
+  using SheetnessFilterType =
+    HessianEigenvalueMeasureImageFilter<HessianImageType, OutputImageType, SheetnessFunctionType>;
 
   using RescaleFilterType = RescaleIntensityImageFilter<OutputImageType, OutputImageType>;
 
-  typename HessianFilterType::Pointer       m_HessianFilter;
-  typename EigenAnalysisFilterType::Pointer m_EigenAnalysisFilter;
-  typename SheetnessFilterType::Pointer     m_SheetnessFilter;
-  typename RescaleFilterType::Pointer       m_RescaleFilter;
+  typename HessianFilterType::Pointer   m_HessianFilter;
+  typename SheetnessFilterType::Pointer m_SheetnessFilter;
+  typename RescaleFilterType::Pointer   m_RescaleFilter;
 
   double m_Sigma;
   double m_SheetnessNormalization;
   double m_BloobinessNormalization;
   double m_NoiseNormalization;
   bool   m_DetectBrightSheets;
+  bool   m_UseFastApproximation;
 };
 
 } // end namespace itk
@@ -31,13 +31,11 @@ DescoteauxSheetnessFeatureGenerator<NDimension>::DescoteauxSheetnessFeatureGener
   this->SetNumberOfRequiredInputs(1);
 
   this->m_HessianFilter = HessianFilterType::New();
-  this->m_EigenAnalysisFilter = EigenAnalysisFilterType::New();
   this->m_SheetnessFilter = SheetnessFilterType::New();
   this->m_RescaleFilter = RescaleFilterType::New();
 
   // Allow progressive memory release
   this->m_HessianFilter->ReleaseDataFlagOn();
-  this->m_EigenAnalysisFilter->ReleaseDataFlagOn();
   this->m_SheetnessFilter->ReleaseDataFlagOn();
   this->m_RescaleFilter->ReleaseDataFlagOn();
 
@@ -49,6 +47,7 @@ DescoteauxSheetnessFeatureGenerator<NDimension>::DescoteauxSheetnessFeatureGener
   this->m_SheetnessNormalization = 0.5;
   this->m_BloobinessNormalization = 2.0;
   this->m_NoiseNormalization = 1.0;
+  this->m_UseFastApproximation = false;
   this->m_DetectBrightSheets = true;
 }
 
@@ -86,6 +85,23 @@ DescoteauxSheetnessFeatureGenerator<NDimension>::PrintSelf(std::ostream & os, In
 }
 
 
+/**
+ * PrintParameters
+ */
+template <unsigned int NDimension>
+void
+DescoteauxSheetnessFeatureGenerator<NDimension>::PrintParameters(std::ostream & os) const
+{
+  Superclass::PrintParameters(os);
+  os << "Sigma " << this->m_Sigma << std::endl;
+  os << "SheetnessNormalization " << this->m_SheetnessNormalization << std::endl;
+  os << "BloobinessNormalization " << this->m_BloobinessNormalization << std::endl;
+  os << "NoiseNormalization " << this->m_NoiseNormalization << std::endl;
+  os << "DetectBrightSheets " << this->m_DetectBrightSheets << std::endl;
+  os << "UseFastApproximation " << this->m_UseFastApproximation << std::endl;
+}
+
+
 /*
  * Generate Data
  */
@@ -109,16 +125,17 @@ DescoteauxSheetnessFeatureGenerator<NDimension>::GenerateData()
   }
 
   this->m_HessianFilter->SetInput(inputImage);
-  this->m_EigenAnalysisFilter->SetInput(this->m_HessianFilter->GetOutput());
-  this->m_SheetnessFilter->SetInput(this->m_EigenAnalysisFilter->GetOutput());
+  this->m_SheetnessFilter->SetInput(this->m_HessianFilter->GetOutput());
   this->m_RescaleFilter->SetInput(this->m_SheetnessFilter->GetOutput());
 
   this->m_HessianFilter->SetSigma(this->m_Sigma);
-  this->m_EigenAnalysisFilter->SetDimension(Dimension);
-  this->m_SheetnessFilter->SetSheetnessNormalization(this->m_SheetnessNormalization);
-  this->m_SheetnessFilter->SetBloobinessNormalization(this->m_BloobinessNormalization);
-  this->m_SheetnessFilter->SetNoiseNormalization(this->m_NoiseNormalization);
-  this->m_SheetnessFilter->SetDetectBrightSheets(this->m_DetectBrightSheets);
+
+  SheetnessFunctionType & sheetness = this->m_SheetnessFilter->GetMeasure();
+  sheetness.SetAlpha(this->m_SheetnessNormalization);
+  sheetness.SetGamma(this->m_BloobinessNormalization);
+  sheetness.SetC(this->m_NoiseNormalization);
+  sheetness.SetDetectBrightSheets(this->m_DetectBrightSheets);
+  sheetness.SetUseFastApproximation(this->m_UseFastApproximation);
 
   this->m_RescaleFilter->SetOutputMinimum(0.0);
   this->m_RescaleFilter->SetOutputMaximum(1.0);
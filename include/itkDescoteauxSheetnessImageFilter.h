@@ -19,6 +19,7 @@
 #define itkDescoteauxSheetnessImageFilter_h
 
 #include "itkUnaryFunctorImageFilter.h"
+#include "itkEigenValueMeasureFunctions.h"
 #include "itkMath.h"
 
 namespace itk
@@ -47,10 +48,11 @@ class Sheetness
 public:
   Sheetness()
   {
-    m_Alpha = 0.5; // suggested value in the paper
-    m_Gamma = 0.5; // suggested value in the paper;
-    m_C = 1.0;
+    this->SetAlpha(0.5); // suggested value in the paper
+    this->SetGamma(0.5); // suggested value in the paper;
+    this->SetC(1.0);
     m_DetectBrightSheets = true;
+    m_UseFastApproximation = false;
   }
   ~Sheetness() = default;
   bool
@@ -64,102 +66,72 @@ public:
     return !(*this != other);
   }
   inline TOutput
-  operator()(const TInput & A)
+  operator()(const TInput & A) const
   {
-    double sheetness = 0.0;
-
     auto a1 = static_cast<double>(A[0]);
     auto a2 = static_cast<double>(A[1]);
     auto a3 = static_cast<double>(A[2]);
 
-    double l1 = itk::Math::abs(a1);
-    double l2 = itk::Math::abs(a2);
-    double l3 = itk::Math::abs(a3);
-
     //
     // Sort the values by their absolute value.
     // At the end of the sorting we should have
     //
-    //          l1 <= l2 <= l3
+    //          |a1| <= |a2| <= |a3|
     //
-    if (l2 > l3)
-    {
-      double tmpl = l3;
-      l3 = l2;
-      l2 = tmpl;
-      double tmpa = a3;
-      a3 = a2;
-      a2 = tmpa;
-    }
-
-    if (l1 > l2)
-    {
-      double tmp = l1;
-      l1 = l2;
-      l2 = tmp;
-      double tmpa = a1;
-      a1 = a2;
-      a2 = tmpa;
-    }
-
-    if (l2 > l3)
-    {
-      double tmp = l3;
-      l3 = l2;
-      l2 = tmp;
-      double tmpa = a3;
-      a3 = a2;
-      a2 = tmpa;
-    }
-
-    if (this->m_DetectBrightSheets)
-    {
-      if (a3 > 0.0)
-      {
-        return static_cast<TOutput>(sheetness);
-      }
-    }
-    else
-    {
-      if (a3 < 0.0)
-      {
-        return static_cast<TOutput>(sheetness);
-      }
-    }
+    SortByMagnitude(a1, a2, a3);
 
+    const double l1 = itk::Math::abs(a1);
+    const double l2 = itk::Math::abs(a2);
+    const double l3 = itk::Math::abs(a3);
 
     //
-    // Avoid divisions by zero (or close to zero)
+    // Reject the sheets of the opposite polarity, and avoid divisions by zero
+    // (or close to zero). The measure is computed for all the pixels and then
+    // masked, so that the evaluation does not branch.
     //
-    if (static_cast<double>(l3) < itk::Math::eps)
-    {
-      return static_cast<TOutput>(sheetness);
-    }
+    const bool polarity = this->m_DetectBrightSheets ? !(a3 > 0.0) : !(a3 < 0.0);
+    const bool valid = polarity && !(l3 < itk::Math::eps);
+
+    const double inverseL3 = 1.0 / (valid ? l3 : 1.0);
 
-    const double Rs = l2 / l3;
-    const double Rb = itk::Math::abs(l3 + l3 - l2 - l1) / l3;
-    const double Rn = std::sqrt(l3 * l3 + l2 * l2 + l1 * l1);
+    const double Rs = l2 * inverseL3;
+    const double Rb = itk::Math::abs(l3 + l3 - l2 - l1) * inverseL3;
+    const double Rn2 = l3 * l3 + l2 * l2 + l1 * l1;
 
-    sheetness = std::exp(-(Rs * Rs) / (2.0 * m_Alpha * m_Alpha));
-    sheetness *= (1.0 - std::exp(-(Rb * Rb) / (2.0 * m_Gamma * m_Gamma)));
-    sheetness *= (1.0 - std::exp(-(Rn * Rn) / (2.0 * m_C * m_C)));
+    double sheetness = this->Exponential(Rs * Rs * m_SheetnessFactor);
+    sheetness *= (1.0 - this->Exponential(Rb * Rb * m_BloobinessFactor));
+    sheetness *= (1.0 - this->Exponential(Rn2 * m_NoiseFactor));
 
-    return static_cast<TOutput>(sheetness);
+    return static_cast<TOutput>(valid ? sheetness : 0.0);
   }
+
+  /** Evaluate the measure on a contiguous array of eigenvalue arrays. */
+  void
+  Evaluate(const TInput * input, TOutput * output, SizeValueType numberOfPixels) const
+  {
+    for (SizeValueType i = 0; i < numberOfPixels; ++i)
+    {
+      output[i] = (*this)(input[i]);
+    }
+  }
+
   void
   SetAlpha(double value)
   {
     this->m_Alpha = value;
+    this->m_SheetnessFactor = -1.0 / (2.0 * value * value);
   }
   void
   SetGamma(double value)
   {
     this->m_Gamma = value;
+    this->m_BloobinessFactor = -1.0 / (2.0 * value * value);
   }
   void
   SetC(double value)
   {
     this->m_C = value;
+    this->m_NoiseFactor = -1.0 / (2.0 * value * value);
   }
   void
   SetDetectBrightSheets(bool value)
@@ -172,11 +144,29 @@ public:
     this->m_DetectBrightSheets = !value;
   }
 
+  /** Use a polynomial approximation of the exponential, with a relative
+   * error below 1e-9, instead of std::exp(). */
+  void
+  SetUseFastApproximation(bool value)
+  {
+    this->m_UseFastApproximation = value;
+  }
+
 private:
+  inline double
+  Exponential(double x) const
+  {
+    return this->m_UseFastApproximation ? ExponentialApproximation(x) : std::exp(x);
+  }
+
   double m_Alpha;
   double m_Gamma;
   double m_C;
+  double m_SheetnessFactor;
+  double m_BloobinessFactor;
+  double m_NoiseFactor;
   bool   m_DetectBrightSheets;
+  bool   m_UseFastApproximation;
 };
 } // namespace Function
 
@@ -236,6 +226,13 @@ public:
     this->GetFunctor().SetDetectDarkSheets(value);
   }
 
+  /** Trade accuracy for speed in the evaluation of the exponentials. */
+  void
+  SetUseFastApproximation(bool value)
+  {
+    this->GetFunctor().SetUseFastApproximation(value);
+  }
+
 #ifdef ITK_USE_CONCEPT_CHECKING
   /** Begin concept checking */
   using InputPixelType = typename TInputImage::PixelType;
@@ -0,0 +1,172 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkEigenValueMeasureFunctions_h
+#define itkEigenValueMeasureFunctions_h
+
+#include "itkMath.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+
+namespace itk
+{
+namespace Function
+{
+
+/**
+ * Helpers shared by the eigenvalue based measures (Function::Sheetness,
+ * Function::Tubularness and Function::LocalStructure).
+ *
+ * They are written without data dependent branches, so that loops calling
+ * them over arrays of pixels can be vectorized by the compiler.
+ *
+ * \ingroup LesionSizingToolkit
+ */
+
+/** Order two values by increasing absolute value. The values are exchanged
+ * only when the first one is strictly larger in magnitude. */
+inline void
+OrderByMagnitude(double & a, double & b)
+{
+  const bool   exchange = itk::Math::abs(a) > itk::Math::abs(b);
+  const double smaller = exchange ? b : a;
+  const double larger = exchange ? a : b;
+  a = smaller;
+  b = larger;
+}
+
+/** Sort three eigenvalues by increasing absolute value with a three
+ * comparator network. At the end |a1| <= |a2| <= |a3|. */
+inline void
+SortByMagnitude(double & a1, double & a2, double & a3)
+{
+  OrderByMagnitude(a2, a3);
+  OrderByMagnitude(a1, a2);
+  OrderByMagnitude(a2, a3);
+}
+
+/** Approximation of std::exp() with a relative error below 1e-9, computed
+ * with a Cody-Waite range reduction followed by a polynomial. Arguments are
+ * clamped to [-708, 709], the range of normal double precision results. */
+inline double
+ExponentialApproximation(double x)
+{
+  constexpr double log2e = 1.4426950408889634074;
+  constexpr double ln2High = 0.693145751953125;
+  constexpr double ln2Low = 1.42860682030941723212e-6;
+
+  x = std::clamp(x, -708.0, 709.0);
+
+  const double n = std::floor(x * log2e + 0.5);
+  const double r = (x - n * ln2High) - n * ln2Low;
+
+  // Taylor polynomial of degree 8, |r| <= ln(2)/2
+  double p = 1.0 / 40320.0;
+  p = p * r + 1.0 / 5040.0;
+  p = p * r + 1.0 / 720.0;
+  p = p * r + 1.0 / 120.0;
+  p = p * r + 1.0 / 24.0;
+  p = p * r + 1.0 / 6.0;
+  p = p * r + 0.5;
+  p = p * r + 1.0;
+  p = p * r + 1.0;
+
+  // Build 2^n directly in the exponent field of the double.
+  const std::uint64_t bits = static_cast<std::uint64_t>(static_cast<std::int64_t>(n) + 1023) << 52;
+  double              scale;
+  std::memcpy(&scale, &bits, sizeof(double));
+
+  return p * scale;
+}
+
+/** \class PowerWithFixedExponent
+ * \brief Raises values to an exponent known ahead of time.
+ *
+ * Integer and half integer exponents, which are the common values of the
+ * gamma parameters of the measures, are evaluated with multiplications and
+ * one square root instead of calling std::pow().
+ *
+ * \ingroup LesionSizingToolkit
+ */
+class PowerWithFixedExponent
+{
+public:
+  PowerWithFixedExponent() { this->SetExponent(1.0); }
+
+  void
+  SetExponent(double exponent)
+  {
+    this->m_Exponent = exponent;
+
+    const double twiceExponent = 2.0 * exponent;
+    const double roundedTwiceExponent = std::round(twiceExponent);
+
+    this->m_UseMultiplications =
+      (twiceExponent == roundedTwiceExponent) && (itk::Math::abs(roundedTwiceExponent) <= 2.0 * MaximumExponent);
+
+    if (this->m_UseMultiplications)
+    {
+      const auto twice = static_cast<int>(roundedTwiceExponent);
+      this->m_IntegerPart = std::abs(twice) / 2;
+      this->m_HasHalf = (twice % 2) != 0;
+      this->m_Negative = twice < 0;
+    }
+  }
+
+  double
+  GetExponent() const
+  {
+    return this->m_Exponent;
+  }
+
+  double
+  operator()(double base) const
+  {
+    if (!this->m_UseMultiplications)
+    {
+      return std::pow(base, this->m_Exponent);
+    }
+
+    double result = 1.0;
+    for (unsigned int i = 0; i < this->m_IntegerPart; ++i)
+    {
+      result *= base;
+    }
+    if (this->m_HasHalf)
+    {
+      result *= std::sqrt(base);
+    }
+    return this->m_Negative ? 1.0 / result : result;
+  }
+
+private:
+  static constexpr unsigned int MaximumExponent = 8;
+
+  double       m_Exponent{ 1.0 };
+  bool         m_UseMultiplications{ true };
+  unsigned int m_IntegerPart{ 1 };
+  bool         m_HasHalf{ false };
+  bool         m_Negative{ false };
+};
+
+} // namespace Function
+} // end namespace itk
+
+#endif
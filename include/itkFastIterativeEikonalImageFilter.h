@@ -0,0 +1,194 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkFastIterativeEikonalImageFilter_h
+#define itkFastIterativeEikonalImageFilter_h
+
+#include "itkImageToImageFilter.h"
+#include "itkLevelSet.h"
+
+#include <utility>
+#include <vector>
+
+namespace itk
+{
+
+/** \class FastIterativeEikonalImageFilter
+ *
+ * \brief Multithreaded Eikonal solver based on the Fast Iterative Method.
+ *
+ * This filter computes the same arrival times as the FastMarchingImageFilter:
+ * the input image is the speed of the front, and the output is the time at
+ * which the front, started at the trial points, arrives at each pixel. The
+ * equation is solved with the Fast Iterative Method (W.-K. Jeong and R. T.
+ * Whitaker, "A fast iterative method for Eikonal equations", SIAM Journal on
+ * Scientific Computing, 2008) instead of a priority queue.
+ *
+ * The method keeps a list of active pixels, the pixels whose arrival time
+ * may still decrease. At every iteration, the arrival times of all the
+ * active pixels are updated in parallel from the current times of their
+ * neighbors, with the same upwind discretization as the fast marching.
+ * Pixels whose time changes by less than the ConvergenceTolerance leave the
+ * list, and activate those of their neighbors whose time they decrease. The
+ * iterations are Jacobi iterations: every update of an iteration reads the
+ * times of the previous iteration, so that the result does not depend on the
+ * number of threads.
+ *
+ * The converged times are the solution of the discrete equation solved by
+ * the fast marching, up to the ConvergenceTolerance. Pixels whose arrival
+ * time exceeds the StoppingValue are never activated, and keep the
+ * LargeValue when none of their neighbors is reached either.
+ *
+ * As in the FastMarchingImageFilter, the absolute value of the speed is
+ * used, divided by the NormalizationFactor, and pixels of zero speed are
+ * never reached.
+ *
+ * \sa FastMarchingImageFilter
+ * \sa UntidyFastMarchingImageFilter
+ *
+ * \ingroup LevelSetSegmentation Multithreaded
+ * \ingroup LesionSizingToolkit
+ */
+template <typename TInputImage, typename TOutputImage>
+class ITK_TEMPLATE_EXPORT FastIterativeEikonalImageFilter : public ImageToImageFilter<TInputImage, TOutputImage>
+{
+public:
+  ITK_DISALLOW_COPY_AND_MOVE(FastIterativeEikonalImageFilter);
+
+  /** Standard class type alias. */
+  using Self = FastIterativeEikonalImageFilter;
+  using Superclass = ImageToImageFilter<TInputImage, TOutputImage>;
+  using Pointer = SmartPointer<Self>;
+  using ConstPointer = SmartPointer<const Self>;
+
+  /** Method for creation through the object factory. */
+  itkNewMacro(Self);
+
+  /** Run-time type information (and related methods). */
+  itkOverrideGetNameOfClassMacro(FastIterativeEikonalImageFilter);
+
+  /** Image dimension constant */
+  static constexpr unsigned int ImageDimension = TOutputImage::ImageDimension;
+
+  using InputImageType = TInputImage;
+  using InputPixelType = typename InputImageType::PixelType;
+  using OutputImageType = TOutputImage;
+  using OutputPixelType = typename OutputImageType::PixelType;
+  using OutputImageRegionType = typename OutputImageType::RegionType;
+  using IndexType = typename OutputImageType::IndexType;
+
+  /** Types of the trial points, the same as the ones of the
+   * FastMarchingImageFilter. */
+  using NodeType = LevelSetNode<OutputPixelType, ImageDimension>;
+  using NodeContainer = VectorContainer<unsigned int, NodeType>;
+  using NodeContainerPointer = typename NodeContainer::Pointer;
+
+  /** Set/Get the points from which the front starts, with their initial
+   * arrival time. */
+  itkSetObjectMacro(TrialPoints, NodeContainer);
+  itkGetModifiableObjectMacro(TrialPoints, NodeContainer);
+
+  /** Pixels whose arrival time exceeds the StoppingValue are not
+   * propagated. */
+  itkSetMacro(StoppingValue, double);
+  itkGetConstMacro(StoppingValue, double);
+
+  /** The speed is divided by this factor. Defaults to 1. */
+  itkSetMacro(NormalizationFactor, double);
+  itkGetConstMacro(NormalizationFactor, double);
+
+  /** An active pixel converges when its arrival time changes by less than
+   * this tolerance in one iteration. Defaults to 1e-6. */
+  itkSetMacro(ConvergenceTolerance, double);
+  itkGetConstMacro(ConvergenceTolerance, double);
+
+  /** Value given to the pixels that the front does not reach. */
+  itkGetConstMacro(LargeValue, OutputPixelType);
+
+  /** Number of iterations run by the last execution of the filter. */
+  itkGetConstMacro(NumberOfIterations, SizeValueType);
+
+#ifdef ITK_USE_CONCEPT_CHECKING
+  /** Begin concept checking */
+  itkConceptMacro(SameDimensionCheck, (Concept::SameDimension<TInputImage::ImageDimension, ImageDimension>));
+  itkConceptMacro(InputHasNumericTraitsCheck, (Concept::HasNumericTraits<InputPixelType>));
+  itkConceptMacro(OutputIsFloatingPointCheck, (Concept::IsFloatingPoint<OutputPixelType>));
+  /** End concept checking */
+#endif
+
+protected:
+  FastIterativeEikonalImageFilter();
+  ~FastIterativeEikonalImageFilter() override = default;
+
+  void
+  PrintSelf(std::ostream & os, Indent indent) const override;
+
+  /** The whole input is requested, since the front may reach any pixel. */
+  void
+  GenerateInputRequestedRegion() override;
+
+  /** The whole output is produced. */
+  void
+  EnlargeOutputRequestedRegion(DataObject * output) override;
+
+  void
+  GenerateData() override;
+
+private:
+  /** Pixel states. */
+  enum : unsigned char
+  {
+    FarPixel = 0,
+    ActivePixel = 1,
+    SourcePixel = 2
+  };
+
+  using CandidateType = std::pair<OffsetValueType, double>;
+
+  /** Solve the upwind discretization of the Eikonal equation at a pixel,
+   * from the current values of its neighbors. */
+  double
+  ComputeArrivalTime(const IndexType & index, OffsetValueType offset) const;
+
+  /** Apply a function to the index and offset of the face neighbors of a
+   * pixel that lie inside the buffered region. */
+  template <typename TFunction>
+  void
+  VisitNeighbors(const IndexType & index, OffsetValueType offset, TFunction function) const;
+
+  NodeContainerPointer m_TrialPoints;
+  double               m_StoppingValue;
+  double               m_NormalizationFactor;
+  double               m_ConvergenceTolerance;
+  OutputPixelType      m_LargeValue;
+  SizeValueType        m_NumberOfIterations;
+
+  // Valid during the execution of GenerateData() only.
+  const InputPixelType *  m_SpeedBuffer;
+  OutputPixelType *       m_OutputBuffer;
+  OutputImageRegionType   m_BufferedRegion;
+  const OffsetValueType * m_OffsetTable;
+  double                  m_InverseSquaredSpacing[ImageDimension];
+};
+
+} // end namespace itk
+
+#ifndef ITK_MANUAL_INSTANTIATION
+#  include "itkFastIterativeEikonalImageFilter.hxx"
+#endif
+
+#endif
@@ -0,0 +1,455 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkFastIterativeEikonalImageFilter_hxx
+#define itkFastIterativeEikonalImageFilter_hxx
+
+#include "itkMath.h"
+#include "itkMultiThreaderBase.h"
+#include "itkNumericTraits.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace itk
+{
+
+/**
+ * Constructor
+ */
+template <typename TInputImage, typename TOutputImage>
+FastIterativeEikonalImageFilter<TInputImage, TOutputImage>::FastIterativeEikonalImageFilter()
+{
+  this->m_TrialPoints = nullptr;
+  this->m_StoppingValue = static_cast<double>(NumericTraits<OutputPixelType>::max());
+  this->m_NormalizationFactor = 1.0;
+  this->m_ConvergenceTolerance = 1e-6;
+  this->m_LargeValue = static_cast<OutputPixelType>(NumericTraits<OutputPixelType>::max() / 2.0);
+  this->m_NumberOfIterations = 0;
+
+  this->m_SpeedBuffer = nullptr;
+  this->m_OutputBuffer = nullptr;
+  this->m_OffsetTable = nullptr;
+  std::fill_n(this->m_InverseSquaredSpacing, ImageDimension, 0.0);
+}
+
+
+/**
+ * PrintSelf
+ */
+template <typename TInputImage, typename TOutputImage>
+void
+FastIterativeEikonalImageFilter<TInputImage, TOutputImage>::PrintSelf(std::ostream & os, Indent indent) const
+{
+  Superclass::PrintSelf(os, indent);
+  os << indent << "TrialPoints = " << this->m_TrialPoints.GetPointer() << std::endl;
+  os << indent << "StoppingValue = " << this->m_StoppingValue << std::endl;
+  os << indent << "NormalizationFactor = " << this->m_NormalizationFactor << std::endl;
+  os << indent << "ConvergenceTolerance = " << this->m_ConvergenceTolerance << std::endl;
+  os << indent << "LargeValue = " << static_cast<typename NumericTraits<OutputPixelType>::PrintType>(this->m_LargeValue)
+     << std::endl;
+  os << indent << "NumberOfIterations = " << this->m_NumberOfIterations << std::endl;
+}
+
+
+/**
+ * Request the whole input
+ */
+template <typename TInputImage, typename TOutputImage>
+void
+FastIterativeEikonalImageFilter<TInputImage, TOutputImage>::GenerateInputRequestedRegion()
+{
+  Superclass::GenerateInputRequestedRegion();
+
+  if (this->GetInput())
+  {
+    auto * input = const_cast<InputImageType *>(this->GetInput());
+    input->SetRequestedRegionToLargestPossibleRegion();
+  }
+}
+
+
+/**
+ * Produce the whole output
+ */
+template <typename TInputImage, typename TOutputImage>
+void
+FastIterativeEikonalImageFilter<TInputImage, TOutputImage>::EnlargeOutputRequestedRegion(DataObject * output)
+{
+  Superclass::EnlargeOutputRequestedRegion(output);
+  output->SetRequestedRegionToLargestPossibleRegion();
+}
+
+
+/*
+ * Face neighbors of one pixel
+ */
+template <typename TInputImage, typename TOutputImage>
+template <typename TFunction>
+void
+FastIterativeEikonalImageFilter<TInputImage, TOutputImage>::VisitNeighbors(const IndexType & index,
+                                                                          OffsetValueType   offset,
+                                                                          TFunction         function) const
+{
+  const IndexType & start = this->m_BufferedRegion.GetIndex();
+  const auto &      size = this->m_BufferedRegion.GetSize();
+
+  for (unsigned int d = 0; d < ImageDimension; ++d)
+  {
+    if (index[d] > start[d])
+    {
+      IndexType neighborIndex = index;
+      --neighborIndex[d];
+      function(neighborIndex, offset - this->m_OffsetTable[d]);
+    }
+    if (index[d] + 1 < start[d] + static_cast<IndexValueType>(size[d]))
+    {
+      IndexType neighborIndex = index;
+      ++neighborIndex[d];
+      function(neighborIndex, offset + this->m_OffsetTable[d]);
+    }
+  }
+}
+
+
+/*
+ * Arrival time at one pixel
+ */
+template <typename TInputImage, typename TOutputImage>
+double
+FastIterativeEikonalImageFilter<TInputImage, TOutputImage>::ComputeArrivalTime(const IndexType & index,
+                                                                              OffsetValueType   offset) const
+{
+  const double speed = itk::Math::abs(static_cast<double>(this->m_SpeedBuffer[offset])) / this->m_NormalizationFactor;
+
+  if (!(speed > 0.0))
+  {
+    return NumericTraits<double>::max();
+  }
+
+  //
+  // Smallest reached neighbor along each axis.
+  //
+  std::pair<double, double> neighbors[ImageDimension];
+  unsigned int              numberOfNeighbors = 0;
+
+  const IndexType & start = this->m_BufferedRegion.GetIndex();
+  const auto &      size = this->m_BufferedRegion.GetSize();
+  const double      largeValue = static_cast<double>(this->m_LargeValue);
+
+  for (unsigned int d = 0; d < ImageDimension; ++d)
+  {
+    double neighborValue = largeValue;
+
+    if (index[d] > start[d])
+    {
+      neighborValue =
+        std::min(neighborValue, static_cast<double>(this->m_OutputBuffer[offset - this->m_OffsetTable[d]]));
+    }
+    if (index[d] + 1 < start[d] + static_cast<IndexValueType>(size[d]))
+    {
+      neighborValue =
+        std::min(neighborValue, static_cast<double>(this->m_OutputBuffer[offset + this->m_OffsetTable[d]]));
+    }
+
+    if (neighborValue < largeValue)
+    {
+      neighbors[numberOfNeighbors++] = std::make_pair(neighborValue, this->m_InverseSquaredSpacing[d]);
+    }
+  }
+
+  std::sort(neighbors, neighbors + numberOfNeighbors);
+
+  //
+  // Same upwind solution as the FastMarchingImageFilter: the neighbors are
+  // added in increasing order as long as they are smaller than the solution.
+  //
+  double solution = NumericTraits<double>::max();
+  double aa = 0.0;
+  double bb = 0.0;
+  double cc = -1.0 / (speed * speed);
+
+  for (unsigned int j = 0; j < numberOfNeighbors; ++j)
+  {
+    const double value = neighbors[j].first;
+    const double spaceFactor = neighbors[j].second;
+
+    if (solution < value)
+    {
+      break;
+    }
+
+    aa += spaceFactor;
+    bb += value * spaceFactor;
+    cc += value * value * spaceFactor;
+
+    const double discriminant = bb * bb - aa * cc;
+    if (discriminant < 0.0)
+    {
+      // Only possible through rounding errors, keep the solution computed
+      // with the previous neighbors.
+      break;
+    }
+
+    solution = (std::sqrt(discriminant) + bb) / aa;
+  }
+
+  return solution;
+}
+
+
+/*
+ * Generate Data
+ */
+template <typename TInputImage, typename TOutputImage>
+void
+FastIterativeEikonalImageFilter<TInputImage, TOutputImage>::GenerateData()
+{
+  const InputImageType * speedImage = this->GetInput();
+  OutputImageType *      outputImage = this->GetOutput();
+
+  const OutputImageRegionType region = outputImage->GetRequestedRegion();
+
+  outputImage->SetBufferedRegion(region);
+  outputImage->Allocate();
+  outputImage->FillBuffer(this->m_LargeValue);
+
+  this->m_NumberOfIterations = 0;
+
+  if (speedImage->GetBufferedRegion() != region)
+  {
+    itkExceptionMacro("The buffered region of the speed image " << speedImage->GetBufferedRegion()
+                                                                << " differs from the output region " << region);
+  }
+
+  if (this->m_TrialPoints.IsNull() || this->m_TrialPoints->Size() == 0)
+  {
+    this->UpdateProgress(1.0f);
+    return;
+  }
+
+  this->m_SpeedBuffer = speedImage->GetBufferPointer();
+  this->m_OutputBuffer = outputImage->GetBufferPointer();
+  this->m_BufferedRegion = region;
+  this->m_OffsetTable = outputImage->GetOffsetTable();
+
+  const typename OutputImageType::SpacingType & spacing = outputImage->GetSpacing();
+  for (unsigned int d = 0; d < ImageDimension; ++d)
+  {
+    this->m_InverseSquaredSpacing[d] = 1.0 / (spacing[d] * spacing[d]);
+  }
+
+  const double stoppingValue = this->m_StoppingValue;
+  const double tolerance = this->m_ConvergenceTolerance;
+
+  std::vector<unsigned char> state(region.GetNumberOfPixels(), FarPixel);
+
+  //
+  // The trial points keep their value, and their neighbors form the initial
+  // active list.
+  //
+  double origin = NumericTraits<double>::max();
+  for (auto it = this->m_TrialPoints->Begin(); it != this->m_TrialPoints->End(); ++it)
+  {
+    const NodeType & node = it->Value();
+    if (!region.IsInside(node.GetIndex()))
+    {
+      continue;
+    }
+    const OffsetValueType offset = outputImage->ComputeOffset(node.GetIndex());
+    this->m_OutputBuffer[offset] = std::min(this->m_OutputBuffer[offset], node.GetValue());
+    state[offset] = SourcePixel;
+    origin = std::min(origin, static_cast<double>(node.GetValue()));
+  }
+
+  std::vector<OffsetValueType> activeList;
+  for (auto it = this->m_TrialPoints->Begin(); it != this->m_TrialPoints->End(); ++it)
+  {
+    const IndexType index = it->Value().GetIndex();
+    if (!region.IsInside(index))
+    {
+      continue;
+    }
+    this->VisitNeighbors(index, outputImage->ComputeOffset(index), [&](const IndexType &, OffsetValueType neighbor) {
+      if (state[neighbor] == FarPixel)
+      {
+        state[neighbor] = ActivePixel;
+        activeList.push_back(neighbor);
+      }
+    });
+  }
+
+  MultiThreaderBase * multiThreader = this->GetMultiThreader();
+  multiThreader->SetNumberOfWorkUnits(this->GetNumberOfWorkUnits());
+
+  // The active list is processed in chunks of fixed length, so that the
+  // order of the candidates, and then the result, do not depend on the
+  // number of threads.
+  constexpr SizeValueType chunkLength = 1024;
+
+  std::vector<double>                     updatedValues;
+  std::vector<unsigned char>              converged;
+  std::vector<std::vector<CandidateType>> candidates;
+  std::vector<OffsetValueType>            nextActiveList;
+
+  const bool   reportProgress = stoppingValue > origin && stoppingValue < static_cast<double>(this->m_LargeValue);
+  const double progressScale = reportProgress ? 1.0 / (stoppingValue - origin) : 0.0;
+  double       progress = 0.0;
+
+  while (!activeList.empty())
+  {
+    const SizeValueType numberOfActivePixels = activeList.size();
+    const SizeValueType numberOfChunks = (numberOfActivePixels + chunkLength - 1) / chunkLength;
+
+    updatedValues.resize(numberOfActivePixels);
+    converged.resize(numberOfActivePixels);
+    candidates.resize(numberOfChunks);
+
+    //
+    // Update the active pixels from the values of the previous iteration.
+    //
+    multiThreader->ParallelizeArray(
+      0,
+      numberOfChunks,
+      [&](SizeValueType chunk) {
+        const SizeValueType last = std::min(numberOfActivePixels, (chunk + 1) * chunkLength);
+        for (SizeValueType i = chunk * chunkLength; i < last; ++i)
+        {
+          const OffsetValueType offset = activeList[i];
+          const double          previous = static_cast<double>(this->m_OutputBuffer[offset]);
+          const double solution = this->ComputeArrivalTime(outputImage->ComputeIndex(offset), offset);
+          // Rounded to the output pixel type, so that a pixel converges when
+          // its stored value stops changing.
+          const double value = static_cast<double>(static_cast<OutputPixelType>(std::min(previous, solution)));
+
+          updatedValues[i] = value;
+          converged[i] = (previous - value <= tolerance);
+        }
+      },
+      nullptr);
+
+    for (SizeValueType i = 0; i < numberOfActivePixels; ++i)
+    {
+      this->m_OutputBuffer[activeList[i]] = static_cast<OutputPixelType>(updatedValues[i]);
+    }
+
+    //
+    // The neighbors of the converged pixels whose value decreases with the
+    // new values become active.
+    //
+    multiThreader->ParallelizeArray(
+      0,
+      numberOfChunks,
+      [&](SizeValueType chunk) {
+        std::vector<CandidateType> & chunkCandidates = candidates[chunk];
+        chunkCandidates.clear();
+
+        const SizeValueType last = std::min(numberOfActivePixels, (chunk + 1) * chunkLength);
+        for (SizeValueType i = chunk * chunkLength; i < last; ++i)
+        {
+          if (!converged[i] || !(updatedValues[i] <= stoppingValue))
+          {
+            continue;
+          }
+
+          const OffsetValueType offset = activeList[i];
+          this->VisitNeighbors(
+            outputImage->ComputeIndex(offset), offset, [&](const IndexType & neighborIndex, OffsetValueType neighbor) {
+              if (state[neighbor] != FarPixel)
+              {
+                return;
+              }
+              // The same tolerance as the convergence test prevents the
+              // reactivation of pixels for rounding errors.
+              const double solution = this->ComputeArrivalTime(neighborIndex, neighbor);
+              if (static_cast<double>(this->m_OutputBuffer[neighbor]) - solution > tolerance &&
+                  solution <= stoppingValue)
+              {
+                chunkCandidates.emplace_back(neighbor, solution);
+              }
+            });
+        }
+      },
+      nullptr);
+
+    //
+    // Build the next active list: the pixels that did not converge, followed
+    // by the new candidates.
+    //
+    nextActiveList.clear();
+    for (SizeValueType i = 0; i < numberOfActivePixels; ++i)
+    {
+      if (converged[i])
+      {
+        state[activeList[i]] = FarPixel;
+      }
+      else
+      {
+        nextActiveList.push_back(activeList[i]);
+      }
+    }
+
+    for (SizeValueType chunk = 0; chunk < numberOfChunks; ++chunk)
+    {
+      for (const CandidateType & candidate : candidates[chunk])
+      {
+        OutputPixelType & value = this->m_OutputBuffer[candidate.first];
+        value = std::min(value, static_cast<OutputPixelType>(candidate.second));
+        if (state[candidate.first] == FarPixel)
+        {
+          state[candidate.first] = ActivePixel;
+          nextActiveList.push_back(candidate.first);
+        }
+      }
+    }
+
+    activeList.swap(nextActiveList);
+    ++this->m_NumberOfIterations;
+
+    if (reportProgress)
+    {
+      // The front moves forward by about one pixel per iteration, report the
+      // largest value converged so far.
+      for (SizeValueType i = 0; i < numberOfActivePixels; ++i)
+      {
+        if (converged[i] && updatedValues[i] <= stoppingValue)
+        {
+          progress = std::max(progress, (updatedValues[i] - origin) * progressScale);
+        }
+      }
+      this->UpdateProgress(static_cast<float>(std::min(1.0, progress)));
+    }
+
+    if (this->GetAbortGenerateData())
+    {
+      ProcessAborted e(__FILE__, __LINE__);
+      e.SetDescription("Process aborted.");
+      e.SetLocation(ITK_LOCATION);
+      throw e;
+    }
+  }
+
+  this->m_SpeedBuffer = nullptr;
+  this->m_OutputBuffer = nullptr;
+  this->m_OffsetTable = nullptr;
+
+  this->UpdateProgress(1.0f);
+}
+
+} // end namespace itk
+
+#endif
@@ -69,6 +69,7 @@ public:
   using OutputImageType = typename Superclass::OutputImageType;
   using FeatureSpatialObjectType = typename Superclass::FeatureSpatialObjectType;
   using OutputSpatialObjectType = typename Superclass::OutputSpatialObjectType;
+  using TimePointType = typename Superclass::TimePointType;
 
   /** Type of the input set of seed points. They are stored in a Landmark Spatial Object. */
   using InputSpatialObjectType = LandmarkSpatialObject<NDimension>;
@@ -99,6 +100,36 @@ public:
     return m_FastMarchingModule->GetDistanceFromSeeds();
   }
 
+  /** Select the solver of the Fast Marching initialization. */
+  using FastMarchingSolverType = typename FastMarchingSegmentationModule<NDimension>::SolverType;
+  virtual void
+  SetFastMarchingSolver(FastMarchingSolverType solver)
+  {
+    m_FastMarchingModule->SetSolver(solver);
+  }
+  virtual FastMarchingSolverType
+  GetFastMarchingSolver() const
+  {
+    return m_FastMarchingModule->GetSolver();
+  }
+
+  /** Shrink factor of the coarse resolution. When larger than one, the fast
+   * marching and the geodesic active contour are first run on the feature
+   * image shrunk by this factor, for MaximumNumberOfIterations. The
+   * resulting level set is then upsampled, and refined on the full
+   * resolution feature image for NumberOfRefinementIterations. The front
+   * crosses the large distances on the coarse grid, where iterations are
+   * cheaper and fewer of them are needed. The IterationEvent is invoked for
+   * the iterations of both resolutions, and the ElapsedIterations restart
+   * from zero at the refinement. Defaults to 1, a single resolution. */
+  itkSetClampMacro(CoarseResolutionShrinkFactor, unsigned int, 1, NumericTraits<unsigned int>::max());
+  itkGetConstMacro(CoarseResolutionShrinkFactor, unsigned int);
+
+  /** Maximum number of iterations of the full resolution refinement, when
+   * the CoarseResolutionShrinkFactor is larger than one. Defaults to 30. */
+  itkSetMacro(NumberOfRefinementIterations, unsigned int);
+  itkGetConstMacro(NumberOfRefinementIterations, unsigned int);
+
 protected:
   FastMarchingAndGeodesicActiveContourLevelSetSegmentationModule();
   ~FastMarchingAndGeodesicActiveContourLevelSetSegmentationModule() override;
@@ -114,6 +145,22 @@ protected:
   typename FastMarchingModuleType::Pointer m_FastMarchingModule;
   using GeodesicActiveContourLevelSetModuleType = GeodesicActiveContourLevelSetSegmentationModule<Dimension>;
   typename GeodesicActiveContourLevelSetModuleType::Pointer m_GeodesicActiveContourLevelSetModule;
+
+  unsigned int m_CoarseResolutionShrinkFactor;
+  unsigned int m_NumberOfRefinementIterations;
+
+private:
+  /** Segment on the shrunk feature image first, then refine at full
+   * resolution. */
+  void
+  GenerateMultiResolutionData(const TimePointType & startTime);
+
+  /** Pass the level set parameters of this module to a geodesic active
+   * contour module, with the time left since startTime. */
+  void
+  ConfigureLevelSetModule(GeodesicActiveContourLevelSetModuleType * levelSetModule,
+                          unsigned int                              numberOfIterations,
+                          const TimePointType &                     startTime) const;
 };
 
 } // end namespace itk
@@ -18,8 +18,13 @@
 #ifndef itkFastMarchingAndGeodesicActiveContourLevelSetSegmentationModule_hxx
 #define itkFastMarchingAndGeodesicActiveContourLevelSetSegmentationModule_hxx
 
+#include "itkBinShrinkImageFilter.h"
 #include "itkGeodesicActiveContourLevelSetImageFilter.h"
+#include "itkNearestNeighborExtrapolateImageFunction.h"
 #include "itkProgressAccumulator.h"
+#include "itkResampleImageFilter.h"
+
+#include <algorithm>
 
 
 namespace itk
@@ -39,6 +44,8 @@ FastMarchingAndGeodesicActiveContourLevelSetSegmentationModule<
   this->m_FastMarchingModule->InvertOutputIntensitiesOff();
   this->m_GeodesicActiveContourLevelSetModule = GeodesicActiveContourLevelSetModuleType::New();
   this->m_GeodesicActiveContourLevelSetModule->InvertOutputIntensitiesOff();
+  this->m_CoarseResolutionShrinkFactor = 1;
+  this->m_NumberOfRefinementIterations = 30;
 }
 
 
@@ -59,6 +66,29 @@ FastMarchingAndGeodesicActiveContourLevelSetSegmentationModule<NDimension>::Prin
                                                                                       Indent         indent) const
 {
   Superclass::PrintSelf(os, indent);
+  os << indent << "CoarseResolutionShrinkFactor = " << this->m_CoarseResolutionShrinkFactor << std::endl;
+  os << indent << "NumberOfRefinementIterations = " << this->m_NumberOfRefinementIterations << std::endl;
+}
+
+
+/**
+ * Pass the level set parameters to a geodesic active contour module
+ */
+template <unsigned int NDimension>
+void
+FastMarchingAndGeodesicActiveContourLevelSetSegmentationModule<NDimension>::ConfigureLevelSetModule(
+  GeodesicActiveContourLevelSetModuleType * levelSetModule,
+  unsigned int                              numberOfIterations,
+  const TimePointType &                     startTime) const
+{
+  levelSetModule->SetMaximumRMSError(this->GetMaximumRMSError());
+  levelSetModule->SetMaximumNumberOfIterations(numberOfIterations);
+  levelSetModule->SetPropagationScaling(this->GetPropagationScaling());
+  levelSetModule->SetCurvatureScaling(this->GetCurvatureScaling());
+  levelSetModule->SetAdvectionScaling(this->GetAdvectionScaling());
+  levelSetModule->SetUseParallelSolver(this->GetUseParallelSolver());
+  levelSetModule->SetMaximumElapsedTime(this->GetRemainingElapsedTime(startTime));
+  levelSetModule->SetMaximumFrontVolume(this->GetMaximumFrontVolume());
 }
 
 
@@ -69,24 +99,159 @@ template <unsigned int NDimension>
 void
 FastMarchingAndGeodesicActiveContourLevelSetSegmentationModule<NDimension>::GenerateData()
 {
+  const TimePointType startTime = std::chrono::steady_clock::now();
+
+  // The fast marching, and the coarse resolution, are skipped when the
+  // evolution starts from an initial level set.
+  const typename InputImageType::ConstPointer initialLevelSet = this->ComputeInternalInitialLevelSet();
+
+  if (this->m_CoarseResolutionShrinkFactor > 1 && !initialLevelSet)
+  {
+    this->GenerateMultiResolutionData(startTime);
+    return;
+  }
+
+  // Report progress.
+  ProgressAccumulator::Pointer progress = ProgressAccumulator::New();
+  progress->SetMiniPipelineFilter(this);
+
+  if (initialLevelSet)
+  {
+    typename OutputSpatialObjectType::Pointer initialObject = OutputSpatialObjectType::New();
+    initialObject->SetImage(initialLevelSet);
+    m_GeodesicActiveContourLevelSetModule->SetInput(initialObject);
+
+    progress->RegisterInternalFilter(this->m_GeodesicActiveContourLevelSetModule, 1.0);
+  }
+  else
+  {
+    progress->RegisterInternalFilter(this->m_FastMarchingModule, 0.3);
+    progress->RegisterInternalFilter(this->m_GeodesicActiveContourLevelSetModule, 0.7);
+
+    this->m_FastMarchingModule->SetInput(this->GetInput());
+    this->m_FastMarchingModule->SetFeature(this->GetFeature());
+    this->m_FastMarchingModule->Update();
+
+    m_GeodesicActiveContourLevelSetModule->SetInput(m_FastMarchingModule->GetOutput());
+  }
+
+  m_GeodesicActiveContourLevelSetModule->SetFeature(this->GetFeature());
+  this->ConfigureLevelSetModule(m_GeodesicActiveContourLevelSetModule, this->GetMaximumNumberOfIterations(), startTime);
+
+  this->ForwardIterationEvents(m_GeodesicActiveContourLevelSetModule);
+  m_GeodesicActiveContourLevelSetModule->Update();
+  this->StopForwardingIterationEvents();
+
+  this->SetStopCondition(m_GeodesicActiveContourLevelSetModule->GetStopCondition());
+  this->CopyIterationStatistics(m_GeodesicActiveContourLevelSetModule);
+
+  this->PackOutputImageInOutputSpatialObject(const_cast<OutputImageType *>(
+    dynamic_cast<const OutputSpatialObjectType *>(m_GeodesicActiveContourLevelSetModule->GetOutput())->GetImage()));
+}
+
+
+/**
+ * Generate Data on the coarse resolution, then refine at full resolution
+ */
+template <unsigned int NDimension>
+void
+FastMarchingAndGeodesicActiveContourLevelSetSegmentationModule<NDimension>::GenerateMultiResolutionData(
+  const TimePointType & startTime)
+{
+  const FeatureImageType * featureImage = this->GetInternalFeatureImage();
+
+  //
+  // Coarse feature image: each pixel is the average of a block of the full
+  // resolution pixels. The factor is reduced along the axes that are too
+  // short to be shrunk.
+  //
+  using ShrinkFilterType = BinShrinkImageFilter<FeatureImageType, FeatureImageType>;
+  typename ShrinkFilterType::Pointer shrinker = ShrinkFilterType::New();
+  shrinker->SetInput(featureImage);
+
+  const typename FeatureImageType::SizeType & featureSize = featureImage->GetBufferedRegion().GetSize();
+  for (unsigned int d = 0; d < Dimension; ++d)
+  {
+    const auto axisFactor = static_cast<unsigned int>(
+      std::max<SizeValueType>(1, std::min<SizeValueType>(this->m_CoarseResolutionShrinkFactor, featureSize[d])));
+    shrinker->SetShrinkFactor(d, axisFactor);
+  }
+
+  using ResampleFilterType = ResampleImageFilter<OutputImageType, OutputImageType>;
+  typename ResampleFilterType::Pointer upsampler = ResampleFilterType::New();
+
+  typename GeodesicActiveContourLevelSetModuleType::Pointer coarseLevelSetModule =
+    GeodesicActiveContourLevelSetModuleType::New();
+  coarseLevelSetModule->InvertOutputIntensitiesOff();
+
   // Report progress.
   ProgressAccumulator::Pointer progress = ProgressAccumulator::New();
   progress->SetMiniPipelineFilter(this);
-  progress->RegisterInternalFilter(this->m_FastMarchingModule, 0.3);
-  progress->RegisterInternalFilter(this->m_GeodesicActiveContourLevelSetModule, 0.7);
+  progress->RegisterInternalFilter(shrinker, 0.05);
+  progress->RegisterInternalFilter(this->m_FastMarchingModule, 0.1);
+  progress->RegisterInternalFilter(coarseLevelSetModule, 0.45);
+  progress->RegisterInternalFilter(upsampler, 0.05);
+  progress->RegisterInternalFilter(this->m_GeodesicActiveContourLevelSetModule, 0.35);
+
+  shrinker->Update();
 
+  typename FeatureSpatialObjectType::Pointer coarseFeatureObject = FeatureSpatialObjectType::New();
+  coarseFeatureObject->SetImage(shrinker->GetOutput());
+
+  //
+  // Coarse segmentation. The seeds and the fast marching parameters are
+  // physical, they do not depend on the resolution.
+  //
   this->m_FastMarchingModule->SetInput(this->GetInput());
-  this->m_FastMarchingModule->SetFeature(this->GetFeature());
+  this->m_FastMarchingModule->SetFeature(coarseFeatureObject);
   this->m_FastMarchingModule->Update();
 
-  m_GeodesicActiveContourLevelSetModule->SetInput(m_FastMarchingModule->GetOutput());
+  coarseLevelSetModule->SetInput(this->m_FastMarchingModule->GetOutput());
+  coarseLevelSetModule->SetFeature(coarseFeatureObject);
+  this->ConfigureLevelSetModule(coarseLevelSetModule, this->GetMaximumNumberOfIterations(), startTime);
+
+  this->ForwardIterationEvents(coarseLevelSetModule);
+  coarseLevelSetModule->Update();
+  this->StopForwardingIterationEvents();
+
+  //
+  // Upsample the coarse level set on the grid of the feature image. The
+  // pixels of the border that are not covered by the coarse grid take the
+  // value of the nearest coarse pixel.
+  //
+  using ExtrapolatorType = NearestNeighborExtrapolateImageFunction<OutputImageType, double>;
+
+  upsampler->SetInput(dynamic_cast<const OutputSpatialObjectType *>(coarseLevelSetModule->GetOutput())->GetImage());
+  upsampler->SetOutputParametersFromImage(featureImage);
+  upsampler->SetExtrapolator(ExtrapolatorType::New());
+  upsampler->Update();
+
+  typename OutputSpatialObjectType::Pointer initialObject = OutputSpatialObjectType::New();
+  initialObject->SetImage(upsampler->GetOutput());
+
+  //
+  // Refinement at full resolution, from the upsampled level set.
+  //
+  m_GeodesicActiveContourLevelSetModule->SetInput(initialObject);
   m_GeodesicActiveContourLevelSetModule->SetFeature(this->GetFeature());
-  m_GeodesicActiveContourLevelSetModule->SetMaximumRMSError(this->GetMaximumRMSError());
-  m_GeodesicActiveContourLevelSetModule->SetMaximumNumberOfIterations(this->GetMaximumNumberOfIterations());
-  m_GeodesicActiveContourLevelSetModule->SetPropagationScaling(this->GetPropagationScaling());
-  m_GeodesicActiveContourLevelSetModule->SetCurvatureScaling(this->GetCurvatureScaling());
-  m_GeodesicActiveContourLevelSetModule->SetAdvectionScaling(this->GetAdvectionScaling());
+  this->ConfigureLevelSetModule(m_GeodesicActiveContourLevelSetModule, this->m_NumberOfRefinementIterations, startTime);
+
+  this->ForwardIterationEvents(m_GeodesicActiveContourLevelSetModule);
   m_GeodesicActiveContourLevelSetModule->Update();
+  this->StopForwardingIterationEvents();
+
+  this->CopyIterationStatistics(m_GeodesicActiveContourLevelSetModule);
+
+  // A limit hit on the coarse resolution is the reason of the early stop.
+  if (coarseLevelSetModule->GetStopCondition() == Superclass::MaximumElapsedTimeStop ||
+      coarseLevelSetModule->GetStopCondition() == Superclass::MaximumFrontVolumeStop)
+  {
+    this->SetStopCondition(coarseLevelSetModule->GetStopCondition());
+  }
+  else
+  {
+    this->SetStopCondition(m_GeodesicActiveContourLevelSetModule->GetStopCondition());
+  }
 
   this->PackOutputImageInOutputSpatialObject(const_cast<OutputImageType *>(
     dynamic_cast<const OutputSpatialObjectType *>(m_GeodesicActiveContourLevelSetModule->GetOutput())->GetImage()));
@@ -69,6 +69,7 @@ public:
   using OutputImageType = typename Superclass::OutputImageType;
   using FeatureSpatialObjectType = typename Superclass::FeatureSpatialObjectType;
   using OutputSpatialObjectType = typename Superclass::OutputSpatialObjectType;
+  using TimePointType = typename Superclass::TimePointType;
 
   /** Type of the input set of seed points. They are stored in a Landmark Spatial Object. */
   using InputSpatialObjectType = LandmarkSpatialObject<NDimension>;
@@ -99,6 +100,19 @@ public:
     return m_FastMarchingModule->GetDistanceFromSeeds();
   }
 
+  /** Select the solver of the Fast Marching initialization. */
+  using FastMarchingSolverType = typename FastMarchingSegmentationModule<NDimension>::SolverType;
+  virtual void
+  SetFastMarchingSolver(FastMarchingSolverType solver)
+  {
+    m_FastMarchingModule->SetSolver(solver);
+  }
+  virtual FastMarchingSolverType
+  GetFastMarchingSolver() const
+  {
+    return m_FastMarchingModule->GetSolver();
+  }
+
 protected:
   FastMarchingAndShapeDetectionLevelSetSegmentationModule();
   ~FastMarchingAndShapeDetectionLevelSetSegmentationModule() override;
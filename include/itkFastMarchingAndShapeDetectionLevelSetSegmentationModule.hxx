@@ -68,23 +68,50 @@ template <unsigned int NDimension>
 void
 FastMarchingAndShapeDetectionLevelSetSegmentationModule<NDimension>::GenerateData()
 {
+  const TimePointType startTime = std::chrono::steady_clock::now();
+
   // Report progress.
   ProgressAccumulator::Pointer progress = ProgressAccumulator::New();
   progress->SetMiniPipelineFilter(this);
-  progress->RegisterInternalFilter(this->m_FastMarchingModule, 0.3);
-  progress->RegisterInternalFilter(this->m_ShapeDetectionLevelSetModule, 0.7);
 
-  this->m_FastMarchingModule->SetInput(this->GetInput());
-  this->m_FastMarchingModule->SetFeature(this->GetFeature());
-  this->m_FastMarchingModule->Update();
+  // The fast marching is skipped when the evolution starts from an initial
+  // level set.
+  const typename InputImageType::ConstPointer initialLevelSet = this->ComputeInternalInitialLevelSet();
+  if (initialLevelSet)
+  {
+    typename OutputSpatialObjectType::Pointer initialObject = OutputSpatialObjectType::New();
+    initialObject->SetImage(initialLevelSet);
+    m_ShapeDetectionLevelSetModule->SetInput(initialObject);
+
+    progress->RegisterInternalFilter(this->m_ShapeDetectionLevelSetModule, 1.0);
+  }
+  else
+  {
+    progress->RegisterInternalFilter(this->m_FastMarchingModule, 0.3);
+    progress->RegisterInternalFilter(this->m_ShapeDetectionLevelSetModule, 0.7);
+
+    this->m_FastMarchingModule->SetInput(this->GetInput());
+    this->m_FastMarchingModule->SetFeature(this->GetFeature());
+    this->m_FastMarchingModule->Update();
+
+    m_ShapeDetectionLevelSetModule->SetInput(m_FastMarchingModule->GetOutput());
+  }
 
-  m_ShapeDetectionLevelSetModule->SetInput(m_FastMarchingModule->GetOutput());
   m_ShapeDetectionLevelSetModule->SetFeature(this->GetFeature());
   m_ShapeDetectionLevelSetModule->SetMaximumRMSError(this->GetMaximumRMSError());
   m_ShapeDetectionLevelSetModule->SetMaximumNumberOfIterations(this->GetMaximumNumberOfIterations());
   m_ShapeDetectionLevelSetModule->SetPropagationScaling(this->GetPropagationScaling());
   m_ShapeDetectionLevelSetModule->SetCurvatureScaling(this->GetCurvatureScaling());
+  m_ShapeDetectionLevelSetModule->SetUseParallelSolver(this->GetUseParallelSolver());
+  m_ShapeDetectionLevelSetModule->SetMaximumElapsedTime(this->GetRemainingElapsedTime(startTime));
+  m_ShapeDetectionLevelSetModule->SetMaximumFrontVolume(this->GetMaximumFrontVolume());
+
+  this->ForwardIterationEvents(m_ShapeDetectionLevelSetModule);
   m_ShapeDetectionLevelSetModule->Update();
+  this->StopForwardingIterationEvents();
+
+  this->SetStopCondition(m_ShapeDetectionLevelSetModule->GetStopCondition());
+  this->CopyIterationStatistics(m_ShapeDetectionLevelSetModule);
 
   this->PackOutputImageInOutputSpatialObject(const_cast<OutputImageType *>(
     dynamic_cast<const OutputSpatialObjectType *>(m_ShapeDetectionLevelSetModule->GetOutput())->GetImage()));
@@ -32,6 +32,10 @@ namespace itk
  * output a segmentation of the output level set. Threshold this at 0 and you
  * will get the zero set.
  *
+ * The arrival times [-DistanceFromSeeds:StoppingValue] are mapped to [4:-4]
+ * when InvertOutputIntensities is on, and to [-4:4] otherwise, whatever the
+ * range actually reached by the front.
+ *
  * \ingroup SpatialObjectFilters
  * \ingroup LesionSizingToolkit
  */
@@ -84,6 +88,24 @@ public:
   itkSetMacro(DistanceFromSeeds, double);
   itkGetMacro(DistanceFromSeeds, double);
 
+  /** Fast marching solvers. HeapSolver runs the FastMarchingImageFilter.
+   * UntidyQueueSolver runs the UntidyFastMarchingImageFilter, whose cost
+   * only depends on the number of pixels reached before the StoppingValue,
+   * and whose arrival times differ from the ones of the HeapSolver by less
+   * than the time needed to cross a pixel. FastIterativeSolver runs the
+   * multithreaded FastIterativeEikonalImageFilter, whose arrival times are
+   * the ones of the HeapSolver up to its convergence tolerance. */
+  enum SolverType
+  {
+    HeapSolver = 0,
+    UntidyQueueSolver = 1,
+    FastIterativeSolver = 2
+  };
+
+  /** Select the fast marching solver. Defaults to HeapSolver. */
+  itkSetMacro(Solver, SolverType);
+  itkGetConstMacro(Solver, SolverType);
+
 protected:
   FastMarchingSegmentationModule();
   ~FastMarchingSegmentationModule() override;
@@ -99,8 +121,15 @@ protected:
   const InputSpatialObjectType *
   GetInternalInputLandmarks() const;
 
-  double m_StoppingValue;
-  double m_DistanceFromSeeds;
+  double     m_StoppingValue;
+  double     m_DistanceFromSeeds;
+  SolverType m_Solver;
+
+private:
+  /** Run the fast marching filter from the seeds. */
+  template <typename TFilter>
+  void
+  ComputeArrivalTimes(TFilter * filter);
 };
 
 } // end namespace itk
@@ -20,7 +20,8 @@
 
 #include "itkImageRegionIterator.h"
 #include "itkFastMarchingImageFilter.h"
-#include "itkIntensityWindowingImageFilter.h"
+#include "itkFastIterativeEikonalImageFilter.h"
+#include "itkUntidyFastMarchingImageFilter.h"
 #include "itkProgressAccumulator.h"
 
 namespace itk
@@ -37,6 +38,8 @@ FastMarchingSegmentationModule<NDimension>::FastMarchingSegmentationModule()
 
   this->m_DistanceFromSeeds = 0.0;
 
+  this->m_Solver = HeapSolver;
+
   this->SetNumberOfRequiredInputs(2);
   this->SetNumberOfRequiredOutputs(1);
 
@@ -63,6 +66,7 @@ FastMarchingSegmentationModule<NDimension>::PrintSelf(std::ostream & os, Indent
   Superclass::PrintSelf(os, indent);
   os << indent << "Stopping Value = " << this->m_StoppingValue << std::endl;
   os << indent << "Distance from seeds = " << this->m_DistanceFromSeeds << std::endl;
+  os << indent << "Solver = " << static_cast<int>(this->m_Solver) << std::endl;
 }
 
 
@@ -73,9 +77,42 @@ template <unsigned int NDimension>
 void
 FastMarchingSegmentationModule<NDimension>::GenerateData()
 {
-  using FilterType = FastMarchingImageFilter<FeatureImageType, OutputImageType>;
+  if (this->m_Solver == UntidyQueueSolver)
+  {
+    using FilterType = UntidyFastMarchingImageFilter<FeatureImageType, OutputImageType>;
+
+    typename FilterType::Pointer filter = FilterType::New();
+
+    this->ComputeArrivalTimes(filter.GetPointer());
+  }
+  else if (this->m_Solver == FastIterativeSolver)
+  {
+    using FilterType = FastIterativeEikonalImageFilter<FeatureImageType, OutputImageType>;
+
+    typename FilterType::Pointer filter = FilterType::New();
+
+    this->ComputeArrivalTimes(filter.GetPointer());
+  }
+  else
+  {
+    using FilterType = FastMarchingImageFilter<FeatureImageType, OutputImageType>;
 
-  typename FilterType::Pointer filter = FilterType::New();
+    typename FilterType::Pointer filter = FilterType::New();
+
+    this->ComputeArrivalTimes(filter.GetPointer());
+  }
+}
+
+
+/**
+ * Run the fast marching filter
+ */
+template <unsigned int NDimension>
+template <typename TFilter>
+void
+FastMarchingSegmentationModule<NDimension>::ComputeArrivalTimes(TFilter * filter)
+{
+  using FilterType = TFilter;
 
   const FeatureImageType * featureImage = this->GetInternalFeatureImage();
 
@@ -86,7 +123,7 @@ FastMarchingSegmentationModule<NDimension>::GenerateData()
   // Progress reporting - forward events from the fast marching filter.
   ProgressAccumulator::Pointer progress = ProgressAccumulator::New();
   progress->SetMiniPipelineFilter(this);
-  progress->RegisterInternalFilter(filter, 0.9);
+  progress->RegisterInternalFilter(filter, 1.0);
 
   const InputSpatialObjectType * inputSeeds = this->GetInternalInputLandmarks();
   const unsigned int             numberOfPoints = inputSeeds->GetNumberOfPoints();
@@ -122,19 +159,10 @@ FastMarchingSegmentationModule<NDimension>::GenerateData()
   filter->Update();
 
   // Rescale the values to make the output intensity fit in the expected
-  // range of [-4:4]
-  using WindowingFilterType = itk::IntensityWindowingImageFilter<OutputImageType, OutputImageType>;
-  typename WindowingFilterType::Pointer windowing = WindowingFilterType::New();
-  windowing->SetInput(filter->GetOutput());
-  windowing->SetWindowMinimum(-this->m_DistanceFromSeeds);
-  windowing->SetWindowMaximum(this->m_StoppingValue);
-  windowing->SetOutputMinimum(-4.0);
-  windowing->SetOutputMaximum(4.0);
-  windowing->InPlaceOn();
-  progress->RegisterInternalFilter(windowing, 0.1);
-  windowing->Update();
-
-  this->PackOutputImageInOutputSpatialObject(windowing->GetOutput());
+  // range of [-4:4]. The range of the relevant values is known: the front
+  // starts at -DistanceFromSeeds and the marching stops at StoppingValue,
+  // so the window is applied in place, without scanning the image first.
+  this->PackOutputImageInOutputSpatialObject(filter->GetOutput(), -this->m_DistanceFromSeeds, this->m_StoppingValue);
 }
 
 
@@ -83,6 +83,10 @@ public:
   ModifiedTimeType
   GetMTime() const override;
 
+  /** Print the parameters that determine the feature. */
+  void
+  PrintParameters(std::ostream & os) const override;
+
 protected:
   FeatureAggregator();
   ~FeatureAggregator() override;
@@ -103,6 +103,22 @@ FeatureAggregator<NDimension>::PrintSelf(std::ostream & os, Indent indent) const
 }
 
 
+/**
+ * PrintParameters
+ */
+template <unsigned int NDimension>
+void
+FeatureAggregator<NDimension>::PrintParameters(std::ostream & os) const
+{
+  Superclass::PrintParameters(os);
+  for (unsigned int i = 0; i < this->m_FeatureGenerators.size(); ++i)
+  {
+    os << "FeatureGenerator " << i << std::endl;
+    this->m_FeatureGenerators[i]->PrintParameters(os);
+  }
+}
+
+
 /*
  * Generate Data
  */
@@ -75,6 +75,13 @@ public:
   const SpatialObjectType *
   GetFeature() const;
 
+  /** Print the name of the class and the parameters that determine the
+   * feature, one per line. Together with the input, they identify the
+   * feature, for instance in a cache of features. Derived classes with
+   * parameters extend this method. */
+  virtual void
+  PrintParameters(std::ostream & os) const;
+
 
 protected:
   FeatureGenerator();
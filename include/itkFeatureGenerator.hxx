@@ -71,6 +71,17 @@ FeatureGenerator<NDimension>::GetInternalFeature()
 }
 
 
+/**
+ * PrintParameters
+ */
+template <unsigned int NDimension>
+void
+FeatureGenerator<NDimension>::PrintParameters(std::ostream & os) const
+{
+  os << this->GetNameOfClass() << std::endl;
+}
+
+
 /*
  * PrintSelf
  */
@@ -23,7 +23,7 @@
 #include "itkImageSpatialObject.h"
 #include "itkHessianRecursiveGaussianImageFilter.h"
 #include "itkSymmetricSecondRankTensor.h"
-#include "itkSymmetricEigenAnalysisImageFilter.h"
+#include "itkHessianEigenvalueMeasureImageFilter.h"
 #include "itkFrangiTubularnessImageFilter.h"
 
 namespace itk
@@ -97,6 +97,16 @@ public:
   itkSetMacro(NoiseNormalization, double);
   itkGetMacro(NoiseNormalization, double);
 
+  /** Use a fast polynomial approximation of the exponentials of the measure,
+   * with a relative error below 1e-9. Off by default. */
+  itkSetMacro(UseFastApproximation, bool);
+  itkGetMacro(UseFastApproximation, bool);
+  itkBooleanMacro(UseFastApproximation);
+
+  /** Print the parameters that determine the feature. */
+  void
+  PrintParameters(std::ostream & os) const override;
+
 protected:
   FrangiTubularnessFeatureGenerator();
   ~FrangiTubularnessFeatureGenerator() override;
@@ -122,20 +132,19 @@ private:
   using HessianPixelType = typename HessianImageType::PixelType;
 
   using EigenValueArrayType = FixedArray<double, HessianPixelType::Dimension>;
-  using EigenValueImageType = Image<EigenValueArrayType, Dimension>;
-
-  using EigenAnalysisFilterType = SymmetricEigenAnalysisImageFilter<HessianImageType, EigenValueImageType>;
+  using TubularnessFunctionType = Function::Tubularness<EigenValueArrayType, OutputPixelType>;
 
-  using SheetnessFilterType = FrangiTubularnessImageFilter<EigenValueImageType, OutputImageType>;
+  using SheetnessFilterType =
+    HessianEigenvalueMeasureImageFilter<HessianImageType, OutputImageType, TubularnessFunctionType>;
 
-  typename HessianFilterType::Pointer       m_HessianFilter;
-  typename EigenAnalysisFilterType::Pointer m_EigenAnalysisFilter;
-  typename SheetnessFilterType::Pointer     m_SheetnessFilter;
+  typename HessianFilterType::Pointer   m_HessianFilter;
+  typename SheetnessFilterType::Pointer m_SheetnessFilter;
 
   double m_Sigma;
   double m_SheetnessNormalization;
   double m_BloobinessNormalization;
   double m_NoiseNormalization;
+  bool   m_UseFastApproximation;
 };
 
 } // end namespace itk
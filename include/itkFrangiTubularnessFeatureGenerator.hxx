@@ -31,11 +31,9 @@ FrangiTubularnessFeatureGenerator<NDimension>::FrangiTubularnessFeatureGenerator
   this->SetNumberOfRequiredInputs(1);
 
   this->m_HessianFilter = HessianFilterType::New();
-  this->m_EigenAnalysisFilter = EigenAnalysisFilterType::New();
   this->m_SheetnessFilter = SheetnessFilterType::New();
 
   this->m_HessianFilter->ReleaseDataFlagOn();
-  this->m_EigenAnalysisFilter->ReleaseDataFlagOn();
   this->m_SheetnessFilter->ReleaseDataFlagOn();
 
   typename OutputImageSpatialObjectType::Pointer outputObject = OutputImageSpatialObjectType::New();
@@ -46,6 +44,7 @@ FrangiTubularnessFeatureGenerator<NDimension>::FrangiTubularnessFeatureGenerator
   this->m_SheetnessNormalization = 0.5;
   this->m_BloobinessNormalization = 2.0;
   this->m_NoiseNormalization = 1.0;
+  this->m_UseFastApproximation = false;
 }
 
 
@@ -87,6 +86,22 @@ FrangiTubularnessFeatureGenerator<NDimension>::PrintSelf(std::ostream & os, Inde
 }
 
 
+/**
+ * PrintParameters
+ */
+template <unsigned int NDimension>
+void
+FrangiTubularnessFeatureGenerator<NDimension>::PrintParameters(std::ostream & os) const
+{
+  Superclass::PrintParameters(os);
+  os << "Sigma " << this->m_Sigma << std::endl;
+  os << "SheetnessNormalization " << this->m_SheetnessNormalization << std::endl;
+  os << "BloobinessNormalization " << this->m_BloobinessNormalization << std::endl;
+  os << "NoiseNormalization " << this->m_NoiseNormalization << std::endl;
+  os << "UseFastApproximation " << this->m_UseFastApproximation << std::endl;
+}
+
+
 /*
  * Generate Data
  */
@@ -98,8 +113,7 @@ FrangiTubularnessFeatureGenerator<NDimension>::GenerateData()
   ProgressAccumulator::Pointer progress = ProgressAccumulator::New();
   progress->SetMiniPipelineFilter(this);
   progress->RegisterInternalFilter(this->m_HessianFilter, .5);
-  progress->RegisterInternalFilter(this->m_EigenAnalysisFilter, .25);
-  progress->RegisterInternalFilter(this->m_SheetnessFilter, .25);
+  progress->RegisterInternalFilter(this->m_SheetnessFilter, .5);
 
   typename InputImageSpatialObjectType::ConstPointer inputObject =
     dynamic_cast<const InputImageSpatialObjectType *>(this->ProcessObject::GetInput(0));
@@ -117,14 +131,15 @@ FrangiTubularnessFeatureGenerator<NDimension>::GenerateData()
   }
 
   this->m_HessianFilter->SetInput(inputImage);
-  this->m_EigenAnalysisFilter->SetInput(this->m_HessianFilter->GetOutput());
-  this->m_SheetnessFilter->SetInput(this->m_EigenAnalysisFilter->GetOutput());
+  this->m_SheetnessFilter->SetInput(this->m_HessianFilter->GetOutput());
 
   this->m_HessianFilter->SetSigma(this->m_Sigma);
-  this->m_EigenAnalysisFilter->SetDimension(Dimension);
-  this->m_SheetnessFilter->SetSheetnessNormalization(this->m_SheetnessNormalization);
-  this->m_SheetnessFilter->SetBloobinessNormalization(this->m_BloobinessNormalization);
-  this->m_SheetnessFilter->SetNoiseNormalization(this->m_NoiseNormalization);
+
+  TubularnessFunctionType & tubularness = this->m_SheetnessFilter->GetMeasure();
+  tubularness.SetAlpha(this->m_SheetnessNormalization);
+  tubularness.SetBeta(this->m_BloobinessNormalization);
+  tubularness.SetGamma(this->m_NoiseNormalization);
+  tubularness.SetUseFastApproximation(this->m_UseFastApproximation);
 
   this->m_SheetnessFilter->Update();
 
@@ -19,6 +19,7 @@
 #define itkFrangiTubularnessImageFilter_h
 
 #include "itkUnaryFunctorImageFilter.h"
+#include "itkEigenValueMeasureFunctions.h"
 #include "itkMath.h"
 
 namespace itk
@@ -42,28 +43,16 @@ class Tubularness
 public:
   Tubularness()
   {
-    m_Alpha = 0.5; // suggested value in the paper
-    m_Beta = 0.5;  // suggested value in the paper;
-    m_Gamma = 1.0; // suggested value in the paper;
+    this->SetAlpha(0.5); // suggested value in the paper
+    this->SetBeta(0.5);  // suggested value in the paper;
+    this->SetGamma(1.0); // suggested value in the paper;
     m_BrigthForeground = true;
+    m_UseFastApproximation = false;
   }
   ~Tubularness() = default;
-  Tubularness(const Tubularness & one)
-  {
-    this->m_Alpha = one.m_Alpha;
-    this->m_Beta = one.m_Beta;
-    this->m_Gamma = one.m_Gamma;
-    this->m_BrigthForeground = one.m_BrigthForeground;
-  }
-  const Tubularness &
-  operator=(const Tubularness & one)
-  {
-    this->m_Alpha = one.m_Alpha;
-    this->m_Beta = one.m_Beta;
-    this->m_Gamma = one.m_Gamma;
-    this->m_BrigthForeground = one.m_BrigthForeground;
-    return *this;
-  }
+  Tubularness(const Tubularness & one) = default;
+  Tubularness &
+  operator=(const Tubularness & one) = default;
   bool
   operator!=(const Tubularness &) const
   {
@@ -75,116 +64,101 @@ public:
     return !(*this != other);
   }
   inline TOutput
-  operator()(const TInput & A)
+  operator()(const TInput & A) const
   {
-    double tubularness = 0.0;
-
     auto a1 = static_cast<double>(A[0]);
     auto a2 = static_cast<double>(A[1]);
     auto a3 = static_cast<double>(A[2]);
 
-    double l1 = itk::Math::abs(a1);
-    double l2 = itk::Math::abs(a2);
-    double l3 = itk::Math::abs(a3);
-
     //
     // Sort the values by their absolute value.
     //
-    if (l2 > l3)
-    {
-      double tmpl = l3;
-      l3 = l2;
-      l2 = tmpl;
-      double tmpa = a3;
-      a3 = a2;
-      a2 = tmpa;
-    }
+    SortByMagnitude(a1, a2, a3);
 
-    if (l1 > l2)
-    {
-      double tmp = l1;
-      l1 = l2;
-      l2 = tmp;
-      double tmpa = a1;
-      a1 = a2;
-      a2 = tmpa;
-    }
+    const double l1 = itk::Math::abs(a1);
+    const double l2 = itk::Math::abs(a2);
+    const double l3 = itk::Math::abs(a3);
 
-    if (l2 > l3)
-    {
-      double tmp = l3;
-      l3 = l2;
-      l2 = tmp;
-      double tmpa = a3;
-      a3 = a2;
-      a2 = tmpa;
-    }
+    //
+    // With a bright foreground, reject dark tubes and dark ridges over bright
+    // background, and the other way around. Also avoid divisions by zero.
+    // The measure is computed for all the pixels and then masked, so that the
+    // evaluation does not branch.
+    //
+    const bool polarity = m_BrigthForeground ? !(a3 > 0.0) : !(a3 < 0.0);
+    const bool valid = polarity && !(l2 < itk::Math::eps) && !(l3 < itk::Math::eps);
 
-    if (m_BrigthForeground)
-    {
-      //
-      // Reject dark tubes and dark ridges over bright background
-      //
-      if (a3 > 0.0)
-      {
-        return tubularness;
-      }
-    }
-    else
-    {
-      //
-      // Reject bright tubes and bright ridges over dark background
-      //
-      if (a3 < 0.0)
-      {
-        return tubularness;
-      }
-    }
+    const double safeL2 = valid ? l2 : 1.0;
+    const double safeL3 = valid ? l3 : 1.0;
 
-    // avoid divisions by zero
-    if (l2 < itk::Math::eps || l3 < itk::Math::eps)
-    {
-      return tubularness;
-    }
+    const double Rs = safeL2 / safeL3;
+    const double Rb2 = (l1 * l1) / (safeL2 * safeL3);
+    const double Rn2 = l3 * l3 + l2 * l2 + l1 * l1;
 
-    const double Rs = l2 / l3;
-    const double Rb = l1 / std::sqrt(l2 * l3);
-    const double Rn = std::sqrt(l3 * l3 + l2 * l2 + l1 * l1);
+    double tubularness = (1.0 - this->Exponential(Rs * Rs * m_SheetnessFactor));
+    tubularness *= this->Exponential(Rb2 * m_BloobinessFactor);
+    tubularness *= (1.0 - this->Exponential(Rn2 * m_NoiseFactor));
 
-    tubularness = (1.0 - std::exp(-(Rs * Rs) / (2.0 * m_Alpha * m_Alpha)));
-    tubularness *= (std::exp(-(Rb * Rb) / (2.0 * m_Beta * m_Beta)));
-    tubularness *= (1.0 - std::exp(-(Rn * Rn) / (2.0 * m_Gamma * m_Gamma)));
+    return static_cast<TOutput>(valid ? tubularness : 0.0);
+  }
 
-    return static_cast<TOutput>(tubularness);
+  /** Evaluate the measure on a contiguous array of eigenvalue arrays. */
+  void
+  Evaluate(const TInput * input, TOutput * output, SizeValueType numberOfPixels) const
+  {
+    for (SizeValueType i = 0; i < numberOfPixels; ++i)
+    {
+      output[i] = (*this)(input[i]);
+    }
   }
 
   void
   SetAlpha(double value)
   {
     this->m_Alpha = value;
+    this->m_SheetnessFactor = -1.0 / (2.0 * value * value);
   }
   void
   SetBeta(double value)
   {
     this->m_Beta = value;
+    this->m_BloobinessFactor = -1.0 / (2.0 * value * value);
   }
   void
   SetGamma(double value)
   {
     this->m_Gamma = value;
+    this->m_NoiseFactor = -1.0 / (2.0 * value * value);
   }
   void
   SetBrightBackground(bool value)
   {
-    std::cout << "m_BrigthForeground " << value << std::endl;
-    this->m_BrigthForeground;
+    this->m_BrigthForeground = !value;
+  }
+
+  /** Use a polynomial approximation of the exponential, with a relative
+   * error below 1e-9, instead of std::exp(). */
+  void
+  SetUseFastApproximation(bool value)
+  {
+    this->m_UseFastApproximation = value;
   }
 
 private:
+  inline double
+  Exponential(double x) const
+  {
+    return this->m_UseFastApproximation ? ExponentialApproximation(x) : std::exp(x);
+  }
+
   double m_Alpha;
   double m_Beta;
   double m_Gamma;
+  double m_SheetnessFactor;
+  double m_BloobinessFactor;
+  double m_NoiseFactor;
   bool   m_BrigthForeground;
+  bool   m_UseFastApproximation;
 };
 } // namespace Function
 
@@ -242,6 +216,13 @@ public:
     this->GetFunctor().SetBrightBackground(value);
   }
 
+  /** Trade accuracy for speed in the evaluation of the exponentials. */
+  void
+  SetUseFastApproximation(bool value)
+  {
+    this->GetFunctor().SetUseFastApproximation(value);
+  }
+
 
 #ifdef ITK_USE_CONCEPT_CHECKING
   /** Begin concept checking */
@@ -20,6 +20,8 @@
 
 #include "itkSinglePhaseLevelSetSegmentationModule.h"
 #include "itkGeodesicActiveContourLevelSetImageFilter.h"
+#include "itkParallelSegmentationLevelSetImageFilter.h"
+#include "itkGeodesicActiveContourLevelSetFunction.h"
 
 namespace itk
 {
@@ -80,6 +82,12 @@ protected:
    * the segmentation. */
   void
   GenerateData() override;
+
+private:
+  /** Configure and run the serial or the parallel level set filter. */
+  template <typename TFilter>
+  void
+  ComputeLevelSet(TFilter * filter);
 };
 
 } // end namespace itk
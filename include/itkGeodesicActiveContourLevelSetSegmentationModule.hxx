@@ -19,6 +19,7 @@
 #define itkGeodesicActiveContourLevelSetSegmentationModule_hxx
 
 #include "itkGeodesicActiveContourLevelSetImageFilter.h"
+#include "itkParallelSegmentationLevelSetImageFilter.h"
 #include "itkProgressAccumulator.h"
 
 
@@ -60,11 +61,48 @@ template <unsigned int NDimension>
 void
 GeodesicActiveContourLevelSetSegmentationModule<NDimension>::GenerateData()
 {
-  using FilterType = GeodesicActiveContourLevelSetImageFilter<InputImageType, FeatureImageType, OutputPixelType>;
+  if (this->GetUseParallelSolver())
+  {
+    using FunctionType = GeodesicActiveContourLevelSetFunction<OutputImageType, FeatureImageType>;
+    using FilterType = typename Superclass::template HaltableLevelSetFilter<
+      ParallelSegmentationLevelSetImageFilter<InputImageType, FeatureImageType, OutputPixelType>>;
+
+    typename FunctionType::Pointer function = FunctionType::New();
+    typename FilterType::Pointer   filter = FilterType::New();
+    filter->SetSegmentationFunction(function);
+
+    this->ComputeLevelSet(filter.GetPointer());
+  }
+  else
+  {
+    using FilterType = typename Superclass::template HaltableLevelSetFilter<
+      GeodesicActiveContourLevelSetImageFilter<InputImageType, FeatureImageType, OutputPixelType>>;
+
+    typename FilterType::Pointer filter = FilterType::New();
+
+    this->ComputeLevelSet(filter.GetPointer());
+  }
+}
 
-  typename FilterType::Pointer filter = FilterType::New();
 
-  filter->SetInput(this->GetInternalInputImage());
+/**
+ * Run the level set filter
+ */
+template <unsigned int NDimension>
+template <typename TFilter>
+void
+GeodesicActiveContourLevelSetSegmentationModule<NDimension>::ComputeLevelSet(TFilter * filter)
+{
+  // Warm start from the initial level set when one is given.
+  const typename InputImageType::ConstPointer initialLevelSet = this->ComputeInternalInitialLevelSet();
+  if (initialLevelSet)
+  {
+    filter->SetInput(initialLevelSet);
+  }
+  else
+  {
+    filter->SetInput(this->GetInternalInputImage());
+  }
   filter->SetFeatureImage(this->GetInternalFeatureImage());
 
   filter->SetMaximumRMSError(this->GetMaximumRMSError());
@@ -79,14 +117,13 @@ GeodesicActiveContourLevelSetSegmentationModule<NDimension>::GenerateData()
   progress->SetMiniPipelineFilter(this);
   progress->RegisterInternalFilter(filter, 1.0);
 
-  filter->Update();
+  this->EvolveLevelSet(filter);
 
-  std::cout << std::endl;
-  std::cout << "Max. no. iterations: " << filter->GetNumberOfIterations() << std::endl;
-  std::cout << "Max. RMS error: " << filter->GetMaximumRMSError() << std::endl;
-  std::cout << std::endl;
-  std::cout << "No. elpased iterations: " << filter->GetElapsedIterations() << std::endl;
-  std::cout << "RMS change: " << filter->GetRMSChange() << std::endl;
+  itkDebugMacro("Max. no. iterations: " << this->GetMaximumNumberOfIterations()
+                                         << ", max. RMS error: " << this->GetMaximumRMSError()
+                                         << ", no. elapsed iterations: " << this->GetElapsedIterations()
+                                         << ", RMS change: " << this->GetRMSChange());
+  itkDebugMacro("Stop condition: " << this->GetStopConditionDescription());
 
   this->PackOutputImageInOutputSpatialObject(filter->GetOutput());
 }
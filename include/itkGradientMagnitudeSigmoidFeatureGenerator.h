@@ -93,6 +93,10 @@ public:
   itkSetMacro(Beta, double);
   itkGetMacro(Beta, double);
 
+  /** Print the parameters that determine the feature. */
+  void
+  PrintParameters(std::ostream & os) const override;
+
 protected:
   GradientMagnitudeSigmoidFeatureGenerator();
   ~GradientMagnitudeSigmoidFeatureGenerator() override;
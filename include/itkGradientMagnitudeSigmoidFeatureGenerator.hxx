@@ -87,6 +87,20 @@ GradientMagnitudeSigmoidFeatureGenerator<NDimension>::PrintSelf(std::ostream & o
 }
 
 
+/**
+ * PrintParameters
+ */
+template <unsigned int NDimension>
+void
+GradientMagnitudeSigmoidFeatureGenerator<NDimension>::PrintParameters(std::ostream & os) const
+{
+  Superclass::PrintParameters(os);
+  os << "Sigma " << this->m_Sigma << std::endl;
+  os << "Alpha " << this->m_Alpha << std::endl;
+  os << "Beta " << this->m_Beta << std::endl;
+}
+
+
 /*
  * Generate Data
  */
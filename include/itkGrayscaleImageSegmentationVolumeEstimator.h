@@ -37,6 +37,15 @@ namespace itk
  *
  * The pixels size is, of course, taken into account.
  *
+ * The pixels are scanned in parallel, one hyperplane of the image at a time,
+ * and the partial sums are combined in order with compensated summation. The
+ * result does not depend on the number of threads.
+ *
+ * The scan can be restricted to a RegionOfInterest, for instance the bounding
+ * box of the segmentation. The pixels outside of it are assumed to be at the
+ * minimum intensity, and contribute nothing to the volume. The
+ * RegionOfInterest must therefore contain some of the background.
+ *
  * \ingroup SpatialObjectFilters
  * \ingroup LesionSizingToolkit
  */
@@ -72,6 +81,18 @@ public:
   using InputPixelType = float;
   using InputImageSpatialObjectType = ImageSpatialObject<NDimension, InputPixelType>;
   using InputImageType = Image<InputPixelType, NDimension>;
+  using RegionType = typename InputImageType::RegionType;
+
+  /** Region of the input image that is scanned, when UseRegionOfInterest is
+   * ON. It is cropped to the buffered region of the input image. */
+  itkSetMacro(RegionOfInterest, RegionType);
+  itkGetConstReferenceMacro(RegionOfInterest, RegionType);
+
+  /** Turn On/Off the restriction of the scan to the RegionOfInterest.
+   * Defaults to false. */
+  itkSetMacro(UseRegionOfInterest, bool);
+  itkGetConstMacro(UseRegionOfInterest, bool);
+  itkBooleanMacro(UseRegionOfInterest);
 
 protected:
   GrayscaleImageSegmentationVolumeEstimator();
@@ -84,6 +105,10 @@ protected:
    * the segmentation. */
   void
   GenerateData() override;
+
+private:
+  RegionType m_RegionOfInterest;
+  bool       m_UseRegionOfInterest;
 };
 
 } // end namespace itk
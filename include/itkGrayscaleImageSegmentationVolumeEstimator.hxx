@@ -19,7 +19,13 @@
 #define itkGrayscaleImageSegmentationVolumeEstimator_hxx
 
 #include "itkImageSpatialObject.h"
-#include "itkImageRegionIterator.h"
+#include "itkImageScanlineIterator.h"
+#include "itkCompensatedSummation.h"
+#include "itkMath.h"
+#include "itkMultiThreaderBase.h"
+
+#include <algorithm>
+#include <vector>
 
 
 namespace itk
@@ -29,7 +35,10 @@ namespace itk
  * Constructor
  */
 template <unsigned int NDimension>
-GrayscaleImageSegmentationVolumeEstimator<NDimension>::GrayscaleImageSegmentationVolumeEstimator() = default;
+GrayscaleImageSegmentationVolumeEstimator<NDimension>::GrayscaleImageSegmentationVolumeEstimator()
+{
+  this->m_UseRegionOfInterest = false;
+}
 
 
 /**
@@ -47,6 +56,8 @@ void
 GrayscaleImageSegmentationVolumeEstimator<NDimension>::PrintSelf(std::ostream & os, Indent indent) const
 {
   Superclass::PrintSelf(os, indent);
+  os << indent << "RegionOfInterest = " << this->m_RegionOfInterest << std::endl;
+  os << indent << "UseRegionOfInterest = " << this->m_UseRegionOfInterest << std::endl;
 }
 
 
@@ -67,40 +78,77 @@ GrayscaleImageSegmentationVolumeEstimator<NDimension>::GenerateData()
 
   const InputImageType * inputImage = inputObject->GetImage();
 
-  double sumOfIntensities = 0.0;
-
-  double minimumIntensity = NumericTraits<double>::max();
-  double maximumIntensity = NumericTraits<double>::NonpositiveMin();
-
-  using IteratorType = ImageRegionConstIterator<InputImageType>;
-
-  using ImageRegionType = typename InputImageType::RegionType;
+  RegionType region = inputImage->GetBufferedRegion();
 
-  const ImageRegionType region = inputImage->GetBufferedRegion();
-
-  IteratorType itr(inputImage, region);
-
-  itr.GoToBegin();
-
-  while (!itr.IsAtEnd())
+  if (this->m_UseRegionOfInterest)
   {
-    const double pixelValue = itr.Get();
-
-    if (pixelValue < minimumIntensity)
+    RegionType regionOfInterest = this->m_RegionOfInterest;
+    if (!regionOfInterest.Crop(region))
     {
-      minimumIntensity = pixelValue;
-    }
-
-    if (pixelValue > maximumIntensity)
-    {
-      maximumIntensity = pixelValue;
+      itkExceptionMacro("The region of interest " << this->m_RegionOfInterest
+                                                  << " does not overlap the buffered region " << region);
     }
+    region = regionOfInterest;
+  }
 
-    sumOfIntensities += pixelValue;
-    ++itr;
+  //
+  // Minimum, maximum and sum of the intensities of each hyperplane of the
+  // region, computed in parallel.
+  //
+  constexpr unsigned int lastDimension = Dimension - 1;
+
+  const SizeValueType numberOfHyperplanes = region.GetSize(lastDimension);
+
+  std::vector<double> hyperplaneMinimum(numberOfHyperplanes);
+  std::vector<double> hyperplaneMaximum(numberOfHyperplanes);
+  std::vector<double> hyperplaneSum(numberOfHyperplanes);
+
+  this->GetMultiThreader()->ParallelizeArray(
+    0,
+    numberOfHyperplanes,
+    [&](SizeValueType hyperplane) {
+      RegionType hyperplaneRegion = region;
+      hyperplaneRegion.SetIndex(lastDimension, region.GetIndex(lastDimension) + hyperplane);
+      hyperplaneRegion.SetSize(lastDimension, 1);
+
+      double                       minimumIntensity = NumericTraits<double>::max();
+      double                       maximumIntensity = NumericTraits<double>::NonpositiveMin();
+      CompensatedSummation<double> sumOfIntensities;
+
+      ImageScanlineConstIterator<InputImageType> itr(inputImage, hyperplaneRegion);
+      while (!itr.IsAtEnd())
+      {
+        while (!itr.IsAtEndOfLine())
+        {
+          const double pixelValue = itr.Get();
+          minimumIntensity = std::min(minimumIntensity, pixelValue);
+          maximumIntensity = std::max(maximumIntensity, pixelValue);
+          sumOfIntensities += pixelValue;
+          ++itr;
+        }
+        itr.NextLine();
+      }
+
+      hyperplaneMinimum[hyperplane] = minimumIntensity;
+      hyperplaneMaximum[hyperplane] = maximumIntensity;
+      hyperplaneSum[hyperplane] = sumOfIntensities.GetSum();
+    },
+    nullptr);
+
+  // Combined in order, so that the result does not depend on the number of
+  // threads.
+  double                       minimumIntensity = NumericTraits<double>::max();
+  double                       maximumIntensity = NumericTraits<double>::NonpositiveMin();
+  CompensatedSummation<double> sumOfIntensities;
+
+  for (SizeValueType hyperplane = 0; hyperplane < numberOfHyperplanes; ++hyperplane)
+  {
+    minimumIntensity = std::min(minimumIntensity, hyperplaneMinimum[hyperplane]);
+    maximumIntensity = std::max(maximumIntensity, hyperplaneMaximum[hyperplane]);
+    sumOfIntensities += hyperplaneSum[hyperplane];
   }
 
-  const unsigned int long numberOfPixels = region.GetNumberOfPixels();
+  const SizeValueType numberOfPixels = region.GetNumberOfPixels();
 
   sumOfIntensities -= numberOfPixels * minimumIntensity;
 
@@ -108,15 +156,16 @@ GrayscaleImageSegmentationVolumeEstimator<NDimension>::GenerateData()
 
   const SpacingType spacing = inputImage->GetSpacing();
 
-  double pixelVolume = spacing[0] * spacing[1] * spacing[2];
+  double pixelVolume = 1.0;
+  for (unsigned int d = 0; d < Dimension; ++d)
+  {
+    pixelVolume *= spacing[d];
+  }
 
   //
   // Deal with eventual cases of negative spacing
   //
-  if (pixelVolume < 0.0)
-  {
-    pixelVolume = -pixelVolume;
-  }
+  pixelVolume = itk::Math::abs(pixelVolume);
 
   const double intensityRange = (maximumIntensity - minimumIntensity);
 
@@ -124,7 +173,7 @@ GrayscaleImageSegmentationVolumeEstimator<NDimension>::GenerateData()
 
   if (intensityRange > 1e-6)
   {
-    volumeEstimation = pixelVolume * sumOfIntensities / intensityRange;
+    volumeEstimation = pixelVolume * sumOfIntensities.GetSum() / intensityRange;
   }
 
   auto * outputCarrier = static_cast<RealObjectType *>(this->ProcessObject::GetOutput(0));
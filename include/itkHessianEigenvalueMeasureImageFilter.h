@@ -0,0 +1,135 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkHessianEigenvalueMeasureImageFilter_h
+#define itkHessianEigenvalueMeasureImageFilter_h
+
+#include "itkImageToImageFilter.h"
+#include "itkFixedArray.h"
+
+namespace itk
+{
+
+/** \class HessianEigenvalueMeasureImageFilter
+ *
+ * \brief Computes a scalar measure from the eigenvalues of a Hessian image
+ * without storing the eigenvalues.
+ *
+ * This filter fuses the SymmetricEigenAnalysisImageFilter with one of the
+ * eigenvalue based measures of this toolkit (Function::Sheetness,
+ * Function::Tubularness, Function::LocalStructure). For every pixel the
+ * eigenvalues of the Hessian are computed in closed form, passed to the
+ * measure functor, and only the resulting scalar is written to the output.
+ * This avoids allocating, writing and reading back an intermediate image of
+ * eigenvalue arrays.
+ *
+ * The measure functor must provide a batched evaluation method
+ *
+ *   void Evaluate(const EigenValueArrayType * eigenValues,
+ *                 OutputPixelType * output, SizeValueType numberOfPixels) const
+ *
+ * that is called once per image line. The eigenvalues of each pixel are
+ * passed in a FixedArray<double, Dimension>, sorted by increasing value, as
+ * produced by default by the SymmetricEigenAnalysisImageFilter.
+ *
+ * \ingroup IntensityImageFilters  Multithreaded
+ * \ingroup LesionSizingToolkit
+ */
+template <typename TInputImage, typename TOutputImage, typename TMeasure>
+class ITK_TEMPLATE_EXPORT HessianEigenvalueMeasureImageFilter : public ImageToImageFilter<TInputImage, TOutputImage>
+{
+public:
+  ITK_DISALLOW_COPY_AND_MOVE(HessianEigenvalueMeasureImageFilter);
+
+  /** Standard class type alias. */
+  using Self = HessianEigenvalueMeasureImageFilter;
+  using Superclass = ImageToImageFilter<TInputImage, TOutputImage>;
+  using Pointer = SmartPointer<Self>;
+  using ConstPointer = SmartPointer<const Self>;
+
+  /** Method for creation through the object factory. */
+  itkNewMacro(Self);
+
+  /** Run-time type information (and related methods). */
+  itkOverrideGetNameOfClassMacro(HessianEigenvalueMeasureImageFilter);
+
+  /** Image dimension constant */
+  static constexpr unsigned int ImageDimension = TInputImage::ImageDimension;
+
+  using InputImageType = TInputImage;
+  using InputPixelType = typename InputImageType::PixelType;
+  using OutputImageType = TOutputImage;
+  using OutputPixelType = typename OutputImageType::PixelType;
+  using OutputImageRegionType = typename OutputImageType::RegionType;
+
+  using MeasureType = TMeasure;
+
+  /** Type of the array that holds the eigenvalues of one pixel. */
+  using EigenValueArrayType = FixedArray<double, ImageDimension>;
+
+  /** Get the measure functor, in order to set its parameters. The filter is
+   * marked as modified since the parameters of the functor are likely to
+   * change. */
+  MeasureType &
+  GetMeasure()
+  {
+    this->Modified();
+    return this->m_Measure;
+  }
+  const MeasureType &
+  GetMeasure() const
+  {
+    return this->m_Measure;
+  }
+
+  /** Set the measure functor. */
+  void
+  SetMeasure(const MeasureType & measure)
+  {
+    this->m_Measure = measure;
+    this->Modified();
+  }
+
+  /** Compute the eigenvalues of a symmetric tensor, sorted by increasing
+   * value. Three dimensional tensors are solved in closed form. */
+  static void
+  ComputeEigenValues(const InputPixelType & tensor, EigenValueArrayType & eigenValues);
+
+#ifdef ITK_USE_CONCEPT_CHECKING
+  /** Begin concept checking */
+  itkConceptMacro(SameDimensionCheck, (Concept::SameDimension<ImageDimension, TOutputImage::ImageDimension>));
+  /** End concept checking */
+#endif
+
+protected:
+  HessianEigenvalueMeasureImageFilter();
+  ~HessianEigenvalueMeasureImageFilter() override = default;
+
+  void
+  DynamicThreadedGenerateData(const OutputImageRegionType & outputRegionForThread) override;
+
+private:
+  MeasureType m_Measure;
+};
+
+} // end namespace itk
+
+#ifndef ITK_MANUAL_INSTANTIATION
+#  include "itkHessianEigenvalueMeasureImageFilter.hxx"
+#endif
+
+#endif
@@ -0,0 +1,162 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkHessianEigenvalueMeasureImageFilter_hxx
+#define itkHessianEigenvalueMeasureImageFilter_hxx
+
+#include "itkImageScanlineIterator.h"
+#include "itkMath.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <vector>
+
+namespace itk
+{
+
+/**
+ * Constructor
+ */
+template <typename TInputImage, typename TOutputImage, typename TMeasure>
+HessianEigenvalueMeasureImageFilter<TInputImage, TOutputImage, TMeasure>::HessianEigenvalueMeasureImageFilter()
+{
+  this->SetNumberOfRequiredInputs(1);
+  this->DynamicMultiThreadingOn();
+  this->ThreaderUpdateProgressOff();
+}
+
+
+/*
+ * Eigenvalues of a symmetric tensor
+ */
+template <typename TInputImage, typename TOutputImage, typename TMeasure>
+void
+HessianEigenvalueMeasureImageFilter<TInputImage, TOutputImage, TMeasure>::ComputeEigenValues(
+  const InputPixelType & tensor,
+  EigenValueArrayType &  eigenValues)
+{
+  if constexpr (ImageDimension == 3)
+  {
+    //
+    // Trigonometric solution of the characteristic polynomial of a symmetric
+    // 3x3 matrix. The matrix is shifted by a third of its trace and scaled,
+    // so that its eigenvalues can be expressed as 2 cos( phi + 2 k pi / 3 ).
+    //
+    const double a00 = tensor(0, 0);
+    const double a01 = tensor(0, 1);
+    const double a02 = tensor(0, 2);
+    const double a11 = tensor(1, 1);
+    const double a12 = tensor(1, 2);
+    const double a22 = tensor(2, 2);
+
+    const double q = (a00 + a11 + a22) / 3.0;
+
+    const double b00 = a00 - q;
+    const double b11 = a11 - q;
+    const double b22 = a22 - q;
+
+    const double offDiagonal = a01 * a01 + a02 * a02 + a12 * a12;
+    const double p = std::sqrt((b00 * b00 + b11 * b11 + b22 * b22 + 2.0 * offDiagonal) / 6.0);
+
+    //
+    // The matrix is a multiple of the identity.
+    //
+    if (!(p > std::numeric_limits<double>::min()))
+    {
+      eigenValues.Fill(q);
+      return;
+    }
+
+    const double invp = 1.0 / p;
+
+    const double c00 = b00 * invp;
+    const double c01 = a01 * invp;
+    const double c02 = a02 * invp;
+    const double c11 = b11 * invp;
+    const double c12 = a12 * invp;
+    const double c22 = b22 * invp;
+
+    const double determinant =
+      c00 * (c11 * c22 - c12 * c12) - c01 * (c01 * c22 - c12 * c02) + c02 * (c01 * c12 - c11 * c02);
+
+    const double r = std::clamp(0.5 * determinant, -1.0, 1.0);
+    const double phi = std::acos(r) / 3.0;
+
+    const double largest = q + 2.0 * p * std::cos(phi);
+    const double smallest = q + 2.0 * p * std::cos(phi + 2.0 * itk::Math::pi / 3.0);
+
+    eigenValues[0] = smallest;
+    eigenValues[1] = 3.0 * q - largest - smallest;
+    eigenValues[2] = largest;
+  }
+  else
+  {
+    typename InputPixelType::EigenValuesArrayType values;
+    tensor.ComputeEigenValues(values);
+    for (unsigned int i = 0; i < ImageDimension; ++i)
+    {
+      eigenValues[i] = static_cast<double>(values[i]);
+    }
+    std::sort(eigenValues.Begin(), eigenValues.End());
+  }
+}
+
+
+/*
+ * Generate Data for each region
+ */
+template <typename TInputImage, typename TOutputImage, typename TMeasure>
+void
+HessianEigenvalueMeasureImageFilter<TInputImage, TOutputImage, TMeasure>::DynamicThreadedGenerateData(
+  const OutputImageRegionType & outputRegionForThread)
+{
+  const InputImageType * inputImage = this->GetInput();
+  OutputImageType *      outputImage = this->GetOutput();
+
+  const MeasureType & measure = this->m_Measure;
+
+  ImageScanlineConstIterator<InputImageType> inputIt(inputImage, outputRegionForThread);
+  ImageScanlineIterator<OutputImageType>     outputIt(outputImage, outputRegionForThread);
+
+  //
+  // The eigenvalues of a whole line are computed first, and the measure is
+  // then evaluated in a single batch over the line, writing directly in the
+  // output buffer.
+  //
+  const SizeValueType lineLength = outputRegionForThread.GetSize(0);
+
+  std::vector<EigenValueArrayType> eigenValues(lineLength);
+
+  while (!inputIt.IsAtEnd())
+  {
+    SizeValueType i = 0;
+    while (!inputIt.IsAtEndOfLine())
+    {
+      Self::ComputeEigenValues(inputIt.Get(), eigenValues[i]);
+      ++inputIt;
+      ++i;
+    }
+    measure.Evaluate(eigenValues.data(), &(outputIt.Value()), lineLength);
+    inputIt.NextLine();
+    outputIt.NextLine();
+  }
+}
+
+} // end namespace itk
+
+#endif
@@ -0,0 +1,109 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkIsoSurfaceMeshSource_h
+#define itkIsoSurfaceMeshSource_h
+
+#include "itkImageToMeshFilter.h"
+#include "itkTriangleCell.h"
+
+namespace itk
+{
+
+/** \class IsoSurfaceMeshSource
+ *
+ * \brief Extract the iso-surface of a level set image as a triangle mesh.
+ *
+ * The inside of the surface is the region where the level set is larger than
+ * the IsoValue. The cells of the image, the cubes between eight neighboring
+ * pixels, are split in six tetrahedra, and the surface is built by marching
+ * tetrahedra. This is the surface whose enclosed volume is computed by the
+ * IsoSurfaceSegmentationVolumeEstimator. The triangles are oriented with
+ * their normals pointing outward, and the surface is closed where the
+ * segmentation does not reach the border of the image.
+ *
+ * Only the slabs of cells within the bounding box of the inside pixels are
+ * visited. The slabs, one layer of cells along the last axis each, are
+ * triangulated in parallel. The points are identified by the edge of the
+ * image grid they lie on, so that the points shared by the triangles of a
+ * slab are created once, and the points on the plane between two slabs are
+ * merged when the slabs are combined, in order. The mesh does not depend on
+ * the number of threads.
+ *
+ * The points are in physical coordinates.
+ *
+ * \sa IsoSurfaceSegmentationVolumeEstimator
+ * \sa TriangleMeshFileWriter
+ *
+ * \ingroup LesionSizingToolkit
+ */
+template <typename TInputImage, typename TOutputMesh>
+class ITK_TEMPLATE_EXPORT IsoSurfaceMeshSource : public ImageToMeshFilter<TInputImage, TOutputMesh>
+{
+public:
+  ITK_DISALLOW_COPY_AND_MOVE(IsoSurfaceMeshSource);
+
+  /** Standard class type alias. */
+  using Self = IsoSurfaceMeshSource;
+  using Superclass = ImageToMeshFilter<TInputImage, TOutputMesh>;
+  using Pointer = SmartPointer<Self>;
+  using ConstPointer = SmartPointer<const Self>;
+
+  /** Method for creation through the object factory. */
+  itkNewMacro(Self);
+
+  /** Run-time type information (and related methods). */
+  itkOverrideGetNameOfClassMacro(IsoSurfaceMeshSource);
+
+  /** Image dimension constant */
+  static constexpr unsigned int ImageDimension = TInputImage::ImageDimension;
+  static_assert(ImageDimension == 3, "The iso-surface mesh is only extracted in three dimensions.");
+
+  using InputImageType = TInputImage;
+  using InputPixelType = typename InputImageType::PixelType;
+  using OutputMeshType = TOutputMesh;
+  using MeshPointType = typename OutputMeshType::PointType;
+  using CellType = typename OutputMeshType::CellType;
+  using CellAutoPointer = typename CellType::CellAutoPointer;
+  using TriangleCellType = TriangleCell<CellType>;
+
+  /** Value of the iso-surface. Defaults to -0.5, the surface of the output of
+   * the LesionSegmentationImageFilter8. */
+  itkSetMacro(IsoValue, double);
+  itkGetConstMacro(IsoValue, double);
+
+protected:
+  IsoSurfaceMeshSource();
+  ~IsoSurfaceMeshSource() override = default;
+
+  void
+  PrintSelf(std::ostream & os, Indent indent) const override;
+
+  void
+  GenerateData() override;
+
+private:
+  double m_IsoValue;
+};
+
+} // end namespace itk
+
+#ifndef ITK_MANUAL_INSTANTIATION
+#  include "itkIsoSurfaceMeshSource.hxx"
+#endif
+
+#endif
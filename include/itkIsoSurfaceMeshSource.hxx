@@ -0,0 +1,434 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkIsoSurfaceMeshSource_hxx
+#define itkIsoSurfaceMeshSource_hxx
+
+#include "itkMultiThreaderBase.h"
+#include "itkNumericTraits.h"
+#include "itkVector.h"
+
+#include <algorithm>
+#include <array>
+#include <unordered_map>
+#include <vector>
+
+namespace itk
+{
+
+/**
+ * Constructor
+ */
+template <typename TInputImage, typename TOutputMesh>
+IsoSurfaceMeshSource<TInputImage, TOutputMesh>::IsoSurfaceMeshSource()
+{
+  this->m_IsoValue = -0.5;
+}
+
+
+/**
+ * PrintSelf
+ */
+template <typename TInputImage, typename TOutputMesh>
+void
+IsoSurfaceMeshSource<TInputImage, TOutputMesh>::PrintSelf(std::ostream & os, Indent indent) const
+{
+  Superclass::PrintSelf(os, indent);
+  os << indent << "IsoValue = " << this->m_IsoValue << std::endl;
+}
+
+
+/*
+ * Generate Data
+ */
+template <typename TInputImage, typename TOutputMesh>
+void
+IsoSurfaceMeshSource<TInputImage, TOutputMesh>::GenerateData()
+{
+  const InputImageType * inputImage = this->GetInput();
+  OutputMeshType *       outputMesh = this->GetOutput();
+
+  if (!inputImage)
+  {
+    itkExceptionMacro("Missing input image");
+  }
+
+  outputMesh->Initialize();
+
+  const auto              size = inputImage->GetBufferedRegion().GetSize();
+  const InputPixelType *  buffer = inputImage->GetBufferPointer();
+  const OffsetValueType * offsetTable = inputImage->GetOffsetTable();
+  const double            isoValue = this->m_IsoValue;
+
+  for (unsigned int d = 0; d < ImageDimension; ++d)
+  {
+    if (size[d] < 2)
+    {
+      return;
+    }
+  }
+
+  MultiThreaderBase * multiThreader = this->GetMultiThreader();
+
+  //
+  // Bounding box of the inside pixels, slice by slice.
+  //
+  using BoundsType = std::array<OffsetValueType, 4>;
+
+  std::vector<BoundsType> sliceBounds(size[2]);
+
+  multiThreader->ParallelizeArray(
+    0,
+    size[2],
+    [&](SizeValueType z) {
+      BoundsType bounds = { { NumericTraits<OffsetValueType>::max(),
+                              NumericTraits<OffsetValueType>::NonpositiveMin(),
+                              NumericTraits<OffsetValueType>::max(),
+                              NumericTraits<OffsetValueType>::NonpositiveMin() } };
+      for (OffsetValueType y = 0; y < static_cast<OffsetValueType>(size[1]); ++y)
+      {
+        const InputPixelType * line = buffer + z * offsetTable[2] + y * offsetTable[1];
+        for (OffsetValueType x = 0; x < static_cast<OffsetValueType>(size[0]); ++x)
+        {
+          if (line[x] > isoValue)
+          {
+            bounds[0] = std::min(bounds[0], x);
+            bounds[1] = std::max(bounds[1], x);
+            bounds[2] = std::min(bounds[2], y);
+            bounds[3] = std::max(bounds[3], y);
+          }
+        }
+      }
+      sliceBounds[z] = bounds;
+    },
+    nullptr);
+
+  OffsetValueType lower[3];
+  OffsetValueType upper[3];
+  for (unsigned int d = 0; d < ImageDimension; ++d)
+  {
+    lower[d] = NumericTraits<OffsetValueType>::max();
+    upper[d] = NumericTraits<OffsetValueType>::NonpositiveMin();
+  }
+
+  for (SizeValueType z = 0; z < size[2]; ++z)
+  {
+    if (sliceBounds[z][0] <= sliceBounds[z][1])
+    {
+      lower[0] = std::min(lower[0], sliceBounds[z][0]);
+      upper[0] = std::max(upper[0], sliceBounds[z][1]);
+      lower[1] = std::min(lower[1], sliceBounds[z][2]);
+      upper[1] = std::max(upper[1], sliceBounds[z][3]);
+      lower[2] = std::min(lower[2], static_cast<OffsetValueType>(z));
+      upper[2] = std::max(upper[2], static_cast<OffsetValueType>(z));
+    }
+  }
+
+  if (upper[2] < lower[2])
+  {
+    return;
+  }
+
+  // Cells, identified by their lowest corner, that have at least one corner
+  // inside.
+  for (unsigned int d = 0; d < ImageDimension; ++d)
+  {
+    lower[d] = std::max<OffsetValueType>(lower[d] - 1, 0);
+    upper[d] = std::min<OffsetValueType>(upper[d], static_cast<OffsetValueType>(size[d]) - 2);
+  }
+
+  //
+  // Geometry of the cells, in physical space.
+  //
+  using VectorType = Vector<double, ImageDimension>;
+
+  typename InputImageType::IndexType referenceIndex = inputImage->GetBufferedRegion().GetIndex();
+  for (unsigned int d = 0; d < ImageDimension; ++d)
+  {
+    referenceIndex[d] += lower[d];
+  }
+  typename InputImageType::PointType referencePoint;
+  inputImage->TransformIndexToPhysicalPoint(referenceIndex, referencePoint);
+
+  VectorType steps[3];
+  for (unsigned int axis = 0; axis < ImageDimension; ++axis)
+  {
+    for (unsigned int d = 0; d < ImageDimension; ++d)
+    {
+      steps[axis][d] = inputImage->GetDirection()(d, axis) * inputImage->GetSpacing()[axis];
+    }
+  }
+
+  // Offsets and positions of the corners of a cell, the bits of the corner
+  // number being the x, y and z steps.
+  OffsetValueType cornerOffsets[8];
+  VectorType      cornerPositions[8];
+  for (unsigned int corner = 0; corner < 8; ++corner)
+  {
+    cornerOffsets[corner] = 0;
+    cornerPositions[corner].Fill(0.0);
+    for (unsigned int axis = 0; axis < ImageDimension; ++axis)
+    {
+      if (corner & (1u << axis))
+      {
+        cornerOffsets[corner] += offsetTable[axis];
+        cornerPositions[corner] += steps[axis];
+      }
+    }
+  }
+
+  // Corners of the six tetrahedra of the cell, one per path from the first
+  // to the last corner along the edges of the cell. The corners of each edge
+  // of a tetrahedron are nested: the bits of the lower corner are a subset of
+  // the bits of the upper corner.
+  static constexpr unsigned int tetrahedra[6][4] = { { 0, 1, 3, 7 }, { 0, 1, 5, 7 }, { 0, 2, 3, 7 },
+                                                     { 0, 2, 6, 7 }, { 0, 4, 5, 7 }, { 0, 4, 6, 7 } };
+
+  //
+  // Triangulate the slabs of cells in parallel. A point is identified by the
+  // offset of the lower corner of its edge and by the direction of the edge.
+  //
+  enum : unsigned char
+  {
+    InsideSlab,
+    LowerPlane,
+    UpperPlane
+  };
+
+  struct SlabType
+  {
+    std::vector<VectorType>      Points;
+    std::vector<OffsetValueType> PointKeys;
+    std::vector<unsigned char>   PointPlanes;
+    std::vector<IdentifierType>  Triangles;
+  };
+
+  const SizeValueType   numberOfSlabs = upper[2] - lower[2] + 1;
+  std::vector<SlabType> slabs(numberOfSlabs);
+
+  multiThreader->ParallelizeArray(
+    0,
+    numberOfSlabs,
+    [&](SizeValueType slabNumber) {
+      SlabType &                                          slab = slabs[slabNumber];
+      std::unordered_map<OffsetValueType, IdentifierType> pointIds;
+
+      const OffsetValueType z = lower[2] + static_cast<OffsetValueType>(slabNumber);
+      for (OffsetValueType y = lower[1]; y <= upper[1]; ++y)
+      {
+        for (OffsetValueType x = lower[0]; x <= upper[0]; ++x)
+        {
+          const OffsetValueType cellOffset = z * offsetTable[2] + y * offsetTable[1] + x;
+
+          double       values[8];
+          unsigned int numberOfInsideCorners = 0;
+          for (unsigned int corner = 0; corner < 8; ++corner)
+          {
+            values[corner] = buffer[cellOffset + cornerOffsets[corner]] - isoValue;
+            numberOfInsideCorners += (values[corner] > 0.0);
+          }
+
+          if (numberOfInsideCorners == 0 || numberOfInsideCorners == 8)
+          {
+            continue;
+          }
+
+          const VectorType cellPosition = steps[0] * static_cast<double>(x - lower[0]) +
+                                          steps[1] * static_cast<double>(y - lower[1]) +
+                                          steps[2] * static_cast<double>(z - lower[2]);
+
+          // Point on the edge between two corners of the cell.
+          auto edgePoint = [&](unsigned int corner1, unsigned int corner2) {
+            const unsigned int    lowerCorner = corner1 & corner2;
+            const unsigned int    upperCorner = corner1 | corner2;
+            const OffsetValueType key = (cellOffset + cornerOffsets[lowerCorner]) * 8 + (lowerCorner ^ upperCorner);
+
+            const auto found = pointIds.find(key);
+            if (found != pointIds.end())
+            {
+              return found->second;
+            }
+
+            const double t = values[lowerCorner] / (values[lowerCorner] - values[upperCorner]);
+            slab.Points.push_back(cellPosition + cornerPositions[lowerCorner] +
+                                  (cornerPositions[upperCorner] - cornerPositions[lowerCorner]) * t);
+            slab.PointKeys.push_back(key);
+            if (upperCorner & 4)
+            {
+              slab.PointPlanes.push_back((lowerCorner & 4) ? UpperPlane : InsideSlab);
+            }
+            else
+            {
+              slab.PointPlanes.push_back(LowerPlane);
+            }
+
+            const IdentifierType pointId = slab.Points.size() - 1;
+            pointIds.emplace(key, pointId);
+            return pointId;
+          };
+
+          for (const auto & tetrahedron : tetrahedra)
+          {
+            unsigned int inside[4];
+            unsigned int outside[4];
+            unsigned int numberOfInside = 0;
+            unsigned int numberOfOutside = 0;
+            for (const unsigned int corner : tetrahedron)
+            {
+              if (values[corner] > 0.0)
+              {
+                inside[numberOfInside++] = corner;
+              }
+              else
+              {
+                outside[numberOfOutside++] = corner;
+              }
+            }
+
+            if (numberOfInside == 0 || numberOfInside == 4)
+            {
+              continue;
+            }
+
+            IdentifierType triangles[2][3];
+            unsigned int   numberOfTriangles = 1;
+            switch (numberOfInside)
+            {
+              case 1:
+                triangles[0][0] = edgePoint(inside[0], outside[0]);
+                triangles[0][1] = edgePoint(inside[0], outside[1]);
+                triangles[0][2] = edgePoint(inside[0], outside[2]);
+                break;
+              case 3:
+                triangles[0][0] = edgePoint(inside[0], outside[0]);
+                triangles[0][1] = edgePoint(inside[1], outside[0]);
+                triangles[0][2] = edgePoint(inside[2], outside[0]);
+                break;
+              default:
+              {
+                const IdentifierType quadrilateral[4] = { edgePoint(inside[0], outside[0]),
+                                                          edgePoint(inside[0], outside[1]),
+                                                          edgePoint(inside[1], outside[1]),
+                                                          edgePoint(inside[1], outside[0]) };
+                triangles[0][0] = quadrilateral[0];
+                triangles[0][1] = quadrilateral[1];
+                triangles[0][2] = quadrilateral[2];
+                triangles[1][0] = quadrilateral[0];
+                triangles[1][1] = quadrilateral[2];
+                triangles[1][2] = quadrilateral[3];
+                numberOfTriangles = 2;
+                break;
+              }
+            }
+
+            // Orient the normals away from the inside corners.
+            const VectorType insidePosition = cellPosition + cornerPositions[inside[0]];
+            for (unsigned int i = 0; i < numberOfTriangles; ++i)
+            {
+              const VectorType & p0 = slab.Points[triangles[i][0]];
+              const VectorType & p1 = slab.Points[triangles[i][1]];
+              const VectorType & p2 = slab.Points[triangles[i][2]];
+              if (CrossProduct(p1 - p0, p2 - p0) * (insidePosition - p0) > 0.0)
+              {
+                std::swap(triangles[i][0], triangles[i][1]);
+              }
+              slab.Triangles.insert(slab.Triangles.end(), triangles[i], triangles[i] + 3);
+            }
+          }
+        }
+      }
+    },
+    nullptr);
+
+  //
+  // Combine the slabs in order, merging the points on the plane between two
+  // slabs.
+  //
+  SizeValueType numberOfPoints = 0;
+  for (const SlabType & slab : slabs)
+  {
+    numberOfPoints += slab.Points.size();
+  }
+
+  std::vector<MeshPointType> meshPoints;
+  meshPoints.reserve(numberOfPoints);
+
+  std::unordered_map<OffsetValueType, IdentifierType> upperPlanePointIds;
+  std::unordered_map<OffsetValueType, IdentifierType> previousUpperPlanePointIds;
+  std::vector<IdentifierType>                         slabPointIds;
+
+  IdentifierType cellId = 0;
+
+  for (const SlabType & slab : slabs)
+  {
+    slabPointIds.resize(slab.Points.size());
+    upperPlanePointIds.clear();
+
+    for (size_t i = 0; i < slab.Points.size(); ++i)
+    {
+      if (slab.PointPlanes[i] == LowerPlane)
+      {
+        const auto found = previousUpperPlanePointIds.find(slab.PointKeys[i]);
+        if (found != previousUpperPlanePointIds.end())
+        {
+          slabPointIds[i] = found->second;
+          continue;
+        }
+      }
+
+      MeshPointType point;
+      for (unsigned int d = 0; d < ImageDimension; ++d)
+      {
+        point[d] = referencePoint[d] + slab.Points[i][d];
+      }
+      slabPointIds[i] = meshPoints.size();
+      meshPoints.push_back(point);
+
+      if (slab.PointPlanes[i] == UpperPlane)
+      {
+        upperPlanePointIds.emplace(slab.PointKeys[i], slabPointIds[i]);
+      }
+    }
+
+    for (size_t i = 0; i < slab.Triangles.size(); i += 3)
+    {
+      CellAutoPointer cell;
+      cell.TakeOwnership(new TriangleCellType);
+      for (unsigned int j = 0; j < 3; ++j)
+      {
+        cell->SetPointId(j, slabPointIds[slab.Triangles[i + j]]);
+      }
+      outputMesh->SetCell(cellId++, cell);
+    }
+
+    std::swap(upperPlanePointIds, previousUpperPlanePointIds);
+  }
+
+  typename OutputMeshType::PointsContainer::Pointer points = OutputMeshType::PointsContainer::New();
+  points->Reserve(meshPoints.size());
+  for (size_t i = 0; i < meshPoints.size(); ++i)
+  {
+    points->SetElement(i, meshPoints[i]);
+  }
+  outputMesh->SetPoints(points);
+
+  itkDebugMacro("Extracted " << meshPoints.size() << " points and " << cellId << " triangles");
+}
+
+} // end namespace itk
+
+#endif
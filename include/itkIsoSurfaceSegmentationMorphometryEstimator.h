@@ -0,0 +1,179 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkIsoSurfaceSegmentationMorphometryEstimator_h
+#define itkIsoSurfaceSegmentationMorphometryEstimator_h
+
+#include "itkIsoSurfaceSegmentationVolumeEstimator.h"
+#include "itkMath.h"
+#include "itkMatrix.h"
+#include "itkPoint.h"
+#include "itkVector.h"
+
+namespace itk
+{
+
+/** \class IsoSurfaceSegmentationMorphometryEstimator
+ * \brief Class for measuring the shape of a segmentation stored in a
+ * SpatialObject that carries a level set image of pixel type float.
+ *
+ * The segmentation is the region where the level set is larger than the
+ * IsoValue, as in the IsoSurfaceSegmentationVolumeEstimator. The cells of the
+ * image are split in the same six tetrahedra, and a single parallel
+ * traversal of the cells computes:
+ *
+ *   - the volume,
+ *   - the area of the iso-surface,
+ *   - the centroid of the segmentation,
+ *   - its bounding box,
+ *   - its principal moments, the eigenvalues of the covariance of the
+ *     positions in the segmentation, and the principal axes,
+ *   - its maximum diameter, the largest distance between two points of the
+ *     iso-surface,
+ *   - its sphericity, the ratio of the area of the sphere of same volume to
+ *     the area of the iso-surface.
+ *
+ * The volume and the moments are integrated in closed form on the inside part
+ * of each tetrahedron, and the area on the iso-surface polygons of the
+ * tetrahedra, without building a mesh. The maximum diameter is computed
+ * between the extreme points of the iso-surface along 128 directions, and
+ * underestimates the exact diameter by a fraction of a percent at most.
+ *
+ * All the measures are in physical units, and the GetVolume() of the
+ * superclass returns the volume as well. The results do not depend on the
+ * number of threads.
+ *
+ * \ingroup SpatialObjectFilters
+ * \ingroup LesionSizingToolkit
+ */
+template <unsigned int NDimension>
+class ITK_TEMPLATE_EXPORT IsoSurfaceSegmentationMorphometryEstimator
+  : public IsoSurfaceSegmentationVolumeEstimator<NDimension>
+{
+public:
+  ITK_DISALLOW_COPY_AND_MOVE(IsoSurfaceSegmentationMorphometryEstimator);
+
+  /** Standard class type alias. */
+  using Self = IsoSurfaceSegmentationMorphometryEstimator;
+  using Superclass = IsoSurfaceSegmentationVolumeEstimator<NDimension>;
+  using Pointer = SmartPointer<Self>;
+  using ConstPointer = SmartPointer<const Self>;
+  using RealObjectType = typename Superclass::RealObjectType;
+
+  /** Method for constructing new instances of this class. */
+  itkNewMacro(Self);
+
+  /** Run-time type information (and related methods). */
+  itkOverrideGetNameOfClassMacro(IsoSurfaceSegmentationMorphometryEstimator);
+
+  /** Dimension of the space */
+  static constexpr unsigned int Dimension = NDimension;
+
+  /** Required type of the input */
+  using InputPixelType = typename Superclass::InputPixelType;
+  using InputImageSpatialObjectType = typename Superclass::InputImageSpatialObjectType;
+  using InputImageType = typename Superclass::InputImageType;
+
+  using PointType = Point<double, NDimension>;
+  using VectorType = Vector<double, NDimension>;
+  using MatrixType = Matrix<double, NDimension, NDimension>;
+
+  /** Measures of the segmentation. */
+  struct MorphometryType
+  {
+    double     Volume{ 0.0 };
+    double     SurfaceArea{ 0.0 };
+    PointType  Centroid{};
+    PointType  BoundingBoxMinimum{};
+    PointType  BoundingBoxMaximum{};
+    VectorType PrincipalMoments{}; // In increasing order
+    MatrixType PrincipalAxes{};    // One axis per row
+    double     MaximumDiameter{ 0.0 };
+    double     Sphericity{ 0.0 };
+
+    bool
+    operator==(const MorphometryType & other) const
+    {
+      return Math::ExactlyEquals(Volume, other.Volume) && Math::ExactlyEquals(SurfaceArea, other.SurfaceArea) &&
+             Centroid == other.Centroid && BoundingBoxMinimum == other.BoundingBoxMinimum &&
+             BoundingBoxMaximum == other.BoundingBoxMaximum && PrincipalMoments == other.PrincipalMoments &&
+             PrincipalAxes == other.PrincipalAxes && Math::ExactlyEquals(MaximumDiameter, other.MaximumDiameter) &&
+             Math::ExactlyEquals(Sphericity, other.Sphericity);
+    }
+
+    bool
+    operator!=(const MorphometryType & other) const
+    {
+      return !(*this == other);
+    }
+  };
+
+  /** Type of DataObject used for the measures */
+  using MorphometryObjectType = SimpleDataObjectDecorator<MorphometryType>;
+
+  /** Return the measures of the segmentation. */
+  const MorphometryType &
+  GetMorphometry() const;
+  const MorphometryObjectType *
+  GetMorphometryOutput() const;
+
+protected:
+  IsoSurfaceSegmentationMorphometryEstimator();
+  ~IsoSurfaceSegmentationMorphometryEstimator() override;
+
+  void
+  PrintSelf(std::ostream & os, Indent indent) const override;
+
+  /** Method invoked by the pipeline in order to trigger the computation of
+   * the segmentation. */
+  void
+  GenerateData() override;
+
+private:
+  static constexpr unsigned int NumberOfDiameterDirections = 128;
+
+  /** Integrals accumulated over the cells of a slice. The positions are
+   * relative to the first cell of the traversal. */
+  struct AccumulatorType
+  {
+    double     Volume{ 0.0 };
+    VectorType FirstMoment{};
+    MatrixType SecondMoment{};
+    double     SurfaceArea{ 0.0 };
+    VectorType BoundingBoxMinimum{};
+    VectorType BoundingBoxMaximum{};
+    double     MinimumProjection[NumberOfDiameterDirections];
+    double     MaximumProjection[NumberOfDiameterDirections];
+    VectorType MinimumPoint[NumberOfDiameterDirections];
+    VectorType MaximumPoint[NumberOfDiameterDirections];
+  };
+
+  /** Add the integrals of the inside part of a tetrahedron. */
+  static void
+  AccumulateTetrahedron(const VectorType  vertices[4],
+                        const double      values[4],
+                        const VectorType  directions[],
+                        AccumulatorType & accumulator);
+};
+
+} // end namespace itk
+
+#ifndef ITK_MANUAL_INSTANTIATION
+#  include "itkIsoSurfaceSegmentationMorphometryEstimator.hxx"
+#endif
+
+#endif
@@ -0,0 +1,494 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkIsoSurfaceSegmentationMorphometryEstimator_hxx
+#define itkIsoSurfaceSegmentationMorphometryEstimator_hxx
+
+#include "itkMultiThreaderBase.h"
+#include "itkSymmetricEigenAnalysis.h"
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+
+namespace itk
+{
+
+/**
+ * Constructor
+ */
+template <unsigned int NDimension>
+IsoSurfaceSegmentationMorphometryEstimator<NDimension>::IsoSurfaceSegmentationMorphometryEstimator()
+{
+  this->SetNumberOfRequiredOutputs(2); // for the Volume and the Morphometry
+
+  MorphometryType morphometry;
+  morphometry.Centroid.Fill(0.0);
+  morphometry.BoundingBoxMinimum.Fill(0.0);
+  morphometry.BoundingBoxMaximum.Fill(0.0);
+  morphometry.PrincipalMoments.Fill(0.0);
+  morphometry.PrincipalAxes.SetIdentity();
+
+  typename MorphometryObjectType::Pointer output = MorphometryObjectType::New();
+  output->Set(morphometry);
+  this->ProcessObject::SetNthOutput(1, output.GetPointer());
+}
+
+
+/**
+ * Destructor
+ */
+template <unsigned int NDimension>
+IsoSurfaceSegmentationMorphometryEstimator<NDimension>::~IsoSurfaceSegmentationMorphometryEstimator() = default;
+
+
+/**
+ * Return the measures of the segmentation
+ */
+template <unsigned int NDimension>
+const typename IsoSurfaceSegmentationMorphometryEstimator<NDimension>::MorphometryType &
+IsoSurfaceSegmentationMorphometryEstimator<NDimension>::GetMorphometry() const
+{
+  return this->GetMorphometryOutput()->Get();
+}
+
+
+/**
+ * Return the measures of the segmentation stored in a DataObject decorator
+ * that can be passed down a pipeline.
+ */
+template <unsigned int NDimension>
+const typename IsoSurfaceSegmentationMorphometryEstimator<NDimension>::MorphometryObjectType *
+IsoSurfaceSegmentationMorphometryEstimator<NDimension>::GetMorphometryOutput() const
+{
+  return static_cast<const MorphometryObjectType *>(this->ProcessObject::GetOutput(1));
+}
+
+
+/**
+ * PrintSelf
+ */
+template <unsigned int NDimension>
+void
+IsoSurfaceSegmentationMorphometryEstimator<NDimension>::PrintSelf(std::ostream & os, Indent indent) const
+{
+  Superclass::PrintSelf(os, indent);
+
+  const MorphometryType & morphometry = this->GetMorphometry();
+  os << indent << "Volume = " << morphometry.Volume << std::endl;
+  os << indent << "SurfaceArea = " << morphometry.SurfaceArea << std::endl;
+  os << indent << "Centroid = " << morphometry.Centroid << std::endl;
+  os << indent << "BoundingBoxMinimum = " << morphometry.BoundingBoxMinimum << std::endl;
+  os << indent << "BoundingBoxMaximum = " << morphometry.BoundingBoxMaximum << std::endl;
+  os << indent << "PrincipalMoments = " << morphometry.PrincipalMoments << std::endl;
+  os << indent << "PrincipalAxes = " << std::endl << morphometry.PrincipalAxes;
+  os << indent << "MaximumDiameter = " << morphometry.MaximumDiameter << std::endl;
+  os << indent << "Sphericity = " << morphometry.Sphericity << std::endl;
+}
+
+
+/**
+ * Integrals of the inside part of a tetrahedron
+ */
+template <unsigned int NDimension>
+void
+IsoSurfaceSegmentationMorphometryEstimator<NDimension>::AccumulateTetrahedron(const VectorType  vertices[4],
+                                                                              const double      values[4],
+                                                                              const VectorType  directions[],
+                                                                              AccumulatorType & accumulator)
+{
+  unsigned int inside[4];
+  unsigned int outside[4];
+  unsigned int numberOfInside = 0;
+  unsigned int numberOfOutside = 0;
+  for (unsigned int i = 0; i < 4; ++i)
+  {
+    if (values[i] > 0.0)
+    {
+      inside[numberOfInside++] = i;
+    }
+    else
+    {
+      outside[numberOfOutside++] = i;
+    }
+  }
+
+  if (numberOfInside == 0)
+  {
+    return;
+  }
+
+  auto addToBoundingBox = [&accumulator](const VectorType & point) {
+    for (unsigned int d = 0; d < Dimension; ++d)
+    {
+      accumulator.BoundingBoxMinimum[d] = std::min(accumulator.BoundingBoxMinimum[d], point[d]);
+      accumulator.BoundingBoxMaximum[d] = std::max(accumulator.BoundingBoxMaximum[d], point[d]);
+    }
+  };
+
+  // Volume, first and second moments of a tetrahedron, added with a sign.
+  auto addTetrahedron = [&accumulator](const VectorType & p0,
+                                       const VectorType & p1,
+                                       const VectorType & p2,
+                                       const VectorType & p3,
+                                       double             sign) {
+    const VectorType u = p1 - p0;
+    const VectorType v = p2 - p0;
+    const VectorType w = p3 - p0;
+    const double     determinant =
+      u[0] * (v[1] * w[2] - v[2] * w[1]) - u[1] * (v[0] * w[2] - v[2] * w[0]) + u[2] * (v[0] * w[1] - v[1] * w[0]);
+    const double     volume = sign * itk::Math::abs(determinant) / 6.0;
+    const VectorType sum = p0 + p1 + p2 + p3;
+
+    accumulator.Volume += volume;
+    accumulator.FirstMoment += sum * (volume / 4.0);
+    for (unsigned int i = 0; i < Dimension; ++i)
+    {
+      for (unsigned int j = 0; j < Dimension; ++j)
+      {
+        accumulator.SecondMoment(i, j) +=
+          volume / 20.0 * (p0[i] * p0[j] + p1[i] * p1[j] + p2[i] * p2[j] + p3[i] * p3[j] + sum[i] * sum[j]);
+      }
+    }
+  };
+
+  auto addTriangle = [&accumulator](const VectorType & p0, const VectorType & p1, const VectorType & p2) {
+    accumulator.SurfaceArea += 0.5 * CrossProduct(p1 - p0, p2 - p0).GetNorm();
+  };
+
+  for (unsigned int i = 0; i < numberOfInside; ++i)
+  {
+    addToBoundingBox(vertices[inside[i]]);
+  }
+
+  if (numberOfInside == 4)
+  {
+    addTetrahedron(vertices[0], vertices[1], vertices[2], vertices[3], 1.0);
+    return;
+  }
+
+  //
+  // Points of the iso-surface on the edges between the inside and the outside
+  // vertices.
+  //
+  VectorType edgePoints[3][3];
+  for (unsigned int i = 0; i < numberOfInside; ++i)
+  {
+    for (unsigned int j = 0; j < numberOfOutside; ++j)
+    {
+      const VectorType & a = vertices[inside[i]];
+      const VectorType & b = vertices[outside[j]];
+      const double       t = values[inside[i]] / (values[inside[i]] - values[outside[j]]);
+      const VectorType   point = a + (b - a) * t;
+
+      edgePoints[i][j] = point;
+      addToBoundingBox(point);
+
+      for (unsigned int k = 0; k < NumberOfDiameterDirections; ++k)
+      {
+        const double projection = point * directions[k];
+        if (projection < accumulator.MinimumProjection[k])
+        {
+          accumulator.MinimumProjection[k] = projection;
+          accumulator.MinimumPoint[k] = point;
+        }
+        if (projection > accumulator.MaximumProjection[k])
+        {
+          accumulator.MaximumProjection[k] = projection;
+          accumulator.MaximumPoint[k] = point;
+        }
+      }
+    }
+  }
+
+  switch (numberOfInside)
+  {
+    case 1:
+      // Tetrahedron cut at the inside vertex.
+      addTetrahedron(vertices[inside[0]], edgePoints[0][0], edgePoints[0][1], edgePoints[0][2], 1.0);
+      addTriangle(edgePoints[0][0], edgePoints[0][1], edgePoints[0][2]);
+      break;
+    case 3:
+      // Complement of the tetrahedron cut at the outside vertex.
+      addTetrahedron(vertices[0], vertices[1], vertices[2], vertices[3], 1.0);
+      addTetrahedron(vertices[outside[0]], edgePoints[0][0], edgePoints[1][0], edgePoints[2][0], -1.0);
+      addTriangle(edgePoints[0][0], edgePoints[1][0], edgePoints[2][0]);
+      break;
+    default:
+      // Wedge, split in the three tetrahedra joining the first inside vertex
+      // to the faces that do not contain it. The iso-surface is a
+      // quadrilateral.
+      addTetrahedron(vertices[inside[0]], vertices[inside[1]], edgePoints[1][0], edgePoints[1][1], 1.0);
+      addTetrahedron(vertices[inside[0]], edgePoints[0][0], edgePoints[0][1], edgePoints[1][1], 1.0);
+      addTetrahedron(vertices[inside[0]], edgePoints[0][0], edgePoints[1][1], edgePoints[1][0], 1.0);
+      addTriangle(edgePoints[0][0], edgePoints[0][1], edgePoints[1][1]);
+      addTriangle(edgePoints[0][0], edgePoints[1][1], edgePoints[1][0]);
+      break;
+  }
+}
+
+
+/*
+ * Generate Data
+ */
+template <unsigned int NDimension>
+void
+IsoSurfaceSegmentationMorphometryEstimator<NDimension>::GenerateData()
+{
+  const InputImageType * inputImage = this->GetInputImage();
+
+  auto * volumeCarrier = static_cast<RealObjectType *>(this->ProcessObject::GetOutput(0));
+  auto * morphometryCarrier = static_cast<MorphometryObjectType *>(this->ProcessObject::GetOutput(1));
+
+  MorphometryType morphometry;
+  morphometry.Centroid.Fill(0.0);
+  morphometry.BoundingBoxMinimum.Fill(0.0);
+  morphometry.BoundingBoxMaximum.Fill(0.0);
+  morphometry.PrincipalMoments.Fill(0.0);
+  morphometry.PrincipalAxes.SetIdentity();
+
+  OffsetValueType lower[3];
+  OffsetValueType upper[3];
+  if (!this->ComputeInsideCellBounds(inputImage, lower, upper))
+  {
+    volumeCarrier->Set(0.0);
+    morphometryCarrier->Set(morphometry);
+    return;
+  }
+
+  const InputPixelType *  buffer = inputImage->GetBufferPointer();
+  const OffsetValueType * offsetTable = inputImage->GetOffsetTable();
+  const double            isoValue = this->GetIsoValue();
+
+  //
+  // Positions are computed relative to the lowest corner of the first cell,
+  // to keep the moments accurate far from the origin.
+  //
+  typename InputImageType::IndexType referenceIndex = inputImage->GetBufferedRegion().GetIndex();
+  for (unsigned int d = 0; d < Dimension; ++d)
+  {
+    referenceIndex[d] += lower[d];
+  }
+  PointType referencePoint;
+  inputImage->TransformIndexToPhysicalPoint(referenceIndex, referencePoint);
+
+  // Physical steps along the axes of the image.
+  VectorType steps[3];
+  for (unsigned int axis = 0; axis < Dimension; ++axis)
+  {
+    for (unsigned int d = 0; d < Dimension; ++d)
+    {
+      steps[axis][d] = inputImage->GetDirection()(d, axis) * inputImage->GetSpacing()[axis];
+    }
+  }
+
+  // Offsets and positions of the corners of a cell, the bits of the corner
+  // number being the x, y and z steps.
+  OffsetValueType cornerOffsets[8];
+  VectorType      cornerPositions[8];
+  for (unsigned int corner = 0; corner < 8; ++corner)
+  {
+    cornerOffsets[corner] = 0;
+    cornerPositions[corner].Fill(0.0);
+    for (unsigned int axis = 0; axis < Dimension; ++axis)
+    {
+      if (corner & (1u << axis))
+      {
+        cornerOffsets[corner] += offsetTable[axis];
+        cornerPositions[corner] += steps[axis];
+      }
+    }
+  }
+
+  // Corners of the six tetrahedra of the cell, as in the superclass.
+  static constexpr unsigned int tetrahedra[6][4] = { { 0, 1, 3, 7 }, { 0, 1, 5, 7 }, { 0, 2, 3, 7 },
+                                                     { 0, 2, 6, 7 }, { 0, 4, 5, 7 }, { 0, 4, 6, 7 } };
+
+  // Directions spread over a half sphere, along which the extreme points of
+  // the iso-surface are searched for the maximum diameter.
+  VectorType directions[NumberOfDiameterDirections];
+  for (unsigned int k = 0; k < NumberOfDiameterDirections; ++k)
+  {
+    const double z = 1.0 - (k + 0.5) / NumberOfDiameterDirections;
+    const double radius = std::sqrt(1.0 - z * z);
+    const double angle = k * itk::Math::pi * (3.0 - std::sqrt(5.0));
+    directions[k][0] = radius * std::cos(angle);
+    directions[k][1] = radius * std::sin(angle);
+    directions[k][2] = z;
+  }
+
+  auto initializeAccumulator = [](AccumulatorType & accumulator) {
+    accumulator.Volume = 0.0;
+    accumulator.FirstMoment.Fill(0.0);
+    accumulator.SecondMoment.Fill(0.0);
+    accumulator.SurfaceArea = 0.0;
+    accumulator.BoundingBoxMinimum.Fill(NumericTraits<double>::max());
+    accumulator.BoundingBoxMaximum.Fill(NumericTraits<double>::NonpositiveMin());
+    for (unsigned int k = 0; k < NumberOfDiameterDirections; ++k)
+    {
+      accumulator.MinimumProjection[k] = NumericTraits<double>::max();
+      accumulator.MaximumProjection[k] = NumericTraits<double>::NonpositiveMin();
+      accumulator.MinimumPoint[k].Fill(0.0);
+      accumulator.MaximumPoint[k].Fill(0.0);
+    }
+  };
+
+  const SizeValueType          numberOfSlices = upper[2] - lower[2] + 1;
+  std::vector<AccumulatorType> sliceAccumulators(numberOfSlices);
+
+  this->GetMultiThreader()->ParallelizeArray(
+    0,
+    numberOfSlices,
+    [&](SizeValueType sliceNumber) {
+      AccumulatorType & accumulator = sliceAccumulators[sliceNumber];
+      initializeAccumulator(accumulator);
+
+      const OffsetValueType z = lower[2] + static_cast<OffsetValueType>(sliceNumber);
+      for (OffsetValueType y = lower[1]; y <= upper[1]; ++y)
+      {
+        const InputPixelType * line = buffer + z * offsetTable[2] + y * offsetTable[1];
+        for (OffsetValueType x = lower[0]; x <= upper[0]; ++x)
+        {
+          const InputPixelType * cell = line + x;
+
+          double       values[8];
+          unsigned int numberOfInsideCorners = 0;
+          for (unsigned int corner = 0; corner < 8; ++corner)
+          {
+            values[corner] = cell[cornerOffsets[corner]] - isoValue;
+            numberOfInsideCorners += (values[corner] > 0.0);
+          }
+
+          if (numberOfInsideCorners == 0)
+          {
+            continue;
+          }
+
+          const VectorType cellPosition = steps[0] * static_cast<double>(x - lower[0]) +
+                                          steps[1] * static_cast<double>(y - lower[1]) +
+                                          steps[2] * static_cast<double>(z - lower[2]);
+
+          for (const auto & tetrahedron : tetrahedra)
+          {
+            const VectorType vertices[4] = { cellPosition + cornerPositions[tetrahedron[0]],
+                                             cellPosition + cornerPositions[tetrahedron[1]],
+                                             cellPosition + cornerPositions[tetrahedron[2]],
+                                             cellPosition + cornerPositions[tetrahedron[3]] };
+            const double     tetrahedronValues[4] = {
+              values[tetrahedron[0]], values[tetrahedron[1]], values[tetrahedron[2]], values[tetrahedron[3]]
+            };
+            Self::AccumulateTetrahedron(vertices, tetrahedronValues, directions, accumulator);
+          }
+        }
+      }
+    },
+    nullptr);
+
+  //
+  // Combine the slices in order, so that the results do not depend on the
+  // number of threads.
+  //
+  AccumulatorType total;
+  initializeAccumulator(total);
+
+  for (const AccumulatorType & accumulator : sliceAccumulators)
+  {
+    total.Volume += accumulator.Volume;
+    total.FirstMoment += accumulator.FirstMoment;
+    total.SecondMoment += accumulator.SecondMoment;
+    total.SurfaceArea += accumulator.SurfaceArea;
+    for (unsigned int d = 0; d < Dimension; ++d)
+    {
+      total.BoundingBoxMinimum[d] = std::min(total.BoundingBoxMinimum[d], accumulator.BoundingBoxMinimum[d]);
+      total.BoundingBoxMaximum[d] = std::max(total.BoundingBoxMaximum[d], accumulator.BoundingBoxMaximum[d]);
+    }
+    for (unsigned int k = 0; k < NumberOfDiameterDirections; ++k)
+    {
+      if (accumulator.MinimumProjection[k] < total.MinimumProjection[k])
+      {
+        total.MinimumProjection[k] = accumulator.MinimumProjection[k];
+        total.MinimumPoint[k] = accumulator.MinimumPoint[k];
+      }
+      if (accumulator.MaximumProjection[k] > total.MaximumProjection[k])
+      {
+        total.MaximumProjection[k] = accumulator.MaximumProjection[k];
+        total.MaximumPoint[k] = accumulator.MaximumPoint[k];
+      }
+    }
+  }
+
+  morphometry.Volume = total.Volume;
+  morphometry.SurfaceArea = total.SurfaceArea;
+
+  if (total.Volume > 0.0)
+  {
+    const VectorType centroid = total.FirstMoment / total.Volume;
+
+    MatrixType covariance;
+    for (unsigned int i = 0; i < Dimension; ++i)
+    {
+      for (unsigned int j = 0; j < Dimension; ++j)
+      {
+        covariance(i, j) = total.SecondMoment(i, j) / total.Volume - centroid[i] * centroid[j];
+      }
+    }
+
+    using EigenAnalysisType = SymmetricEigenAnalysis<MatrixType, VectorType, MatrixType>;
+    EigenAnalysisType eigenAnalysis(Dimension);
+    eigenAnalysis.SetOrderEigenValues(true);
+    eigenAnalysis.ComputeEigenValuesAndVectors(covariance, morphometry.PrincipalMoments, morphometry.PrincipalAxes);
+
+    morphometry.Centroid = referencePoint + centroid;
+    morphometry.BoundingBoxMinimum = referencePoint + total.BoundingBoxMinimum;
+    morphometry.BoundingBoxMaximum = referencePoint + total.BoundingBoxMaximum;
+  }
+
+  // Largest distance between the extreme points of the iso-surface.
+  std::vector<VectorType> extremePoints;
+  for (unsigned int k = 0; k < NumberOfDiameterDirections; ++k)
+  {
+    if (total.MinimumProjection[k] <= total.MaximumProjection[k])
+    {
+      extremePoints.push_back(total.MinimumPoint[k]);
+      extremePoints.push_back(total.MaximumPoint[k]);
+    }
+  }
+
+  double squaredDiameter = 0.0;
+  for (size_t i = 0; i < extremePoints.size(); ++i)
+  {
+    for (size_t j = i + 1; j < extremePoints.size(); ++j)
+    {
+      squaredDiameter = std::max(squaredDiameter, (extremePoints[i] - extremePoints[j]).GetSquaredNorm());
+    }
+  }
+  morphometry.MaximumDiameter = std::sqrt(squaredDiameter);
+
+  if (morphometry.SurfaceArea > 0.0)
+  {
+    morphometry.Sphericity =
+      std::cbrt(itk::Math::pi) * std::pow(6.0 * morphometry.Volume, 2.0 / 3.0) / morphometry.SurfaceArea;
+  }
+
+  volumeCarrier->Set(morphometry.Volume);
+  morphometryCarrier->Set(morphometry);
+}
+
+} // end namespace itk
+
+#endif
@@ -0,0 +1,127 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkIsoSurfaceSegmentationVolumeEstimator_h
+#define itkIsoSurfaceSegmentationVolumeEstimator_h
+
+#include "itkSegmentationVolumeEstimator.h"
+
+namespace itk
+{
+
+/** \class IsoSurfaceSegmentationVolumeEstimator
+ * \brief Class for estimating the volume of a segmentation stored in a
+ * SpatialObject that carries a level set image of pixel type float. The
+ * volume is the one enclosed by the iso-surface of the level set at the
+ * IsoValue, the segmentation being the region where the level set is larger
+ * than the IsoValue.
+ *
+ * The volume is integrated cell by cell, a cell being the cube between eight
+ * neighboring pixels, without building the iso-surface. Each cell is split in
+ * six tetrahedra, in which the level set is linearly interpolated, and the
+ * volume of the part of each tetrahedron that is inside the iso-surface is
+ * computed in closed form. The result is the volume enclosed by the
+ * triangulated iso-surface of marching tetrahedra, and is within a fraction of
+ * a percent of the volume of the marching cubes surface computed with VTK for
+ * smooth segmentations.
+ *
+ * Only the cells within the bounding box of the pixels inside the
+ * segmentation are visited, and they are visited in parallel. The result
+ * does not depend on the number of threads.
+ *
+ * The default IsoValue of -0.5 is the one of the surfaces generated from the
+ * output of the LesionSegmentationImageFilter8.
+ *
+ * \ingroup SpatialObjectFilters
+ * \ingroup LesionSizingToolkit
+ */
+template <unsigned int NDimension>
+class ITK_TEMPLATE_EXPORT IsoSurfaceSegmentationVolumeEstimator : public SegmentationVolumeEstimator<NDimension>
+{
+public:
+  ITK_DISALLOW_COPY_AND_MOVE(IsoSurfaceSegmentationVolumeEstimator);
+
+  /** Standard class type alias. */
+  using Self = IsoSurfaceSegmentationVolumeEstimator;
+  using Superclass = SegmentationVolumeEstimator<NDimension>;
+  using Pointer = SmartPointer<Self>;
+  using ConstPointer = SmartPointer<const Self>;
+  using RealObjectType = typename Superclass::RealObjectType;
+
+  /** Method for constructing new instances of this class. */
+  itkNewMacro(Self);
+
+  /** Run-time type information (and related methods). */
+  itkOverrideGetNameOfClassMacro(IsoSurfaceSegmentationVolumeEstimator);
+
+  /** Dimension of the space */
+  static constexpr unsigned int Dimension = NDimension;
+  static_assert(Dimension == 3, "The iso-surface volume is only computed in three dimensions.");
+
+  /** Type of spatialObject that will be passed as input and output of this
+   * segmentation method. */
+  using SpatialObjectType = typename Superclass::SpatialObjectType;
+  using SpatialObjectPointer = typename Superclass::SpatialObjectPointer;
+  using SpatialObjectConstPointer = typename Superclass::SpatialObjectConstPointer;
+
+  /** Required type of the input */
+  using InputPixelType = float;
+  using InputImageSpatialObjectType = ImageSpatialObject<NDimension, InputPixelType>;
+  using InputImageType = Image<InputPixelType, NDimension>;
+
+  /** Value of the iso-surface. Defaults to -0.5. */
+  itkSetMacro(IsoValue, double);
+  itkGetConstMacro(IsoValue, double);
+
+protected:
+  IsoSurfaceSegmentationVolumeEstimator();
+  ~IsoSurfaceSegmentationVolumeEstimator() override;
+
+  void
+  PrintSelf(std::ostream & os, Indent indent) const override;
+
+  /** Method invoked by the pipeline in order to trigger the computation of
+   * the segmentation. */
+  void
+  GenerateData() override;
+
+  /** Image of the input spatial object. Throws when it is missing. */
+  const InputImageType *
+  GetInputImage() const;
+
+  /** Bounds, as offsets from the start of the buffered region, of the lowest
+   * corners of the cells that have at least one corner inside the
+   * iso-surface. Returns false when no cell has a corner inside. */
+  bool
+  ComputeInsideCellBounds(const InputImageType * inputImage, OffsetValueType lower[3], OffsetValueType upper[3]);
+
+private:
+  /** Fraction of the volume of a tetrahedron where the linear interpolation
+   * of the values at its vertices, minus the IsoValue, is positive. */
+  static double
+  ComputeInsideTetrahedronFraction(const double values[4]);
+
+  double m_IsoValue;
+};
+
+} // end namespace itk
+
+#ifndef ITK_MANUAL_INSTANTIATION
+#  include "itkIsoSurfaceSegmentationVolumeEstimator.hxx"
+#endif
+
+#endif
@@ -0,0 +1,382 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkIsoSurfaceSegmentationVolumeEstimator_hxx
+#define itkIsoSurfaceSegmentationVolumeEstimator_hxx
+
+#include "itkImageSpatialObject.h"
+#include "itkMath.h"
+#include "itkMultiThreaderBase.h"
+
+#include <algorithm>
+#include <array>
+#include <vector>
+
+
+namespace itk
+{
+
+/**
+ * Constructor
+ */
+template <unsigned int NDimension>
+IsoSurfaceSegmentationVolumeEstimator<NDimension>::IsoSurfaceSegmentationVolumeEstimator()
+{
+  this->m_IsoValue = -0.5;
+}
+
+
+/**
+ * Destructor
+ */
+template <unsigned int NDimension>
+IsoSurfaceSegmentationVolumeEstimator<NDimension>::~IsoSurfaceSegmentationVolumeEstimator() = default;
+
+
+/**
+ * PrintSelf
+ */
+template <unsigned int NDimension>
+void
+IsoSurfaceSegmentationVolumeEstimator<NDimension>::PrintSelf(std::ostream & os, Indent indent) const
+{
+  Superclass::PrintSelf(os, indent);
+  os << indent << "IsoValue = " << this->m_IsoValue << std::endl;
+}
+
+
+/**
+ * Inside fraction of a tetrahedron
+ */
+template <unsigned int NDimension>
+double
+IsoSurfaceSegmentationVolumeEstimator<NDimension>::ComputeInsideTetrahedronFraction(const double values[4])
+{
+  unsigned int inside[4];
+  unsigned int outside[4];
+  unsigned int numberOfInside = 0;
+  unsigned int numberOfOutside = 0;
+  for (unsigned int i = 0; i < 4; ++i)
+  {
+    if (values[i] > 0.0)
+    {
+      inside[numberOfInside++] = i;
+    }
+    else
+    {
+      outside[numberOfOutside++] = i;
+    }
+  }
+
+  // Parameter, from a to b, of the zero crossing on the edge between a vertex
+  // a inside and a vertex b outside.
+  auto crossing = [values](unsigned int a, unsigned int b) { return values[a] / (values[a] - values[b]); };
+
+  switch (numberOfInside)
+  {
+    case 0:
+      return 0.0;
+    case 1:
+      // Tetrahedron cut at the inside vertex.
+      return crossing(inside[0], outside[0]) * crossing(inside[0], outside[1]) * crossing(inside[0], outside[2]);
+    case 3:
+      // Complement of the tetrahedron cut at the outside vertex.
+      return 1.0 - (1.0 - crossing(inside[0], outside[0])) * (1.0 - crossing(inside[1], outside[0])) *
+                     (1.0 - crossing(inside[2], outside[0]));
+    case 4:
+      return 1.0;
+    default:
+      break;
+  }
+
+  //
+  // Two vertices inside: the inside part is a wedge, whose volume is computed
+  // in the reference tetrahedron as the sum of the three tetrahedra joining
+  // the first inside vertex to the faces that do not contain it.
+  //
+  using VectorType = Vector<double, 3>;
+
+  VectorType vertices[4];
+  for (unsigned int i = 0; i < 4; ++i)
+  {
+    vertices[i].Fill(0.0);
+    if (i > 0)
+    {
+      vertices[i][i - 1] = 1.0;
+    }
+  }
+
+  VectorType edgePoints[2][2];
+  for (unsigned int i = 0; i < 2; ++i)
+  {
+    for (unsigned int j = 0; j < 2; ++j)
+    {
+      const double t = crossing(inside[i], outside[j]);
+      edgePoints[i][j] = vertices[inside[i]] + (vertices[outside[j]] - vertices[inside[i]]) * t;
+    }
+  }
+
+  // Six times the volume of a tetrahedron, which is the fraction of the
+  // reference tetrahedron.
+  auto tetrahedronFraction =
+    [](const VectorType & p0, const VectorType & p1, const VectorType & p2, const VectorType & p3) {
+    const VectorType u = p1 - p0;
+    const VectorType v = p2 - p0;
+    const VectorType w = p3 - p0;
+    return itk::Math::abs(u[0] * (v[1] * w[2] - v[2] * w[1]) - u[1] * (v[0] * w[2] - v[2] * w[0]) +
+                          u[2] * (v[0] * w[1] - v[1] * w[0]));
+  };
+
+  const VectorType & apex = vertices[inside[0]];
+
+  return tetrahedronFraction(apex, vertices[inside[1]], edgePoints[1][0], edgePoints[1][1]) +
+         tetrahedronFraction(apex, edgePoints[0][0], edgePoints[0][1], edgePoints[1][1]) +
+         tetrahedronFraction(apex, edgePoints[0][0], edgePoints[1][1], edgePoints[1][0]);
+}
+
+
+/**
+ * Input image
+ */
+template <unsigned int NDimension>
+const typename IsoSurfaceSegmentationVolumeEstimator<NDimension>::InputImageType *
+IsoSurfaceSegmentationVolumeEstimator<NDimension>::GetInputImage() const
+{
+  const auto * inputObject = dynamic_cast<const InputImageSpatialObjectType *>(this->ProcessObject::GetInput(0));
+
+  if (!inputObject)
+  {
+    itkExceptionMacro("Missing input spatial object or incorrect type");
+  }
+
+  const InputImageType * inputImage = inputObject->GetImage();
+
+  if (!inputImage)
+  {
+    itkExceptionMacro("Missing input image in the spatial object");
+  }
+
+  return inputImage;
+}
+
+
+/**
+ * Cells with a corner inside
+ */
+template <unsigned int NDimension>
+bool
+IsoSurfaceSegmentationVolumeEstimator<NDimension>::ComputeInsideCellBounds(const InputImageType * inputImage,
+                                                                           OffsetValueType        lower[3],
+                                                                           OffsetValueType        upper[3])
+{
+  using SizeType = typename InputImageType::SizeType;
+
+  const SizeType size = inputImage->GetBufferedRegion().GetSize();
+
+  for (unsigned int d = 0; d < Dimension; ++d)
+  {
+    if (size[d] < 2)
+    {
+      return false;
+    }
+  }
+
+  const InputPixelType *  buffer = inputImage->GetBufferPointer();
+  const OffsetValueType * offsetTable = inputImage->GetOffsetTable();
+  const double            isoValue = this->m_IsoValue;
+
+  //
+  // Bounding box of the inside pixels, slice by slice.
+  //
+  using BoundsType = std::array<OffsetValueType, 4>;
+
+  std::vector<BoundsType>    sliceBounds(size[2]);
+  std::vector<unsigned char> sliceHasInside(size[2], 0);
+
+  this->GetMultiThreader()->ParallelizeArray(
+    0,
+    size[2],
+    [&](SizeValueType z) {
+      BoundsType bounds = { { NumericTraits<OffsetValueType>::max(),
+                              NumericTraits<OffsetValueType>::NonpositiveMin(),
+                              NumericTraits<OffsetValueType>::max(),
+                              NumericTraits<OffsetValueType>::NonpositiveMin() } };
+      const InputPixelType * slice = buffer + z * offsetTable[2];
+      for (OffsetValueType y = 0; y < static_cast<OffsetValueType>(size[1]); ++y)
+      {
+        const InputPixelType * line = slice + y * offsetTable[1];
+        for (OffsetValueType x = 0; x < static_cast<OffsetValueType>(size[0]); ++x)
+        {
+          if (line[x] > isoValue)
+          {
+            bounds[0] = std::min(bounds[0], x);
+            bounds[1] = std::max(bounds[1], x);
+            bounds[2] = std::min(bounds[2], y);
+            bounds[3] = std::max(bounds[3], y);
+          }
+        }
+      }
+      sliceBounds[z] = bounds;
+      sliceHasInside[z] = (bounds[1] >= bounds[0]);
+    },
+    nullptr);
+
+  for (unsigned int d = 0; d < Dimension; ++d)
+  {
+    lower[d] = NumericTraits<OffsetValueType>::max();
+    upper[d] = NumericTraits<OffsetValueType>::NonpositiveMin();
+  }
+
+  for (SizeValueType z = 0; z < size[2]; ++z)
+  {
+    if (sliceHasInside[z])
+    {
+      lower[0] = std::min(lower[0], sliceBounds[z][0]);
+      upper[0] = std::max(upper[0], sliceBounds[z][1]);
+      lower[1] = std::min(lower[1], sliceBounds[z][2]);
+      upper[1] = std::max(upper[1], sliceBounds[z][3]);
+      lower[2] = std::min(lower[2], static_cast<OffsetValueType>(z));
+      upper[2] = std::max(upper[2], static_cast<OffsetValueType>(z));
+    }
+  }
+
+  if (upper[2] < lower[2])
+  {
+    return false;
+  }
+
+  //
+  // Cells, identified by their lowest corner, that have at least one corner
+  // inside.
+  //
+  for (unsigned int d = 0; d < Dimension; ++d)
+  {
+    lower[d] = std::max<OffsetValueType>(lower[d] - 1, 0);
+    upper[d] = std::min<OffsetValueType>(upper[d], static_cast<OffsetValueType>(size[d]) - 2);
+  }
+
+  return true;
+}
+
+
+/*
+ * Generate Data
+ */
+template <unsigned int NDimension>
+void
+IsoSurfaceSegmentationVolumeEstimator<NDimension>::GenerateData()
+{
+  const InputImageType * inputImage = this->GetInputImage();
+
+  auto * outputCarrier = static_cast<RealObjectType *>(this->ProcessObject::GetOutput(0));
+
+  OffsetValueType lower[3];
+  OffsetValueType upper[3];
+  if (!this->ComputeInsideCellBounds(inputImage, lower, upper))
+  {
+    outputCarrier->Set(0.0);
+    return;
+  }
+
+  const InputPixelType *  buffer = inputImage->GetBufferPointer();
+  const OffsetValueType * offsetTable = inputImage->GetOffsetTable();
+  const double            isoValue = this->m_IsoValue;
+
+  // Offsets of the corners of a cell, the bits of the corner number being the
+  // x, y and z steps.
+  OffsetValueType cornerOffsets[8];
+  for (unsigned int corner = 0; corner < 8; ++corner)
+  {
+    cornerOffsets[corner] =
+      ((corner & 1) ? offsetTable[0] : 0) + ((corner & 2) ? offsetTable[1] : 0) + ((corner & 4) ? offsetTable[2] : 0);
+  }
+
+  // Corners of the six tetrahedra of the cell, one per path from the first
+  // to the last corner along the edges of the cell.
+  static constexpr unsigned int tetrahedra[6][4] = { { 0, 1, 3, 7 }, { 0, 1, 5, 7 }, { 0, 2, 3, 7 },
+                                                     { 0, 2, 6, 7 }, { 0, 4, 5, 7 }, { 0, 4, 6, 7 } };
+
+  const SizeValueType numberOfSlices = upper[2] - lower[2] + 1;
+  std::vector<double> sliceVolumes(numberOfSlices, 0.0);
+
+  this->GetMultiThreader()->ParallelizeArray(
+    0,
+    numberOfSlices,
+    [&](SizeValueType sliceNumber) {
+      const OffsetValueType z = lower[2] + static_cast<OffsetValueType>(sliceNumber);
+      double                sliceVolume = 0.0;
+      for (OffsetValueType y = lower[1]; y <= upper[1]; ++y)
+      {
+        const InputPixelType * line = buffer + z * offsetTable[2] + y * offsetTable[1];
+        for (OffsetValueType x = lower[0]; x <= upper[0]; ++x)
+        {
+          const InputPixelType * cell = line + x;
+
+          double       values[8];
+          unsigned int numberOfInsideCorners = 0;
+          for (unsigned int corner = 0; corner < 8; ++corner)
+          {
+            values[corner] = cell[cornerOffsets[corner]] - isoValue;
+            numberOfInsideCorners += (values[corner] > 0.0);
+          }
+
+          if (numberOfInsideCorners == 0)
+          {
+            continue;
+          }
+          if (numberOfInsideCorners == 8)
+          {
+            sliceVolume += 1.0;
+            continue;
+          }
+
+          double cellVolume = 0.0;
+          for (const auto & tetrahedron : tetrahedra)
+          {
+            const double tetrahedronValues[4] = {
+              values[tetrahedron[0]], values[tetrahedron[1]], values[tetrahedron[2]], values[tetrahedron[3]]
+            };
+            cellVolume += Self::ComputeInsideTetrahedronFraction(tetrahedronValues);
+          }
+          sliceVolume += cellVolume / 6.0;
+        }
+      }
+      sliceVolumes[sliceNumber] = sliceVolume;
+    },
+    nullptr);
+
+  // Summed in slice order, so that the volume does not depend on the number
+  // of threads.
+  double numberOfCells = 0.0;
+  for (const double sliceVolume : sliceVolumes)
+  {
+    numberOfCells += sliceVolume;
+  }
+
+  const typename InputImageType::SpacingType spacing = inputImage->GetSpacing();
+
+  //
+  // Deal with eventual cases of negative spacing
+  //
+  const double cellVolume = itk::Math::abs(spacing[0] * spacing[1] * spacing[2]);
+
+  outputCarrier->Set(numberOfCells * cellVolume);
+}
+
+} // end namespace itk
+
+#endif
@@ -27,8 +27,9 @@ namespace itk
 /** \class IsotropicResampler
  * \brief Resamples the image to an isotropic resolution.
  *
- * This class resamples an image using BSplineInterpolator and produces
- * an isotropic image.
+ * This class resamples an image using cubic BSpline interpolation and produces
+ * an isotropic image. The resampling is done with the
+ * SeparableBSplineResampleImageFilter, which interpolates one axis at a time.
  *
  * SpatialObjects are used as inputs and outputs of this class.
  *
@@ -18,9 +18,7 @@
 #ifndef itkIsotropicResampler_hxx
 #define itkIsotropicResampler_hxx
 
-#include "itkResampleImageFilter.h"
-#include "itkIdentityTransform.h"
-#include "itkBSplineInterpolateImageFunction.h"
+#include "itkSeparableBSplineResampleImageFilter.h"
 #include "itkProgressAccumulator.h"
 
 namespace itk
@@ -88,26 +86,10 @@ IsotropicResampler<NDimension>::GenerateData()
   }
 
 
-  using ResampleFilterType = itk::ResampleImageFilter<InputImageType, InputImageType>;
+  using ResampleFilterType = itk::SeparableBSplineResampleImageFilter<InputImageType, InputImageType>;
 
   typename ResampleFilterType::Pointer resampler = ResampleFilterType::New();
 
-  using TransformType = itk::IdentityTransform<double, Dimension>;
-
-  typename TransformType::Pointer transform = TransformType::New();
-  transform->SetIdentity();
-
-  using BSplineInterpolatorType = itk::BSplineInterpolateImageFunction<InputImageType, double>;
-
-  typename BSplineInterpolatorType::Pointer bsplineInterpolator = BSplineInterpolatorType::New();
-
-#if ITK_VERSION_MAJOR > 3 || (ITK_VERSION_MAJOR == 3 && ITK_VERSION_MINOR >= 10)
-  bsplineInterpolator->UseImageDirectionOn();
-#endif
-
-  bsplineInterpolator->SetSplineOrder(3);
-  resampler->SetTransform(transform);
-  resampler->SetInterpolator(bsplineInterpolator);
   resampler->SetDefaultPixelValue(-1024); // Hounsfield Units for Air
 
   const typename InputImageType::SpacingType & inputSpacing = inputImage->GetSpacing();
@@ -121,22 +103,26 @@ IsotropicResampler<NDimension>::GenerateData()
 
   resampler->SetOutputSpacing(outputSpacing);
 
-  resampler->SetOutputOrigin(inputImage->GetOrigin());
-  resampler->SetOutputDirection(inputImage->GetDirection());
-
   using SizeType = typename InputImageType::SizeType;
 
   SizeType inputSize = inputImage->GetLargestPossibleRegion().GetSize();
 
-  const double dx = inputSize[0] * inputSpacing[0] / outputSpacing[0];
-  const double dy = inputSize[1] * inputSpacing[1] / outputSpacing[1];
-  const double dz = inputSize[2] * inputSpacing[2] / outputSpacing[2];
-
+  // Axes along which the spacing is unchanged keep their size, and are
+  // copied by the resampler instead of being interpolated.
   typename InputImageType::SizeType finalSize;
 
-  finalSize[0] = static_cast<SizeValueType>(dx);
-  finalSize[1] = static_cast<SizeValueType>(dy);
-  finalSize[2] = static_cast<SizeValueType>(dz);
+  for (unsigned int i = 0; i < Dimension; i++)
+  {
+    if (itk::Math::ExactlyEquals(outputSpacing[i], inputSpacing[i]))
+    {
+      finalSize[i] = inputSize[i];
+    }
+    else
+    {
+      const double dx = inputSize[i] * inputSpacing[i] / outputSpacing[i];
+      finalSize[i] = static_cast<SizeValueType>(dx);
+    }
+  }
 
   resampler->SetSize(finalSize);
 
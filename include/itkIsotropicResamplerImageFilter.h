@@ -18,9 +18,8 @@
 #ifndef itkIsotropicResamplerImageFilter_h
 #define itkIsotropicResamplerImageFilter_h
 
-#include "itkResampleImageFilter.h"
+#include "itkSeparableBSplineResampleImageFilter.h"
 #include "itkImage.h"
-#include "itkBSplineInterpolateImageFunction.h"
 
 namespace itk
 {
@@ -29,8 +28,9 @@ namespace itk
  *
  * \brief Resamples the image to an isotropic resolution.
  *
- * This class resamples an image using BSplineInterpolator and produces
- * an isotropic image.
+ * This class resamples an image using cubic BSpline interpolation and produces
+ * an isotropic image. The resampling is done with the
+ * SeparableBSplineResampleImageFilter, which interpolates one axis at a time.
  *
  *\ingroup LesionSizingToolkit
  * \ingroup LesionSizingToolkit
@@ -103,11 +103,17 @@ protected:
   void
   GenerateData() override;
 
+  /** Size of the resampled image. Axes along which the spacing is unchanged
+   * keep the size of the input, so that they can be passed through without
+   * interpolation. */
+  SizeType
+  ComputeOutputSize(const InputImageType * inputImage) const;
+
 private:
   ~IsotropicResamplerImageFilter() override = default;
 
   SpacingType m_OutputSpacing;
-  using ResampleFilterType = ResampleImageFilter<TInputImage, TOutputImage>;
+  using ResampleFilterType = SeparableBSplineResampleImageFilter<TInputImage, TOutputImage>;
   using ResampleFilterPointer = typename ResampleFilterType::Pointer;
 
   ResampleFilterPointer m_ResampleFilter;
@@ -18,6 +18,7 @@
 #ifndef itkIsotropicResamplerImageFilter_hxx
 #define itkIsotropicResamplerImageFilter_hxx
 
+#include "itkMath.h"
 #include "itkProgressAccumulator.h"
 
 namespace itk
@@ -54,14 +55,7 @@ IsotropicResamplerImageFilter<TInputImage, TOutputImage>::GenerateOutputInformat
     itkExceptionMacro("Missing input image");
   }
 
-  const SpacingType & inputSpacing = inputImage->GetSpacing();
-
-  SizeType inputSize = inputImage->GetLargestPossibleRegion().GetSize(), finalSize;
-  for (unsigned int i = 0; i < ImageDimension; i++)
-  {
-    const double dx = inputSize[i] * inputSpacing[i] / m_OutputSpacing[i];
-    finalSize[i] = static_cast<SizeValueType>(dx);
-  }
+  const SizeType finalSize = this->ComputeOutputSize(inputImage);
 
   typename TOutputImage::RegionType            outputLargestPossibleRegion;
   typename TOutputImage::RegionType::IndexType index;
@@ -99,34 +93,10 @@ IsotropicResamplerImageFilter<TInputImage, TOutputImage>::GenerateData()
     return;
   }
 
-  using TransformType = itk::IdentityTransform<double, ImageDimension>;
-
-  typename TransformType::Pointer transform = TransformType::New();
-  transform->SetIdentity();
-
-  using BSplineInterpolatorType = itk::BSplineInterpolateImageFunction<InputImageType, double>;
+  const SizeType finalSize = this->ComputeOutputSize(inputImage);
 
-  typename BSplineInterpolatorType::Pointer bsplineInterpolator = BSplineInterpolatorType::New();
-
-#if ITK_VERSION_MAJOR > 3 || (ITK_VERSION_MAJOR == 3 && ITK_VERSION_MINOR >= 10)
-  bsplineInterpolator->UseImageDirectionOn();
-#endif
-  bsplineInterpolator->SetSplineOrder(3);
-
-  const SpacingType & inputSpacing = inputImage->GetSpacing();
-  SizeType            inputSize = inputImage->GetLargestPossibleRegion().GetSize(), finalSize;
-  for (unsigned int i = 0; i < ImageDimension; i++)
-  {
-    const double dx = inputSize[i] * inputSpacing[i] / m_OutputSpacing[i];
-    finalSize[i] = static_cast<SizeValueType>(dx);
-  }
-
-  this->m_ResampleFilter->SetTransform(transform);
-  this->m_ResampleFilter->SetInterpolator(bsplineInterpolator);
   this->m_ResampleFilter->SetDefaultPixelValue(this->m_DefaultPixelValue);
   this->m_ResampleFilter->SetOutputSpacing(m_OutputSpacing);
-  this->m_ResampleFilter->SetOutputOrigin(inputImage->GetOrigin());
-  this->m_ResampleFilter->SetOutputDirection(inputImage->GetDirection());
   this->m_ResampleFilter->SetSize(finalSize);
   this->m_ResampleFilter->SetInput(inputImage);
 
@@ -137,6 +107,30 @@ IsotropicResamplerImageFilter<TInputImage, TOutputImage>::GenerateData()
   this->GraftOutput(this->m_ResampleFilter->GetOutput());
 }
 
+template <typename TInputImage, typename TOutputImage>
+auto
+IsotropicResamplerImageFilter<TInputImage, TOutputImage>::ComputeOutputSize(const InputImageType * inputImage) const
+  -> SizeType
+{
+  const SpacingType & inputSpacing = inputImage->GetSpacing();
+  const SizeType &    inputSize = inputImage->GetLargestPossibleRegion().GetSize();
+
+  SizeType finalSize;
+  for (unsigned int i = 0; i < ImageDimension; i++)
+  {
+    if (Math::ExactlyEquals(m_OutputSpacing[i], inputSpacing[i]))
+    {
+      finalSize[i] = inputSize[i];
+    }
+    else
+    {
+      const double dx = inputSize[i] * inputSpacing[i] / m_OutputSpacing[i];
+      finalSize[i] = static_cast<SizeValueType>(dx);
+    }
+  }
+  return finalSize;
+}
+
 template <typename TInputImage, typename TOutputImage>
 void
 IsotropicResamplerImageFilter<TInputImage, TOutputImage>::SetAbortGenerateData(const bool abort)
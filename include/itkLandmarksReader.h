@@ -23,6 +23,9 @@
 #include "itkLandmarkSpatialObject.h"
 #include "itkSpatialObjectReader.h"
 
+#include <string>
+#include <vector>
+
 namespace itk
 {
 
@@ -31,6 +34,12 @@ namespace itk
  *
  * A LandmarkSpatialObject is produced as output.
  *
+ * The ASCII landmark files of MetaIO, as the seed files of this module,
+ * are parsed directly. Other files, for instance with binary points or with
+ * other types of objects, are read with a SpatialObjectReader. The static
+ * ReadLandmarks() methods read the points without the pipeline, and read a
+ * list of files in parallel.
+ *
  * \ingroup SpatialObjectFilters
  * \ingroup LesionSizingToolkit
  */
@@ -59,6 +68,12 @@ public:
    * segmentation method. */
   using SpatialObjectType = LandmarkSpatialObject<NDimension>;
   using SpatialObjectPointer = typename SpatialObjectType::Pointer;
+  using LandmarkPointType = typename SpatialObjectType::LandmarkPointType;
+  using LandmarkPointListType = typename SpatialObjectType::LandmarkPointListType;
+
+  /** Types of the lists of files and of their points. */
+  using FileNameContainerType = std::vector<std::string>;
+  using LandmarkPointListContainerType = std::vector<LandmarkPointListType>;
 
   /** Output data that carries the feature in the form of a
    * SpatialObject. */
@@ -69,6 +84,15 @@ public:
   itkSetStringMacro(FileName);
   itkGetStringMacro(FileName);
 
+  /** Read the points of the first landmarks of a file. */
+  static void
+  ReadLandmarks(const std::string & fileName, LandmarkPointListType & points);
+
+  /** Read the points of the first landmarks of each file, in parallel. The
+   * points of the i-th file are the i-th list. */
+  static void
+  ReadLandmarks(const FileNameContainerType & fileNames, LandmarkPointListContainerType & points);
+
 protected:
   LandmarksReader();
   ~LandmarksReader() override;
@@ -84,8 +108,17 @@ private:
   using GroupType = typename SpatialObjectReaderType::GroupType;
   using ObjectListType = typename GroupType::ObjectListType;
 
-  std::string                m_FileName;
-  SpatialObjectReaderPointer m_SpatialObjectReader;
+  /** Parse the points of an ASCII MetaIO landmark file. Returns false when
+   * the file is not of this subset of MetaIO, and throws when it cannot be
+   * opened. */
+  static bool
+  ParseLandmarks(const std::string & fileName, LandmarkPointListType & points);
+
+  /** Read the points with the generic SpatialObjectReader. */
+  static void
+  ReadLandmarksWithSpatialObjectReader(const std::string & fileName, LandmarkPointListType & points);
+
+  std::string m_FileName;
 };
 
 } // end namespace itk
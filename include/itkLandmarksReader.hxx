@@ -18,8 +18,13 @@
 #ifndef itkLandmarksReader_hxx
 #define itkLandmarksReader_hxx
 
+#include "itkMultiThreaderBase.h"
 #include "itkSpatialObjectReader.h"
 
+#include <algorithm>
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
 
 namespace itk
 {
@@ -32,8 +37,6 @@ LandmarksReader<NDimension>::LandmarksReader()
 {
   this->SetNumberOfRequiredOutputs(1);
 
-  this->m_SpatialObjectReader = SpatialObjectReaderType::New();
-
   typename SpatialObjectType::Pointer outputObject = SpatialObjectType::New();
 
   this->ProcessObject::SetNthOutput(0, outputObject);
@@ -57,48 +60,305 @@ template <unsigned int NDimension>
 void
 LandmarksReader<NDimension>::GenerateData()
 {
-  this->m_SpatialObjectReader->SetFileName(this->GetFileName());
+  auto * outputObject = dynamic_cast<SpatialObjectType *>(this->ProcessObject::GetOutput(0));
+
+  LandmarkPointListType points;
+
+  ReadLandmarks(this->GetFileName(), points);
+
+  outputObject->SetPoints(points);
+}
+
+
+/**
+ * ReadLandmarks
+ */
+template <unsigned int NDimension>
+void
+LandmarksReader<NDimension>::ReadLandmarks(const std::string & fileName, LandmarkPointListType & points)
+{
+  if (!ParseLandmarks(fileName, points))
+  {
+    ReadLandmarksWithSpatialObjectReader(fileName, points);
+  }
+}
+
+
+template <unsigned int NDimension>
+void
+LandmarksReader<NDimension>::ReadLandmarks(const FileNameContainerType &    fileNames,
+                                           LandmarkPointListContainerType & points)
+{
+  points.assign(fileNames.size(), LandmarkPointListType());
+
+  std::vector<std::string> errors(fileNames.size());
+
+  MultiThreaderBase::Pointer multiThreader = MultiThreaderBase::New();
+  multiThreader->ParallelizeArray(
+    0,
+    fileNames.size(),
+    [&](SizeValueType i) {
+      try
+      {
+        ReadLandmarks(fileNames[i], points[i]);
+      }
+      catch (ExceptionObject & excp)
+      {
+        errors[i] = excp.GetDescription();
+      }
+    },
+    nullptr);
+
+  for (unsigned int i = 0; i < fileNames.size(); ++i)
+  {
+    if (!errors[i].empty())
+    {
+      itkGenericExceptionMacro("Could not read the landmarks of " << fileNames[i] << ": " << errors[i]);
+    }
+  }
+}
+
+
+/**
+ * ParseLandmarks
+ */
+template <unsigned int NDimension>
+bool
+LandmarksReader<NDimension>::ParseLandmarks(const std::string & fileName, LandmarkPointListType & points)
+{
+  std::ifstream file(fileName.c_str(), std::ios::in | std::ios::binary);
+  if (!file)
+  {
+    itkGenericExceptionMacro("Could not open the landmarks file " << fileName);
+  }
+
+  std::ostringstream contents;
+  contents << file.rdbuf();
+  const std::string text = contents.str();
+
+  const char * position = text.c_str();
+  const char * const end = position + text.size();
+
+  const auto trim = [](const std::string & value) {
+    const std::string::size_type first = value.find_first_not_of(" \t\r");
+    if (first == std::string::npos)
+    {
+      return std::string();
+    }
+    return value.substr(first, value.find_last_not_of(" \t\r") - first + 1);
+  };
 
-  this->m_SpatialObjectReader->Update();
+  bool          inLandmark = false;
+  unsigned int  numberOfDimensions = 0;
+  unsigned long numberOfPoints = 0;
+  double        spacing[NDimension];
 
-  typename SpatialObjectReaderType::GroupPointer group = this->m_SpatialObjectReader->GetGroup();
+  while (position < end)
+  {
+    const char * lineEnd = std::find(position, end, '\n');
+    const std::string line = trim(std::string(position, lineEnd));
+    position = (lineEnd < end) ? lineEnd + 1 : end;
+
+    if (line.empty())
+    {
+      continue;
+    }
+
+    const std::string::size_type separator = line.find('=');
+    if (separator == std::string::npos)
+    {
+      return false;
+    }
+
+    const std::string  key = trim(line.substr(0, separator));
+    const std::string  value = trim(line.substr(separator + 1));
+    std::istringstream values(value);
+
+    if (key == "ObjectType")
+    {
+      // Any other object may carry data that only MetaIO can skip.
+      if (value == "Scene")
+      {
+        inLandmark = false;
+        continue;
+      }
+      if (value == "Landmark")
+      {
+        inLandmark = true;
+        numberOfDimensions = 0;
+        numberOfPoints = 0;
+        std::fill_n(spacing, NDimension, 1.0);
+        continue;
+      }
+      return false;
+    }
+
+    if (!inLandmark)
+    {
+      if (key == "NDims" || key == "NObjects" || key == "Comment")
+      {
+        continue;
+      }
+      return false;
+    }
+
+    if (key == "NDims")
+    {
+      if (!(values >> numberOfDimensions) || numberOfDimensions != NDimension)
+      {
+        return false;
+      }
+    }
+    else if (key == "BinaryData")
+    {
+      if (value != "False" && value != "false" && value != "F" && value != "0")
+      {
+        return false;
+      }
+    }
+    else if (key == "ElementSpacing")
+    {
+      for (unsigned int d = 0; d < NDimension; ++d)
+      {
+        if (!(values >> spacing[d]))
+        {
+          return false;
+        }
+      }
+    }
+    else if (key == "PointDim")
+    {
+      // The coordinates and the color of the points.
+      unsigned int numberOfComponents = 0;
+      std::string  component;
+      while (values >> component)
+      {
+        ++numberOfComponents;
+      }
+      if (numberOfComponents != NDimension + 4)
+      {
+        return false;
+      }
+    }
+    else if (key == "NPoints")
+    {
+      if (!(values >> numberOfPoints))
+      {
+        return false;
+      }
+    }
+    else if (key == "Points")
+    {
+      if (numberOfDimensions != NDimension)
+      {
+        return false;
+      }
+
+      // As MetaIO, read floats, each followed by one separator character.
+      const auto readValue = [&position, end](float & component) {
+        char *      valueEnd = nullptr;
+        const float parsed = std::strtof(position, &valueEnd);
+        if (valueEnd == position)
+        {
+          return false;
+        }
+        component = parsed;
+        position = (valueEnd < end) ? valueEnd + 1 : end;
+        return true;
+      };
+
+      points.clear();
+      points.reserve(numberOfPoints);
+
+      for (unsigned long i = 0; i < numberOfPoints; ++i)
+      {
+        float                                 components[NDimension + 4];
+        typename LandmarkPointType::PointType point;
+        for (unsigned int c = 0; c < NDimension + 4; ++c)
+        {
+          if (!readValue(components[c]))
+          {
+            return false;
+          }
+        }
+        for (unsigned int d = 0; d < NDimension; ++d)
+        {
+          point[d] = components[d] * spacing[d];
+        }
+
+        LandmarkPointType landmarkPoint;
+        landmarkPoint.SetPositionInObjectSpace(point);
+        landmarkPoint.SetColor(components[NDimension],
+                               components[NDimension + 1],
+                               components[NDimension + 2],
+                               components[NDimension + 3]);
+        points.push_back(landmarkPoint);
+      }
+      return true;
+    }
+    else if (key != "Comment" && key != "ID" && key != "ParentID" && key != "Name" && key != "Color" &&
+             key != "TransformMatrix" && key != "Offset" && key != "CenterOfRotation" &&
+             key != "AnatomicalOrientation" && key != "ElementType" && key != "BinaryDataByteOrderMSB" &&
+             key != "ElementByteOrderMSB")
+    {
+      // The transform of the object is not applied to its points.
+      return false;
+    }
+  }
+
+  return false;
+}
+
+
+/**
+ * ReadLandmarksWithSpatialObjectReader
+ */
+template <unsigned int NDimension>
+void
+LandmarksReader<NDimension>::ReadLandmarksWithSpatialObjectReader(const std::string &     fileName,
+                                                                  LandmarkPointListType & points)
+{
+  SpatialObjectReaderPointer spatialObjectReader = SpatialObjectReaderType::New();
+
+  spatialObjectReader->SetFileName(fileName);
+
+  spatialObjectReader->Update();
+
+  typename SpatialObjectReaderType::GroupPointer group = spatialObjectReader->GetGroup();
 
   if (!group)
   {
-    itkExceptionMacro("Couldn't fine a group in file" << this->GetFileName());
+    itkGenericExceptionMacro("Couldn't fine a group in file" << fileName);
   }
 
   ObjectListType * groupChildren = group->GetChildren(999999);
 
   typename ObjectListType::const_iterator spatialObjectItr = groupChildren->begin();
 
-  typename SpatialObjectType::Pointer landmarkSpatialObject;
+  const SpatialObjectType * landmarkSpatialObject = nullptr;
 
   while (spatialObjectItr != groupChildren->end())
   {
     std::string objectName = (*spatialObjectItr)->GetTypeName();
     if (objectName == "LandmarkSpatialObject")
     {
-      const auto * landmarkSpatialObjectRawPointer =
-        dynamic_cast<const SpatialObjectType *>(spatialObjectItr->GetPointer());
-      landmarkSpatialObject = const_cast<SpatialObjectType *>(landmarkSpatialObjectRawPointer);
+      landmarkSpatialObject = dynamic_cast<const SpatialObjectType *>(spatialObjectItr->GetPointer());
       break;
     }
     spatialObjectItr++;
   }
 
-  if (landmarkSpatialObject.IsNull())
+  if (landmarkSpatialObject)
   {
-    itkExceptionMacro("Input file does not contain landmarks");
+    points = landmarkSpatialObject->GetPoints();
   }
 
-  landmarkSpatialObject->DisconnectPipeline();
-
-  auto * outputObject = dynamic_cast<SpatialObjectType *>(this->ProcessObject::GetOutput(0));
-
-  outputObject->SetPoints(landmarkSpatialObject->GetPoints());
-
   delete groupChildren;
+
+  if (!landmarkSpatialObject)
+  {
+    itkGenericExceptionMacro("Input file does not contain landmarks");
+  }
 }
 
 /*
@@ -28,13 +28,16 @@
 #include "itkSatoVesselnessSigmoidFeatureGenerator.h"
 #include "itkSigmoidFeatureGenerator.h"
 #include "itkCannyEdgesFeatureGenerator.h"
+#include "itkCachedFeatureGenerator.h"
 #include "itkFastMarchingAndGeodesicActiveContourLevelSetSegmentationModule.h"
 #include "itkMinimumFeatureAggregator.h"
 #include "itkRegionOfInterestImageFilter.h"
 #include "itkLesionSegmentationMethod.h"
 #include "itkMinimumFeatureAggregator.h"
 #include "itkIsotropicResamplerImageFilter.h"
+#include "itkSeparableBSplineResampleImageFilter.h"
 #include <string>
+#include <vector>
 
 namespace itk
 {
@@ -82,9 +85,15 @@ public:
   using CannyEdgesFeatureGeneratorType = CannyEdgesFeatureGenerator<ImageDimension>;
   using SigmaArrayType = typename CannyEdgesFeatureGeneratorType::SigmaArrayType;
 
+  /** Only the RegionOfInterest of the input is requested, or the whole input
+   * when the RegionOfInterest is empty. */
   void
   GenerateInputRequestedRegion() noexcept(false) override;
 
+  /** The whole output is produced. */
+  void
+  EnlargeOutputRequestedRegion(DataObject * output) override;
+
 #ifdef ITK_USE_CONCEPT_CHECKING
   /** Begin concept checking */
   itkConceptMacro(InputHasNumericTraitsCheck, (Concept::HasNumericTraits<InputImagePixelType>));
@@ -117,6 +126,80 @@ public:
   itkSetMacro(AnisotropyThreshold, double);
   itkGetMacro(AnisotropyThreshold, double);
 
+  /** If ResampleThickSliceData is ON and the anisotropy of the data exceeds
+   * the AnisotropyThreshold, compute the features and the segmentation on
+   * the native grid of the data instead of on the resampled grid. The feature
+   * generators and the level sets take the spacing into account, and only the
+   * final level set is upsampled to the output grid. This saves the memory
+   * and the time of running every stage on a grid that has more voxels by
+   * the anisotropy ratio. The output has the same grid in both modes.
+   * Defaults to false. */
+  itkSetMacro(SegmentOnNativeGrid, bool);
+  itkGetMacro(SegmentOnNativeGrid, bool);
+  itkBooleanMacro(SegmentOnNativeGrid);
+
+  /** Turn On/Off the multithreaded sparse field solver for the geodesic
+   * active contour level set. Defaults to false. */
+  itkSetMacro(UseParallelLevelSetSolver, bool);
+  itkGetMacro(UseParallelLevelSetSolver, bool);
+  itkBooleanMacro(UseParallelLevelSetSolver);
+
+  /** Shrink factor of the coarse resolution of the geodesic active contour.
+   * When larger than one, the level set is evolved first on the shrunk
+   * features, then refined at full resolution. Defaults to 1, a single
+   * resolution. */
+  itkSetMacro(CoarseResolutionShrinkFactor, unsigned int);
+  itkGetMacro(CoarseResolutionShrinkFactor, unsigned int);
+
+  /** Segmentation of the same lesion computed previously, for instance on
+   * an earlier run with other seeds or parameters. It has the sign
+   * convention of the output of this filter, positive inside the lesion,
+   * and may be defined on any grid. When set, the level set evolution starts
+   * from it instead of from the fast marching of the seeds, and converges in
+   * a few iterations when the segmentation changes little. Null, the
+   * default, starts from the seeds. */
+  itkSetConstObjectMacro(PriorSegmentation, OutputImageType);
+  itkGetConstObjectMacro(PriorSegmentation, OutputImageType);
+
+  /** Interpret the PriorSegmentation as a mask, non zero inside the lesion,
+   * instead of a level set. Defaults to false. */
+  itkSetMacro(PriorSegmentationIsMask, bool);
+  itkGetMacro(PriorSegmentationIsMask, bool);
+  itkBooleanMacro(PriorSegmentationIsMask);
+
+  /** Turn On/Off the adaptive region of interest. When ON, the features and
+   * the segmentation are first computed in a box around the seeds, that
+   * extends InitialRegionOfInterestRadius millimeters beyond them, instead
+   * of in the whole RegionOfInterest. When the segmentation reaches a face
+   * of the box that is inside the RegionOfInterest, the radius is doubled
+   * and the segmentation is computed again, until it fits in the box or the
+   * box covers the RegionOfInterest. Small lesions in large regions of
+   * interest are segmented without computing the features far away from
+   * them. The output covers the RegionOfInterest in both modes: the level
+   * set of the box is copied on the output grid, and the output is
+   * normalized over the whole RegionOfInterest. Along the axes resampled
+   * for thick slices, the box covers the whole RegionOfInterest, so that
+   * its grid is the one of the output. The features near the faces of the
+   * box may differ slightly from the ones computed in the whole
+   * RegionOfInterest, since the filters see less context. Defaults to
+   * false. */
+  itkSetMacro(AdaptiveRegionOfInterest, bool);
+  itkGetMacro(AdaptiveRegionOfInterest, bool);
+  itkBooleanMacro(AdaptiveRegionOfInterest);
+
+  /** Margin, in millimeters, of the first box around the seeds used by the
+   * adaptive region of interest. Defaults to 20. */
+  itkSetMacro(InitialRegionOfInterestRadius, double);
+  itkGetMacro(InitialRegionOfInterestRadius, double);
+
+  /** Directory where the lung wall, vesselness, sigmoid and Canny edges
+   * features are kept, keyed by the input of the feature generators and
+   * their parameters. The features computed on an earlier run for the same
+   * region of interest and feature parameters are read from it instead of
+   * being computed again. Empty, the default, disables the cache. */
+  itkSetStringMacro(FeatureCacheDirectory);
+  itkGetStringMacro(FeatureCacheDirectory);
+
   /** Turn On/Off the use of vessel enhancing diffusion (R. Manniesing et al)
    * prior to computing the vesselness. This is slow. Defaults to false. */
   virtual void
@@ -137,10 +220,35 @@ public:
     return m_Seeds;
   }
 
-  /** Report progress */
+  /** Report progress, and forward the iterations of the level set. */
   void
   ProgressUpdate(Object * caller, const EventObject & event);
 
+  /** Statistics of the last iteration of the level set evolution, see the
+   * SinglePhaseLevelSetSegmentationModule. The filter invokes an
+   * IterationEvent after every iteration of the level set, whose observers
+   * query these statistics. */
+  itk::SizeValueType
+  GetElapsedIterations() const
+  {
+    return m_SegmentationModule->GetElapsedIterations();
+  }
+  double
+  GetRMSChange() const
+  {
+    return m_SegmentationModule->GetRMSChange();
+  }
+  itk::SizeValueType
+  GetActiveLayerSize() const
+  {
+    return m_SegmentationModule->GetActiveLayerSize();
+  }
+  double
+  GetElapsedTime() const
+  {
+    return m_SegmentationModule->GetElapsedTime();
+  }
+
   // Return the status message
   const char *
   GetStatusMessage() const
@@ -174,20 +282,44 @@ protected:
   using LungWallGeneratorType = LungWallFeatureGenerator<ImageDimension>;
   using SigmoidFeatureGeneratorType = SigmoidFeatureGenerator<ImageDimension>;
   using FeatureAggregatorType = MinimumFeatureAggregator<ImageDimension>;
+  using CachedFeatureGeneratorType = CachedFeatureGenerator<ImageDimension>;
+  using CachedFeatureGeneratorArrayType = std::vector<typename CachedFeatureGeneratorType::Pointer>;
   using SegmentationModuleType = FastMarchingAndGeodesicActiveContourLevelSetSegmentationModule<ImageDimension>;
   using CropFilterType = RegionOfInterestImageFilter<InputImageType, InputImageType>;
   using SpatialObjectType = typename SegmentationModuleType::SpatialObjectType;
   using OutputSpatialObjectType = typename SegmentationModuleType::OutputSpatialObjectType;
   using InputImageSpatialObjectType = ImageSpatialObject<ImageDimension, InputImagePixelType>;
   using IsotropicResamplerType = IsotropicResamplerImageFilter<InputImageType, InputImageType>;
+  using LevelSetResamplerType = SeparableBSplineResampleImageFilter<OutputImageType, OutputImageType>;
   using SizeType = typename RegionType::SizeType;
   using SizeValueType = typename SizeType::SizeValueType;
+  using InitialLevelSetType = typename SegmentationModuleType::InputImageType;
   using CommandType = MemberCommand<Self>;
 
 
 private:
   ~LesionSegmentationImageFilter8() override = default;
 
+  /** Map the progress of a stage to its share [stageStart, stageStart +
+   * stageWeight] of the progress of the filter. */
+  void
+  UpdateStageProgress(double stageStart, double stageWeight, float stageProgress);
+
+  /** Run the segmentation pipeline on a region of the input. Returns the
+   * level set on the resampled grid of the region. */
+  typename OutputImageType::Pointer
+  SegmentRegion(const RegionType & region);
+
+  /** Run the segmentation pipeline on growing boxes around the seeds, see
+   * AdaptiveRegionOfInterest. Returns the level set on the output grid. */
+  typename OutputImageType::Pointer
+  SegmentAdaptiveRegion();
+
+  /** Whether the segmentation, where the level set is negative, touches a
+   * face of the region that lies inside the RegionOfInterest. */
+  bool
+  SegmentationReachesRegionBorder(const OutputImageType * levelSet, const RegionType & region) const;
+
   double m_SigmoidBeta;
   double m_FastMarchingStoppingTime;
   double m_FastMarchingDistanceFromSeeds;
@@ -198,9 +330,12 @@ private:
   typename SigmoidFeatureGeneratorType::Pointer         m_SigmoidFeatureGenerator;
   typename CannyEdgesFeatureGeneratorType::Pointer      m_CannyEdgesFeatureGenerator;
   typename FeatureAggregatorType::Pointer               m_FeatureAggregator;
+  CachedFeatureGeneratorArrayType                       m_CachedFeatureGenerators;
+  std::string                                           m_FeatureCacheDirectory;
   typename SegmentationModuleType::Pointer              m_SegmentationModule;
   typename CropFilterType::Pointer                      m_CropFilter;
   typename IsotropicResamplerType::Pointer              m_IsotropicResampler;
+  typename LevelSetResamplerType::Pointer               m_LevelSetResampler;
   typename CommandType::Pointer                         m_CommandObserver;
   RegionType                                            m_RegionOfInterest;
   std::string                                           m_StatusMessage;
@@ -208,6 +343,13 @@ private:
   typename InputImageSpatialObjectType::Pointer         m_InputSpatialObject;
   bool                                                  m_ResampleThickSliceData;
   double                                                m_AnisotropyThreshold;
+  bool                                                  m_SegmentOnNativeGrid;
+  bool                                                  m_UseParallelLevelSetSolver;
+  unsigned int                                          m_CoarseResolutionShrinkFactor;
+  typename OutputImageType::ConstPointer                m_PriorSegmentation;
+  bool                                                  m_PriorSegmentationIsMask;
+  bool                                                  m_AdaptiveRegionOfInterest;
+  double                                                m_InitialRegionOfInterestRadius;
   bool                                                  m_UserSpecifiedSigmas;
 };
 
@@ -23,6 +23,14 @@
 #include "itkGradientMagnitudeImageFilter.h"
 #include "itkImageFileReader.h"
 #include "itkImageFileWriter.h"
+#include "itkImageRegionConstIterator.h"
+#include "itkImageRegionIterator.h"
+#include "itkIntensityWindowingImageFilter.h"
+#include "itkMath.h"
+#include "itkMinimumMaximumImageCalculator.h"
+
+#include <algorithm>
+#include <cmath>
 
 namespace itk
 {
@@ -39,6 +47,7 @@ LesionSegmentationImageFilter8<TInputImage, TOutputImage>::LesionSegmentationIma
   m_SegmentationModule = SegmentationModuleType::New();
   m_CropFilter = CropFilterType::New();
   m_IsotropicResampler = IsotropicResamplerType::New();
+  m_LevelSetResampler = LevelSetResamplerType::New();
   m_InputSpatialObject = InputImageSpatialObjectType::New();
 
   // Report progress.
@@ -51,16 +60,29 @@ LesionSegmentationImageFilter8<TInputImage, TOutputImage>::LesionSegmentationIma
   m_SegmentationModule->AddObserver(itk::ProgressEvent(), m_CommandObserver);
   m_CropFilter->AddObserver(itk::ProgressEvent(), m_CommandObserver);
   m_IsotropicResampler->AddObserver(itk::ProgressEvent(), m_CommandObserver);
+  m_LevelSetResampler->AddObserver(itk::ProgressEvent(), m_CommandObserver);
 
   // Connect pipeline
   m_LungWallFeatureGenerator->SetInput(m_InputSpatialObject);
   m_SigmoidFeatureGenerator->SetInput(m_InputSpatialObject);
   m_VesselnessFeatureGenerator->SetInput(m_InputSpatialObject);
   m_CannyEdgesFeatureGenerator->SetInput(m_InputSpatialObject);
-  m_FeatureAggregator->AddFeatureGenerator(m_LungWallFeatureGenerator);
-  m_FeatureAggregator->AddFeatureGenerator(m_VesselnessFeatureGenerator);
-  m_FeatureAggregator->AddFeatureGenerator(m_SigmoidFeatureGenerator);
-  m_FeatureAggregator->AddFeatureGenerator(m_CannyEdgesFeatureGenerator);
+
+  // The features are aggregated through generators that may keep them in
+  // the FeatureCacheDirectory.
+  using FeatureGeneratorType = typename CachedFeatureGeneratorType::FeatureGeneratorType;
+  FeatureGeneratorType * featureGenerators[] = { m_LungWallFeatureGenerator.GetPointer(),
+                                                 m_VesselnessFeatureGenerator.GetPointer(),
+                                                 m_SigmoidFeatureGenerator.GetPointer(),
+                                                 m_CannyEdgesFeatureGenerator.GetPointer() };
+  for (FeatureGeneratorType * featureGenerator : featureGenerators)
+  {
+    typename CachedFeatureGeneratorType::Pointer cachedFeatureGenerator = CachedFeatureGeneratorType::New();
+    cachedFeatureGenerator->SetFeatureGenerator(featureGenerator);
+    cachedFeatureGenerator->SetInput(m_InputSpatialObject);
+    m_FeatureAggregator->AddFeatureGenerator(cachedFeatureGenerator);
+    m_CachedFeatureGenerators.push_back(cachedFeatureGenerator);
+  }
   m_LesionSegmentationMethod->AddFeatureGenerator(m_FeatureAggregator);
   m_LesionSegmentationMethod->SetSegmentationModule(m_SegmentationModule);
 
@@ -87,6 +109,13 @@ LesionSegmentationImageFilter8<TInputImage, TOutputImage>::LesionSegmentationIma
   m_SegmentationModule->SetMaximumNumberOfIterations(300);
   m_ResampleThickSliceData = true;
   m_AnisotropyThreshold = 1.0;
+  m_SegmentOnNativeGrid = false;
+  m_UseParallelLevelSetSolver = false;
+  m_CoarseResolutionShrinkFactor = 1;
+  m_PriorSegmentation = nullptr;
+  m_PriorSegmentationIsMask = false;
+  m_AdaptiveRegionOfInterest = false;
+  m_InitialRegionOfInterestRadius = 20.0;
   m_UserSpecifiedSigmas = false;
 }
 
@@ -101,11 +130,42 @@ LesionSegmentationImageFilter8<TInputImage, TOutputImage>::GenerateInputRequeste
   {
     typename InputImageType::Pointer inputPtr = const_cast<TInputImage *>(this->GetInput());
 
-    // Request the entire input image
-    inputPtr->SetRequestedRegion(inputPtr->GetLargestPossibleRegion());
+    // The mini-pipeline starts by cropping the input to the region of
+    // interest, and the resampler and the feature generators only see the
+    // cropped image. Request the region of interest alone, so that a
+    // streaming reader upstream does not load the whole volume.
+    RegionType inputRequestedRegion = m_RegionOfInterest;
+    if (inputRequestedRegion.GetNumberOfPixels() == 0)
+    {
+      inputPtr->SetRequestedRegion(inputPtr->GetLargestPossibleRegion());
+      return;
+    }
+
+    if (!inputRequestedRegion.Crop(inputPtr->GetLargestPossibleRegion()))
+    {
+      inputPtr->SetRequestedRegion(inputRequestedRegion);
+
+      InvalidRequestedRegionError e(__FILE__, __LINE__);
+      e.SetLocation(ITK_LOCATION);
+      e.SetDescription("The region of interest is outside the largest possible region of the input.");
+      e.SetDataObject(inputPtr);
+      throw e;
+    }
+
+    inputPtr->SetRequestedRegion(inputRequestedRegion);
   }
 }
 
+template <typename TInputImage, typename TOutputImage>
+void
+LesionSegmentationImageFilter8<TInputImage, TOutputImage>::EnlargeOutputRequestedRegion(DataObject * output)
+{
+  Superclass::EnlargeOutputRequestedRegion(output);
+
+  // The segmentation is computed in the whole region of interest.
+  output->SetRequestedRegionToLargestPossibleRegion();
+}
+
 template <typename TInputImage, typename TOutputImage>
 void
 LesionSegmentationImageFilter8<TInputImage, TOutputImage>::SetSigma(SigmaArrayType s)
@@ -139,7 +199,10 @@ LesionSegmentationImageFilter8<TInputImage, TOutputImage>::GenerateOutputInforma
     minSpacing = (minSpacing > inputPtr->GetSpacing()[i] ? inputPtr->GetSpacing()[i] : minSpacing);
   }
 
-  // Try and reduce the anisotropy.
+  // Try and reduce the anisotropy. Only the axes that are too coarse are
+  // resampled: the other ones keep their spacing exactly, and the resampler
+  // copies them instead of interpolating them. For typical thick-slice CT
+  // only the z axis is interpolated.
   SpacingType outputSpacing = inputPtr->GetSpacing();
   for (unsigned int i = 0; i < ImageDimension; i++)
   {
@@ -170,6 +233,36 @@ LesionSegmentationImageFilter8<TInputImage, TOutputImage>::GenerateData()
   m_SigmoidFeatureGenerator->SetBeta(m_SigmoidBeta);
   m_SegmentationModule->SetDistanceFromSeeds(m_FastMarchingDistanceFromSeeds);
   m_SegmentationModule->SetStoppingValue(m_FastMarchingStoppingTime);
+  m_SegmentationModule->SetUseParallelSolver(m_UseParallelLevelSetSolver);
+  m_SegmentationModule->SetCoarseResolutionShrinkFactor(m_CoarseResolutionShrinkFactor);
+  m_SegmentationModule->InvertOutputIntensitiesOn();
+  for (CachedFeatureGeneratorType * cachedFeatureGenerator : m_CachedFeatureGenerators)
+  {
+    cachedFeatureGenerator->SetCacheDirectory(m_FeatureCacheDirectory);
+  }
+
+  // Warm start from the prior segmentation. The level set of the module is
+  // negative inside, the opposite of the output of this filter.
+  typename InitialLevelSetType::Pointer initialLevelSet = nullptr;
+  if (m_PriorSegmentation)
+  {
+    initialLevelSet = InitialLevelSetType::New();
+    initialLevelSet->CopyInformation(m_PriorSegmentation);
+    initialLevelSet->SetRegions(m_PriorSegmentation->GetBufferedRegion());
+    initialLevelSet->Allocate();
+
+    ImageRegionConstIterator<OutputImageType> pit(m_PriorSegmentation, m_PriorSegmentation->GetBufferedRegion());
+    ImageRegionIterator<InitialLevelSetType>  lit(initialLevelSet, initialLevelSet->GetBufferedRegion());
+    const double                              sign = m_PriorSegmentationIsMask ? 1.0 : -1.0;
+    while (!pit.IsAtEnd())
+    {
+      lit.Set(sign * static_cast<double>(pit.Get()));
+      ++pit;
+      ++lit;
+    }
+  }
+  m_SegmentationModule->SetInitialLevelSet(initialLevelSet);
+  m_SegmentationModule->SetInitialLevelSetIsMask(m_PriorSegmentationIsMask);
 
   // Allocate the output
   this->GetOutput()->SetBufferedRegion(this->GetOutput()->GetRequestedRegion());
@@ -178,11 +271,67 @@ LesionSegmentationImageFilter8<TInputImage, TOutputImage>::GenerateData()
   // Get the input image
   typename InputImageType::ConstPointer input = this->GetInput();
 
+  // Sigma for the canny is the max spacing of the original input (before
+  // resampling)
+
+  if (m_UserSpecifiedSigmas == false)
+  {
+    double maxSpacing = NumericTraits<double>::min();
+    for (unsigned int i = 0; i < ImageDimension; i++)
+    {
+      maxSpacing = (maxSpacing < input->GetSpacing()[i] ? input->GetSpacing()[i] : maxSpacing);
+    }
+    m_CannyEdgesFeatureGenerator->SetSigma(maxSpacing);
+  }
+
+  // Seeds
+
+  typename SeedSpatialObjectType::Pointer seedSpatialObject = SeedSpatialObjectType::New();
+  seedSpatialObject->SetPoints(m_Seeds);
+  m_LesionSegmentationMethod->SetInitialSegmentation(seedSpatialObject);
+
+  typename OutputImageType::Pointer outputImage = nullptr;
+  if (m_AdaptiveRegionOfInterest)
+  {
+    outputImage = this->SegmentAdaptiveRegion();
+  }
+  else
+  {
+    outputImage = this->SegmentRegion(m_RegionOfInterest);
+  }
+
+  this->GraftOutput(outputImage);
+
+  /* // DEBUGGING CODE
+  using WriterType = ImageFileWriter< OutputImageType >;
+  typename WriterType::Pointer writer = WriterType::New();
+  writer->SetFileName("output.mha");
+  writer->SetInput(outputImage);
+  writer->UseCompressionOn();
+  writer->Write();*/
+}
+
+
+template <typename TInputImage, typename TOutputImage>
+typename LesionSegmentationImageFilter8<TInputImage, TOutputImage>::OutputImageType::Pointer
+LesionSegmentationImageFilter8<TInputImage, TOutputImage>::SegmentRegion(const RegionType & region)
+{
   // Crop and perform thin slice resampling (done only if necessary)
+  m_CropFilter->SetRegionOfInterest(region);
   m_CropFilter->Update();
 
+  // When segmenting on the native grid, the resampling is deferred to the
+  // final level set. The output information computed in
+  // GenerateOutputInformation() is the resampled grid in both cases.
+  const bool segmentOnNativeGrid = m_SegmentOnNativeGrid && m_ResampleThickSliceData &&
+                                   this->GetOutput()->GetSpacing() != m_CropFilter->GetOutput()->GetSpacing();
+
+  // The lung wall hole filling neighborhood is given in pixels, keep its
+  // physical extent when the pixels are anisotropic.
+  m_LungWallFeatureGenerator->SetUseImageSpacing(segmentOnNativeGrid);
+
   typename InputImageType::Pointer inputImage = nullptr;
-  if (m_ResampleThickSliceData)
+  if (m_ResampleThickSliceData && !segmentOnNativeGrid)
   {
     m_IsotropicResampler->Update();
     inputImage = this->m_IsotropicResampler->GetOutput();
@@ -199,43 +348,234 @@ LesionSegmentationImageFilter8<TInputImage, TOutputImage>::GenerateData()
   inputImage->DisconnectPipeline();
   m_InputSpatialObject->SetImage(inputImage);
 
-  // Sigma for the canny is the max spacing of the original input (before
-  // resampling)
-
-  if (m_UserSpecifiedSigmas == false)
+  // Do the actual segmentation, reporting the iterations of the level set
+  // when the filter is observed.
+  unsigned long iterationTag = 0;
+  const bool    reportIterations = this->HasObserver(IterationEvent());
+  if (reportIterations)
   {
-    double maxSpacing = NumericTraits<double>::min();
-    for (unsigned int i = 0; i < ImageDimension; i++)
-    {
-      maxSpacing = (maxSpacing < input->GetSpacing()[i] ? input->GetSpacing()[i] : maxSpacing);
-    }
-    m_CannyEdgesFeatureGenerator->SetSigma(maxSpacing);
+    iterationTag = m_SegmentationModule->AddObserver(IterationEvent(), m_CommandObserver);
   }
 
-  // Seeds
-
-  typename SeedSpatialObjectType::Pointer seedSpatialObject = SeedSpatialObjectType::New();
-  seedSpatialObject->SetPoints(m_Seeds);
-  m_LesionSegmentationMethod->SetInitialSegmentation(seedSpatialObject);
-
-  // Do the actual segmentation.
   m_LesionSegmentationMethod->Update();
 
-  // Graft the output.
+  if (reportIterations)
+  {
+    m_SegmentationModule->RemoveObserver(iterationTag);
+  }
+
   typename SpatialObjectType::Pointer segmentation = const_cast<SpatialObjectType *>(m_SegmentationModule->GetOutput());
   typename OutputSpatialObjectType::Pointer outputObject =
     dynamic_cast<OutputSpatialObjectType *>(segmentation.GetPointer());
   typename OutputImageType::Pointer outputImage = const_cast<OutputImageType *>(outputObject->GetImage());
   outputImage->DisconnectPipeline();
-  this->GraftOutput(outputImage);
 
-  /* // DEBUGGING CODE
-  using WriterType = ImageFileWriter< OutputImageType >;
-  typename WriterType::Pointer writer = WriterType::New();
-  writer->SetFileName("output.mha");
-  writer->SetInput(outputImage);
-  writer->UseCompressionOn();
-  writer->Write();*/
+  // Upsample the level set to the resampled grid of the region. Only the
+  // thick-slice axes are interpolated, the other axes are copied.
+  if (segmentOnNativeGrid)
+  {
+    m_IsotropicResampler->UpdateOutputInformation();
+
+    m_LevelSetResampler->SetInput(outputImage);
+    m_LevelSetResampler->SetOutputSpacing(this->GetOutput()->GetSpacing());
+    m_LevelSetResampler->SetSize(m_IsotropicResampler->GetOutput()->GetLargestPossibleRegion().GetSize());
+    // Outside value of the level set, once inverted by the module.
+    double outsideValue = -4.0;
+    if (!m_SegmentationModule->GetInvertOutputIntensities())
+    {
+      using CalculatorType = MinimumMaximumImageCalculator<OutputImageType>;
+      typename CalculatorType::Pointer calculator = CalculatorType::New();
+      calculator->SetImage(outputImage);
+      calculator->ComputeMaximum();
+      outsideValue = calculator->GetMaximum();
+    }
+    m_LevelSetResampler->SetDefaultPixelValue(outsideValue);
+    m_LevelSetResampler->Update();
+    outputImage = m_LevelSetResampler->GetOutput();
+    outputImage->DisconnectPipeline();
+  }
+
+  return outputImage;
+}
+
+
+template <typename TInputImage, typename TOutputImage>
+typename LesionSegmentationImageFilter8<TInputImage, TOutputImage>::OutputImageType::Pointer
+LesionSegmentationImageFilter8<TInputImage, TOutputImage>::SegmentAdaptiveRegion()
+{
+  const InputImageType * input = this->GetInput();
+
+  //
+  // Bounding box of the seeds, in the index space of the input.
+  //
+  IndexType lowerIndex;
+  IndexType upperIndex;
+  lowerIndex.Fill(NumericTraits<IndexValueType>::max());
+  upperIndex.Fill(NumericTraits<IndexValueType>::NonpositiveMin());
+
+  for (const auto & seed : m_Seeds)
+  {
+    const IndexType index = input->TransformPhysicalPointToIndex(seed.GetPositionInObjectSpace());
+    for (unsigned int d = 0; d < ImageDimension; ++d)
+    {
+      lowerIndex[d] = std::min(lowerIndex[d], index[d]);
+      upperIndex[d] = std::max(upperIndex[d], index[d]);
+    }
+  }
+
+  // Along the axes resampled for thick slices, the boxes cover the whole
+  // RegionOfInterest: the level sets of the boxes are then on the grid of
+  // the output, shifted by a whole number of pixels.
+  const SpacingType & outputSpacing = this->GetOutput()->GetSpacing();
+
+  // The level sets of the boxes are not normalized by the segmentation
+  // module. They are pasted on the output first, and the output is
+  // normalized as a whole, as the level set of the RegionOfInterest is.
+  m_SegmentationModule->InvertOutputIntensitiesOff();
+
+  typename OutputImageType::Pointer levelSet = nullptr;
+  RegionType                        region;
+  double                            radius = m_InitialRegionOfInterestRadius;
+
+  while (true)
+  {
+    bool isInside = !m_Seeds.empty();
+    for (unsigned int d = 0; d < ImageDimension && isInside; ++d)
+    {
+      if (Math::NotExactlyEquals(outputSpacing[d], input->GetSpacing()[d]))
+      {
+        region.SetIndex(d, m_RegionOfInterest.GetIndex(d));
+        region.SetSize(d, m_RegionOfInterest.GetSize(d));
+        continue;
+      }
+      const auto margin = static_cast<IndexValueType>(std::ceil(radius / input->GetSpacing()[d]));
+      region.SetIndex(d, lowerIndex[d] - margin);
+      region.SetSize(d, static_cast<SizeValueType>(upperIndex[d] - lowerIndex[d] + 2 * margin + 1));
+    }
+    isInside = isInside && region.Crop(m_RegionOfInterest);
+
+    if (!isInside || region == m_RegionOfInterest)
+    {
+      break;
+    }
+
+    levelSet = this->SegmentRegion(region);
+
+    if (!this->SegmentationReachesRegionBorder(levelSet, region))
+    {
+      break;
+    }
+
+    levelSet = nullptr;
+    radius *= 2.0;
+  }
+
+  m_SegmentationModule->InvertOutputIntensitiesOn();
+
+  if (!levelSet)
+  {
+    return this->SegmentRegion(m_RegionOfInterest);
+  }
+
+  //
+  // Paste the level set of the box on the output grid. The rest of the
+  // output is outside of the lesion, far from the front, where the level
+  // set of the RegionOfInterest has the value of the level set of the box
+  // at its faces.
+  //
+  using CalculatorType = MinimumMaximumImageCalculator<OutputImageType>;
+  typename CalculatorType::Pointer calculator = CalculatorType::New();
+  calculator->SetImage(levelSet);
+  calculator->Compute();
+
+  const RegionType & outputRegion = this->GetOutput()->GetLargestPossibleRegion();
+
+  typename OutputImageType::Pointer outputImage = OutputImageType::New();
+  outputImage->CopyInformation(this->GetOutput());
+  outputImage->SetRegions(outputRegion);
+  outputImage->Allocate();
+  outputImage->FillBuffer(calculator->GetMaximum());
+
+  RegionType pasteRegion = levelSet->GetLargestPossibleRegion();
+  for (unsigned int d = 0; d < ImageDimension; ++d)
+  {
+    pasteRegion.SetIndex(d, outputRegion.GetIndex(d) + region.GetIndex(d) - m_RegionOfInterest.GetIndex(d));
+  }
+  if (!outputRegion.IsInside(pasteRegion))
+  {
+    itkExceptionMacro("The level set of the region " << region << " does not fit in the output region "
+                                                     << outputRegion);
+  }
+
+  ImageRegionConstIterator<OutputImageType> lit(levelSet, levelSet->GetLargestPossibleRegion());
+  ImageRegionIterator<OutputImageType>      oit(outputImage, pasteRegion);
+  while (!lit.IsAtEnd())
+  {
+    oit.Set(lit.Get());
+    ++lit;
+    ++oit;
+  }
+
+  //
+  // Normalize the output as the segmentation module does.
+  //
+  using RescaleFilterType = IntensityWindowingImageFilter<OutputImageType, OutputImageType>;
+  typename RescaleFilterType::Pointer rescaler = RescaleFilterType::New();
+  rescaler->SetInput(outputImage);
+  rescaler->SetWindowMinimum(calculator->GetMinimum());
+  rescaler->SetWindowMaximum(calculator->GetMaximum());
+  rescaler->SetOutputMinimum(4.0);  // Note that the values must be [4:-4] here to
+  rescaler->SetOutputMaximum(-4.0); // make sure that we invert and not just rescale.
+  rescaler->InPlaceOn();
+  rescaler->Update();
+
+  outputImage = rescaler->GetOutput();
+  outputImage->DisconnectPipeline();
+  return outputImage;
+}
+
+
+template <typename TInputImage, typename TOutputImage>
+bool
+LesionSegmentationImageFilter8<TInputImage, TOutputImage>::SegmentationReachesRegionBorder(
+  const OutputImageType * levelSet,
+  const RegionType &      region) const
+{
+  const RegionType & levelSetRegion = levelSet->GetLargestPossibleRegion();
+
+  for (unsigned int d = 0; d < ImageDimension; ++d)
+  {
+    // Only the faces of the region that are inside the region of interest
+    // may be moved.
+    const bool lowerFaceIsInside = region.GetIndex(d) > m_RegionOfInterest.GetIndex(d);
+    const bool upperFaceIsInside = region.GetUpperIndex()[d] < m_RegionOfInterest.GetUpperIndex()[d];
+
+    for (unsigned int face = 0; face < 2; ++face)
+    {
+      if (!(face == 0 ? lowerFaceIsInside : upperFaceIsInside))
+      {
+        continue;
+      }
+
+      RegionType faceRegion = levelSetRegion;
+      faceRegion.SetSize(d, 1);
+      if (face == 1)
+      {
+        faceRegion.SetIndex(d, levelSetRegion.GetUpperIndex()[d]);
+      }
+
+      ImageRegionConstIterator<OutputImageType> it(levelSet, faceRegion);
+      for (; !it.IsAtEnd(); ++it)
+      {
+        if (it.Get() < 0.0)
+        {
+          return true;
+        }
+      }
+    }
+  }
+
+  return false;
 }
 
 
@@ -243,53 +583,85 @@ template <typename TInputImage, typename TOutputImage>
 void
 LesionSegmentationImageFilter8<TInputImage, TOutputImage>::ProgressUpdate(Object * caller, const EventObject & e)
 {
+  if (typeid(itk::IterationEvent) == typeid(e))
+  {
+    if (dynamic_cast<SegmentationModuleType *>(caller))
+    {
+      this->InvokeEvent(IterationEvent());
+    }
+    return;
+  }
+
+  //
+  // The stages run in sequence, and each one reports its progress within
+  // its share of the total progress. The shares follow the typical run
+  // times of the stages, the level set evolution and the vesselness being
+  // the most expensive ones.
+  //
   if (typeid(itk::ProgressEvent) == typeid(e))
   {
     if (dynamic_cast<CropFilterType *>(caller))
     {
       this->m_StatusMessage = "Cropping data..";
-      this->UpdateProgress(m_CropFilter->GetProgress());
+      this->UpdateStageProgress(0.0, 0.02, m_CropFilter->GetProgress());
     }
 
-    if (dynamic_cast<IsotropicResamplerType *>(caller))
+    else if (dynamic_cast<IsotropicResamplerType *>(caller))
     {
       this->m_StatusMessage = "Isotropic resampling of data using BSpline interpolation..";
-      this->UpdateProgress(m_IsotropicResampler->GetProgress());
+      this->UpdateStageProgress(0.02, 0.08, m_IsotropicResampler->GetProgress());
     }
 
     else if (dynamic_cast<LungWallGeneratorType *>(caller))
     {
-      // Given its iterative nature.. a cranky heuristic here.
       this->m_StatusMessage = "Generating lung wall feature by front propagation..";
-      this->UpdateProgress(((double)(((int)(m_LungWallFeatureGenerator->GetProgress() * 500)) % 100)) / 100.0);
+      this->UpdateStageProgress(0.10, 0.15, m_LungWallFeatureGenerator->GetProgress());
+    }
+
+    else if (dynamic_cast<VesselnessGeneratorType *>(caller))
+    {
+      m_StatusMessage = "Generating vesselness feature (Sato et al.)..";
+      this->UpdateStageProgress(0.25, 0.20, m_VesselnessFeatureGenerator->GetProgress());
     }
 
     else if (dynamic_cast<SigmoidFeatureGeneratorType *>(caller))
     {
       this->m_StatusMessage = "Generating intensity feature..";
-      this->UpdateProgress(m_SigmoidFeatureGenerator->GetProgress());
+      this->UpdateStageProgress(0.45, 0.02, m_SigmoidFeatureGenerator->GetProgress());
     }
 
     else if (dynamic_cast<CannyEdgesFeatureGeneratorType *>(caller))
     {
       m_StatusMessage = "Generating canny edge feature..";
-      this->UpdateProgress(m_CannyEdgesFeatureGenerator->GetProgress());
+      this->UpdateStageProgress(0.47, 0.08, m_CannyEdgesFeatureGenerator->GetProgress());
     }
 
-    else if (dynamic_cast<VesselnessGeneratorType *>(caller))
+    else if (dynamic_cast<SegmentationModuleType *>(caller))
     {
-      m_StatusMessage = "Generating vesselness feature (Sato et al.)..";
-      this->UpdateProgress(m_LungWallFeatureGenerator->GetProgress());
+      m_StatusMessage = "Segmenting using level sets..";
+      this->UpdateStageProgress(0.55, 0.42, m_SegmentationModule->GetProgress());
     }
 
-    else if (dynamic_cast<SegmentationModuleType *>(caller))
+    else if (dynamic_cast<LevelSetResamplerType *>(caller))
     {
-      m_StatusMessage = "Segmenting using level sets..";
-      this->UpdateProgress(m_SegmentationModule->GetProgress());
+      this->m_StatusMessage = "Resampling the segmentation to the output grid..";
+      this->UpdateStageProgress(0.97, 0.03, m_LevelSetResampler->GetProgress());
     }
   }
 }
 
+
+template <typename TInputImage, typename TOutputImage>
+void
+LesionSegmentationImageFilter8<TInputImage, TOutputImage>::UpdateStageProgress(double stageStart,
+                                                                              double stageWeight,
+                                                                              float  stageProgress)
+{
+  const double progress = std::min(std::max(static_cast<double>(stageProgress), 0.0), 1.0);
+  this->UpdateProgress(static_cast<float>(stageStart + stageWeight * progress));
+}
+
+
 template <typename TInputImage, typename TOutputImage>
 void
 LesionSegmentationImageFilter8<TInputImage, TOutputImage>::SetAbortGenerateData(bool abort)
@@ -297,6 +669,7 @@ LesionSegmentationImageFilter8<TInputImage, TOutputImage>::SetAbortGenerateData(
   this->Superclass::SetAbortGenerateData(abort);
   this->m_CropFilter->SetAbortGenerateData(abort);
   this->m_IsotropicResampler->SetAbortGenerateData(abort);
+  this->m_LevelSetResampler->SetAbortGenerateData(abort);
   this->m_LesionSegmentationMethod->SetAbortGenerateData(abort);
 }
 
@@ -19,6 +19,7 @@
 #define itkLocalStructureImageFilter_h
 
 #include "itkUnaryFunctorImageFilter.h"
+#include "itkEigenValueMeasureFunctions.h"
 #include "itkMath.h"
 
 namespace itk
@@ -54,8 +55,8 @@ class LocalStructure
 public:
   LocalStructure()
   {
-    m_Alpha = 0.25; // suggested value in the paper
-    m_Gamma = 0.50; // suggested value in the paper;
+    m_Alpha = 0.25;      // suggested value in the paper
+    this->SetGamma(0.5); // suggested value in the paper;
   }
   ~LocalStructure() = default;
   bool
@@ -69,85 +70,64 @@ public:
     return !(*this != other);
   }
   inline TOutput
-  operator()(const TInput & A)
+  operator()(const TInput & A) const
   {
     auto a1 = static_cast<double>(A[0]);
     auto a2 = static_cast<double>(A[1]);
     auto a3 = static_cast<double>(A[2]);
 
-    double l1 = itk::Math::abs(a1);
-    double l2 = itk::Math::abs(a2);
-    double l3 = itk::Math::abs(a3);
-
     //
     // Sort the values by their absolute value.
     //
-    if (l2 > l3)
-    {
-      double tmpl = l3;
-      l3 = l2;
-      l2 = tmpl;
-      double tmpa = a3;
-      a3 = a2;
-      a2 = tmpa;
-    }
-
-    if (l1 > l2)
-    {
-      double tmp = l1;
-      l1 = l2;
-      l2 = tmp;
-      double tmpa = a1;
-      a1 = a2;
-      a2 = tmpa;
-    }
-
-    if (l2 > l3)
-    {
-      double tmp = l3;
-      l3 = l2;
-      l2 = tmp;
-      double tmpa = a3;
-      a3 = a2;
-      a2 = tmpa;
-    }
+    SortByMagnitude(a1, a2, a3);
 
     //
     // Avoid divisions by zero.
     //
-    if (l3 < itk::Math::eps)
-    {
-      return 0.0;
-    }
+    const double L3 = itk::Math::abs(a3);
+    const bool   valid = !(L3 < itk::Math::eps);
 
-    const double L3 = itk::Math::abs(static_cast<double>(a3));
-    const double W = WeightFunctionOmega(a2, a3);
-    const double F = WeightFunctionOmega(a1, a3);
+    const double safeA3 = valid ? a3 : -1.0;
+
+    const double W = WeightFunctionOmega(a2, safeA3);
+    const double F = WeightFunctionOmega(a1, safeA3);
 
     const double sheetness = L3 * W * F;
 
-    return static_cast<TOutput>(sheetness);
+    return static_cast<TOutput>(valid ? sheetness : 0.0);
   }
-  inline double
-  WeightFunctionOmega(double ls, double lt) const
+
+  /** Evaluate the measure on a contiguous array of eigenvalue arrays. */
+  void
+  Evaluate(const TInput * input, TOutput * output, SizeValueType numberOfPixels) const
   {
-    if (ls <= 0.0 && lt <= ls)
+    for (SizeValueType i = 0; i < numberOfPixels; ++i)
     {
-      return (1 + std::pow(ls / itk::Math::abs(lt), m_Gamma));
+      output[i] = (*this)(input[i]);
     }
+  }
+
+  /** Weight function omega( ls ; lt ) of the paper, for |ls| <= |lt| */
+  inline double
+  WeightFunctionOmega(double ls, double lt) const
+  {
     const double abslt = itk::Math::abs(lt);
-    if (ls > 0.0 && abslt / m_Gamma > ls)
-    {
-      return std::pow(1 - m_Alpha * ls / itk::Math::abs(lt), m_Gamma);
-    }
-    return 0.0;
+    const double ratio = ls / abslt;
+
+    const bool negative = ls <= 0.0 && lt <= ls;
+    const bool positive = ls > 0.0 && m_Alpha * ls < abslt;
+
+    const double base = negative ? 1.0 + ratio : 1.0 - m_Alpha * ratio;
+    const double weight = m_Power(std::max(base, 0.0));
+
+    return (negative || positive) ? weight : 0.0;
   }
   inline double
   WeightFunctionPhi(double ls, double lt) const
   {
     if (ls < 0.0 && lt <= ls)
     {
-      return std::pow((ls / lt), m_Gamma);
+      return m_Power(ls / lt);
     }
     return 0.0;
   }
@@ -158,15 +138,19 @@ public:
     this->m_Alpha = value;
   }
 
+  /** Integer and half integer values of gamma are evaluated with
+   * multiplications and a square root instead of std::pow(). */
   void
   SetGamma(double value)
   {
     this->m_Gamma = value;
+    this->m_Power.SetExponent(value);
   }
 
 private:
-  double m_Alpha;
-  double m_Gamma;
+  double                 m_Alpha;
+  double                 m_Gamma;
+  PowerWithFixedExponent m_Power;
 };
 } // namespace Function
 
@@ -85,6 +85,19 @@ public:
   itkSetMacro(LungThreshold, InputPixelType);
   itkGetMacro(LungThreshold, InputPixelType);
 
+  /** Scale the radius of the hole filling neighborhood along each axis by the
+   * spacing of the input, so that the neighborhood keeps the same physical
+   * extent along all axes. The radius is three pixels along the axis with the
+   * finest spacing. Useful on anisotropic images. Defaults to false, in which
+   * case the radius is three pixels along all axes. */
+  itkSetMacro(UseImageSpacing, bool);
+  itkGetMacro(UseImageSpacing, bool);
+  itkBooleanMacro(UseImageSpacing);
+
+  /** Print the parameters that determine the feature. */
+  void
+  PrintParameters(std::ostream & os) const override;
+
 protected:
   LungWallFeatureGenerator();
   ~LungWallFeatureGenerator() override;
@@ -115,6 +128,7 @@ private:
   VotingHoleFillingFilterPointer m_VotingHoleFillingFilter;
 
   InputPixelType m_LungThreshold;
+  bool           m_UseImageSpacing;
 };
 
 } // end namespace itk
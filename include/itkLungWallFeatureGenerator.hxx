@@ -20,6 +20,9 @@
 
 #include "itkProgressAccumulator.h"
 
+#include <algorithm>
+#include <cmath>
+
 
 namespace itk
 {
@@ -44,6 +47,7 @@ LungWallFeatureGenerator<NDimension>::LungWallFeatureGenerator()
   this->ProcessObject::SetNthOutput(0, outputObject.GetPointer());
 
   this->m_LungThreshold = -400;
+  this->m_UseImageSpacing = false;
 }
 
 
@@ -83,6 +87,20 @@ LungWallFeatureGenerator<NDimension>::PrintSelf(std::ostream & os, Indent indent
 {
   Superclass::PrintSelf(os, indent);
   os << indent << "Lung threshold " << this->m_ThresholdFilter << std::endl;
+  os << indent << "Use image spacing " << this->m_UseImageSpacing << std::endl;
+}
+
+
+/**
+ * PrintParameters
+ */
+template <unsigned int NDimension>
+void
+LungWallFeatureGenerator<NDimension>::PrintParameters(std::ostream & os) const
+{
+  Superclass::PrintParameters(os);
+  os << "LungThreshold " << this->m_LungThreshold << std::endl;
+  os << "UseImageSpacing " << this->m_UseImageSpacing << std::endl;
 }
 
 
@@ -127,6 +145,23 @@ LungWallFeatureGenerator<NDimension>::GenerateData()
 
   ballManhattanRadius.Fill(3);
 
+  if (this->m_UseImageSpacing)
+  {
+    const typename InputImageType::SpacingType & spacing = inputImage->GetSpacing();
+
+    double minSpacing = NumericTraits<double>::max();
+    for (unsigned int i = 0; i < Dimension; i++)
+    {
+      minSpacing = std::min(minSpacing, static_cast<double>(spacing[i]));
+    }
+
+    for (unsigned int i = 0; i < Dimension; i++)
+    {
+      const double radius = std::round(3.0 * minSpacing / spacing[i]);
+      ballManhattanRadius[i] = std::max(static_cast<SizeValueType>(radius), SizeValueType{ 1 });
+    }
+  }
+
   this->m_VotingHoleFillingFilter->SetRadius(ballManhattanRadius);
   this->m_VotingHoleFillingFilter->SetBackgroundValue(0.0);
   this->m_VotingHoleFillingFilter->SetForegroundValue(1.0);
@@ -88,6 +88,10 @@ public:
   itkSetMacro(LungThreshold, InputPixelType);
   itkGetMacro(LungThreshold, InputPixelType);
 
+  /** Print the parameters that determine the feature. */
+  void
+  PrintParameters(std::ostream & os) const override;
+
 protected:
   MorphologicalOpeningFeatureGenerator();
   ~MorphologicalOpeningFeatureGenerator() override;
@@ -90,6 +90,18 @@ MorphologicalOpeningFeatureGenerator<NDimension>::PrintSelf(std::ostream & os, I
 }
 
 
+/**
+ * PrintParameters
+ */
+template <unsigned int NDimension>
+void
+MorphologicalOpeningFeatureGenerator<NDimension>::PrintParameters(std::ostream & os) const
+{
+  Superclass::PrintParameters(os);
+  os << "LungThreshold " << this->m_LungThreshold << std::endl;
+}
+
+
 /*
  * Generate Data
  */
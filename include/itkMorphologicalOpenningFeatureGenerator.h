@@ -86,6 +86,10 @@ public:
   itkSetMacro(LungThreshold, InputPixelType);
   itkGetMacro(LungThreshold, InputPixelType);
 
+  /** Print the parameters that determine the feature. */
+  void
+  PrintParameters(std::ostream & os) const;
+
 protected:
   MorphologicalOpenningFeatureGenerator();
   virtual ~MorphologicalOpenningFeatureGenerator();
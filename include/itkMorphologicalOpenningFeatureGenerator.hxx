@@ -91,6 +91,18 @@ MorphologicalOpenningFeatureGenerator<NDimension>::PrintSelf(std::ostream & os,
 }
 
 
+/**
+ * PrintParameters
+ */
+template <unsigned int NDimension>
+void
+MorphologicalOpenningFeatureGenerator<NDimension>::PrintParameters(std::ostream & os) const
+{
+  Superclass::PrintParameters(os);
+  os << "LungThreshold " << this->m_LungThreshold << std::endl;
+}
+
+
 /*
  * Generate Data
  */
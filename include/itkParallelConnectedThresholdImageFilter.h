@@ -0,0 +1,156 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkParallelConnectedThresholdImageFilter_h
+#define itkParallelConnectedThresholdImageFilter_h
+
+#include "itkImageToImageFilter.h"
+
+#include <vector>
+
+namespace itk
+{
+
+/** \class ParallelConnectedThresholdImageFilter
+ *
+ * \brief Multithreaded flood fill of the pixels connected to seeds and
+ * within an intensity interval.
+ *
+ * This filter labels the same pixels as the ConnectedThresholdImageFilter
+ * with face connectivity: the pixels whose intensity lies within
+ * [Lower, Upper] and that are connected to one of the seeds through such
+ * pixels. Seeds outside of the interval are ignored.
+ *
+ * The region is grown in breadth first order, one layer of pixels at a
+ * time. The pixels of the current layer are distributed among the threads,
+ * which test the neighbors of their pixels and claim the ones that belong to
+ * the region in a one byte per pixel mask. The claimed pixels form the next
+ * layer. The claims are atomic, so that every pixel is added once, and the
+ * region does not depend on the number of threads.
+ *
+ * The mask is converted to the output in a single multithreaded pass: the
+ * pixels of the region are set to the ReplaceValue and the other pixels to
+ * the OutsideValue. With a floating point output, the values of a level set,
+ * for instance, are written directly without a separate pass over the
+ * output.
+ *
+ * \sa ConnectedThresholdImageFilter
+ *
+ * \ingroup RegionGrowingSegmentation Multithreaded
+ * \ingroup LesionSizingToolkit
+ */
+template <typename TInputImage, typename TOutputImage>
+class ITK_TEMPLATE_EXPORT ParallelConnectedThresholdImageFilter : public ImageToImageFilter<TInputImage, TOutputImage>
+{
+public:
+  ITK_DISALLOW_COPY_AND_MOVE(ParallelConnectedThresholdImageFilter);
+
+  /** Standard class type alias. */
+  using Self = ParallelConnectedThresholdImageFilter;
+  using Superclass = ImageToImageFilter<TInputImage, TOutputImage>;
+  using Pointer = SmartPointer<Self>;
+  using ConstPointer = SmartPointer<const Self>;
+
+  /** Method for creation through the object factory. */
+  itkNewMacro(Self);
+
+  /** Run-time type information (and related methods). */
+  itkOverrideGetNameOfClassMacro(ParallelConnectedThresholdImageFilter);
+
+  /** Image dimension constant */
+  static constexpr unsigned int ImageDimension = TOutputImage::ImageDimension;
+
+  using InputImageType = TInputImage;
+  using InputPixelType = typename InputImageType::PixelType;
+  using OutputImageType = TOutputImage;
+  using OutputPixelType = typename OutputImageType::PixelType;
+  using OutputImageRegionType = typename OutputImageType::RegionType;
+  using IndexType = typename OutputImageType::IndexType;
+  using SeedContainerType = std::vector<IndexType>;
+
+  /** Set/Add/Clear the seeds of the region. */
+  void
+  SetSeed(const IndexType & seed);
+  void
+  AddSeed(const IndexType & seed);
+  void
+  ClearSeeds();
+  const SeedContainerType &
+  GetSeeds() const
+  {
+    return this->m_Seeds;
+  }
+
+  /** Bounds of the intensity interval, included in the interval. */
+  itkSetMacro(Lower, InputPixelType);
+  itkGetConstMacro(Lower, InputPixelType);
+  itkSetMacro(Upper, InputPixelType);
+  itkGetConstMacro(Upper, InputPixelType);
+
+  /** Value of the pixels of the region. Defaults to one. */
+  itkSetMacro(ReplaceValue, OutputPixelType);
+  itkGetConstMacro(ReplaceValue, OutputPixelType);
+
+  /** Value of the pixels outside of the region. Defaults to zero. */
+  itkSetMacro(OutsideValue, OutputPixelType);
+  itkGetConstMacro(OutsideValue, OutputPixelType);
+
+  /** Number of pixels of the region found by the last execution of the
+   * filter. */
+  itkGetConstMacro(NumberOfRegionPixels, SizeValueType);
+
+#ifdef ITK_USE_CONCEPT_CHECKING
+  /** Begin concept checking */
+  itkConceptMacro(SameDimensionCheck, (Concept::SameDimension<TInputImage::ImageDimension, ImageDimension>));
+  itkConceptMacro(InputComparableCheck, (Concept::LessThanComparable<InputPixelType>));
+  /** End concept checking */
+#endif
+
+protected:
+  ParallelConnectedThresholdImageFilter();
+  ~ParallelConnectedThresholdImageFilter() override = default;
+
+  void
+  PrintSelf(std::ostream & os, Indent indent) const override;
+
+  /** The whole input is requested, since the region may reach any pixel. */
+  void
+  GenerateInputRequestedRegion() override;
+
+  /** The whole output is produced. */
+  void
+  EnlargeOutputRequestedRegion(DataObject * output) override;
+
+  void
+  GenerateData() override;
+
+private:
+  SeedContainerType m_Seeds;
+  InputPixelType    m_Lower;
+  InputPixelType    m_Upper;
+  OutputPixelType   m_ReplaceValue;
+  OutputPixelType   m_OutsideValue;
+  SizeValueType     m_NumberOfRegionPixels;
+};
+
+} // end namespace itk
+
+#ifndef ITK_MANUAL_INSTANTIATION
+#  include "itkParallelConnectedThresholdImageFilter.hxx"
+#endif
+
+#endif
@@ -0,0 +1,292 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkParallelConnectedThresholdImageFilter_hxx
+#define itkParallelConnectedThresholdImageFilter_hxx
+
+#include "itkMultiThreaderBase.h"
+#include "itkNumericTraits.h"
+
+#include <algorithm>
+#include <atomic>
+#include <memory>
+
+namespace itk
+{
+
+/**
+ * Constructor
+ */
+template <typename TInputImage, typename TOutputImage>
+ParallelConnectedThresholdImageFilter<TInputImage, TOutputImage>::ParallelConnectedThresholdImageFilter()
+{
+  this->m_Lower = NumericTraits<InputPixelType>::NonpositiveMin();
+  this->m_Upper = NumericTraits<InputPixelType>::max();
+  this->m_ReplaceValue = NumericTraits<OutputPixelType>::OneValue();
+  this->m_OutsideValue = NumericTraits<OutputPixelType>::ZeroValue();
+  this->m_NumberOfRegionPixels = 0;
+}
+
+
+/**
+ * PrintSelf
+ */
+template <typename TInputImage, typename TOutputImage>
+void
+ParallelConnectedThresholdImageFilter<TInputImage, TOutputImage>::PrintSelf(std::ostream & os, Indent indent) const
+{
+  Superclass::PrintSelf(os, indent);
+  os << indent << "NumberOfSeeds = " << this->m_Seeds.size() << std::endl;
+  os << indent << "Lower = " << static_cast<typename NumericTraits<InputPixelType>::PrintType>(this->m_Lower)
+     << std::endl;
+  os << indent << "Upper = " << static_cast<typename NumericTraits<InputPixelType>::PrintType>(this->m_Upper)
+     << std::endl;
+  os << indent << "ReplaceValue = "
+     << static_cast<typename NumericTraits<OutputPixelType>::PrintType>(this->m_ReplaceValue) << std::endl;
+  os << indent << "OutsideValue = "
+     << static_cast<typename NumericTraits<OutputPixelType>::PrintType>(this->m_OutsideValue) << std::endl;
+  os << indent << "NumberOfRegionPixels = " << this->m_NumberOfRegionPixels << std::endl;
+}
+
+
+/**
+ * Seeds
+ */
+template <typename TInputImage, typename TOutputImage>
+void
+ParallelConnectedThresholdImageFilter<TInputImage, TOutputImage>::SetSeed(const IndexType & seed)
+{
+  this->m_Seeds.clear();
+  this->AddSeed(seed);
+}
+
+
+template <typename TInputImage, typename TOutputImage>
+void
+ParallelConnectedThresholdImageFilter<TInputImage, TOutputImage>::AddSeed(const IndexType & seed)
+{
+  this->m_Seeds.push_back(seed);
+  this->Modified();
+}
+
+
+template <typename TInputImage, typename TOutputImage>
+void
+ParallelConnectedThresholdImageFilter<TInputImage, TOutputImage>::ClearSeeds()
+{
+  if (!this->m_Seeds.empty())
+  {
+    this->m_Seeds.clear();
+    this->Modified();
+  }
+}
+
+
+/**
+ * Request the whole input
+ */
+template <typename TInputImage, typename TOutputImage>
+void
+ParallelConnectedThresholdImageFilter<TInputImage, TOutputImage>::GenerateInputRequestedRegion()
+{
+  Superclass::GenerateInputRequestedRegion();
+
+  if (this->GetInput())
+  {
+    auto * input = const_cast<InputImageType *>(this->GetInput());
+    input->SetRequestedRegionToLargestPossibleRegion();
+  }
+}
+
+
+/**
+ * Produce the whole output
+ */
+template <typename TInputImage, typename TOutputImage>
+void
+ParallelConnectedThresholdImageFilter<TInputImage, TOutputImage>::EnlargeOutputRequestedRegion(DataObject * output)
+{
+  Superclass::EnlargeOutputRequestedRegion(output);
+  output->SetRequestedRegionToLargestPossibleRegion();
+}
+
+
+/*
+ * Generate Data
+ */
+template <typename TInputImage, typename TOutputImage>
+void
+ParallelConnectedThresholdImageFilter<TInputImage, TOutputImage>::GenerateData()
+{
+  const InputImageType * inputImage = this->GetInput();
+  OutputImageType *      outputImage = this->GetOutput();
+
+  const OutputImageRegionType region = outputImage->GetRequestedRegion();
+
+  outputImage->SetBufferedRegion(region);
+  outputImage->Allocate();
+
+  this->m_NumberOfRegionPixels = 0;
+
+  if (inputImage->GetBufferedRegion() != region)
+  {
+    itkExceptionMacro("The buffered region of the input image " << inputImage->GetBufferedRegion()
+                                                                << " differs from the output region " << region);
+  }
+
+  const InputPixelType *  inputBuffer = inputImage->GetBufferPointer();
+  OutputPixelType *       outputBuffer = outputImage->GetBufferPointer();
+  const OffsetValueType * offsetTable = outputImage->GetOffsetTable();
+  const IndexType &       start = region.GetIndex();
+  const auto &            size = region.GetSize();
+  const SizeValueType     numberOfPixels = region.GetNumberOfPixels();
+
+  const InputPixelType lower = this->m_Lower;
+  const InputPixelType upper = this->m_Upper;
+
+  auto isInside = [&](OffsetValueType offset) {
+    const InputPixelType value = inputBuffer[offset];
+    return !(value < lower) && !(upper < value);
+  };
+
+  MultiThreaderBase * multiThreader = this->GetMultiThreader();
+  multiThreader->SetNumberOfWorkUnits(this->GetNumberOfWorkUnits());
+
+  // The passes over the whole image are done in blocks of fixed length, the
+  // layers of the region in chunks of fixed length.
+  constexpr SizeValueType blockLength = 65536;
+  constexpr SizeValueType chunkLength = 1024;
+  const SizeValueType     numberOfBlocks = (numberOfPixels + blockLength - 1) / blockLength;
+
+  std::unique_ptr<std::atomic<unsigned char>[]> mask(new std::atomic<unsigned char>[numberOfPixels]);
+
+  multiThreader->ParallelizeArray(
+    0,
+    numberOfBlocks,
+    [&](SizeValueType block) {
+      const SizeValueType last = std::min(numberOfPixels, (block + 1) * blockLength);
+      for (SizeValueType i = block * blockLength; i < last; ++i)
+      {
+        mask[i].store(0, std::memory_order_relaxed);
+      }
+    },
+    nullptr);
+
+  std::vector<OffsetValueType> layer;
+  for (const IndexType & seed : this->m_Seeds)
+  {
+    if (!region.IsInside(seed))
+    {
+      continue;
+    }
+    const OffsetValueType offset = outputImage->ComputeOffset(seed);
+    if (isInside(offset) && mask[offset].load(std::memory_order_relaxed) == 0)
+    {
+      mask[offset].store(1, std::memory_order_relaxed);
+      layer.push_back(offset);
+    }
+  }
+
+  //
+  // Grow the region one layer at a time. A neighbor is claimed by the first
+  // thread that exchanges its mask value.
+  //
+  std::vector<std::vector<OffsetValueType>> nextLayers;
+
+  while (!layer.empty())
+  {
+    this->m_NumberOfRegionPixels += layer.size();
+
+    const SizeValueType numberOfLayerPixels = layer.size();
+    const SizeValueType numberOfChunks = (numberOfLayerPixels + chunkLength - 1) / chunkLength;
+
+    nextLayers.resize(numberOfChunks);
+
+    multiThreader->ParallelizeArray(
+      0,
+      numberOfChunks,
+      [&](SizeValueType chunk) {
+        std::vector<OffsetValueType> & nextLayer = nextLayers[chunk];
+        nextLayer.clear();
+
+        auto claim = [&](OffsetValueType neighbor) {
+          if (mask[neighbor].load(std::memory_order_relaxed) == 0 && isInside(neighbor) &&
+              mask[neighbor].exchange(1, std::memory_order_relaxed) == 0)
+          {
+            nextLayer.push_back(neighbor);
+          }
+        };
+
+        const SizeValueType last = std::min(numberOfLayerPixels, (chunk + 1) * chunkLength);
+        for (SizeValueType i = chunk * chunkLength; i < last; ++i)
+        {
+          const OffsetValueType offset = layer[i];
+          const IndexType       index = outputImage->ComputeIndex(offset);
+          for (unsigned int d = 0; d < ImageDimension; ++d)
+          {
+            if (index[d] > start[d])
+            {
+              claim(offset - offsetTable[d]);
+            }
+            if (index[d] + 1 < start[d] + static_cast<IndexValueType>(size[d]))
+            {
+              claim(offset + offsetTable[d]);
+            }
+          }
+        }
+      },
+      nullptr);
+
+    layer.clear();
+    for (SizeValueType chunk = 0; chunk < numberOfChunks; ++chunk)
+    {
+      layer.insert(layer.end(), nextLayers[chunk].begin(), nextLayers[chunk].end());
+    }
+
+    if (this->GetAbortGenerateData())
+    {
+      ProcessAborted e(__FILE__, __LINE__);
+      e.SetDescription("Process aborted.");
+      e.SetLocation(ITK_LOCATION);
+      throw e;
+    }
+  }
+
+  //
+  // Convert the mask to the output values.
+  //
+  const OutputPixelType replaceValue = this->m_ReplaceValue;
+  const OutputPixelType outsideValue = this->m_OutsideValue;
+
+  multiThreader->ParallelizeArray(
+    0,
+    numberOfBlocks,
+    [&](SizeValueType block) {
+      const SizeValueType last = std::min(numberOfPixels, (block + 1) * blockLength);
+      for (SizeValueType i = block * blockLength; i < last; ++i)
+      {
+        outputBuffer[i] = mask[i].load(std::memory_order_relaxed) ? replaceValue : outsideValue;
+      }
+    },
+    nullptr);
+
+  this->UpdateProgress(1.0f);
+}
+
+} // end namespace itk
+
+#endif
@@ -0,0 +1,131 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkParallelSegmentationLevelSetImageFilter_h
+#define itkParallelSegmentationLevelSetImageFilter_h
+
+#include "itkParallelSparseFieldLevelSetImageFilter.h"
+#include "itkSegmentationLevelSetFunction.h"
+
+namespace itk
+{
+
+/** \class ParallelSegmentationLevelSetImageFilter
+ *
+ * \brief Solves a segmentation level set equation with the multithreaded
+ * sparse field solver.
+ *
+ * This filter plays the role of the SegmentationLevelSetImageFilter, on top
+ * of the ParallelSparseFieldLevelSetImageFilter instead of the serial
+ * SparseFieldLevelSetImageFilter. The image is split in slabs along its last
+ * dimension, and the active layers of each slab are updated by a separate
+ * thread. The equation is the one of the SegmentationLevelSetFunction given
+ * with SetSegmentationFunction(), for instance a
+ * GeodesicActiveContourLevelSetFunction or a ShapeDetectionLevelSetFunction,
+ * so that the same PDE is solved as with the serial filters, and the results
+ * only differ within the RMS tolerance of the solvers.
+ *
+ * The speed and advection images of the function are computed from the
+ * feature image before the evolution starts, in the same way as done by the
+ * SegmentationLevelSetImageFilter.
+ *
+ * \ingroup LevelSetSegmentation Multithreaded
+ * \ingroup LesionSizingToolkit
+ */
+template <typename TInputImage, typename TFeatureImage, typename TOutputPixelType = float>
+class ITK_TEMPLATE_EXPORT ParallelSegmentationLevelSetImageFilter
+  : public ParallelSparseFieldLevelSetImageFilter<TInputImage, Image<TOutputPixelType, TInputImage::ImageDimension>>
+{
+public:
+  ITK_DISALLOW_COPY_AND_MOVE(ParallelSegmentationLevelSetImageFilter);
+
+  /** Standard class type alias. */
+  using Self = ParallelSegmentationLevelSetImageFilter;
+  using OutputImageType = Image<TOutputPixelType, TInputImage::ImageDimension>;
+  using Superclass = ParallelSparseFieldLevelSetImageFilter<TInputImage, OutputImageType>;
+  using Pointer = SmartPointer<Self>;
+  using ConstPointer = SmartPointer<const Self>;
+
+  /** Method for creation through the object factory. */
+  itkNewMacro(Self);
+
+  /** Run-time type information (and related methods). */
+  itkOverrideGetNameOfClassMacro(ParallelSegmentationLevelSetImageFilter);
+
+  /** Image dimension constant */
+  static constexpr unsigned int ImageDimension = TInputImage::ImageDimension;
+
+  using InputImageType = TInputImage;
+  using FeatureImageType = TFeatureImage;
+  using ValueType = typename Superclass::ValueType;
+
+  /** The function that defines the segmentation equation. */
+  using SegmentationFunctionType = SegmentationLevelSetFunction<OutputImageType, FeatureImageType>;
+
+  /** Set/Get the feature image from which the speed and advection images
+   * of the segmentation function are computed. */
+  void
+  SetFeatureImage(const FeatureImageType * featureImage);
+  const FeatureImageType *
+  GetFeatureImage() const;
+
+  /** Set/Get the segmentation function solved by the filter. It must be set
+   * before the filter is updated. */
+  void
+  SetSegmentationFunction(SegmentationFunctionType * function);
+  itkGetModifiableObjectMacro(SegmentationFunction, SegmentationFunctionType);
+
+  /** Weight of the propagation term of the segmentation function. */
+  void
+  SetPropagationScaling(ValueType value);
+  ValueType
+  GetPropagationScaling() const;
+
+  /** Weight of the curvature term of the segmentation function. */
+  void
+  SetCurvatureScaling(ValueType value);
+  ValueType
+  GetCurvatureScaling() const;
+
+  /** Weight of the advection term of the segmentation function. */
+  void
+  SetAdvectionScaling(ValueType value);
+  ValueType
+  GetAdvectionScaling() const;
+
+protected:
+  ParallelSegmentationLevelSetImageFilter();
+  ~ParallelSegmentationLevelSetImageFilter() override = default;
+
+  void
+  PrintSelf(std::ostream & os, Indent indent) const override;
+
+  /** Compute the speed and advection images and run the solver. */
+  void
+  GenerateData() override;
+
+private:
+  typename SegmentationFunctionType::Pointer m_SegmentationFunction;
+};
+
+} // end namespace itk
+
+#ifndef ITK_MANUAL_INSTANTIATION
+#  include "itkParallelSegmentationLevelSetImageFilter.hxx"
+#endif
+
+#endif
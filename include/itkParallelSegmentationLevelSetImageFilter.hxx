@@ -0,0 +1,221 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkParallelSegmentationLevelSetImageFilter_hxx
+#define itkParallelSegmentationLevelSetImageFilter_hxx
+
+#include "itkMath.h"
+
+namespace itk
+{
+
+/**
+ * Constructor
+ */
+template <typename TInputImage, typename TFeatureImage, typename TOutputPixelType>
+ParallelSegmentationLevelSetImageFilter<TInputImage, TFeatureImage, TOutputPixelType>::
+  ParallelSegmentationLevelSetImageFilter()
+{
+  this->SetNumberOfRequiredInputs(2);
+  this->SetNumberOfLayers(ImageDimension);
+  this->SetIsoSurfaceValue(ValueType{});
+
+  // Same defaults as the serial SegmentationLevelSetImageFilter.
+  this->SetMaximumRMSError(0.02);
+  this->SetNumberOfIterations(1000);
+
+  this->m_SegmentationFunction = nullptr;
+}
+
+
+/**
+ * PrintSelf
+ */
+template <typename TInputImage, typename TFeatureImage, typename TOutputPixelType>
+void
+ParallelSegmentationLevelSetImageFilter<TInputImage, TFeatureImage, TOutputPixelType>::PrintSelf(std::ostream & os,
+                                                                                                  Indent indent) const
+{
+  Superclass::PrintSelf(os, indent);
+  os << indent << "SegmentationFunction = " << this->m_SegmentationFunction.GetPointer() << std::endl;
+  if (this->m_SegmentationFunction)
+  {
+    os << indent << "PropagationScaling = " << this->GetPropagationScaling() << std::endl;
+    os << indent << "CurvatureScaling = " << this->GetCurvatureScaling() << std::endl;
+    os << indent << "AdvectionScaling = " << this->GetAdvectionScaling() << std::endl;
+  }
+}
+
+
+/**
+ * Feature image
+ */
+template <typename TInputImage, typename TFeatureImage, typename TOutputPixelType>
+void
+ParallelSegmentationLevelSetImageFilter<TInputImage, TFeatureImage, TOutputPixelType>::SetFeatureImage(
+  const FeatureImageType * featureImage)
+{
+  this->ProcessObject::SetNthInput(1, const_cast<FeatureImageType *>(featureImage));
+}
+
+
+template <typename TInputImage, typename TFeatureImage, typename TOutputPixelType>
+const typename ParallelSegmentationLevelSetImageFilter<TInputImage, TFeatureImage, TOutputPixelType>::FeatureImageType *
+ParallelSegmentationLevelSetImageFilter<TInputImage, TFeatureImage, TOutputPixelType>::GetFeatureImage() const
+{
+  return itkDynamicCastInDebugMode<const FeatureImageType *>(this->ProcessObject::GetInput(1));
+}
+
+
+/**
+ * Segmentation function
+ */
+template <typename TInputImage, typename TFeatureImage, typename TOutputPixelType>
+void
+ParallelSegmentationLevelSetImageFilter<TInputImage, TFeatureImage, TOutputPixelType>::SetSegmentationFunction(
+  SegmentationFunctionType * function)
+{
+  if (this->m_SegmentationFunction == function)
+  {
+    return;
+  }
+
+  this->m_SegmentationFunction = function;
+
+  if (function)
+  {
+    typename SegmentationFunctionType::RadiusType radius;
+    radius.Fill(1);
+    function->Initialize(radius);
+  }
+
+  this->SetDifferenceFunction(function);
+  this->Modified();
+}
+
+
+/**
+ * Weights of the terms of the segmentation function
+ */
+template <typename TInputImage, typename TFeatureImage, typename TOutputPixelType>
+void
+ParallelSegmentationLevelSetImageFilter<TInputImage, TFeatureImage, TOutputPixelType>::SetPropagationScaling(
+  ValueType value)
+{
+  if (Math::NotExactlyEquals(value, this->m_SegmentationFunction->GetPropagationWeight()))
+  {
+    this->m_SegmentationFunction->SetPropagationWeight(value);
+    this->Modified();
+  }
+}
+
+
+template <typename TInputImage, typename TFeatureImage, typename TOutputPixelType>
+typename ParallelSegmentationLevelSetImageFilter<TInputImage, TFeatureImage, TOutputPixelType>::ValueType
+ParallelSegmentationLevelSetImageFilter<TInputImage, TFeatureImage, TOutputPixelType>::GetPropagationScaling() const
+{
+  return this->m_SegmentationFunction->GetPropagationWeight();
+}
+
+
+template <typename TInputImage, typename TFeatureImage, typename TOutputPixelType>
+void
+ParallelSegmentationLevelSetImageFilter<TInputImage, TFeatureImage, TOutputPixelType>::SetCurvatureScaling(
+  ValueType value)
+{
+  if (Math::NotExactlyEquals(value, this->m_SegmentationFunction->GetCurvatureWeight()))
+  {
+    this->m_SegmentationFunction->SetCurvatureWeight(value);
+    this->Modified();
+  }
+}
+
+
+template <typename TInputImage, typename TFeatureImage, typename TOutputPixelType>
+typename ParallelSegmentationLevelSetImageFilter<TInputImage, TFeatureImage, TOutputPixelType>::ValueType
+ParallelSegmentationLevelSetImageFilter<TInputImage, TFeatureImage, TOutputPixelType>::GetCurvatureScaling() const
+{
+  return this->m_SegmentationFunction->GetCurvatureWeight();
+}
+
+
+template <typename TInputImage, typename TFeatureImage, typename TOutputPixelType>
+void
+ParallelSegmentationLevelSetImageFilter<TInputImage, TFeatureImage, TOutputPixelType>::SetAdvectionScaling(
+  ValueType value)
+{
+  if (Math::NotExactlyEquals(value, this->m_SegmentationFunction->GetAdvectionWeight()))
+  {
+    this->m_SegmentationFunction->SetAdvectionWeight(value);
+    this->Modified();
+  }
+}
+
+
+template <typename TInputImage, typename TFeatureImage, typename TOutputPixelType>
+typename ParallelSegmentationLevelSetImageFilter<TInputImage, TFeatureImage, TOutputPixelType>::ValueType
+ParallelSegmentationLevelSetImageFilter<TInputImage, TFeatureImage, TOutputPixelType>::GetAdvectionScaling() const
+{
+  return this->m_SegmentationFunction->GetAdvectionWeight();
+}
+
+
+/*
+ * Generate Data
+ */
+template <typename TInputImage, typename TFeatureImage, typename TOutputPixelType>
+void
+ParallelSegmentationLevelSetImageFilter<TInputImage, TFeatureImage, TOutputPixelType>::GenerateData()
+{
+  if (this->m_SegmentationFunction == nullptr)
+  {
+    itkExceptionMacro("No segmentation function was set.");
+  }
+
+  const FeatureImageType * featureImage = this->GetFeatureImage();
+
+  if (featureImage == nullptr)
+  {
+    itkExceptionMacro("No feature image was set.");
+  }
+
+  this->m_SegmentationFunction->SetFeatureImage(featureImage);
+
+  //
+  // The speed image is always needed: the curvature term of the geodesic
+  // active contours and of the shape detection is also weighted by the speed,
+  // even when the propagation weight is zero.
+  //
+  this->m_SegmentationFunction->AllocateSpeedImage();
+  this->m_SegmentationFunction->CalculateSpeedImage();
+
+  if (Math::NotExactlyEquals(this->m_SegmentationFunction->GetAdvectionWeight(), ValueType{}))
+  {
+    this->m_SegmentationFunction->AllocateAdvectionImage();
+    this->m_SegmentationFunction->CalculateAdvectionImage();
+  }
+
+  // Scale the derivatives of the function by the image spacing when
+  // UseImageSpacing is on, as the serial solver does.
+  this->InitializeFunctionCoefficients();
+
+  Superclass::GenerateData();
+}
+
+} // end namespace itk
+
+#endif
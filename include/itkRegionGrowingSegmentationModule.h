@@ -72,6 +72,10 @@ public:
   /** Type of the input set of seed points. They are stored in a Landmark Spatial Object. */
   using InputSpatialObjectType = LandmarkSpatialObject<NDimension>;
 
+  /** Values of the output image inside and outside of the region. */
+  static constexpr OutputPixelType InsideValue = 4.0;
+  static constexpr OutputPixelType OutsideValue = -4.0;
+
 protected:
   RegionGrowingSegmentationModule();
   ~RegionGrowingSegmentationModule() override;
@@ -83,10 +87,18 @@ protected:
   void
   GenerateData() override;
 
-  /** Set the output image as cargo of the output SpatialObject. */
+  /** Set the output image as cargo of the output SpatialObject. Its non
+   * zero pixels are set to the InsideValue and the other pixels to the
+   * OutsideValue. */
   void
   PackOutputImageInOutputSpatialObject(OutputImageType * outputImage);
 
+  /** Set the output image as cargo of the output SpatialObject, when its
+   * pixels already have the InsideValue and the OutsideValue. This saves the
+   * conversion pass over the image. */
+  void
+  PackCenteredRangeImageInOutputSpatialObject(OutputImageType * outputImage);
+
   /** Extract the input set of landmark points to be used as seeds. */
   const InputSpatialObjectType *
   GetInternalInputLandmarks() const;
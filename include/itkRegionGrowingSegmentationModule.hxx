@@ -18,7 +18,8 @@
 #ifndef itkRegionGrowingSegmentationModule_hxx
 #define itkRegionGrowingSegmentationModule_hxx
 
-#include "itkImageRegionIterator.h"
+#include "itkImageScanlineIterator.h"
+#include "itkMultiThreaderBase.h"
 
 
 namespace itk
@@ -110,6 +111,23 @@ RegionGrowingSegmentationModule<NDimension>::PackOutputImageInOutputSpatialObjec
 
   this->ConvertIntensitiesToCenteredRange(outputImage);
 
+  this->PackCenteredRangeImageInOutputSpatialObject(outputImage);
+}
+
+
+/**
+ * This method is intended to be used only by the subclasses to insert the
+ * output image, already in the centered range, as cargo of the output
+ * spatial object.
+ */
+template <unsigned int NDimension>
+void
+RegionGrowingSegmentationModule<NDimension>::PackCenteredRangeImageInOutputSpatialObject(OutputImageType * image)
+{
+  typename OutputImageType::Pointer outputImage = image;
+
+  outputImage->DisconnectPipeline();
+
   auto * outputObject = dynamic_cast<OutputSpatialObjectType *>(this->ProcessObject::GetOutput(0));
 
   outputObject->SetImage(outputImage);
@@ -123,27 +141,26 @@ template <unsigned int NDimension>
 void
 RegionGrowingSegmentationModule<NDimension>::ConvertIntensitiesToCenteredRange(OutputImageType * image)
 {
-  using IteratorType = ImageRegionIterator<OutputImageType>;
-
-  IteratorType itr(image, image->GetBufferedRegion());
-
-  itr.GoToBegin();
+  using IteratorType = ImageScanlineIterator<OutputImageType>;
 
   //
   // Convert intensities to centered range
   //
-  while (!itr.IsAtEnd())
-  {
-    if (itr.Get())
-    {
-      itr.Set(4.0);
-    }
-    else
-    {
-      itr.Set(-4.0);
-    }
-    ++itr;
-  }
+  this->GetMultiThreader()->template ParallelizeImageRegion<Dimension>(
+    image->GetBufferedRegion(),
+    [image](const typename OutputImageType::RegionType & region) {
+      IteratorType itr(image, region);
+      while (!itr.IsAtEnd())
+      {
+        while (!itr.IsAtEndOfLine())
+        {
+          itr.Set(itr.Get() ? InsideValue : OutsideValue);
+          ++itr;
+        }
+        itr.NextLine();
+      }
+    },
+    nullptr);
 }
 
 
@@ -23,7 +23,7 @@
 #include "itkImageSpatialObject.h"
 #include "itkHessianRecursiveGaussianImageFilter.h"
 #include "itkSymmetricSecondRankTensor.h"
-#include "itkSymmetricEigenAnalysisImageFilter.h"
+#include "itkHessianEigenvalueMeasureImageFilter.h"
 #include "itkLocalStructureImageFilter.h"
 
 namespace itk
@@ -93,6 +93,10 @@ public:
   itkSetMacro(Gamma, double);
   itkGetMacro(Gamma, double);
 
+  /** Print the parameters that determine the feature. */
+  void
+  PrintParameters(std::ostream & os) const override;
+
 protected:
   SatoLocalStructureFeatureGenerator();
   ~SatoLocalStructureFeatureGenerator() override;
@@ -118,14 +122,12 @@ private:
   using HessianPixelType = typename HessianImageType::PixelType;
 
   using EigenValueArrayType = FixedArray<double, HessianPixelType::Dimension>;
-  using EigenValueImageType = Image<EigenValueArrayType, Dimension>;
-
-  using EigenAnalysisFilterType = SymmetricEigenAnalysisImageFilter<HessianImageType, EigenValueImageType>;
+  using LocalStructureFunctionType = Function::LocalStructure<EigenValueArrayType, OutputPixelType>;
 
-  using LocalStructureFilterType = LocalStructureImageFilter<EigenValueImageType, OutputImageType>;
+  using LocalStructureFilterType =
+    HessianEigenvalueMeasureImageFilter<HessianImageType, OutputImageType, LocalStructureFunctionType>;
 
   typename HessianFilterType::Pointer        m_HessianFilter;
-  typename EigenAnalysisFilterType::Pointer  m_EigenAnalysisFilter;
   typename LocalStructureFilterType::Pointer m_LocalStructureFilter;
 
   double m_Sigma;
@@ -31,11 +31,9 @@ SatoLocalStructureFeatureGenerator<NDimension>::SatoLocalStructureFeatureGenerat
   this->SetNumberOfRequiredInputs(1);
 
   this->m_HessianFilter = HessianFilterType::New();
-  this->m_EigenAnalysisFilter = EigenAnalysisFilterType::New();
   this->m_LocalStructureFilter = LocalStructureFilterType::New();
 
   this->m_HessianFilter->ReleaseDataFlagOn();
-  this->m_EigenAnalysisFilter->ReleaseDataFlagOn();
   this->m_LocalStructureFilter->ReleaseDataFlagOn();
 
   typename OutputImageSpatialObjectType::Pointer outputObject = OutputImageSpatialObjectType::New();
@@ -43,6 +41,8 @@ SatoLocalStructureFeatureGenerator<NDimension>::SatoLocalStructureFeatureGenerat
   this->ProcessObject::SetNthOutput(0, outputObject.GetPointer());
 
   this->m_Sigma = 1.0;
+  this->m_Alpha = 0.25;
+  this->m_Gamma = 0.5;
 }
 
 
@@ -79,6 +79,20 @@ SatoLocalStructureFeatureGenerator<NDimension>::PrintSelf(std::ostream & os, Ind
 }
 
 
+/**
+ * PrintParameters
+ */
+template <unsigned int NDimension>
+void
+SatoLocalStructureFeatureGenerator<NDimension>::PrintParameters(std::ostream & os) const
+{
+  Superclass::PrintParameters(os);
+  os << "Sigma " << this->m_Sigma << std::endl;
+  os << "Alpha " << this->m_Alpha << std::endl;
+  os << "Gamma " << this->m_Gamma << std::endl;
+}
+
+
 /*
  * Generate Data
  */
@@ -102,13 +116,13 @@ SatoLocalStructureFeatureGenerator<NDimension>::GenerateData()
   }
 
   this->m_HessianFilter->SetInput(inputImage);
-  this->m_EigenAnalysisFilter->SetInput(this->m_HessianFilter->GetOutput());
-  this->m_LocalStructureFilter->SetInput(this->m_EigenAnalysisFilter->GetOutput());
+  this->m_LocalStructureFilter->SetInput(this->m_HessianFilter->GetOutput());
 
   this->m_HessianFilter->SetSigma(this->m_Sigma);
-  this->m_EigenAnalysisFilter->SetDimension(Dimension);
-  this->m_LocalStructureFilter->SetAlpha(this->m_Alpha);
-  this->m_LocalStructureFilter->SetGamma(this->m_Gamma);
+
+  LocalStructureFunctionType & localStructure = this->m_LocalStructureFilter->GetMeasure();
+  localStructure.SetAlpha(this->m_Alpha);
+  localStructure.SetGamma(this->m_Gamma);
 
   this->m_LocalStructureFilter->Update();
 
@@ -100,6 +100,10 @@ public:
   itkGetMacro(UseVesselEnhancingDiffusion, bool);
   itkBooleanMacro(UseVesselEnhancingDiffusion);
 
+  /** Print the parameters that determine the feature. */
+  void
+  PrintParameters(std::ostream & os) const override;
+
 protected:
   SatoVesselnessFeatureGenerator();
   ~SatoVesselnessFeatureGenerator() override;
@@ -92,6 +92,21 @@ SatoVesselnessFeatureGenerator<NDimension>::PrintSelf(std::ostream & os, Indent
 }
 
 
+/**
+ * PrintParameters
+ */
+template <unsigned int NDimension>
+void
+SatoVesselnessFeatureGenerator<NDimension>::PrintParameters(std::ostream & os) const
+{
+  Superclass::PrintParameters(os);
+  os << "Sigma " << this->m_Sigma << std::endl;
+  os << "Alpha1 " << this->m_Alpha1 << std::endl;
+  os << "Alpha2 " << this->m_Alpha2 << std::endl;
+  os << "UseVesselEnhancingDiffusion " << this->m_UseVesselEnhancingDiffusion << std::endl;
+}
+
+
 /*
  * Generate Data
  */
@@ -69,6 +69,10 @@ public:
   itkSetMacro(SigmoidBeta, double);
   itkGetMacro(SigmoidBeta, double);
 
+  /** Print the parameters that determine the feature. */
+  void
+  PrintParameters(std::ostream & os) const override;
+
 protected:
   SatoVesselnessSigmoidFeatureGenerator();
   ~SatoVesselnessSigmoidFeatureGenerator() override;
@@ -59,6 +59,19 @@ SatoVesselnessSigmoidFeatureGenerator<NDimension>::PrintSelf(std::ostream & os,
 }
 
 
+/**
+ * PrintParameters
+ */
+template <unsigned int NDimension>
+void
+SatoVesselnessSigmoidFeatureGenerator<NDimension>::PrintParameters(std::ostream & os) const
+{
+  Superclass::PrintParameters(os);
+  os << "SigmoidAlpha " << this->m_SigmoidAlpha << std::endl;
+  os << "SigmoidBeta " << this->m_SigmoidBeta << std::endl;
+}
+
+
 /*
  * Generate Data
  */
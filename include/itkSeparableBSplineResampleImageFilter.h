@@ -0,0 +1,186 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkSeparableBSplineResampleImageFilter_h
+#define itkSeparableBSplineResampleImageFilter_h
+
+#include "itkImageToImageFilter.h"
+
+#include <vector>
+
+namespace itk
+{
+
+/** \class SeparableBSplineResampleImageFilter
+ *
+ * \brief Resamples an image on a grid aligned with the input grid, using
+ * cubic B-spline interpolation.
+ *
+ * The output image shares the origin and the direction of the input image,
+ * and only its spacing and size differ. The mapping from output to input
+ * index is then a scaling along each axis, and the cubic B-spline
+ * interpolation can be separated in one dimensional operations: along every
+ * axis the B-spline coefficients are computed with a recursive prefilter, and
+ * the axis is then interpolated with a table of four weights per output
+ * sample, computed once for the whole axis. This avoids the evaluation of a
+ * transform and of the full 4x4x4 kernel at every output pixel done by the
+ * ResampleImageFilter with a BSplineInterpolateImageFunction.
+ *
+ * The results are the ones of the ResampleImageFilter with an
+ * IdentityTransform and a BSplineInterpolateImageFunction of order 3, up to
+ * floating point rounding: the same mirror boundary conditions are used,
+ * output pixels that map outside of the input buffer are set to the
+ * DefaultPixelValue, and values are clamped to the range of the output pixel
+ * type before being cast.
+ *
+ * Axes along which the spacing is unchanged are not interpolated: their
+ * samples are copied from the input, so that for instance the in-plane
+ * values of a thick-slice CT resampled along z only are preserved exactly,
+ * and the cost of the filter only depends on the number of resampled axes.
+ *
+ * Each pass is multithreaded over the lines of the image. Along all axes but
+ * the first one the innermost loop runs over contiguous pixels of the fastest
+ * axis, so that it can be vectorized by the compiler.
+ *
+ * Only images of scalar pixels are supported.
+ *
+ * \ingroup GeometricTransform Multithreaded
+ * \ingroup LesionSizingToolkit
+ */
+template <typename TInputImage, typename TOutputImage>
+class ITK_TEMPLATE_EXPORT SeparableBSplineResampleImageFilter : public ImageToImageFilter<TInputImage, TOutputImage>
+{
+public:
+  ITK_DISALLOW_COPY_AND_MOVE(SeparableBSplineResampleImageFilter);
+
+  /** Standard class type alias. */
+  using Self = SeparableBSplineResampleImageFilter;
+  using Superclass = ImageToImageFilter<TInputImage, TOutputImage>;
+  using Pointer = SmartPointer<Self>;
+  using ConstPointer = SmartPointer<const Self>;
+
+  /** Method for creation through the object factory. */
+  itkNewMacro(Self);
+
+  /** Run-time type information (and related methods). */
+  itkOverrideGetNameOfClassMacro(SeparableBSplineResampleImageFilter);
+
+  /** Image dimension constant */
+  static constexpr unsigned int ImageDimension = TInputImage::ImageDimension;
+
+  using InputImageType = TInputImage;
+  using InputPixelType = typename InputImageType::PixelType;
+  using OutputImageType = TOutputImage;
+  using OutputPixelType = typename OutputImageType::PixelType;
+  using OutputImageRegionType = typename OutputImageType::RegionType;
+  using SizeType = typename OutputImageType::SizeType;
+  using SpacingType = typename OutputImageType::SpacingType;
+
+  /** Spacing of the output image. */
+  itkSetMacro(OutputSpacing, SpacingType);
+  itkGetConstReferenceMacro(OutputSpacing, SpacingType);
+
+  /** Size of the output image. */
+  itkSetMacro(Size, SizeType);
+  itkGetConstReferenceMacro(Size, SizeType);
+
+  /** Value given to the output pixels that map outside of the input image. */
+  itkSetMacro(DefaultPixelValue, OutputPixelType);
+  itkGetConstMacro(DefaultPixelValue, OutputPixelType);
+
+  /** Replace, in place, the samples of a set of lines by their cubic B-spline
+   * coefficients. The lines have \c length samples separated by \c stride
+   * values in memory, and \c count lines start at consecutive addresses. */
+  static void
+  ComputeCoefficients(double * data, SizeValueType length, SizeValueType stride, SizeValueType count);
+
+#ifdef ITK_USE_CONCEPT_CHECKING
+  /** Begin concept checking */
+  itkConceptMacro(SameDimensionCheck, (Concept::SameDimension<ImageDimension, TOutputImage::ImageDimension>));
+  itkConceptMacro(InputHasNumericTraitsCheck, (Concept::HasNumericTraits<InputPixelType>));
+  itkConceptMacro(OutputHasNumericTraitsCheck, (Concept::HasNumericTraits<OutputPixelType>));
+  /** End concept checking */
+#endif
+
+protected:
+  SeparableBSplineResampleImageFilter();
+  ~SeparableBSplineResampleImageFilter() override = default;
+
+  void
+  PrintSelf(std::ostream & os, Indent indent) const override;
+
+  /** The output has the spacing and size set by the user, and the origin and
+   * direction of the input. */
+  void
+  GenerateOutputInformation() override;
+
+  /** The whole input is needed to compute the B-spline coefficients. */
+  void
+  GenerateInputRequestedRegion() override;
+
+  /** The whole output is produced. */
+  void
+  EnlargeOutputRequestedRegion(DataObject * output) override;
+
+  void
+  GenerateData() override;
+
+private:
+  /** Interpolation weights along one axis: four weights and four input
+   * indices per output sample, and whether the sample maps inside the input
+   * buffer. When the spacing is unchanged along the axis, the samples are
+   * copied instead of being interpolated (PassThrough), and the axis does not
+   * need to be processed at all when the copy is the identity (Identity). */
+  struct AxisKernel
+  {
+    std::vector<double>        Weights;
+    std::vector<SizeValueType> Indices;
+    std::vector<unsigned char> Inside;
+    bool                       PassThrough{ false };
+    bool                       Identity{ false };
+  };
+
+  static void
+  ComputeAxisKernel(SizeValueType  inputLength,
+                    IndexValueType inputStart,
+                    SizeValueType  outputLength,
+                    double         scale,
+                    AxisKernel &   kernel);
+
+  static void
+  InterpolateLines(const double *     input,
+                   double *           output,
+                   const AxisKernel & kernel,
+                   SizeValueType      outputLength,
+                   SizeValueType      stride,
+                   SizeValueType      count);
+
+  static OutputPixelType
+  CastWithBoundsChecking(double value);
+
+  SpacingType     m_OutputSpacing;
+  SizeType        m_Size;
+  OutputPixelType m_DefaultPixelValue;
+};
+
+} // end namespace itk
+
+#ifndef ITK_MANUAL_INSTANTIATION
+#  include "itkSeparableBSplineResampleImageFilter.hxx"
+#endif
+
+#endif
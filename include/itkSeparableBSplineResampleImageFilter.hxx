@@ -0,0 +1,555 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkSeparableBSplineResampleImageFilter_hxx
+#define itkSeparableBSplineResampleImageFilter_hxx
+
+#include "itkMath.h"
+#include "itkMultiThreaderBase.h"
+#include "itkNumericTraits.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <numeric>
+
+namespace itk
+{
+
+/**
+ * Constructor
+ */
+template <typename TInputImage, typename TOutputImage>
+SeparableBSplineResampleImageFilter<TInputImage, TOutputImage>::SeparableBSplineResampleImageFilter()
+{
+  this->SetNumberOfRequiredInputs(1);
+
+  this->m_OutputSpacing.Fill(1.0);
+  this->m_Size.Fill(0);
+  this->m_DefaultPixelValue = NumericTraits<OutputPixelType>::ZeroValue();
+}
+
+
+/*
+ * Output information
+ */
+template <typename TInputImage, typename TOutputImage>
+void
+SeparableBSplineResampleImageFilter<TInputImage, TOutputImage>::GenerateOutputInformation()
+{
+  // call the superclass' implementation of this method
+  this->Superclass::GenerateOutputInformation();
+
+  OutputImageType *      outputPtr = this->GetOutput();
+  const InputImageType * inputPtr = this->GetInput();
+
+  if (!outputPtr || !inputPtr)
+  {
+    return;
+  }
+
+  OutputImageRegionType outputLargestPossibleRegion;
+  outputLargestPossibleRegion.SetSize(this->m_Size);
+
+  outputPtr->SetLargestPossibleRegion(outputLargestPossibleRegion);
+  outputPtr->SetSpacing(this->m_OutputSpacing);
+  outputPtr->SetOrigin(inputPtr->GetOrigin());
+  outputPtr->SetDirection(inputPtr->GetDirection());
+}
+
+
+/*
+ * Input requested region
+ */
+template <typename TInputImage, typename TOutputImage>
+void
+SeparableBSplineResampleImageFilter<TInputImage, TOutputImage>::GenerateInputRequestedRegion()
+{
+  // call the superclass' implementation of this method
+  this->Superclass::GenerateInputRequestedRegion();
+
+  auto * inputPtr = const_cast<InputImageType *>(this->GetInput());
+
+  if (inputPtr)
+  {
+    inputPtr->SetRequestedRegionToLargestPossibleRegion();
+  }
+}
+
+
+/*
+ * Output requested region
+ */
+template <typename TInputImage, typename TOutputImage>
+void
+SeparableBSplineResampleImageFilter<TInputImage, TOutputImage>::EnlargeOutputRequestedRegion(DataObject * output)
+{
+  this->Superclass::EnlargeOutputRequestedRegion(output);
+  output->SetRequestedRegionToLargestPossibleRegion();
+}
+
+
+/*
+ * Cubic B-spline coefficients of a set of lines
+ */
+template <typename TInputImage, typename TOutputImage>
+void
+SeparableBSplineResampleImageFilter<TInputImage, TOutputImage>::ComputeCoefficients(double *      data,
+                                                                                    SizeValueType length,
+                                                                                    SizeValueType stride,
+                                                                                    SizeValueType count)
+{
+  //
+  // Same recursive filter as the BSplineDecompositionImageFilter, with its
+  // default tolerance, applied to "count" lines at once so that the
+  // innermost loops run over contiguous memory.
+  //
+  if (length == 1)
+  {
+    return;
+  }
+
+  const double z = std::sqrt(3.0) - 2.0;
+  const double gain = (1.0 - z) * (1.0 - 1.0 / z);
+  const double tolerance = 1e-10;
+
+  const auto horizon = static_cast<SizeValueType>(std::ceil(std::log(tolerance) / std::log(itk::Math::abs(z))));
+
+  double * first = data;
+  double * last = data + (length - 1) * stride;
+
+  for (SizeValueType n = 0; n < length; ++n)
+  {
+    double * line = data + n * stride;
+    for (SizeValueType i = 0; i < count; ++i)
+    {
+      line[i] *= gain;
+    }
+  }
+
+  //
+  // Initial causal coefficient.
+  //
+  if (horizon < length)
+  {
+    double zn = z;
+    for (SizeValueType n = 1; n < horizon; ++n)
+    {
+      const double * line = data + n * stride;
+      for (SizeValueType i = 0; i < count; ++i)
+      {
+        first[i] += zn * line[i];
+      }
+      zn *= z;
+    }
+  }
+  else
+  {
+    const double iz = 1.0 / z;
+    double       zn = z;
+    double       z2n = std::pow(z, static_cast<double>(length - 1));
+
+    for (SizeValueType i = 0; i < count; ++i)
+    {
+      first[i] += z2n * last[i];
+    }
+    z2n *= z2n * iz;
+
+    for (SizeValueType n = 1; n + 1 < length; ++n)
+    {
+      const double   factor = zn + z2n;
+      const double * line = data + n * stride;
+      for (SizeValueType i = 0; i < count; ++i)
+      {
+        first[i] += factor * line[i];
+      }
+      zn *= z;
+      z2n *= iz;
+    }
+
+    const double normalization = 1.0 / (1.0 - zn * zn);
+    for (SizeValueType i = 0; i < count; ++i)
+    {
+      first[i] *= normalization;
+    }
+  }
+
+  //
+  // Causal recursion.
+  //
+  for (SizeValueType n = 1; n < length; ++n)
+  {
+    const double * previous = data + (n - 1) * stride;
+    double *       line = data + n * stride;
+    for (SizeValueType i = 0; i < count; ++i)
+    {
+      line[i] += z * previous[i];
+    }
+  }
+
+  //
+  // Initial anti-causal coefficient, and anti-causal recursion.
+  //
+  const double   antiCausalFactor = z / (z * z - 1.0);
+  const double * beforeLast = last - stride;
+  for (SizeValueType i = 0; i < count; ++i)
+  {
+    last[i] = antiCausalFactor * (z * beforeLast[i] + last[i]);
+  }
+
+  for (SizeValueType n = length - 1; n > 0; --n)
+  {
+    const double * next = data + n * stride;
+    double *       line = data + (n - 1) * stride;
+    for (SizeValueType i = 0; i < count; ++i)
+    {
+      line[i] = z * (next[i] - line[i]);
+    }
+  }
+}
+
+
+/*
+ * Interpolation weights along one axis
+ */
+template <typename TInputImage, typename TOutputImage>
+void
+SeparableBSplineResampleImageFilter<TInputImage, TOutputImage>::ComputeAxisKernel(SizeValueType  inputLength,
+                                                                                  IndexValueType inputStart,
+                                                                                  SizeValueType  outputLength,
+                                                                                  double         scale,
+                                                                                  AxisKernel &   kernel)
+{
+  kernel.Weights.assign(4 * outputLength, 0.0);
+  kernel.Indices.assign(4 * outputLength, 0);
+  kernel.Inside.assign(outputLength, 0);
+
+  const auto           length = static_cast<IndexValueType>(inputLength);
+  const IndexValueType period = 2 * (length - 1);
+
+  kernel.PassThrough = Math::ExactlyEquals(scale, 1.0);
+  kernel.Identity = kernel.PassThrough && inputStart == 0 && outputLength == inputLength;
+
+  for (SizeValueType j = 0; j < outputLength; ++j)
+  {
+    // Continuous index of the output sample, relative to the first pixel of
+    // the input buffer.
+    const double x = static_cast<double>(j) * scale - static_cast<double>(inputStart);
+
+    if (!(x >= -0.5 && x < static_cast<double>(length) - 0.5))
+    {
+      continue;
+    }
+
+    kernel.Inside[j] = 1;
+
+    //
+    // Unchanged spacing: the output sample is an input sample.
+    //
+    if (kernel.PassThrough)
+    {
+      const auto index = static_cast<SizeValueType>(static_cast<IndexValueType>(j) - inputStart);
+      kernel.Weights[4 * j + 1] = 1.0;
+      std::fill_n(&(kernel.Indices[4 * j]), 4, index);
+      continue;
+    }
+
+    const double floorX = std::floor(x);
+    const double w = x - floorX;
+
+    double * weights = &(kernel.Weights[4 * j]);
+    weights[3] = (1.0 / 6.0) * w * w * w;
+    weights[0] = (1.0 / 6.0) + 0.5 * w * (w - 1.0) - weights[3];
+    weights[2] = w + weights[0] - 2.0 * weights[3];
+    weights[1] = 1.0 - weights[0] - weights[2] - weights[3];
+
+    //
+    // Mirror boundary conditions, as in the BSplineInterpolateImageFunction.
+    //
+    const IndexValueType firstIndex = static_cast<IndexValueType>(floorX) - 1;
+    for (unsigned int k = 0; k < 4; ++k)
+    {
+      IndexValueType index = 0;
+      if (length > 1)
+      {
+        index = (firstIndex + static_cast<IndexValueType>(k)) % period;
+        if (index < 0)
+        {
+          index += period;
+        }
+        if (index >= length)
+        {
+          index = period - index;
+        }
+      }
+      kernel.Indices[4 * j + k] = static_cast<SizeValueType>(index);
+    }
+  }
+}
+
+
+/*
+ * Interpolation of a set of lines along one axis
+ */
+template <typename TInputImage, typename TOutputImage>
+void
+SeparableBSplineResampleImageFilter<TInputImage, TOutputImage>::InterpolateLines(const double *     input,
+                                                                                 double *           output,
+                                                                                 const AxisKernel & kernel,
+                                                                                 SizeValueType      outputLength,
+                                                                                 SizeValueType      stride,
+                                                                                 SizeValueType      count)
+{
+  for (SizeValueType j = 0; j < outputLength; ++j)
+  {
+    const double *        weights = &(kernel.Weights[4 * j]);
+    const SizeValueType * indices = &(kernel.Indices[4 * j]);
+
+    const double w0 = weights[0];
+    const double w1 = weights[1];
+    const double w2 = weights[2];
+    const double w3 = weights[3];
+
+    const double * line0 = input + indices[0] * stride;
+    const double * line1 = input + indices[1] * stride;
+    const double * line2 = input + indices[2] * stride;
+    const double * line3 = input + indices[3] * stride;
+
+    double * outputLine = output + j * stride;
+
+    for (SizeValueType i = 0; i < count; ++i)
+    {
+      outputLine[i] = w0 * line0[i] + w1 * line1[i] + w2 * line2[i] + w3 * line3[i];
+    }
+  }
+}
+
+
+/*
+ * Cast to the output pixel type
+ */
+template <typename TInputImage, typename TOutputImage>
+auto
+SeparableBSplineResampleImageFilter<TInputImage, TOutputImage>::CastWithBoundsChecking(double value)
+  -> OutputPixelType
+{
+  const auto minimum = static_cast<double>(NumericTraits<OutputPixelType>::NonpositiveMin());
+  const auto maximum = static_cast<double>(NumericTraits<OutputPixelType>::max());
+
+  if (value < minimum)
+  {
+    return NumericTraits<OutputPixelType>::NonpositiveMin();
+  }
+  if (value > maximum)
+  {
+    return NumericTraits<OutputPixelType>::max();
+  }
+  return static_cast<OutputPixelType>(value);
+}
+
+
+/*
+ * Generate Data
+ */
+template <typename TInputImage, typename TOutputImage>
+void
+SeparableBSplineResampleImageFilter<TInputImage, TOutputImage>::GenerateData()
+{
+  this->AllocateOutputs();
+
+  const InputImageType * inputPtr = this->GetInput();
+  OutputImageType *      outputPtr = this->GetOutput();
+
+  const typename InputImageType::RegionType    inputRegion = inputPtr->GetBufferedRegion();
+  const typename InputImageType::SpacingType & inputSpacing = inputPtr->GetSpacing();
+  const SizeType                               outputSize = outputPtr->GetBufferedRegion().GetSize();
+
+  const SizeValueType numberOfOutputPixels = outputPtr->GetBufferedRegion().GetNumberOfPixels();
+  if (numberOfOutputPixels == 0)
+  {
+    return;
+  }
+
+  std::array<AxisKernel, ImageDimension> kernels;
+  for (unsigned int d = 0; d < ImageDimension; ++d)
+  {
+    Self::ComputeAxisKernel(inputRegion.GetSize(d),
+                            inputRegion.GetIndex(d),
+                            outputSize[d],
+                            this->m_OutputSpacing[d] / inputSpacing[d],
+                            kernels[d]);
+  }
+
+  //
+  // Working copy of the input. Each pass replaces it with the result of the
+  // interpolation along one more axis.
+  //
+  const InputPixelType * inputBuffer = inputPtr->GetBufferPointer();
+
+  std::vector<double> buffer(inputRegion.GetNumberOfPixels());
+  std::transform(inputBuffer, inputBuffer + buffer.size(), buffer.begin(), [](const InputPixelType & value) {
+    return static_cast<double>(value);
+  });
+
+  std::vector<double> resampled;
+
+  //
+  // The axes that are shrunk the most are processed first, so that the
+  // following passes work on as few samples as possible.
+  //
+  SizeType currentSize = inputRegion.GetSize();
+
+  std::array<unsigned int, ImageDimension> axes;
+  std::iota(axes.begin(), axes.end(), 0u);
+  std::stable_sort(axes.begin(), axes.end(), [&](unsigned int a, unsigned int b) {
+    return static_cast<double>(outputSize[a]) / static_cast<double>(currentSize[a]) <
+           static_cast<double>(outputSize[b]) / static_cast<double>(currentSize[b]);
+  });
+
+  MultiThreaderBase * multiThreader = this->GetMultiThreader();
+  multiThreader->SetNumberOfWorkUnits(this->GetNumberOfWorkUnits());
+
+  // Number of consecutive lines processed together along the slow axes.
+  constexpr SizeValueType blockLength = 64;
+
+  unsigned int numberOfPasses = 1;
+  for (unsigned int d = 0; d < ImageDimension; ++d)
+  {
+    if (!kernels[d].Identity)
+    {
+      ++numberOfPasses;
+    }
+  }
+
+  unsigned int pass = 0;
+
+  for (const unsigned int axis : axes)
+  {
+    const AxisKernel & kernel = kernels[axis];
+
+    if (kernel.Identity)
+    {
+      continue;
+    }
+
+    SizeValueType inner = 1;
+    SizeValueType outer = 1;
+    for (unsigned int d = 0; d < ImageDimension; ++d)
+    {
+      if (d < axis)
+      {
+        inner *= currentSize[d];
+      }
+      else if (d > axis)
+      {
+        outer *= currentSize[d];
+      }
+    }
+
+    const SizeValueType inputLength = currentSize[axis];
+    const SizeValueType outputLength = outputSize[axis];
+    const SizeValueType numberOfBlocks = (inner + blockLength - 1) / blockLength;
+
+    resampled.resize(outer * outputLength * inner);
+
+    double *   data = buffer.data();
+    double *   result = resampled.data();
+    const bool interpolate = !kernel.PassThrough;
+
+    multiThreader->ParallelizeArray(
+      0,
+      outer * numberOfBlocks,
+      [&](SizeValueType task) {
+        const SizeValueType o = task / numberOfBlocks;
+        const SizeValueType firstLine = (task % numberOfBlocks) * blockLength;
+        const SizeValueType count = std::min(blockLength, inner - firstLine);
+
+        double * lines = data + o * inputLength * inner + firstLine;
+
+        if (interpolate)
+        {
+          Self::ComputeCoefficients(lines, inputLength, inner, count);
+        }
+        Self::InterpolateLines(lines, result + o * outputLength * inner + firstLine, kernel, outputLength, inner, count);
+      },
+      nullptr);
+
+    buffer.swap(resampled);
+    currentSize[axis] = outputLength;
+
+    this->UpdateProgress(static_cast<float>(++pass) / static_cast<float>(numberOfPasses));
+
+    if (this->GetAbortGenerateData())
+    {
+      ProcessAborted e(__FILE__, __LINE__);
+      e.SetDescription("Process aborted.");
+      e.SetLocation(ITK_LOCATION);
+      throw e;
+    }
+  }
+
+  //
+  // Copy to the output, setting the default value where the output maps
+  // outside of the input buffer.
+  //
+  const double *        values = buffer.data();
+  OutputPixelType *     outputBuffer = outputPtr->GetBufferPointer();
+  const OutputPixelType defaultValue = this->m_DefaultPixelValue;
+  const SizeValueType   lineLength = outputSize[0];
+  const SizeValueType   numberOfLines = numberOfOutputPixels / lineLength;
+  const AxisKernel &    firstAxisKernel = kernels[0];
+
+  multiThreader->ParallelizeArray(
+    0,
+    numberOfLines,
+    [&](SizeValueType line) {
+      bool          lineInside = true;
+      SizeValueType remainder = line;
+      for (unsigned int d = 1; d < ImageDimension; ++d)
+      {
+        lineInside = lineInside && kernels[d].Inside[remainder % outputSize[d]];
+        remainder /= outputSize[d];
+      }
+
+      const SizeValueType offset = line * lineLength;
+      for (SizeValueType i = 0; i < lineLength; ++i)
+      {
+        outputBuffer[offset + i] = (lineInside && firstAxisKernel.Inside[i])
+                                     ? Self::CastWithBoundsChecking(values[offset + i])
+                                     : defaultValue;
+      }
+    },
+    nullptr);
+
+  this->UpdateProgress(1.0f);
+}
+
+
+template <typename TInputImage, typename TOutputImage>
+void
+SeparableBSplineResampleImageFilter<TInputImage, TOutputImage>::PrintSelf(std::ostream & os, Indent indent) const
+{
+  Superclass::PrintSelf(os, indent);
+  os << indent << "OutputSpacing: " << this->m_OutputSpacing << std::endl;
+  os << indent << "Size: " << this->m_Size << std::endl;
+  os << indent << "DefaultPixelValue: "
+     << static_cast<typename NumericTraits<OutputPixelType>::PrintType>(this->m_DefaultPixelValue) << std::endl;
+}
+
+} // end namespace itk
+
+#endif
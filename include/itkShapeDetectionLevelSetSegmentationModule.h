@@ -20,6 +20,8 @@
 
 #include "itkSinglePhaseLevelSetSegmentationModule.h"
 #include "itkShapeDetectionLevelSetImageFilter.h"
+#include "itkParallelSegmentationLevelSetImageFilter.h"
+#include "itkShapeDetectionLevelSetFunction.h"
 
 namespace itk
 {
@@ -80,6 +82,12 @@ protected:
    * the segmentation. */
   void
   GenerateData() override;
+
+private:
+  /** Configure and run the serial or the parallel level set filter. */
+  template <typename TFilter>
+  void
+  ComputeLevelSet(TFilter * filter);
 };
 
 } // end namespace itk
@@ -19,6 +19,7 @@
 #define itkShapeDetectionLevelSetSegmentationModule_hxx
 
 #include "itkShapeDetectionLevelSetImageFilter.h"
+#include "itkParallelSegmentationLevelSetImageFilter.h"
 
 
 namespace itk
@@ -57,11 +58,48 @@ template <unsigned int NDimension>
 void
 ShapeDetectionLevelSetSegmentationModule<NDimension>::GenerateData()
 {
-  using FilterType = ShapeDetectionLevelSetImageFilter<InputImageType, FeatureImageType, OutputPixelType>;
+  if (this->GetUseParallelSolver())
+  {
+    using FunctionType = ShapeDetectionLevelSetFunction<OutputImageType, FeatureImageType>;
+    using FilterType = typename Superclass::template HaltableLevelSetFilter<
+      ParallelSegmentationLevelSetImageFilter<InputImageType, FeatureImageType, OutputPixelType>>;
+
+    typename FunctionType::Pointer function = FunctionType::New();
+    typename FilterType::Pointer   filter = FilterType::New();
+    filter->SetSegmentationFunction(function);
+
+    this->ComputeLevelSet(filter.GetPointer());
+  }
+  else
+  {
+    using FilterType = typename Superclass::template HaltableLevelSetFilter<
+      ShapeDetectionLevelSetImageFilter<InputImageType, FeatureImageType, OutputPixelType>>;
+
+    typename FilterType::Pointer filter = FilterType::New();
+
+    this->ComputeLevelSet(filter.GetPointer());
+  }
+}
 
-  typename FilterType::Pointer filter = FilterType::New();
 
-  filter->SetInput(this->GetInternalInputImage());
+/**
+ * Run the level set filter
+ */
+template <unsigned int NDimension>
+template <typename TFilter>
+void
+ShapeDetectionLevelSetSegmentationModule<NDimension>::ComputeLevelSet(TFilter * filter)
+{
+  // Warm start from the initial level set when one is given.
+  const typename InputImageType::ConstPointer initialLevelSet = this->ComputeInternalInitialLevelSet();
+  if (initialLevelSet)
+  {
+    filter->SetInput(initialLevelSet);
+  }
+  else
+  {
+    filter->SetInput(this->GetInternalInputImage());
+  }
   filter->SetIsoSurfaceValue(0.0); // Zero Set value
   filter->SetFeatureImage(this->GetInternalFeatureImage());
 
@@ -72,15 +110,16 @@ ShapeDetectionLevelSetSegmentationModule<NDimension>::GenerateData()
   filter->SetAdvectionScaling(0.0);
   filter->UseImageSpacingOn();
 
-  std::cout << "Propagation Scaling = " << this->GetPropagationScaling() << std::endl;
-  std::cout << "Curvature Scaling = " << this->GetCurvatureScaling() << std::endl;
+  itkDebugMacro("Propagation Scaling = " << this->GetPropagationScaling()
+                                          << ", Curvature Scaling = " << this->GetCurvatureScaling());
 
-  filter->Update();
+  this->EvolveLevelSet(filter);
 
-  std::cout << "Max. no. iterations: " << filter->GetNumberOfIterations() << std::endl;
-  std::cout << "Max. RMS error: " << filter->GetMaximumRMSError() << std::endl;
-  std::cout << "No. elpased iterations: " << filter->GetElapsedIterations() << std::endl;
-  std::cout << "RMS change: " << filter->GetRMSChange() << std::endl;
+  itkDebugMacro("Max. no. iterations: " << this->GetMaximumNumberOfIterations()
+                                         << ", max. RMS error: " << this->GetMaximumRMSError()
+                                         << ", no. elapsed iterations: " << this->GetElapsedIterations()
+                                         << ", RMS change: " << this->GetRMSChange());
+  itkDebugMacro("Stop condition: " << this->GetStopConditionDescription());
 
   this->PackOutputImageInOutputSpatialObject(filter->GetOutput());
 }
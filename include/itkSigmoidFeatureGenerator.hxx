@@ -78,6 +78,19 @@ SigmoidFeatureGenerator<NDimension>::PrintSelf(std::ostream & os, Indent indent)
 }
 
 
+/**
+ * PrintParameters
+ */
+template <unsigned int NDimension>
+void
+SigmoidFeatureGenerator<NDimension>::PrintParameters(std::ostream & os) const
+{
+  Superclass::PrintParameters(os);
+  os << "Alpha " << this->m_Alpha << std::endl;
+  os << "Beta " << this->m_Beta << std::endl;
+}
+
+
 /*
  * Generate Data
  */
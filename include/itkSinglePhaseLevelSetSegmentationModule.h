@@ -21,6 +21,11 @@
 #include "itkSegmentationModule.h"
 #include "itkImageSpatialObject.h"
 
+#include <atomic>
+#include <chrono>
+#include <string>
+#include <thread>
+
 namespace itk
 {
 
@@ -106,6 +111,81 @@ public:
   itkGetMacro(InvertOutputIntensities, bool);
   itkBooleanMacro(InvertOutputIntensities);
 
+  /** Solve the level set equation with the multithreaded sparse field solver
+   * instead of the serial one. The layers of the sparse field are updated in
+   * parallel, and the result matches the one of the serial solver within the
+   * MaximumRMSError tolerance. Defaults to false. */
+  itkSetMacro(UseParallelSolver, bool);
+  itkGetMacro(UseParallelSolver, bool);
+  itkBooleanMacro(UseParallelSolver);
+
+  /** Maximum wall clock time, in seconds, of the evolution of the level set.
+   * When it is exceeded, the evolution stops at the end of the current
+   * iteration, and the level set reached so far is the output. Zero, the
+   * default, sets no limit. */
+  itkSetMacro(MaximumElapsedTime, double);
+  itkGetMacro(MaximumElapsedTime, double);
+
+  /** Maximum volume, in cubic millimeters, enclosed by the front. It is
+   * checked after every iteration, and when it is exceeded the evolution
+   * stops and the level set reached so far is the output. Zero, the
+   * default, sets no limit. The volume is updated from the pixels around
+   * the front, where the sparse field solvers change the level set, rather
+   * than from the whole image. */
+  itkSetMacro(MaximumFrontVolume, double);
+  itkGetMacro(MaximumFrontVolume, double);
+
+  /** Reasons for the end of the evolution of the level set. */
+  enum StopConditionType
+  {
+    ConvergenceStop = 0,
+    MaximumNumberOfIterationsStop = 1,
+    MaximumElapsedTimeStop = 2,
+    MaximumFrontVolumeStop = 3
+  };
+
+  /** Level set from which the evolution starts, negative inside the object
+   * as usual in ITK. It replaces the initialization of the module: the input
+   * level set of the level set modules, or the fast marching of the modules
+   * that start from seeds. It may be defined on any grid, and is resampled
+   * onto the grid of the feature image when the grids differ. When it is
+   * close to the solution, the evolution converges in a few iterations.
+   * Null, the default, starts from the usual initialization. */
+  itkSetConstObjectMacro(InitialLevelSet, InputImageType);
+  itkGetConstObjectMacro(InitialLevelSet, InputImageType);
+
+  /** Interpret the InitialLevelSet as a mask, non zero inside the object,
+   * instead of a level set. Defaults to false. */
+  itkSetMacro(InitialLevelSetIsMask, bool);
+  itkGetMacro(InitialLevelSetIsMask, bool);
+  itkBooleanMacro(InitialLevelSetIsMask);
+
+  /** Reason for the end of the last evolution of the level set. */
+  itkGetConstMacro(StopCondition, StopConditionType);
+
+  /** Description of the StopCondition, intended for logs. */
+  std::string
+  GetStopConditionDescription() const;
+
+  /** Statistics of the last iteration of the level set evolution: the
+   * number of iterations elapsed, the RMS change of the level set and the
+   * time in seconds elapsed since the start of the evolution. The module
+   * invokes an IterationEvent after every iteration, whose observers query
+   * these statistics. */
+  itkGetConstMacro(ElapsedIterations, SizeValueType);
+  itkGetConstMacro(RMSChange, double);
+  itkGetConstMacro(ElapsedTime, double);
+
+  /** Estimate of the size of the active layer at the current iteration: the
+   * number of pixels where the level set lies within half a pixel of the
+   * zero set. The layers of the sparse field solvers are internal to them,
+   * so the pixels are counted from the level set, and only when this method
+   * is called from an IterationEvent observer. The count is restricted to
+   * the region around the front, see UpdateFrontStatistics(). Out of an
+   * IterationEvent, the value of the last call is returned. */
+  SizeValueType
+  GetActiveLayerSize() const;
+
 protected:
   SinglePhaseLevelSetSegmentationModule();
   ~SinglePhaseLevelSetSegmentationModule() override;
@@ -117,10 +197,22 @@ protected:
   void
   GenerateData() override;
 
-  /** Set the output image as cargo of the output SpatialObject. */
+  /** Set the output image as cargo of the output SpatialObject. When
+   * InvertOutputIntensities is on, the range of the image is first computed
+   * and mapped, in place, to [4:-4]. */
   void
   PackOutputImageInOutputSpatialObject(OutputImageType * outputImage);
 
+  /** Set the output image as cargo of the output SpatialObject, when the
+   * range of the relevant values of the image is known in advance. The
+   * window [minimum:maximum] is mapped in place to [4:-4] when
+   * InvertOutputIntensities is on, and to [-4:4] otherwise, and the values
+   * outside of the window are clamped. Unlike the method above, the image
+   * is not scanned for its range: when no pixel reaches a bound of the
+   * window, the output does not reach the corresponding bound of [4:-4]. */
+  void
+  PackOutputImageInOutputSpatialObject(OutputImageType * outputImage, double minimum, double maximum);
+
   /** Extract the input image from the input spatial object. */
   const InputImageType *
   GetInternalInputImage() const;
@@ -129,7 +221,146 @@ protected:
   const FeatureImageType *
   GetInternalFeatureImage() const;
 
+  /** The InitialLevelSet, converted to a level set when it is a mask, and
+   * resampled onto the grid of the feature image when needed. Null when no
+   * InitialLevelSet is set. */
+  typename InputImageType::ConstPointer
+  ComputeInternalInitialLevelSet() const;
+
+  /** Level set filter whose evolution can be halted at the end of any
+   * iteration, without changing its NumberOfIterations while it runs. The
+   * filters given to EvolveLevelSet() are of this type. */
+  template <typename TFilter>
+  class HaltableLevelSetFilter : public TFilter
+  {
+  public:
+    ITK_DISALLOW_COPY_AND_MOVE(HaltableLevelSetFilter);
+
+    /** Standard class type alias. */
+    using Self = HaltableLevelSetFilter;
+    using Superclass = TFilter;
+    using Pointer = SmartPointer<Self>;
+    using ConstPointer = SmartPointer<const Self>;
+
+    /** Method for creation through the object factory. */
+    itkNewMacro(Self);
+
+    /** Halt the evolution at the end of the current iteration. Reset when
+     * the filter is updated again. */
+    void
+    HaltEvolution()
+    {
+      m_HaltEvolution = true;
+    }
+
+  protected:
+    HaltableLevelSetFilter() = default;
+    ~HaltableLevelSetFilter() override = default;
+
+    void
+    Initialize() override
+    {
+      m_HaltEvolution = false;
+      Superclass::Initialize();
+    }
+
+    bool
+    Halt() override
+    {
+      return m_HaltEvolution || Superclass::Halt();
+    }
+
+  private:
+    std::atomic<bool> m_HaltEvolution{ false };
+  };
+
+  /** Update a level set filter. Its evolution is halted when the
+   * MaximumElapsedTime or the MaximumFrontVolume is exceeded, and the
+   * StopCondition is recorded. */
+  template <typename TFilter>
+  void
+  EvolveLevelSet(HaltableLevelSetFilter<TFilter> * filter);
+
+  /** Record the StopCondition of a level set evolved by another module. */
+  itkSetMacro(StopCondition, StopConditionType);
+
+  /** Invoke the IterationEvent of this module after every iteration of
+   * another module, with the statistics of that module. Nothing is
+   * forwarded when this module has no IterationEvent observer. Only one
+   * module is forwarded at a time. */
+  void
+  ForwardIterationEvents(Self * module);
+  void
+  StopForwardingIterationEvents();
+
+  /** Record the statistics of the last iteration of another module. */
+  void
+  CopyIterationStatistics(const Self * module);
+
+  /** Part of the MaximumElapsedTime left since startTime, to be given to
+   * the modules that evolve the level set. Zero when there is no limit, and
+   * the smallest positive value when the time is already exhausted, so that
+   * the evolution stops after its first iteration. */
+  using TimePointType = std::chrono::steady_clock::time_point;
+  double
+  GetRemainingElapsedTime(const TimePointType & startTime) const;
+
 private:
+  using IndexType = typename OutputImageType::IndexType;
+  using RegionType = typename OutputImageType::RegionType;
+
+  /** Pixels where the level set is negative and pixels of the active layer,
+   * where it lies within half a pixel of the zero set, in a region of the
+   * level set. The bounding box of the active layer is also recorded. */
+  struct FrontCountType
+  {
+    SizeValueType InsidePixels{ 0 };
+    SizeValueType ActivePixels{ 0 };
+    IndexType     ActiveMinimum;
+    IndexType     ActiveMaximum;
+  };
+
+  /** Count the pixels of the front in a region. The region is split among
+   * threads when the count runs on the thread evolving the level set, and
+   * is serial when it runs on a thread of a multithreaded solver. */
+  void
+  CountFrontPixels(const OutputImageType * levelSet, const RegionType & region, FrontCountType & count) const;
+
+  /** Update the number of pixels inside the front at the given iteration of
+   * the evolution. The sparse field solvers change the sign of the level set
+   * only next to the active layer, which moves by at most one pixel per
+   * iteration. The pixels inside the front are therefore counted in a region
+   * around the active layer of the previous count, and the pixels inside the
+   * front out of this region are kept from the counts of the previous
+   * iterations. The whole image is only counted at the first iteration, and
+   * when the iterations are counted too far apart. */
+  void
+  UpdateFrontStatistics(const OutputImageType * levelSet, SizeValueType iteration) const;
+
+  /** Volume of the region where the level set is negative, at the given
+   * iteration of the evolution. */
+  double
+  ComputeFrontVolume(const OutputImageType * levelSet, SizeValueType iteration) const;
+
+  /** Record the statistics of an iteration and invoke an IterationEvent. */
+  void
+  InvokeIterationEvent(SizeValueType elapsedIterations, double rmsChange, double elapsedTime);
+
+  /** Multithreaded computation of the range of the image. */
+  void
+  ComputeMinimumAndMaximum(const OutputImageType * image, double & minimum, double & maximum);
+
+  /** Multithreaded, in place, linear mapping of the window
+   * [windowMinimum:windowMaximum] to [outputMinimum:outputMaximum]. Values
+   * outside of the window are clamped, as done by the
+   * IntensityWindowingImageFilter. */
+  void
+  WindowIntensities(OutputImageType * image,
+                    double            windowMinimum,
+                    double            windowMaximum,
+                    double            outputMinimum,
+                    double            outputMaximum);
+
   double m_PropagationScaling;
   double m_CurvatureScaling;
   double m_AdvectionScaling;
@@ -138,9 +369,41 @@ private:
   double       m_MaximumRMSError;
 
   bool m_InvertOutputIntensities;
+  bool m_UseParallelSolver;
+
+  typename InputImageType::ConstPointer m_InitialLevelSet;
+  bool                                  m_InitialLevelSetIsMask;
+
+  double            m_MaximumElapsedTime;
+  double            m_MaximumFrontVolume;
+  StopConditionType m_StopCondition;
+
+  SizeValueType         m_ElapsedIterations;
+  double                m_RMSChange;
+  mutable SizeValueType m_ActiveLayerSize;
+  double                m_ElapsedTime;
+
+  /** Level set and iteration of the IterationEvent being invoked, or module
+   * whose IterationEvent is being forwarded, from which the ActiveLayerSize
+   * is computed on request. */
+  const OutputImageType * m_IterationLevelSet;
+  SizeValueType           m_Iteration;
+  const Self *            m_IterationModule;
+
+  Self *        m_ForwardedModule;
+  unsigned long m_ForwardedModuleObserverTag;
 
   using ImageConstPointer = typename InputImageType::ConstPointer;
   mutable ImageConstPointer m_ZeroSetInputImage;
+
+  /** State of the counts of the front along the evolution, see
+   * UpdateFrontStatistics(). */
+  std::thread::id        m_EvolutionThread;
+  mutable bool           m_FrontCountIsValid;
+  mutable SizeValueType  m_FrontCountIteration;
+  mutable RegionType     m_FrontRegion;
+  mutable SizeValueType  m_InsidePixelsOutOfFrontRegion;
+  mutable FrontCountType m_FrontCount;
 };
 
 } // end namespace itk
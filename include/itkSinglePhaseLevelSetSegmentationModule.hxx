@@ -19,7 +19,16 @@
 #define itkSinglePhaseLevelSetSegmentationModule_hxx
 
 #include "itkLandmarkSpatialObject.h"
-#include "itkIntensityWindowingImageFilter.h"
+#include "itkImageScanlineIterator.h"
+#include "itkMath.h"
+#include "itkMultiThreaderBase.h"
+#include "itkNearestNeighborExtrapolateImageFunction.h"
+#include "itkResampleImageFilter.h"
+
+#include <algorithm>
+#include <limits>
+#include <mutex>
+#include <thread>
 
 namespace itk
 {
@@ -45,6 +54,24 @@ SinglePhaseLevelSetSegmentationModule<NDimension>::SinglePhaseLevelSetSegmentati
   this->m_PropagationScaling = 100.0;
   this->m_ZeroSetInputImage = nullptr;
   this->m_InvertOutputIntensities = true;
+  this->m_UseParallelSolver = false;
+  this->m_InitialLevelSet = nullptr;
+  this->m_InitialLevelSetIsMask = false;
+  this->m_MaximumElapsedTime = 0.0;
+  this->m_MaximumFrontVolume = 0.0;
+  this->m_StopCondition = ConvergenceStop;
+  this->m_ElapsedIterations = 0;
+  this->m_RMSChange = 0.0;
+  this->m_ActiveLayerSize = 0;
+  this->m_ElapsedTime = 0.0;
+  this->m_IterationLevelSet = nullptr;
+  this->m_Iteration = 0;
+  this->m_IterationModule = nullptr;
+  this->m_ForwardedModule = nullptr;
+  this->m_ForwardedModuleObserverTag = 0;
+  this->m_FrontCountIsValid = false;
+  this->m_FrontCountIteration = 0;
+  this->m_InsidePixelsOutOfFrontRegion = 0;
 }
 
 
@@ -68,6 +95,443 @@ SinglePhaseLevelSetSegmentationModule<NDimension>::PrintSelf(std::ostream & os,
   os << indent << "AdvectionScaling = " << this->m_AdvectionScaling << std::endl;
   os << indent << "MaximumRMSError = " << this->m_MaximumRMSError << std::endl;
   os << indent << "MaximumNumberOfIterations = " << this->m_MaximumNumberOfIterations << std::endl;
+  os << indent << "UseParallelSolver = " << this->m_UseParallelSolver << std::endl;
+  os << indent << "InitialLevelSet = " << this->m_InitialLevelSet.GetPointer() << std::endl;
+  os << indent << "InitialLevelSetIsMask = " << this->m_InitialLevelSetIsMask << std::endl;
+  os << indent << "MaximumElapsedTime = " << this->m_MaximumElapsedTime << std::endl;
+  os << indent << "MaximumFrontVolume = " << this->m_MaximumFrontVolume << std::endl;
+  os << indent << "StopCondition = " << this->GetStopConditionDescription() << std::endl;
+  os << indent << "ElapsedIterations = " << this->m_ElapsedIterations << std::endl;
+  os << indent << "RMSChange = " << this->m_RMSChange << std::endl;
+  os << indent << "ActiveLayerSize = " << this->m_ActiveLayerSize << std::endl;
+  os << indent << "ElapsedTime = " << this->m_ElapsedTime << std::endl;
+}
+
+
+/**
+ * Description of the stop condition
+ */
+template <unsigned int NDimension>
+std::string
+SinglePhaseLevelSetSegmentationModule<NDimension>::GetStopConditionDescription() const
+{
+  switch (this->m_StopCondition)
+  {
+    case MaximumNumberOfIterationsStop:
+      return "Maximum number of iterations reached";
+    case MaximumElapsedTimeStop:
+      return "Maximum elapsed time exceeded";
+    case MaximumFrontVolumeStop:
+      return "Maximum front volume exceeded";
+    case ConvergenceStop:
+    default:
+      return "Maximum RMS error reached";
+  }
+}
+
+
+/**
+ * Initial level set on the grid of the feature image
+ */
+template <unsigned int NDimension>
+typename SinglePhaseLevelSetSegmentationModule<NDimension>::InputImageType::ConstPointer
+SinglePhaseLevelSetSegmentationModule<NDimension>::ComputeInternalInitialLevelSet() const
+{
+  if (this->m_InitialLevelSet.IsNull())
+  {
+    return nullptr;
+  }
+
+  typename InputImageType::ConstPointer levelSet = this->m_InitialLevelSet;
+
+  if (this->m_InitialLevelSetIsMask)
+  {
+    // The zero set lies half way between the pixels inside and outside of
+    // the mask.
+    typename InputImageType::Pointer maskLevelSet = InputImageType::New();
+    maskLevelSet->CopyInformation(levelSet);
+    maskLevelSet->SetRegions(levelSet->GetBufferedRegion());
+    maskLevelSet->Allocate();
+
+    const InputPixelType * maskBuffer = levelSet->GetBufferPointer();
+    InputPixelType *       levelSetBuffer = maskLevelSet->GetBufferPointer();
+    const SizeValueType    numberOfPixels = levelSet->GetBufferedRegion().GetNumberOfPixels();
+    for (SizeValueType i = 0; i < numberOfPixels; ++i)
+    {
+      levelSetBuffer[i] = Math::NotExactlyEquals(maskBuffer[i], InputPixelType{}) ? -0.5f : 0.5f;
+    }
+
+    levelSet = maskLevelSet;
+  }
+
+  const FeatureImageType * featureImage = this->GetInternalFeatureImage();
+
+  if (featureImage->IsSameImageGeometryAs(levelSet) &&
+      featureImage->GetBufferedRegion() == levelSet->GetBufferedRegion())
+  {
+    return levelSet;
+  }
+
+  // The pixels of the feature image outside of the initial level set take
+  // the value of the nearest pixel.
+  using ResampleFilterType = ResampleImageFilter<InputImageType, InputImageType>;
+  using ExtrapolatorType = NearestNeighborExtrapolateImageFunction<InputImageType, double>;
+
+  typename ResampleFilterType::Pointer resampler = ResampleFilterType::New();
+  resampler->SetInput(levelSet);
+  resampler->SetOutputParametersFromImage(featureImage);
+  resampler->SetExtrapolator(ExtrapolatorType::New());
+  resampler->Update();
+
+  return resampler->GetOutput();
+}
+
+
+/**
+ * Evolve a level set within the time and volume limits
+ */
+template <unsigned int NDimension>
+template <typename TFilter>
+void
+SinglePhaseLevelSetSegmentationModule<NDimension>::EvolveLevelSet(HaltableLevelSetFilter<TFilter> * filter)
+{
+  StopConditionType stopCondition = ConvergenceStop;
+
+  const double        maximumElapsedTime = this->m_MaximumElapsedTime;
+  const double        maximumFrontVolume = this->m_MaximumFrontVolume;
+  const bool          reportIterations = this->HasObserver(IterationEvent());
+  const TimePointType startTime = std::chrono::steady_clock::now();
+
+  this->m_ActiveLayerSize = 0;
+
+  // The counts of the front start over with each evolution.
+  SizeValueType iteration = 0;
+  this->m_FrontCountIsValid = false;
+  this->m_EvolutionThread = std::this_thread::get_id();
+
+  if (maximumElapsedTime > 0.0 || maximumFrontVolume > 0.0 || reportIterations)
+  {
+    filter->AddObserver(IterationEvent(), [&, filter](const EventObject &) {
+      const std::chrono::duration<double> elapsedTime = std::chrono::steady_clock::now() - startTime;
+
+      ++iteration;
+
+      if (reportIterations)
+      {
+        this->m_IterationLevelSet = filter->GetOutput();
+        this->m_Iteration = iteration;
+        this->InvokeIterationEvent(filter->GetElapsedIterations(), filter->GetRMSChange(), elapsedTime.count());
+        this->m_IterationLevelSet = nullptr;
+      }
+
+      if (stopCondition != ConvergenceStop)
+      {
+        return;
+      }
+
+      if (maximumElapsedTime > 0.0 && elapsedTime.count() > maximumElapsedTime)
+      {
+        stopCondition = MaximumElapsedTimeStop;
+      }
+      else if (maximumFrontVolume > 0.0 &&
+               this->ComputeFrontVolume(filter->GetOutput(), iteration) > maximumFrontVolume)
+      {
+        stopCondition = MaximumFrontVolumeStop;
+      }
+
+      // The level set of the current iteration is the output.
+      if (stopCondition != ConvergenceStop)
+      {
+        filter->HaltEvolution();
+      }
+    });
+  }
+
+  filter->Update();
+
+  if (stopCondition == ConvergenceStop && filter->GetElapsedIterations() >= filter->GetNumberOfIterations())
+  {
+    stopCondition = MaximumNumberOfIterationsStop;
+  }
+
+  const std::chrono::duration<double> elapsedTime = std::chrono::steady_clock::now() - startTime;
+
+  this->m_ElapsedIterations = filter->GetElapsedIterations();
+  this->m_RMSChange = filter->GetRMSChange();
+  this->m_ElapsedTime = elapsedTime.count();
+  this->m_StopCondition = stopCondition;
+}
+
+
+/**
+ * Remaining time
+ */
+template <unsigned int NDimension>
+double
+SinglePhaseLevelSetSegmentationModule<NDimension>::GetRemainingElapsedTime(const TimePointType & startTime) const
+{
+  if (!(this->m_MaximumElapsedTime > 0.0))
+  {
+    return 0.0;
+  }
+
+  const std::chrono::duration<double> elapsedTime = std::chrono::steady_clock::now() - startTime;
+
+  return std::max(this->m_MaximumElapsedTime - elapsedTime.count(), std::numeric_limits<double>::min());
+}
+
+
+/**
+ * Count the pixels of the front in a region
+ */
+template <unsigned int NDimension>
+void
+SinglePhaseLevelSetSegmentationModule<NDimension>::CountFrontPixels(const OutputImageType * levelSet,
+                                                                    const RegionType &      region,
+                                                                    FrontCountType &        count) const
+{
+  const auto countRegion = [levelSet](const RegionType & subRegion, FrontCountType & subCount) {
+    ImageScanlineConstIterator<OutputImageType> it(levelSet, subRegion);
+    while (!it.IsAtEnd())
+    {
+      while (!it.IsAtEndOfLine())
+      {
+        const OutputPixelType value = it.Get();
+        subCount.InsidePixels += (value < 0.0f);
+        if (value >= -0.5f && value <= 0.5f)
+        {
+          const IndexType index = it.GetIndex();
+          if (subCount.ActivePixels == 0)
+          {
+            subCount.ActiveMinimum = index;
+            subCount.ActiveMaximum = index;
+          }
+          for (unsigned int d = 0; d < Dimension; ++d)
+          {
+            subCount.ActiveMinimum[d] = std::min(subCount.ActiveMinimum[d], index[d]);
+            subCount.ActiveMaximum[d] = std::max(subCount.ActiveMaximum[d], index[d]);
+          }
+          ++subCount.ActivePixels;
+        }
+        ++it;
+      }
+      it.NextLine();
+    }
+  };
+
+  count = FrontCountType();
+
+  // The IterationEvents of the multithreaded solvers are invoked by one of
+  // their threads, while the other ones wait for it: the count is serial
+  // there, so that no multithreaded work is nested in theirs.
+  if (std::this_thread::get_id() != this->m_EvolutionThread)
+  {
+    countRegion(region, count);
+    return;
+  }
+
+  std::mutex mutex;
+
+  this->GetMultiThreader()->template ParallelizeImageRegion<Dimension>(
+    region,
+    [&](const RegionType & subRegion) {
+      FrontCountType subCount;
+      countRegion(subRegion, subCount);
+
+      const std::lock_guard<std::mutex> lock(mutex);
+      count.InsidePixels += subCount.InsidePixels;
+      if (subCount.ActivePixels == 0)
+      {
+        return;
+      }
+      if (count.ActivePixels == 0)
+      {
+        count.ActiveMinimum = subCount.ActiveMinimum;
+        count.ActiveMaximum = subCount.ActiveMaximum;
+      }
+      for (unsigned int d = 0; d < Dimension; ++d)
+      {
+        count.ActiveMinimum[d] = std::min(count.ActiveMinimum[d], subCount.ActiveMinimum[d]);
+        count.ActiveMaximum[d] = std::max(count.ActiveMaximum[d], subCount.ActiveMaximum[d]);
+      }
+      count.ActivePixels += subCount.ActivePixels;
+    },
+    nullptr);
+}
+
+
+/**
+ * Update the counts of the front
+ */
+template <unsigned int NDimension>
+void
+SinglePhaseLevelSetSegmentationModule<NDimension>::UpdateFrontStatistics(const OutputImageType * levelSet,
+                                                                         SizeValueType           iteration) const
+{
+  if (this->m_FrontCountIsValid && this->m_FrontCountIteration == iteration)
+  {
+    return;
+  }
+
+  const RegionType & bufferedRegion = levelSet->GetBufferedRegion();
+
+  // Region of the active layer of the previous count, padded by the number
+  // of pixels it may have moved since then.
+  const auto activeRegion = [&bufferedRegion](const FrontCountType & count, SizeValueType padding) {
+    RegionType region;
+    region.SetIndex(count.ActiveMinimum);
+    for (unsigned int d = 0; d < Dimension; ++d)
+    {
+      region.SetSize(d, static_cast<SizeValueType>(count.ActiveMaximum[d] - count.ActiveMinimum[d] + 1));
+    }
+    region.PadByRadius(static_cast<OffsetValueType>(padding));
+    region.Crop(bufferedRegion);
+    return region;
+  };
+
+  // Without active layer, the level set does not change anymore.
+  bool countAll = !this->m_FrontCountIsValid;
+  if (!countAll && this->m_FrontCount.ActivePixels)
+  {
+    countAll = !this->m_FrontRegion.IsInside(
+      activeRegion(this->m_FrontCount, iteration - this->m_FrontCountIteration));
+  }
+
+  if (countAll)
+  {
+    this->m_FrontRegion = bufferedRegion;
+    this->m_InsidePixelsOutOfFrontRegion = 0;
+  }
+
+  FrontCountType count;
+  this->CountFrontPixels(levelSet, this->m_FrontRegion, count);
+  count.InsidePixels += this->m_InsidePixelsOutOfFrontRegion;
+
+  // Follow the active layer with a margin, so that the region is counted
+  // again only every few iterations. The pixels inside the front out of the
+  // new region are the ones of the whole image minus the ones in it.
+  constexpr SizeValueType margin = 4;
+
+  if (count.ActivePixels)
+  {
+    const RegionType frontRegion = activeRegion(count, margin);
+    if (!this->m_FrontRegion.IsInside(activeRegion(count, 1)) ||
+        2 * frontRegion.GetNumberOfPixels() < this->m_FrontRegion.GetNumberOfPixels())
+    {
+      FrontCountType frontRegionCount;
+      this->CountFrontPixels(levelSet, frontRegion, frontRegionCount);
+      this->m_FrontRegion = frontRegion;
+      this->m_InsidePixelsOutOfFrontRegion = count.InsidePixels - frontRegionCount.InsidePixels;
+    }
+  }
+
+  this->m_FrontCount = count;
+  this->m_FrontCountIteration = iteration;
+  this->m_FrontCountIsValid = true;
+}
+
+
+/**
+ * Volume inside the front
+ */
+template <unsigned int NDimension>
+double
+SinglePhaseLevelSetSegmentationModule<NDimension>::ComputeFrontVolume(const OutputImageType * levelSet,
+                                                                      SizeValueType           iteration) const
+{
+  this->UpdateFrontStatistics(levelSet, iteration);
+
+  double pixelVolume = 1.0;
+  for (unsigned int d = 0; d < Dimension; ++d)
+  {
+    pixelVolume *= levelSet->GetSpacing()[d];
+  }
+
+  return static_cast<double>(this->m_FrontCount.InsidePixels) * pixelVolume;
+}
+
+
+/**
+ * Pixels of the active layer
+ */
+template <unsigned int NDimension>
+SizeValueType
+SinglePhaseLevelSetSegmentationModule<NDimension>::GetActiveLayerSize() const
+{
+  if (this->m_IterationModule)
+  {
+    this->m_ActiveLayerSize = this->m_IterationModule->GetActiveLayerSize();
+  }
+  else if (this->m_IterationLevelSet)
+  {
+    this->UpdateFrontStatistics(this->m_IterationLevelSet, this->m_Iteration);
+    this->m_ActiveLayerSize = this->m_FrontCount.ActivePixels;
+  }
+
+  return this->m_ActiveLayerSize;
+}
+
+
+/**
+ * Iteration statistics
+ */
+template <unsigned int NDimension>
+void
+SinglePhaseLevelSetSegmentationModule<NDimension>::InvokeIterationEvent(SizeValueType elapsedIterations,
+                                                                        double        rmsChange,
+                                                                        double        elapsedTime)
+{
+  this->m_ElapsedIterations = elapsedIterations;
+  this->m_RMSChange = rmsChange;
+  this->m_ElapsedTime = elapsedTime;
+
+  this->InvokeEvent(IterationEvent());
+}
+
+
+/**
+ * Forward the iterations of another module
+ */
+template <unsigned int NDimension>
+void
+SinglePhaseLevelSetSegmentationModule<NDimension>::ForwardIterationEvents(Self * module)
+{
+  this->StopForwardingIterationEvents();
+
+  if (!this->HasObserver(IterationEvent()))
+  {
+    return;
+  }
+
+  this->m_ForwardedModule = module;
+  this->m_ForwardedModuleObserverTag = module->AddObserver(IterationEvent(), [this, module](const EventObject &) {
+    this->m_IterationModule = module;
+    this->InvokeIterationEvent(module->GetElapsedIterations(), module->GetRMSChange(), module->GetElapsedTime());
+    this->m_IterationModule = nullptr;
+  });
+}
+
+
+template <unsigned int NDimension>
+void
+SinglePhaseLevelSetSegmentationModule<NDimension>::StopForwardingIterationEvents()
+{
+  if (this->m_ForwardedModule)
+  {
+    this->m_ForwardedModule->RemoveObserver(this->m_ForwardedModuleObserverTag);
+    this->m_ForwardedModule = nullptr;
+  }
+}
+
+
+template <unsigned int NDimension>
+void
+SinglePhaseLevelSetSegmentationModule<NDimension>::CopyIterationStatistics(const Self * module)
+{
+  this->m_ElapsedIterations = module->GetElapsedIterations();
+  this->m_RMSChange = module->GetRMSChange();
+  this->m_ActiveLayerSize = module->GetActiveLayerSize();
+  this->m_ElapsedTime = module->GetElapsedTime();
 }
 
 
@@ -124,20 +588,41 @@ SinglePhaseLevelSetSegmentationModule<NDimension>::PackOutputImageInOutputSpatia
 
   if (this->m_InvertOutputIntensities)
   {
-    using CalculatorType = MinimumMaximumImageCalculator<OutputImageType>;
-    typename CalculatorType::Pointer calculator = CalculatorType::New();
-    calculator->SetImage(outputImage);
-    calculator->Compute();
-    using RescaleFilterType = IntensityWindowingImageFilter<OutputImageType, OutputImageType>;
-    typename RescaleFilterType::Pointer rescaler = RescaleFilterType::New();
-    rescaler->SetInput(outputImage);
-    rescaler->SetWindowMinimum(calculator->GetMinimum());
-    rescaler->SetWindowMaximum(calculator->GetMaximum());
-    rescaler->SetOutputMinimum(4.0);  // Note that the values must be [4:-4] here to
-    rescaler->SetOutputMaximum(-4.0); // make sure that we invert and not just rescale.
-    rescaler->InPlaceOn();
-    rescaler->Update();
-    outputImage = rescaler->GetOutput();
+    double minimum;
+    double maximum;
+    this->ComputeMinimumAndMaximum(outputImage, minimum, maximum);
+
+    // Note that the values must be [4:-4] here to make sure that we invert
+    // and not just rescale.
+    this->WindowIntensities(outputImage, minimum, maximum, 4.0, -4.0);
+  }
+
+  outputImage->DisconnectPipeline();
+
+  auto * outputObject = dynamic_cast<OutputSpatialObjectType *>(this->ProcessObject::GetOutput(0));
+
+  outputObject->SetImage(outputImage);
+}
+
+
+/**
+ * Same as above, for subclasses that know the range of their output.
+ */
+template <unsigned int NDimension>
+void
+SinglePhaseLevelSetSegmentationModule<NDimension>::PackOutputImageInOutputSpatialObject(OutputImageType * image,
+                                                                                        double            minimum,
+                                                                                        double            maximum)
+{
+  typename OutputImageType::Pointer outputImage = image;
+
+  if (this->m_InvertOutputIntensities)
+  {
+    this->WindowIntensities(outputImage, minimum, maximum, 4.0, -4.0);
+  }
+  else
+  {
+    this->WindowIntensities(outputImage, minimum, maximum, -4.0, 4.0);
   }
 
   outputImage->DisconnectPipeline();
@@ -148,6 +633,105 @@ SinglePhaseLevelSetSegmentationModule<NDimension>::PackOutputImageInOutputSpatia
 }
 
 
+/**
+ * Range of the image
+ */
+template <unsigned int NDimension>
+void
+SinglePhaseLevelSetSegmentationModule<NDimension>::ComputeMinimumAndMaximum(const OutputImageType * image,
+                                                                            double &                minimum,
+                                                                            double &                maximum)
+{
+  using RegionType = typename OutputImageType::RegionType;
+
+  OutputPixelType imageMinimum = NumericTraits<OutputPixelType>::max();
+  OutputPixelType imageMaximum = NumericTraits<OutputPixelType>::NonpositiveMin();
+  std::mutex      mutex;
+
+  this->GetMultiThreader()->template ParallelizeImageRegion<Dimension>(
+    image->GetBufferedRegion(),
+    [&](const RegionType & region) {
+      OutputPixelType regionMinimum = NumericTraits<OutputPixelType>::max();
+      OutputPixelType regionMaximum = NumericTraits<OutputPixelType>::NonpositiveMin();
+
+      ImageScanlineConstIterator<OutputImageType> it(image, region);
+      while (!it.IsAtEnd())
+      {
+        while (!it.IsAtEndOfLine())
+        {
+          const OutputPixelType value = it.Get();
+          regionMinimum = std::min(regionMinimum, value);
+          regionMaximum = std::max(regionMaximum, value);
+          ++it;
+        }
+        it.NextLine();
+      }
+
+      const std::lock_guard<std::mutex> lock(mutex);
+      imageMinimum = std::min(imageMinimum, regionMinimum);
+      imageMaximum = std::max(imageMaximum, regionMaximum);
+    },
+    nullptr);
+
+  minimum = static_cast<double>(imageMinimum);
+  maximum = static_cast<double>(imageMaximum);
+}
+
+
+/**
+ * In place intensity windowing
+ */
+template <unsigned int NDimension>
+void
+SinglePhaseLevelSetSegmentationModule<NDimension>::WindowIntensities(OutputImageType * image,
+                                                                     double            windowMinimum,
+                                                                     double            windowMaximum,
+                                                                     double            outputMinimum,
+                                                                     double            outputMaximum)
+{
+  using RegionType = typename OutputImageType::RegionType;
+
+  // A constant image is mapped to the output minimum.
+  double scale = 0.0;
+  if (Math::NotExactlyEquals(windowMaximum, windowMinimum))
+  {
+    scale = (outputMaximum - outputMinimum) / (windowMaximum - windowMinimum);
+  }
+  const double shift = outputMinimum - windowMinimum * scale;
+
+  const auto lowValue = static_cast<OutputPixelType>(outputMinimum);
+  const auto highValue = static_cast<OutputPixelType>(outputMaximum);
+
+  this->GetMultiThreader()->template ParallelizeImageRegion<Dimension>(
+    image->GetBufferedRegion(),
+    [&](const RegionType & region) {
+      ImageScanlineIterator<OutputImageType> it(image, region);
+      while (!it.IsAtEnd())
+      {
+        while (!it.IsAtEndOfLine())
+        {
+          const auto value = static_cast<double>(it.Get());
+          if (value < windowMinimum)
+          {
+            it.Set(lowValue);
+          }
+          else if (value > windowMaximum)
+          {
+            it.Set(highValue);
+          }
+          else
+          {
+            it.Set(static_cast<OutputPixelType>(value * scale + shift));
+          }
+          ++it;
+        }
+        it.NextLine();
+      }
+    },
+    nullptr);
+}
+
+
 /**
  * Generate Data
  */
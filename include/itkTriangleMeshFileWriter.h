@@ -0,0 +1,114 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkTriangleMeshFileWriter_h
+#define itkTriangleMeshFileWriter_h
+
+#include "itkProcessObject.h"
+
+#include <fstream>
+#include <string>
+
+namespace itk
+{
+
+/** \class TriangleMeshFileWriter
+ *
+ * \brief Write a triangle mesh in a binary STL or PLY file.
+ *
+ * The format is chosen from the extension of the FileName, ".stl" or ".ply",
+ * in any case. Both are written in binary, little endian. The STL file
+ * carries a normal per triangle, computed from the order of its points. The
+ * PLY file keeps the points shared between the triangles.
+ *
+ * All the cells of the mesh must be triangles, such as the ones of the
+ * IsoSurfaceMeshSource.
+ *
+ * \sa IsoSurfaceMeshSource
+ *
+ * \ingroup LesionSizingToolkit
+ */
+template <typename TInputMesh>
+class ITK_TEMPLATE_EXPORT TriangleMeshFileWriter : public ProcessObject
+{
+public:
+  ITK_DISALLOW_COPY_AND_MOVE(TriangleMeshFileWriter);
+
+  /** Standard class type alias. */
+  using Self = TriangleMeshFileWriter;
+  using Superclass = ProcessObject;
+  using Pointer = SmartPointer<Self>;
+  using ConstPointer = SmartPointer<const Self>;
+
+  /** Method for creation through the object factory. */
+  itkNewMacro(Self);
+
+  /** Run-time type information (and related methods). */
+  itkOverrideGetNameOfClassMacro(TriangleMeshFileWriter);
+
+  using InputMeshType = TInputMesh;
+
+  /** Set/Get the mesh to write. */
+  using Superclass::SetInput;
+  void
+  SetInput(const InputMeshType * input);
+  const InputMeshType *
+  GetInput();
+
+  /** Name of the file to write. */
+  itkSetStringMacro(FileName);
+  itkGetStringMacro(FileName);
+
+  /** Write the file. */
+  virtual void
+  Write();
+
+  /** Aliased to the Write() method to be consistent with the rest of the
+   * pipeline. */
+  void
+  Update() override
+  {
+    this->Write();
+  }
+
+protected:
+  TriangleMeshFileWriter() = default;
+  ~TriangleMeshFileWriter() override = default;
+
+  void
+  PrintSelf(std::ostream & os, Indent indent) const override;
+
+  void
+  GenerateData() override;
+
+private:
+  void
+  WriteSTL(std::ofstream & file, const InputMeshType * mesh) const;
+
+  void
+  WritePLY(std::ofstream & file, const InputMeshType * mesh) const;
+
+  std::string m_FileName;
+};
+
+} // end namespace itk
+
+#ifndef ITK_MANUAL_INSTANTIATION
+#  include "itkTriangleMeshFileWriter.hxx"
+#endif
+
+#endif
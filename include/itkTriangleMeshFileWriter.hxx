@@ -0,0 +1,238 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkTriangleMeshFileWriter_hxx
+#define itkTriangleMeshFileWriter_hxx
+
+#include "itkByteSwapper.h"
+#include "itkVector.h"
+#include "itksys/SystemTools.hxx"
+
+#include <cstdint>
+#include <cstring>
+
+namespace itk
+{
+
+template <typename TInputMesh>
+void
+TriangleMeshFileWriter<TInputMesh>::SetInput(const InputMeshType * input)
+{
+  this->ProcessObject::SetNthInput(0, const_cast<InputMeshType *>(input));
+}
+
+
+template <typename TInputMesh>
+const typename TriangleMeshFileWriter<TInputMesh>::InputMeshType *
+TriangleMeshFileWriter<TInputMesh>::GetInput()
+{
+  return itkDynamicCastInDebugMode<const InputMeshType *>(this->ProcessObject::GetInput(0));
+}
+
+
+/**
+ * PrintSelf
+ */
+template <typename TInputMesh>
+void
+TriangleMeshFileWriter<TInputMesh>::PrintSelf(std::ostream & os, Indent indent) const
+{
+  Superclass::PrintSelf(os, indent);
+  os << indent << "FileName = " << this->m_FileName << std::endl;
+}
+
+
+/**
+ * Write
+ */
+template <typename TInputMesh>
+void
+TriangleMeshFileWriter<TInputMesh>::Write()
+{
+  auto * input = const_cast<InputMeshType *>(this->GetInput());
+
+  if (input == nullptr)
+  {
+    itkExceptionMacro("No input to writer!");
+  }
+
+  if (this->m_FileName.empty())
+  {
+    itkExceptionMacro("No filename was specified");
+  }
+
+  // Bring the mesh up to date.
+  input->Update();
+
+  this->InvokeEvent(StartEvent());
+  this->GenerateData();
+  this->InvokeEvent(EndEvent());
+}
+
+
+/*
+ * Generate Data
+ */
+template <typename TInputMesh>
+void
+TriangleMeshFileWriter<TInputMesh>::GenerateData()
+{
+  const InputMeshType * mesh = this->GetInput();
+
+  for (auto cellIt = mesh->GetCells()->Begin(); cellIt != mesh->GetCells()->End(); ++cellIt)
+  {
+    if (cellIt.Value()->GetNumberOfPoints() != 3)
+    {
+      itkExceptionMacro("Cell " << cellIt.Index() << " is not a triangle");
+    }
+  }
+
+  const std::string extension =
+    itksys::SystemTools::LowerCase(itksys::SystemTools::GetFilenameLastExtension(this->m_FileName));
+
+  if (extension != ".stl" && extension != ".ply")
+  {
+    itkExceptionMacro("Unknown extension of " << this->m_FileName << ", expected .stl or .ply");
+  }
+
+  std::ofstream file(this->m_FileName.c_str(), std::ios::out | std::ios::binary);
+
+  if (!file)
+  {
+    itkExceptionMacro("Cannot open " << this->m_FileName << " for writing");
+  }
+
+  if (extension == ".stl")
+  {
+    this->WriteSTL(file, mesh);
+  }
+  else
+  {
+    this->WritePLY(file, mesh);
+  }
+
+  if (!file)
+  {
+    itkExceptionMacro("Error while writing " << this->m_FileName);
+  }
+}
+
+
+/**
+ * Binary STL: a header of 80 bytes, the number of triangles, and for each
+ * triangle its normal, its three points and a 16 bits attribute.
+ */
+template <typename TInputMesh>
+void
+TriangleMeshFileWriter<TInputMesh>::WriteSTL(std::ofstream & file, const InputMeshType * mesh) const
+{
+  char header[80];
+  std::memset(header, ' ', sizeof(header));
+  const char description[] = "Binary STL written by the Lesion Sizing Toolkit";
+  std::memcpy(header, description, sizeof(description) - 1);
+  file.write(header, sizeof(header));
+
+  const auto numberOfTriangles = static_cast<std::uint32_t>(mesh->GetNumberOfCells());
+  ByteSwapper<std::uint32_t>::SwapWriteRangeFromSystemToLittleEndian(&numberOfTriangles, 1, &file);
+
+  using VectorType = Vector<double, 3>;
+
+  for (auto cellIt = mesh->GetCells()->Begin(); cellIt != mesh->GetCells()->End(); ++cellIt)
+  {
+    auto pointIdIt = cellIt.Value()->PointIdsBegin();
+
+    VectorType points[3];
+    for (auto & point : points)
+    {
+      const typename InputMeshType::PointType & meshPoint = mesh->GetPoints()->ElementAt(*pointIdIt++);
+      for (unsigned int d = 0; d < 3; ++d)
+      {
+        point[d] = meshPoint[d];
+      }
+    }
+
+    VectorType normal = CrossProduct(points[1] - points[0], points[2] - points[0]);
+    const double norm = normal.GetNorm();
+    if (norm > 0.0)
+    {
+      normal /= norm;
+    }
+
+    float record[12];
+    for (unsigned int d = 0; d < 3; ++d)
+    {
+      record[d] = static_cast<float>(normal[d]);
+      for (unsigned int i = 0; i < 3; ++i)
+      {
+        record[3 * (i + 1) + d] = static_cast<float>(points[i][d]);
+      }
+    }
+    ByteSwapper<float>::SwapWriteRangeFromSystemToLittleEndian(record, 12, &file);
+
+    const std::uint16_t attribute = 0;
+    ByteSwapper<std::uint16_t>::SwapWriteRangeFromSystemToLittleEndian(&attribute, 1, &file);
+  }
+}
+
+
+/**
+ * Binary PLY: a text header, the points as three floats and the faces as a
+ * byte count followed by 32 bits point indices.
+ */
+template <typename TInputMesh>
+void
+TriangleMeshFileWriter<TInputMesh>::WritePLY(std::ofstream & file, const InputMeshType * mesh) const
+{
+  file << "ply\n"
+       << "format binary_little_endian 1.0\n"
+       << "comment Written by the Lesion Sizing Toolkit\n"
+       << "element vertex " << mesh->GetNumberOfPoints() << "\n"
+       << "property float x\n"
+       << "property float y\n"
+       << "property float z\n"
+       << "element face " << mesh->GetNumberOfCells() << "\n"
+       << "property list uchar int vertex_indices\n"
+       << "end_header\n";
+
+  for (auto pointIt = mesh->GetPoints()->Begin(); pointIt != mesh->GetPoints()->End(); ++pointIt)
+  {
+    float coordinates[3];
+    for (unsigned int d = 0; d < 3; ++d)
+    {
+      coordinates[d] = static_cast<float>(pointIt.Value()[d]);
+    }
+    ByteSwapper<float>::SwapWriteRangeFromSystemToLittleEndian(coordinates, 3, &file);
+  }
+
+  for (auto cellIt = mesh->GetCells()->Begin(); cellIt != mesh->GetCells()->End(); ++cellIt)
+  {
+    const unsigned char numberOfPoints = 3;
+    file.write(reinterpret_cast<const char *>(&numberOfPoints), 1);
+
+    std::int32_t pointIds[3];
+    auto         pointIdIt = cellIt.Value()->PointIdsBegin();
+    for (auto & pointId : pointIds)
+    {
+      pointId = static_cast<std::int32_t>(*pointIdIt++);
+    }
+    ByteSwapper<std::int32_t>::SwapWriteRangeFromSystemToLittleEndian(pointIds, 3, &file);
+  }
+}
+
+} // end namespace itk
+
+#endif
@@ -0,0 +1,184 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkUntidyFastMarchingImageFilter_h
+#define itkUntidyFastMarchingImageFilter_h
+
+#include "itkImageToImageFilter.h"
+#include "itkLevelSet.h"
+
+#include <unordered_set>
+#include <vector>
+
+namespace itk
+{
+
+/** \class UntidyFastMarchingImageFilter
+ *
+ * \brief Fast marching solver based on an untidy priority queue.
+ *
+ * This filter solves the same Eikonal equation as the
+ * FastMarchingImageFilter: the input image is the speed of the front, and
+ * the output is the time at which the front, started at the trial points,
+ * arrives at each pixel. Pixels that are not reached before the
+ * StoppingValue keep the LargeValue.
+ *
+ * The binary heap of the FastMarchingImageFilter is replaced by a bucketed,
+ * "untidy", priority queue (L. Yatziv, A. Bartesaghi and G. Sapiro, "O(N)
+ * implementation of the fast marching algorithm", Journal of Computational
+ * Physics, 2006). The trial pixels are stored in buckets of arrival time of
+ * width BucketWidth, and are processed in the order of the buckets, and in
+ * first-in first-out order within a bucket. Insertion and removal are then
+ * done in constant time, at the cost of an error on the arrival times that
+ * is of the order of the grid spacing, like the error of the discretization
+ * itself. When the BucketWidth is not set, it is chosen as the smallest time
+ * needed by the front to cross a pixel, the smallest spacing divided by the
+ * largest speed. Only a fixed number of buckets following the one being
+ * processed are stored; later pixels wait in an overflow bucket, so that the
+ * memory of the queue does not depend on the range of the arrival times.
+ *
+ * The state of the pixels is not stored in a label image: the accepted
+ * pixels are kept in a hash set, and pixels beyond the StoppingValue are
+ * never queued. Apart from the initialization of the output, the cost of the
+ * filter is then proportional to the number of pixels reached by the front,
+ * and not to the size of the image.
+ *
+ * As in the FastMarchingImageFilter, the absolute value of the speed is
+ * used, divided by the NormalizationFactor, and pixels of zero speed are
+ * never reached.
+ *
+ * \sa FastMarchingImageFilter
+ *
+ * \ingroup LevelSetSegmentation
+ * \ingroup LesionSizingToolkit
+ */
+template <typename TInputImage, typename TOutputImage>
+class ITK_TEMPLATE_EXPORT UntidyFastMarchingImageFilter : public ImageToImageFilter<TInputImage, TOutputImage>
+{
+public:
+  ITK_DISALLOW_COPY_AND_MOVE(UntidyFastMarchingImageFilter);
+
+  /** Standard class type alias. */
+  using Self = UntidyFastMarchingImageFilter;
+  using Superclass = ImageToImageFilter<TInputImage, TOutputImage>;
+  using Pointer = SmartPointer<Self>;
+  using ConstPointer = SmartPointer<const Self>;
+
+  /** Method for creation through the object factory. */
+  itkNewMacro(Self);
+
+  /** Run-time type information (and related methods). */
+  itkOverrideGetNameOfClassMacro(UntidyFastMarchingImageFilter);
+
+  /** Image dimension constant */
+  static constexpr unsigned int ImageDimension = TOutputImage::ImageDimension;
+
+  using InputImageType = TInputImage;
+  using InputPixelType = typename InputImageType::PixelType;
+  using OutputImageType = TOutputImage;
+  using OutputPixelType = typename OutputImageType::PixelType;
+  using OutputImageRegionType = typename OutputImageType::RegionType;
+  using IndexType = typename OutputImageType::IndexType;
+
+  /** Types of the trial points, the same as the ones of the
+   * FastMarchingImageFilter. */
+  using NodeType = LevelSetNode<OutputPixelType, ImageDimension>;
+  using NodeContainer = VectorContainer<unsigned int, NodeType>;
+  using NodeContainerPointer = typename NodeContainer::Pointer;
+
+  /** Set/Get the points from which the front starts, with their initial
+   * arrival time. */
+  itkSetObjectMacro(TrialPoints, NodeContainer);
+  itkGetModifiableObjectMacro(TrialPoints, NodeContainer);
+
+  /** The front stops when the arrival times of the trial points exceed the
+   * StoppingValue. */
+  itkSetMacro(StoppingValue, double);
+  itkGetConstMacro(StoppingValue, double);
+
+  /** The speed is divided by this factor. Defaults to 1. */
+  itkSetMacro(NormalizationFactor, double);
+  itkGetConstMacro(NormalizationFactor, double);
+
+  /** Width, in arrival time, of the buckets of the priority queue. A value
+   * of zero, the default, selects the smallest spacing divided by the
+   * largest speed of the input image. */
+  itkSetMacro(BucketWidth, double);
+  itkGetConstMacro(BucketWidth, double);
+
+  /** Value given to the pixels that the front does not reach. */
+  itkGetConstMacro(LargeValue, OutputPixelType);
+
+  /** Number of pixels accepted by the last execution of the filter. */
+  itkGetConstMacro(NumberOfProcessedPixels, SizeValueType);
+
+#ifdef ITK_USE_CONCEPT_CHECKING
+  /** Begin concept checking */
+  itkConceptMacro(SameDimensionCheck, (Concept::SameDimension<TInputImage::ImageDimension, ImageDimension>));
+  itkConceptMacro(InputHasNumericTraitsCheck, (Concept::HasNumericTraits<InputPixelType>));
+  itkConceptMacro(OutputIsFloatingPointCheck, (Concept::IsFloatingPoint<OutputPixelType>));
+  /** End concept checking */
+#endif
+
+protected:
+  UntidyFastMarchingImageFilter();
+  ~UntidyFastMarchingImageFilter() override = default;
+
+  void
+  PrintSelf(std::ostream & os, Indent indent) const override;
+
+  /** The whole input is requested, since the front may reach any pixel. */
+  void
+  GenerateInputRequestedRegion() override;
+
+  /** The whole output is produced. */
+  void
+  EnlargeOutputRequestedRegion(DataObject * output) override;
+
+  void
+  GenerateData() override;
+
+private:
+  using OffsetSetType = std::unordered_set<OffsetValueType>;
+
+  /** Solve the upwind discretization of the Eikonal equation at a pixel,
+   * from the values of its accepted neighbors. */
+  double
+  ComputeArrivalTime(const IndexType & index, OffsetValueType offset, const OffsetSetType & accepted) const;
+
+  NodeContainerPointer m_TrialPoints;
+  double               m_StoppingValue;
+  double               m_NormalizationFactor;
+  double               m_BucketWidth;
+  OutputPixelType      m_LargeValue;
+  SizeValueType        m_NumberOfProcessedPixels;
+
+  // Valid during the execution of GenerateData() only.
+  const InputPixelType *  m_SpeedBuffer;
+  OutputPixelType *       m_OutputBuffer;
+  OutputImageRegionType   m_BufferedRegion;
+  const OffsetValueType * m_OffsetTable;
+  double                  m_InverseSquaredSpacing[ImageDimension];
+};
+
+} // end namespace itk
+
+#ifndef ITK_MANUAL_INSTANTIATION
+#  include "itkUntidyFastMarchingImageFilter.hxx"
+#endif
+
+#endif
@@ -0,0 +1,448 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkUntidyFastMarchingImageFilter_hxx
+#define itkUntidyFastMarchingImageFilter_hxx
+
+#include "itkMath.h"
+#include "itkNumericTraits.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <utility>
+
+namespace itk
+{
+
+/**
+ * Constructor
+ */
+template <typename TInputImage, typename TOutputImage>
+UntidyFastMarchingImageFilter<TInputImage, TOutputImage>::UntidyFastMarchingImageFilter()
+{
+  this->m_TrialPoints = nullptr;
+  this->m_StoppingValue = static_cast<double>(NumericTraits<OutputPixelType>::max());
+  this->m_NormalizationFactor = 1.0;
+  this->m_BucketWidth = 0.0;
+  this->m_LargeValue = static_cast<OutputPixelType>(NumericTraits<OutputPixelType>::max() / 2.0);
+  this->m_NumberOfProcessedPixels = 0;
+
+  this->m_SpeedBuffer = nullptr;
+  this->m_OutputBuffer = nullptr;
+  this->m_OffsetTable = nullptr;
+  std::fill_n(this->m_InverseSquaredSpacing, ImageDimension, 0.0);
+}
+
+
+/**
+ * PrintSelf
+ */
+template <typename TInputImage, typename TOutputImage>
+void
+UntidyFastMarchingImageFilter<TInputImage, TOutputImage>::PrintSelf(std::ostream & os, Indent indent) const
+{
+  Superclass::PrintSelf(os, indent);
+  os << indent << "TrialPoints = " << this->m_TrialPoints.GetPointer() << std::endl;
+  os << indent << "StoppingValue = " << this->m_StoppingValue << std::endl;
+  os << indent << "NormalizationFactor = " << this->m_NormalizationFactor << std::endl;
+  os << indent << "BucketWidth = " << this->m_BucketWidth << std::endl;
+  os << indent << "LargeValue = " << static_cast<typename NumericTraits<OutputPixelType>::PrintType>(this->m_LargeValue)
+     << std::endl;
+  os << indent << "NumberOfProcessedPixels = " << this->m_NumberOfProcessedPixels << std::endl;
+}
+
+
+/**
+ * Request the whole input
+ */
+template <typename TInputImage, typename TOutputImage>
+void
+UntidyFastMarchingImageFilter<TInputImage, TOutputImage>::GenerateInputRequestedRegion()
+{
+  Superclass::GenerateInputRequestedRegion();
+
+  if (this->GetInput())
+  {
+    auto * input = const_cast<InputImageType *>(this->GetInput());
+    input->SetRequestedRegionToLargestPossibleRegion();
+  }
+}
+
+
+/**
+ * Produce the whole output
+ */
+template <typename TInputImage, typename TOutputImage>
+void
+UntidyFastMarchingImageFilter<TInputImage, TOutputImage>::EnlargeOutputRequestedRegion(DataObject * output)
+{
+  Superclass::EnlargeOutputRequestedRegion(output);
+  output->SetRequestedRegionToLargestPossibleRegion();
+}
+
+
+/*
+ * Arrival time at one pixel
+ */
+template <typename TInputImage, typename TOutputImage>
+double
+UntidyFastMarchingImageFilter<TInputImage, TOutputImage>::ComputeArrivalTime(const IndexType &     index,
+                                                                            OffsetValueType       offset,
+                                                                            const OffsetSetType & accepted) const
+{
+  const double speed = itk::Math::abs(static_cast<double>(this->m_SpeedBuffer[offset])) / this->m_NormalizationFactor;
+
+  if (!(speed > 0.0))
+  {
+    return NumericTraits<double>::max();
+  }
+
+  //
+  // Smallest accepted neighbor along each axis.
+  //
+  std::pair<double, double> neighbors[ImageDimension];
+  unsigned int              numberOfNeighbors = 0;
+
+  const IndexType & start = this->m_BufferedRegion.GetIndex();
+  const auto &      size = this->m_BufferedRegion.GetSize();
+
+  for (unsigned int d = 0; d < ImageDimension; ++d)
+  {
+    double neighborValue = NumericTraits<double>::max();
+
+    if (index[d] > start[d])
+    {
+      const OffsetValueType neighborOffset = offset - this->m_OffsetTable[d];
+      if (accepted.count(neighborOffset))
+      {
+        neighborValue = std::min(neighborValue, static_cast<double>(this->m_OutputBuffer[neighborOffset]));
+      }
+    }
+    if (index[d] + 1 < start[d] + static_cast<IndexValueType>(size[d]))
+    {
+      const OffsetValueType neighborOffset = offset + this->m_OffsetTable[d];
+      if (accepted.count(neighborOffset))
+      {
+        neighborValue = std::min(neighborValue, static_cast<double>(this->m_OutputBuffer[neighborOffset]));
+      }
+    }
+
+    if (neighborValue < NumericTraits<double>::max())
+    {
+      neighbors[numberOfNeighbors++] = std::make_pair(neighborValue, this->m_InverseSquaredSpacing[d]);
+    }
+  }
+
+  std::sort(neighbors, neighbors + numberOfNeighbors);
+
+  //
+  // Solve the quadratic equation with the neighbors in increasing order, as
+  // long as they are smaller than the solution, like the
+  // FastMarchingImageFilter does.
+  //
+  double solution = NumericTraits<double>::max();
+  double aa = 0.0;
+  double bb = 0.0;
+  double cc = -1.0 / (speed * speed);
+
+  for (unsigned int j = 0; j < numberOfNeighbors; ++j)
+  {
+    const double value = neighbors[j].first;
+    const double spaceFactor = neighbors[j].second;
+
+    if (solution < value)
+    {
+      break;
+    }
+
+    aa += spaceFactor;
+    bb += value * spaceFactor;
+    cc += value * value * spaceFactor;
+
+    const double discriminant = bb * bb - aa * cc;
+    if (discriminant < 0.0)
+    {
+      // Only possible through rounding errors, keep the solution computed
+      // with the previous neighbors.
+      break;
+    }
+
+    solution = (std::sqrt(discriminant) + bb) / aa;
+  }
+
+  return solution;
+}
+
+
+/*
+ * Generate Data
+ */
+template <typename TInputImage, typename TOutputImage>
+void
+UntidyFastMarchingImageFilter<TInputImage, TOutputImage>::GenerateData()
+{
+  const InputImageType * speedImage = this->GetInput();
+  OutputImageType *      outputImage = this->GetOutput();
+
+  const OutputImageRegionType region = outputImage->GetRequestedRegion();
+
+  outputImage->SetBufferedRegion(region);
+  outputImage->Allocate();
+  outputImage->FillBuffer(this->m_LargeValue);
+
+  this->m_NumberOfProcessedPixels = 0;
+
+  if (speedImage->GetBufferedRegion() != region)
+  {
+    itkExceptionMacro("The buffered region of the speed image " << speedImage->GetBufferedRegion()
+                                                                << " differs from the output region " << region);
+  }
+
+  if (this->m_TrialPoints.IsNull() || this->m_TrialPoints->Size() == 0)
+  {
+    this->UpdateProgress(1.0f);
+    return;
+  }
+
+  this->m_SpeedBuffer = speedImage->GetBufferPointer();
+  this->m_OutputBuffer = outputImage->GetBufferPointer();
+  this->m_BufferedRegion = region;
+  this->m_OffsetTable = outputImage->GetOffsetTable();
+
+  const typename OutputImageType::SpacingType & spacing = outputImage->GetSpacing();
+
+  double minimumSpacing = NumericTraits<double>::max();
+  for (unsigned int d = 0; d < ImageDimension; ++d)
+  {
+    this->m_InverseSquaredSpacing[d] = 1.0 / (spacing[d] * spacing[d]);
+    minimumSpacing = std::min(minimumSpacing, static_cast<double>(spacing[d]));
+  }
+
+  //
+  // Width of the buckets: the time needed by the fastest front to cross the
+  // smallest pixel dimension.
+  //
+  double bucketWidth = this->m_BucketWidth;
+  if (!(bucketWidth > 0.0))
+  {
+    const SizeValueType numberOfPixels = region.GetNumberOfPixels();
+
+    double maximumSpeed = 0.0;
+    for (SizeValueType i = 0; i < numberOfPixels; ++i)
+    {
+      maximumSpeed = std::max(maximumSpeed, itk::Math::abs(static_cast<double>(this->m_SpeedBuffer[i])));
+    }
+    maximumSpeed /= this->m_NormalizationFactor;
+
+    bucketWidth = maximumSpeed > 0.0 ? minimumSpacing / maximumSpeed : 1.0;
+  }
+
+  //
+  // The buckets are numbered from the smallest initial arrival time. Only
+  // the next RingSize buckets are stored, in a ring; the pixels beyond the
+  // ring wait in an overflow bucket, which is redistributed each time the
+  // ring has turned. Pixels whose arrival time exceeds the stopping value, or
+  // reaches the large value, are never queued.
+  //
+  double origin = NumericTraits<double>::max();
+  for (auto it = this->m_TrialPoints->Begin(); it != this->m_TrialPoints->End(); ++it)
+  {
+    origin = std::min(origin, static_cast<double>(it->Value().GetValue()));
+  }
+
+  const double stoppingValue = this->m_StoppingValue;
+  const double largeValue = this->m_LargeValue;
+
+  // Bucket numbers are bounded so that they can be cast to integers.
+  const double maximumPosition = static_cast<double>(NumericTraits<SizeValueType>::max() / 2);
+
+  constexpr SizeValueType RingSize = 1024;
+
+  std::vector<std::vector<OffsetValueType>> ring(RingSize);
+  std::vector<OffsetValueType>              overflow;
+  SizeValueType                             currentBucket = 0;
+  SizeValueType                             numberOfQueuedPixels = 0;
+
+  OffsetSetType accepted;
+
+  auto bucketPosition = [&](double value) { return std::max(0.0, (value - origin) / bucketWidth); };
+
+  auto push = [&](OffsetValueType offset, double value) {
+    if (value > stoppingValue || !(value < largeValue))
+    {
+      return;
+    }
+    const double position = bucketPosition(value);
+    if (!(position < maximumPosition))
+    {
+      return;
+    }
+    if (position >= static_cast<double>(currentBucket + RingSize))
+    {
+      overflow.push_back(offset);
+      return;
+    }
+    // The untidy queue may compute a time slightly smaller than the ones of
+    // the bucket being processed, the pixel is then processed in this bucket.
+    const SizeValueType bucket = std::max(static_cast<SizeValueType>(position), currentBucket);
+    ring[bucket % RingSize].push_back(offset);
+    ++numberOfQueuedPixels;
+  };
+
+  // Moves the waiting pixels that now fall in the ring to their bucket.
+  auto redistribute = [&]() {
+    std::vector<OffsetValueType> waiting;
+    waiting.swap(overflow);
+    for (const OffsetValueType offset : waiting)
+    {
+      if (!accepted.count(offset))
+      {
+        push(offset, static_cast<double>(this->m_OutputBuffer[offset]));
+      }
+    }
+  };
+
+  for (auto it = this->m_TrialPoints->Begin(); it != this->m_TrialPoints->End(); ++it)
+  {
+    const NodeType & node = it->Value();
+    const IndexType  index = node.GetIndex();
+    if (!region.IsInside(index))
+    {
+      continue;
+    }
+    const OffsetValueType offset = outputImage->ComputeOffset(index);
+    const double          value = static_cast<double>(node.GetValue());
+    if (value < static_cast<double>(this->m_OutputBuffer[offset]))
+    {
+      this->m_OutputBuffer[offset] = node.GetValue();
+      push(offset, value);
+    }
+  }
+
+  const bool   reportProgress = stoppingValue > origin && stoppingValue < largeValue;
+  const double progressScale = reportProgress ? 1.0 / (stoppingValue - origin) : 0.0;
+
+  while (numberOfQueuedPixels > 0 || !overflow.empty())
+  {
+    if (numberOfQueuedPixels == 0)
+    {
+      // The ring is empty: skip to the bucket of the earliest waiting pixel.
+      double position = maximumPosition;
+      for (const OffsetValueType offset : overflow)
+      {
+        if (!accepted.count(offset))
+        {
+          position = std::min(position, bucketPosition(static_cast<double>(this->m_OutputBuffer[offset])));
+        }
+      }
+      if (!(position < maximumPosition))
+      {
+        break;
+      }
+      currentBucket = std::max(currentBucket, static_cast<SizeValueType>(position));
+      redistribute();
+      continue;
+    }
+
+    if (currentBucket % RingSize == 0)
+    {
+      redistribute();
+    }
+
+    if (origin + static_cast<double>(currentBucket) * bucketWidth > stoppingValue)
+    {
+      break;
+    }
+
+    std::vector<OffsetValueType> & bucket = ring[currentBucket % RingSize];
+
+    // Pixels may be appended to the current bucket while it is processed.
+    for (SizeValueType i = 0; i < bucket.size(); ++i)
+    {
+      const OffsetValueType offset = bucket[i];
+      const double          value = static_cast<double>(this->m_OutputBuffer[offset]);
+
+      if (value > stoppingValue || !accepted.insert(offset).second)
+      {
+        continue;
+      }
+
+      ++this->m_NumberOfProcessedPixels;
+
+      const IndexType index = outputImage->ComputeIndex(offset);
+
+      for (unsigned int d = 0; d < ImageDimension; ++d)
+      {
+        for (int side = -1; side <= 1; side += 2)
+        {
+          IndexType neighborIndex = index;
+          neighborIndex[d] += side;
+          if (neighborIndex[d] < region.GetIndex(d) ||
+              neighborIndex[d] >= region.GetIndex(d) + static_cast<IndexValueType>(region.GetSize(d)))
+          {
+            continue;
+          }
+
+          const OffsetValueType neighborOffset = offset + side * this->m_OffsetTable[d];
+          if (accepted.count(neighborOffset))
+          {
+            continue;
+          }
+
+          const double solution = this->ComputeArrivalTime(neighborIndex, neighborOffset, accepted);
+          if (solution < static_cast<double>(this->m_OutputBuffer[neighborOffset]))
+          {
+            this->m_OutputBuffer[neighborOffset] = static_cast<OutputPixelType>(solution);
+            push(neighborOffset, solution);
+          }
+        }
+      }
+    }
+
+    numberOfQueuedPixels -= bucket.size();
+    bucket.clear();
+
+    if ((currentBucket & 0xff) == 0)
+    {
+      if (reportProgress)
+      {
+        const double progress = static_cast<double>(currentBucket) * bucketWidth * progressScale;
+        this->UpdateProgress(static_cast<float>(std::min(1.0, progress)));
+      }
+      if (this->GetAbortGenerateData())
+      {
+        ProcessAborted e(__FILE__, __LINE__);
+        e.SetDescription("Process aborted.");
+        e.SetLocation(ITK_LOCATION);
+        throw e;
+      }
+    }
+
+    ++currentBucket;
+  }
+
+  this->m_SpeedBuffer = nullptr;
+  this->m_OutputBuffer = nullptr;
+  this->m_OffsetTable = nullptr;
+
+  this->UpdateProgress(1.0f);
+}
+
+} // end namespace itk
+
+#endif
@@ -23,7 +23,8 @@
 #include "itkImageRegionExclusionIteratorWithIndex.h"
 #include "itkNeighborhoodAlgorithm.h"
 #include "itkOffset.h"
-#include "itkProgressReporter.h"
+
+#include <algorithm>
 
 namespace itk
 {
@@ -91,15 +92,33 @@ VotingBinaryHoleFillFloodingImageFilter<TInputImage, TOutputImage>::IterateFront
   this->m_TotalNumberOfPixelsChanged = 0;
   this->m_NumberOfPixelsChangedInLastIteration = 0;
 
-  // Progress reporting
-  ProgressReporter progress(this, 0, m_MaximumNumberOfIterations, 100000);
+  // The propagation usually stops long before the maximum number of
+  // iterations, when no pixel changes. The progress is estimated from the
+  // decrease of the number of pixels changed since the first iteration.
+  unsigned int numberOfPixelsChangedInFirstIteration = 0;
+  float        progress = 0.0f;
 
   while (this->m_CurrentIterationNumber < this->m_MaximumNumberOfIterations)
   {
     this->VisitAllSeedsAndTransitionTheirState();
     this->m_CurrentIterationNumber++;
 
-    progress.CompletedPixel(); // not really a pixel but an iteration
+    if (this->m_CurrentIterationNumber == 1)
+    {
+      numberOfPixelsChangedInFirstIteration = this->m_NumberOfPixelsChangedInLastIteration;
+    }
+
+    const double iterationFraction =
+      static_cast<double>(this->m_CurrentIterationNumber) / this->m_MaximumNumberOfIterations;
+    double changeFraction = 1.0;
+    if (numberOfPixelsChangedInFirstIteration > 0)
+    {
+      changeFraction = 1.0 - static_cast<double>(this->m_NumberOfPixelsChangedInLastIteration) /
+                               numberOfPixelsChangedInFirstIteration;
+    }
+    progress = std::max(progress, static_cast<float>(std::min(1.0, std::max(iterationFraction, changeFraction))));
+    this->UpdateProgress(progress);
+
     this->InvokeEvent(IterationEvent());
 
     if (this->m_NumberOfPixelsChangedInLastIteration == 0)
@@ -107,6 +126,8 @@ VotingBinaryHoleFillFloodingImageFilter<TInputImage, TOutputImage>::IterateFront
       break;
     }
   }
+
+  this->UpdateProgress(1.0f);
 }
 
 
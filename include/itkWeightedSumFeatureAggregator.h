@@ -71,6 +71,10 @@ public:
   using OutputImageType = typename Superclass::OutputImageType;
   using OutputImageSpatialObjectType = typename Superclass::OutputImageSpatialObjectType;
 
+  /** Print the parameters that determine the feature. */
+  void
+  PrintParameters(std::ostream & os) const override;
+
 protected:
   WeightedSumFeatureAggregator();
   ~WeightedSumFeatureAggregator() override;
@@ -51,6 +51,21 @@ WeightedSumFeatureAggregator<NDimension>::PrintSelf(std::ostream & os, Indent in
 }
 
 
+/**
+ * PrintParameters
+ */
+template <unsigned int NDimension>
+void
+WeightedSumFeatureAggregator<NDimension>::PrintParameters(std::ostream & os) const
+{
+  Superclass::PrintParameters(os);
+  for (const double weight : this->m_Weights)
+  {
+    os << "Weight " << weight << std::endl;
+  }
+}
+
+
 template <unsigned int NDimension>
 void
 WeightedSumFeatureAggregator<NDimension>::AddWeight(double weight)
@@ -21,6 +21,7 @@ itk_module(LesionSizingToolkit
     ITKRegionGrowing
     ITKLabelVoting
     ITKMathematicalMorphology
+    ITKMesh
     ${LesionSizingToolkit_VTK_GLUE_SUPPORT}
     ITKIOSpatialObjects
     ITKCommon
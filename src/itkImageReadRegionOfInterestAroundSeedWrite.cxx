@@ -101,9 +101,15 @@ main(int argc, char ** argv)
   writer->SetInput(filter->GetOutput());
   writer->UseCompressionOn();
 
+  // Only read the image information here. With an ImageIO that supports
+  // streamed reading, such as the MetaImageIO for uncompressed data, only
+  // the rows of the region of interest are read from the file afterwards.
   try
   {
-    reader->Update();
+    reader->UpdateOutputInformation();
+    itk::ImageIOBase::Pointer imageIO = reader->GetImageIO();
+    imageIO->SetUseStreamedReading(true);
+    reader->SetImageIO(imageIO);
   }
   catch (itk::ExceptionObject & err)
   {
@@ -139,7 +145,7 @@ main(int argc, char ** argv)
 
   desiredRegion.PadByRadius(2);
 
-  desiredRegion.Crop(inputImage->GetBufferedRegion());
+  desiredRegion.Crop(inputImage->GetLargestPossibleRegion());
 
   filter->SetRegionOfInterest(desiredRegion);
   std::cout << "Desired region: " << desiredRegion << std::endl;
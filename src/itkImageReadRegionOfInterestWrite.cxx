@@ -93,8 +93,16 @@ main(int argc, char ** argv)
   writer->SetInput(filter->GetOutput());
   writer->UseCompressionOn();
 
+  // With an ImageIO that supports streamed reading, such as the MetaImageIO
+  // for uncompressed data, only the rows of the region of interest are read
+  // from the file.
   try
   {
+    reader->UpdateOutputInformation();
+    itk::ImageIOBase::Pointer imageIO = reader->GetImageIO();
+    imageIO->SetUseStreamedReading(true);
+    reader->SetImageIO(imageIO);
+
     writer->Update();
   }
   catch (itk::ExceptionObject & err)
@@ -26,8 +26,8 @@
 #include "itkImageFileWriter.h"
 #include "itkResampleImageFilter.h"
 #include "itkIdentityTransform.h"
+#include "itkSeparableBSplineResampleImageFilter.h"
 
-#include "itkBSplineInterpolateImageFunction.h"
 #include "itkWindowedSincInterpolateImageFunction.h"
 
 #include <string>
@@ -85,14 +85,11 @@ main(int argc, char * argv[])
   resampler->SetTransform(transform);
 
 
-  using BSplineInterpolatorType = itk::BSplineInterpolateImageFunction<ImageType, double>;
+  // The BSpline case is handled by a dedicated resampler that interpolates
+  // one axis at a time.
+  using BSplineResampleFilterType = itk::SeparableBSplineResampleImageFilter<ImageType, ImageType>;
 
-  BSplineInterpolatorType::Pointer bsplineInterpolator = BSplineInterpolatorType::New();
-
-#ifdef ITK_IMAGE_BEHAVES_AS_ORIENTED_IMAGE
-  bsplineInterpolator->UseImageDirectionOn();
-#endif
-  bsplineInterpolator->SetSplineOrder(3);
+  BSplineResampleFilterType::Pointer bsplineResampler = BSplineResampleFilterType::New();
 
 
   using WindowedSincInterpolatorType = itk::WindowedSincInterpolateImageFunction<ImageType, 3>;
@@ -104,11 +101,10 @@ main(int argc, char * argv[])
   LinearInterpolatorType::Pointer linearInterpolator = LinearInterpolatorType::New();
 
 
-  switch (std::stoi(argv[4]))
+  const int interpolatorType = std::stoi(argv[4]);
+
+  switch (interpolatorType)
   {
-    case 0:
-      resampler->SetInterpolator(bsplineInterpolator);
-      break;
     case 1:
       resampler->SetInterpolator(windowedSincInterpolator);
       break;
@@ -118,7 +114,8 @@ main(int argc, char * argv[])
   }
 
 
-  resampler->SetDefaultPixelValue(-1024); // Hounsfield Units for Air
+  resampler->SetDefaultPixelValue(-1024);        // Hounsfield Units for Air
+  bsplineResampler->SetDefaultPixelValue(-1024); // Hounsfield Units for Air
 
   const ImageType::SpacingType & inputSpacing = inputImage->GetSpacing();
 
@@ -137,6 +134,7 @@ main(int argc, char * argv[])
   outputSpacing[2] = finalSpacing;
 
   resampler->SetOutputSpacing(outputSpacing);
+  bsplineResampler->SetOutputSpacing(outputSpacing);
 
 
   resampler->SetOutputOrigin(inputImage->GetOrigin());
@@ -146,26 +144,42 @@ main(int argc, char * argv[])
 
   using SizeValueType = ImageType::SizeType::SizeValueType;
 
-  const double dx = inputSize[0] * inputSpacing[0] / outputSpacing[0];
-  const double dy = inputSize[1] * inputSpacing[1] / outputSpacing[1];
-  const double dz = inputSize[2] * inputSpacing[2] / outputSpacing[2];
-
+  // Axes along which the spacing is unchanged keep their size, and are
+  // copied by the resampler instead of being interpolated.
   ImageType::SizeType finalSize;
 
-  finalSize[0] = static_cast<SizeValueType>(dx);
-  finalSize[1] = static_cast<SizeValueType>(dy);
-  finalSize[2] = static_cast<SizeValueType>(dz);
+  for (unsigned int i = 0; i < Dimension; i++)
+  {
+    if (itk::Math::ExactlyEquals(outputSpacing[i], inputSpacing[i]))
+    {
+      finalSize[i] = inputSize[i];
+    }
+    else
+    {
+      const double dx = inputSize[i] * inputSpacing[i] / outputSpacing[i];
+      finalSize[i] = static_cast<SizeValueType>(dx);
+    }
+  }
 
   resampler->SetSize(finalSize);
+  bsplineResampler->SetSize(finalSize);
 
   resampler->SetInput(inputImage);
+  bsplineResampler->SetInput(inputImage);
 
   using WriterType = itk::ImageFileWriter<ImageType>;
 
   WriterType::Pointer writer = WriterType::New();
 
   writer->SetFileName(argv[2]);
-  writer->SetInput(resampler->GetOutput());
+  if (interpolatorType == 0)
+  {
+    writer->SetInput(bsplineResampler->GetOutput());
+  }
+  else
+  {
+    writer->SetInput(resampler->GetOutput());
+  }
   writer->UseCompressionOn();
 
   try
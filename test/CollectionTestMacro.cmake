@@ -492,6 +492,16 @@ add_test(LSMT8e_${DATASET_OBJECT_ID}
   -ResampleThickSliceData     # Supersample
   )
 
+add_test(LSMT8f_${DATASET_OBJECT_ID}
+  ${CXX_TEST_PATH}/itkLesionSegmentationMethodTest8b
+  ${SEEDS_FILE}
+  ${DATASET_ROI}
+  ${TEMP}/LSMT8f_Test${DATASET_OBJECT_ID}.mha
+  -500  # Threshold used for part-solid lesions
+  -ResampleThickSliceData     # Supersample
+  -SegmentOnNativeGrid        # Segment before supersampling
+  )
+
 add_test(LSMT8dVED_${DATASET_OBJECT_ID}
   ${CXX_TEST_PATH}/itkLesionSegmentationMethodTest8b
   ${SEEDS_FILE}
@@ -548,6 +558,7 @@ VOLUME_ESTIMATION_B( ${DATASET_ID} ${OBJECT_ID} 8b ${EXPECTED_VOLUME} )
 VOLUME_ESTIMATION_B( ${DATASET_ID} ${OBJECT_ID} 8c ${EXPECTED_VOLUME} )
 VOLUME_ESTIMATION_B( ${DATASET_ID} ${OBJECT_ID} 8d ${EXPECTED_VOLUME} )
 VOLUME_ESTIMATION_B( ${DATASET_ID} ${OBJECT_ID} 8e ${EXPECTED_VOLUME} )
+VOLUME_ESTIMATION_B( ${DATASET_ID} ${OBJECT_ID} 8f ${EXPECTED_VOLUME} )
 VOLUME_ESTIMATION_B( ${DATASET_ID} ${OBJECT_ID} 8dVED ${EXPECTED_VOLUME} )
 VOLUME_ESTIMATION_B( ${DATASET_ID} ${OBJECT_ID} 8eVED ${EXPECTED_VOLUME} )
 
@@ -0,0 +1,194 @@
+/*=========================================================================
+
+  Program:   Lesion Sizing Toolkit
+  Module:    itkCachedFeatureGeneratorTest1.cxx
+
+  Copyright (c) Kitware Inc.
+  All rights reserved.
+  See Copyright.txt or https://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+
+#include "itkCachedFeatureGenerator.h"
+#include "itkSigmoidFeatureGenerator.h"
+#include "itkImage.h"
+#include "itkImageSpatialObject.h"
+#include "itkImageRegionConstIterator.h"
+#include "itkImageRegionIteratorWithIndex.h"
+#include "itkMath.h"
+#include "itkTestingMacros.h"
+#include "itksys/SystemTools.hxx"
+
+#include <cmath>
+
+
+int
+itkCachedFeatureGeneratorTest1(int argc, char * argv[])
+{
+  if (argc < 2)
+  {
+    std::cerr << "Missing parameters." << std::endl;
+    std::cerr << "Usage: " << argv[0];
+    std::cerr << " cacheDirectory" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  constexpr unsigned int Dimension = 3;
+
+  using CachedFeatureGeneratorType = itk::CachedFeatureGenerator<Dimension>;
+  using SigmoidFeatureGeneratorType = itk::SigmoidFeatureGenerator<Dimension>;
+
+  using InputImageType = CachedFeatureGeneratorType::InputImageType;
+  using OutputImageType = CachedFeatureGeneratorType::OutputImageType;
+  using InputImageSpatialObjectType = CachedFeatureGeneratorType::InputImageSpatialObjectType;
+  using OutputImageSpatialObjectType = CachedFeatureGeneratorType::OutputImageSpatialObjectType;
+
+  // Start from an empty cache.
+  const std::string cacheDirectory = argv[1];
+  itksys::SystemTools::RemoveADirectory(cacheDirectory);
+
+  //
+  // Oscillating intensities in a region that does not start at the origin
+  // of the index space.
+  //
+  InputImageType::IndexType start;
+  start[0] = 10;
+  start[1] = -4;
+  start[2] = 3;
+
+  InputImageType::SizeType size;
+  size[0] = 40;
+  size[1] = 32;
+  size[2] = 24;
+
+  InputImageType::SpacingType spacing;
+  spacing[0] = 0.7;
+  spacing[1] = 0.7;
+  spacing[2] = 1.25;
+
+  InputImageType::Pointer inputImage = InputImageType::New();
+  inputImage->SetRegions(InputImageType::RegionType(start, size));
+  inputImage->SetSpacing(spacing);
+  inputImage->Allocate();
+
+  itk::ImageRegionIteratorWithIndex<InputImageType> iit(inputImage, inputImage->GetBufferedRegion());
+  while (!iit.IsAtEnd())
+  {
+    const InputImageType::IndexType & index = iit.GetIndex();
+    iit.Set(static_cast<InputImageType::PixelType>(400.0 * std::sin(0.3 * index[0]) * std::cos(0.2 * index[1]) +
+                                                   100.0 * index[2]));
+    ++iit;
+  }
+
+  InputImageSpatialObjectType::Pointer inputObject = InputImageSpatialObjectType::New();
+  inputObject->SetImage(inputImage);
+
+  auto getFeatureImage = [](const itk::SpatialObject<Dimension> * feature) {
+    return dynamic_cast<const OutputImageSpatialObjectType *>(feature)->GetImage();
+  };
+
+  auto sameImages = [](const OutputImageType * image1, const OutputImageType * image2) {
+    if (image1->GetBufferedRegion() != image2->GetBufferedRegion() || image1->GetOrigin() != image2->GetOrigin() ||
+        image1->GetSpacing() != image2->GetSpacing())
+    {
+      return false;
+    }
+    itk::ImageRegionConstIterator<OutputImageType> it1(image1, image1->GetBufferedRegion());
+    itk::ImageRegionConstIterator<OutputImageType> it2(image2, image2->GetBufferedRegion());
+    while (!it1.IsAtEnd())
+    {
+      if (itk::Math::NotExactlyEquals(it1.Get(), it2.Get()))
+      {
+        return false;
+      }
+      ++it1;
+      ++it2;
+    }
+    return true;
+  };
+
+  //
+  // Reference feature, computed without cache.
+  //
+  SigmoidFeatureGeneratorType::Pointer referenceGenerator = SigmoidFeatureGeneratorType::New();
+  referenceGenerator->SetInput(inputObject);
+  referenceGenerator->SetAlpha(100.0);
+  referenceGenerator->SetBeta(-50.0);
+
+  ITK_TRY_EXPECT_NO_EXCEPTION(referenceGenerator->Update());
+
+  const OutputImageType * referenceImage = getFeatureImage(referenceGenerator->GetFeature());
+
+  //
+  // Without cache directory, the feature is passed through.
+  //
+  CachedFeatureGeneratorType::Pointer cachedGenerator = CachedFeatureGeneratorType::New();
+
+  ITK_EXERCISE_BASIC_OBJECT_METHODS(cachedGenerator, CachedFeatureGenerator, FeatureGenerator);
+
+  ITK_TRY_EXPECT_EXCEPTION(cachedGenerator->Update());
+
+  SigmoidFeatureGeneratorType::Pointer sigmoidGenerator = SigmoidFeatureGeneratorType::New();
+  sigmoidGenerator->SetAlpha(100.0);
+  sigmoidGenerator->SetBeta(-50.0);
+
+  cachedGenerator->SetFeatureGenerator(sigmoidGenerator);
+  ITK_TEST_SET_GET_VALUE(sigmoidGenerator.GetPointer(), cachedGenerator->GetFeatureGenerator());
+
+  cachedGenerator->SetInput(inputObject);
+
+  ITK_TRY_EXPECT_NO_EXCEPTION(cachedGenerator->Update());
+  ITK_TEST_EXPECT_TRUE(!cachedGenerator->GetCacheHit());
+  ITK_TEST_EXPECT_TRUE(sameImages(getFeatureImage(cachedGenerator->GetFeature()), referenceImage));
+
+  //
+  // The first execution with the cache computes the feature, the next ones
+  // read it, even from another generator with the same parameters.
+  //
+  cachedGenerator->SetCacheDirectory(cacheDirectory);
+  ITK_TEST_SET_GET_VALUE(cacheDirectory, std::string(cachedGenerator->GetCacheDirectory()));
+
+  ITK_TRY_EXPECT_NO_EXCEPTION(cachedGenerator->Update());
+  ITK_TEST_EXPECT_TRUE(!cachedGenerator->GetCacheHit());
+  ITK_TEST_EXPECT_TRUE(sameImages(getFeatureImage(cachedGenerator->GetFeature()), referenceImage));
+
+  SigmoidFeatureGeneratorType::Pointer otherSigmoidGenerator = SigmoidFeatureGeneratorType::New();
+  otherSigmoidGenerator->SetAlpha(100.0);
+  otherSigmoidGenerator->SetBeta(-50.0);
+
+  CachedFeatureGeneratorType::Pointer otherCachedGenerator = CachedFeatureGeneratorType::New();
+  otherCachedGenerator->SetFeatureGenerator(otherSigmoidGenerator);
+  otherCachedGenerator->SetCacheDirectory(cacheDirectory);
+  otherCachedGenerator->SetInput(inputObject);
+
+  ITK_TRY_EXPECT_NO_EXCEPTION(otherCachedGenerator->Update());
+  ITK_TEST_EXPECT_TRUE(otherCachedGenerator->GetCacheHit());
+  ITK_TEST_EXPECT_TRUE(sameImages(getFeatureImage(otherCachedGenerator->GetFeature()), referenceImage));
+
+  //
+  // Other parameters or another input are other features.
+  //
+  otherSigmoidGenerator->SetBeta(-60.0);
+
+  ITK_TRY_EXPECT_NO_EXCEPTION(otherCachedGenerator->Update());
+  ITK_TEST_EXPECT_TRUE(!otherCachedGenerator->GetCacheHit());
+
+  otherSigmoidGenerator->SetBeta(-50.0);
+
+  ITK_TRY_EXPECT_NO_EXCEPTION(otherCachedGenerator->Update());
+  ITK_TEST_EXPECT_TRUE(otherCachedGenerator->GetCacheHit());
+
+  inputImage->GetPixel(start) += 1;
+  inputImage->Modified();
+  inputObject->Modified();
+
+  ITK_TRY_EXPECT_NO_EXCEPTION(otherCachedGenerator->Update());
+  ITK_TEST_EXPECT_TRUE(!otherCachedGenerator->GetCacheHit());
+
+  std::cout << "Test finished." << std::endl;
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,193 @@
+/*=========================================================================
+
+  Program:   Lesion Sizing Toolkit
+  Module:    itkFastIterativeEikonalImageFilterTest1.cxx
+
+  Copyright (c) Kitware Inc.
+  All rights reserved.
+  See Copyright.txt or https://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+
+#include "itkFastIterativeEikonalImageFilter.h"
+#include "itkFastMarchingImageFilter.h"
+#include "itkImage.h"
+#include "itkImageRegionConstIterator.h"
+#include "itkImageRegionConstIteratorWithIndex.h"
+#include "itkImageRegionIteratorWithIndex.h"
+#include "itkTestingMacros.h"
+
+#include <algorithm>
+#include <cmath>
+
+
+int
+itkFastIterativeEikonalImageFilterTest1(int itkNotUsed(argc), char * itkNotUsed(argv)[])
+{
+  constexpr unsigned int Dimension = 3;
+
+  using PixelType = float;
+  using ImageType = itk::Image<PixelType, Dimension>;
+
+  //
+  // Smoothly varying speed on an anisotropic grid.
+  //
+  ImageType::SizeType size;
+  size.Fill(64);
+
+  ImageType::SpacingType spacing;
+  spacing[0] = 0.7;
+  spacing[1] = 0.7;
+  spacing[2] = 1.25;
+
+  ImageType::Pointer speedImage = ImageType::New();
+  speedImage->SetRegions(ImageType::RegionType(size));
+  speedImage->SetSpacing(spacing);
+  speedImage->Allocate();
+
+  itk::ImageRegionIteratorWithIndex<ImageType> sit(speedImage, speedImage->GetBufferedRegion());
+  while (!sit.IsAtEnd())
+  {
+    const ImageType::IndexType & index = sit.GetIndex();
+    sit.Set(1.0 + 0.5 * std::sin(0.2 * index[0]) * std::cos(0.15 * index[1]) + 0.3 * (index[2] % 7) / 7.0);
+    ++sit;
+  }
+
+  const double stoppingValue = 15.0;
+  const double distanceFromSeeds = 0.5;
+
+  //
+  // Two seeds, so that the fronts meet.
+  //
+  ImageType::IndexType seedIndex[2];
+  seedIndex[0][0] = 32;
+  seedIndex[0][1] = 30;
+  seedIndex[0][2] = 28;
+  seedIndex[1][0] = 20;
+  seedIndex[1][1] = 40;
+  seedIndex[1][2] = 34;
+
+  using IterativeFilterType = itk::FastIterativeEikonalImageFilter<ImageType, ImageType>;
+  using HeapFilterType = itk::FastMarchingImageFilter<ImageType, ImageType>;
+
+  IterativeFilterType::NodeContainer::Pointer iterativeSeeds = IterativeFilterType::NodeContainer::New();
+  HeapFilterType::NodeContainer::Pointer      heapSeeds = HeapFilterType::NodeContainer::New();
+  for (unsigned int i = 0; i < 2; ++i)
+  {
+    IterativeFilterType::NodeType iterativeSeed;
+    iterativeSeed.SetIndex(seedIndex[i]);
+    iterativeSeed.SetValue(-distanceFromSeeds);
+    iterativeSeeds->InsertElement(i, iterativeSeed);
+
+    HeapFilterType::NodeType heapSeed;
+    heapSeed.SetIndex(seedIndex[i]);
+    heapSeed.SetValue(-distanceFromSeeds);
+    heapSeeds->InsertElement(i, heapSeed);
+  }
+
+  IterativeFilterType::Pointer iterativeFilter = IterativeFilterType::New();
+
+  ITK_EXERCISE_BASIC_OBJECT_METHODS(iterativeFilter, FastIterativeEikonalImageFilter, ImageToImageFilter);
+
+  iterativeFilter->SetInput(speedImage);
+  iterativeFilter->SetTrialPoints(iterativeSeeds);
+
+  iterativeFilter->SetStoppingValue(stoppingValue);
+  ITK_TEST_SET_GET_VALUE(stoppingValue, iterativeFilter->GetStoppingValue());
+
+  const double normalizationFactor = 1.0;
+  iterativeFilter->SetNormalizationFactor(normalizationFactor);
+  ITK_TEST_SET_GET_VALUE(normalizationFactor, iterativeFilter->GetNormalizationFactor());
+
+  const double convergenceTolerance = 1e-6;
+  iterativeFilter->SetConvergenceTolerance(convergenceTolerance);
+  ITK_TEST_SET_GET_VALUE(convergenceTolerance, iterativeFilter->GetConvergenceTolerance());
+
+  ITK_TRY_EXPECT_NO_EXCEPTION(iterativeFilter->Update());
+
+  HeapFilterType::Pointer heapFilter = HeapFilterType::New();
+  heapFilter->SetInput(speedImage);
+  heapFilter->SetTrialPoints(heapSeeds);
+  heapFilter->SetStoppingValue(stoppingValue);
+
+  ITK_TRY_EXPECT_NO_EXCEPTION(heapFilter->Update());
+
+  //
+  // Both filters solve the same discrete equation, the arrival times must
+  // agree up to the convergence tolerance and rounding errors.
+  //
+  itk::ImageRegionConstIterator<ImageType> iit(iterativeFilter->GetOutput(),
+                                               iterativeFilter->GetOutput()->GetBufferedRegion());
+  itk::ImageRegionConstIterator<ImageType> hit(heapFilter->GetOutput(), heapFilter->GetOutput()->GetBufferedRegion());
+
+  double             maximumDifference = 0.0;
+  itk::SizeValueType numberOfReachedPixels = 0;
+  itk::SizeValueType numberOfDifferentPixels = 0;
+  while (!iit.IsAtEnd())
+  {
+    const double iterativeValue = iit.Get();
+    const double heapValue = hit.Get();
+    if (iterativeValue < stoppingValue && heapValue < stoppingValue)
+    {
+      maximumDifference = std::max(maximumDifference, itk::Math::abs(iterativeValue - heapValue));
+      ++numberOfReachedPixels;
+    }
+    numberOfDifferentPixels += ((iterativeValue < 5.0) != (heapValue < 5.0));
+    ++iit;
+    ++hit;
+  }
+
+  std::cout << "Reached pixels: " << numberOfReachedPixels << std::endl;
+  std::cout << "Iterations: " << iterativeFilter->GetNumberOfIterations() << std::endl;
+  std::cout << "Maximum difference with the FastMarchingImageFilter = " << maximumDifference << std::endl;
+  std::cout << "Pixels on a different side of the 5.0 level = " << numberOfDifferentPixels << std::endl;
+
+  const double tolerance = 1e-3;
+
+  if (maximumDifference > tolerance)
+  {
+    std::cerr << "Test failed!" << std::endl;
+    std::cerr << "The arrival times differ from the ones of the FastMarchingImageFilter by " << maximumDifference
+              << " which is more than " << tolerance << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  if (numberOfDifferentPixels > numberOfReachedPixels / 1000)
+  {
+    std::cerr << "Test failed!" << std::endl;
+    std::cerr << numberOfDifferentPixels << " pixels are on a different side of the level set" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  //
+  // The result must not depend on the number of threads.
+  //
+  ImageType::Pointer multiThreadedOutput = iterativeFilter->GetOutput();
+  multiThreadedOutput->DisconnectPipeline();
+
+  iterativeFilter->SetNumberOfWorkUnits(1);
+  ITK_TRY_EXPECT_NO_EXCEPTION(iterativeFilter->Update());
+
+  const ImageType * singleThreadedOutput = iterativeFilter->GetOutput();
+
+  itk::ImageRegionConstIteratorWithIndex<ImageType> mit(multiThreadedOutput, multiThreadedOutput->GetBufferedRegion());
+  itk::ImageRegionConstIterator<ImageType>          oit(singleThreadedOutput, singleThreadedOutput->GetBufferedRegion());
+  while (!mit.IsAtEnd())
+  {
+    if (itk::Math::NotExactlyEquals(mit.Get(), oit.Get()))
+    {
+      std::cerr << "Test failed!" << std::endl;
+      std::cerr << "The arrival times depend on the number of threads at " << mit.GetIndex() << std::endl;
+      return EXIT_FAILURE;
+    }
+    ++mit;
+    ++oit;
+  }
+
+  std::cout << "Test finished." << std::endl;
+  return EXIT_SUCCESS;
+}
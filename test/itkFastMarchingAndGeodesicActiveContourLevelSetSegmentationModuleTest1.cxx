@@ -0,0 +1,255 @@
+/*=========================================================================
+
+  Program:   Lesion Sizing Toolkit
+  Module:    itkFastMarchingAndGeodesicActiveContourLevelSetSegmentationModuleTest1.cxx
+
+  Copyright (c) Kitware Inc.
+  All rights reserved.
+  See Copyright.txt or https://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+
+#include "itkFastMarchingAndGeodesicActiveContourLevelSetSegmentationModule.h"
+#include "itkImage.h"
+#include "itkSpatialObject.h"
+#include "itkImageSpatialObject.h"
+#include "itkImageFileReader.h"
+#include "itkImageFileWriter.h"
+#include "itkImageRegionConstIterator.h"
+#include "itkImageRegionIterator.h"
+#include "itkLandmarksReader.h"
+#include "itkTimeProbe.h"
+#include "itkTestingMacros.h"
+
+#include <algorithm>
+
+
+int
+itkFastMarchingAndGeodesicActiveContourLevelSetSegmentationModuleTest1(int argc, char * argv[])
+{
+  if (argc < 4)
+  {
+    std::cerr << "Missing parameters." << std::endl;
+    std::cerr << "Usage: " << argv[0];
+    std::cerr << " landmarksFile featureImage outputImage";
+    std::cerr << " [coarseResolutionShrinkFactor] [numberOfRefinementIterations] [priorSegmentation]" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  constexpr unsigned int Dimension = 3;
+  using SegmentationModuleType = itk::FastMarchingAndGeodesicActiveContourLevelSetSegmentationModule<Dimension>;
+
+  using FeatureImageType = SegmentationModuleType::FeatureImageType;
+  using OutputImageType = SegmentationModuleType::OutputImageType;
+
+  using FeatureReaderType = itk::ImageFileReader<FeatureImageType>;
+  using OutputReaderType = itk::ImageFileReader<OutputImageType>;
+  using OutputWriterType = itk::ImageFileWriter<OutputImageType>;
+
+  using LandmarksReaderType = itk::LandmarksReader<Dimension>;
+
+  LandmarksReaderType::Pointer landmarksReader = LandmarksReaderType::New();
+
+  landmarksReader->SetFileName(argv[1]);
+  ITK_TRY_EXPECT_NO_EXCEPTION(landmarksReader->Update());
+
+
+  FeatureReaderType::Pointer featureReader = FeatureReaderType::New();
+  featureReader->SetFileName(argv[2]);
+
+  ITK_TRY_EXPECT_NO_EXCEPTION(featureReader->Update());
+
+
+  SegmentationModuleType::Pointer segmentationModule = SegmentationModuleType::New();
+
+  ITK_EXERCISE_BASIC_OBJECT_METHODS(segmentationModule,
+                                    FastMarchingAndGeodesicActiveContourLevelSetSegmentationModule,
+                                    SinglePhaseLevelSetSegmentationModule);
+
+  using FeatureSpatialObjectType = SegmentationModuleType::FeatureSpatialObjectType;
+  using OutputSpatialObjectType = SegmentationModuleType::OutputSpatialObjectType;
+
+  FeatureSpatialObjectType::Pointer featureObject = FeatureSpatialObjectType::New();
+
+  FeatureImageType::Pointer featureImage = featureReader->GetOutput();
+  featureImage->DisconnectPipeline();
+
+  featureObject->SetImage(featureImage);
+
+  // Same parameters as the LesionSegmentationImageFilter8.
+  auto configure = [&](SegmentationModuleType * module) {
+    module->SetFeature(featureObject);
+    module->SetInput(landmarksReader->GetOutput());
+    module->SetStoppingValue(5.0);
+    module->SetDistanceFromSeeds(0.5);
+    module->SetCurvatureScaling(1.0);
+    module->SetAdvectionScaling(0.0);
+    module->SetPropagationScaling(500.0);
+    module->SetMaximumRMSError(0.0002);
+    module->SetMaximumNumberOfIterations(300);
+  };
+
+  configure(segmentationModule);
+
+  unsigned int coarseResolutionShrinkFactor = 1;
+  if (argc > 4)
+  {
+    coarseResolutionShrinkFactor = std::stoi(argv[4]);
+  }
+  segmentationModule->SetCoarseResolutionShrinkFactor(coarseResolutionShrinkFactor);
+  ITK_TEST_SET_GET_VALUE(coarseResolutionShrinkFactor, segmentationModule->GetCoarseResolutionShrinkFactor());
+
+  unsigned int numberOfRefinementIterations = 30;
+  if (argc > 5)
+  {
+    numberOfRefinementIterations = std::stoi(argv[5]);
+  }
+  segmentationModule->SetNumberOfRefinementIterations(numberOfRefinementIterations);
+  ITK_TEST_SET_GET_VALUE(numberOfRefinementIterations, segmentationModule->GetNumberOfRefinementIterations());
+
+  // Warm start from a previous segmentation, positive inside.
+  OutputImageType::Pointer priorSegmentation;
+  if (argc > 6)
+  {
+    OutputReaderType::Pointer priorReader = OutputReaderType::New();
+    priorReader->SetFileName(argv[6]);
+
+    ITK_TRY_EXPECT_NO_EXCEPTION(priorReader->Update());
+
+    priorSegmentation = priorReader->GetOutput();
+    priorSegmentation->DisconnectPipeline();
+
+    using InitialLevelSetType = SegmentationModuleType::InputImageType;
+    InitialLevelSetType::Pointer initialLevelSet = InitialLevelSetType::New();
+    initialLevelSet->CopyInformation(priorSegmentation);
+    initialLevelSet->SetRegions(priorSegmentation->GetBufferedRegion());
+    initialLevelSet->Allocate();
+
+    itk::ImageRegionConstIterator<OutputImageType> pit(priorSegmentation, priorSegmentation->GetBufferedRegion());
+    itk::ImageRegionIterator<InitialLevelSetType>  lit(initialLevelSet, initialLevelSet->GetBufferedRegion());
+    while (!pit.IsAtEnd())
+    {
+      lit.Set(-pit.Get());
+      ++pit;
+      ++lit;
+    }
+
+    segmentationModule->SetInitialLevelSet(initialLevelSet);
+    ITK_TEST_SET_GET_VALUE(initialLevelSet.GetPointer(), segmentationModule->GetInitialLevelSet());
+  }
+
+
+  itk::TimeProbe probe;
+  probe.Start();
+
+  ITK_TRY_EXPECT_NO_EXCEPTION(segmentationModule->Update());
+
+  probe.Stop();
+  std::cout << "Segmentation time: " << probe.GetTotal() << " " << probe.GetUnit() << std::endl;
+
+
+  using SpatialObjectType = SegmentationModuleType::SpatialObjectType;
+  SpatialObjectType::ConstPointer segmentation = segmentationModule->GetOutput();
+
+  OutputSpatialObjectType::ConstPointer outputObject =
+    dynamic_cast<const OutputSpatialObjectType *>(segmentation.GetPointer());
+  OutputImageType::ConstPointer outputImage = outputObject->GetImage();
+
+  if (priorSegmentation)
+  {
+    //
+    // Started from the converged segmentation, the evolution must stay close
+    // to it.
+    //
+    itk::ImageRegionConstIterator<OutputImageType> it(outputImage, outputImage->GetBufferedRegion());
+    itk::ImageRegionConstIterator<OutputImageType> pit(priorSegmentation, priorSegmentation->GetBufferedRegion());
+
+    itk::SizeValueType numberOfInsidePixels = 0;
+    itk::SizeValueType numberOfDifferentPixels = 0;
+    while (!it.IsAtEnd())
+    {
+      const bool inside = it.Get() > 0.0;
+      const bool priorInside = pit.Get() > 0.0;
+      numberOfInsidePixels += priorInside;
+      numberOfDifferentPixels += (inside != priorInside);
+      ++it;
+      ++pit;
+    }
+
+    std::cout << "Pixels segmented differently from the prior segmentation: " << numberOfDifferentPixels
+              << " out of " << numberOfInsidePixels << std::endl;
+
+    if (numberOfInsidePixels == 0 || numberOfDifferentPixels > numberOfInsidePixels / 10)
+    {
+      std::cerr << "Test failed!" << std::endl;
+      std::cerr << "The warm started segmentation drifted away from the prior segmentation" << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+
+  if (coarseResolutionShrinkFactor > 1)
+  {
+    //
+    // The coarse to fine segmentation must cover the same region as the
+    // segmentation computed at full resolution only.
+    //
+    SegmentationModuleType::Pointer fullResolutionModule = SegmentationModuleType::New();
+    configure(fullResolutionModule);
+
+    probe.Reset();
+    probe.Start();
+
+    ITK_TRY_EXPECT_NO_EXCEPTION(fullResolutionModule->Update());
+
+    probe.Stop();
+    std::cout << "Full resolution segmentation time: " << probe.GetTotal() << " " << probe.GetUnit() << std::endl;
+
+    const OutputImageType * fullResolutionImage =
+      dynamic_cast<const OutputSpatialObjectType *>(fullResolutionModule->GetOutput())->GetImage();
+
+    itk::ImageRegionConstIterator<OutputImageType> it(outputImage, outputImage->GetBufferedRegion());
+    itk::ImageRegionConstIterator<OutputImageType> fit(fullResolutionImage,
+                                                       fullResolutionImage->GetBufferedRegion());
+
+    itk::SizeValueType numberOfInsidePixels = 0;
+    itk::SizeValueType numberOfDifferentPixels = 0;
+    while (!it.IsAtEnd())
+    {
+      const bool inside = it.Get() > 0.0;
+      const bool fullResolutionInside = fit.Get() > 0.0;
+      numberOfInsidePixels += fullResolutionInside;
+      numberOfDifferentPixels += (inside != fullResolutionInside);
+      ++it;
+      ++fit;
+    }
+
+    const double differentFraction =
+      static_cast<double>(numberOfDifferentPixels) / std::max<itk::SizeValueType>(numberOfInsidePixels, 1);
+
+    std::cout << "Pixels segmented differently at full resolution: " << numberOfDifferentPixels << " out of "
+              << numberOfInsidePixels << std::endl;
+
+    if (numberOfInsidePixels == 0 || differentFraction > 0.1)
+    {
+      std::cerr << "Test failed!" << std::endl;
+      std::cerr << "The coarse to fine segmentation differs from the full resolution one on "
+                << differentFraction * 100.0 << "% of the segmentation" << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+
+  OutputWriterType::Pointer writer = OutputWriterType::New();
+
+  writer->SetFileName(argv[3]);
+  writer->SetInput(outputImage);
+  writer->UseCompressionOn();
+
+  ITK_TRY_EXPECT_NO_EXCEPTION(writer->Update());
+
+  std::cout << "Test finished." << std::endl;
+  return EXIT_SUCCESS;
+}
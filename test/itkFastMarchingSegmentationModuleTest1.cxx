@@ -32,7 +32,8 @@ itkFastMarchingSegmentationModuleTest1(int argc, char * argv[])
     std::cerr << "Usage: " << argv[0];
     std::cerr << " landmarksFile featureImage outputImage ";
     std::cerr << " stoppingValue";
-    std::cerr << " distanceFromSeeds" << std::endl;
+    std::cerr << " distanceFromSeeds";
+    std::cerr << " [solver]" << std::endl;
     return EXIT_FAILURE;
   }
 
@@ -95,6 +96,14 @@ itkFastMarchingSegmentationModuleTest1(int argc, char * argv[])
   segmentationModule->SetDistanceFromSeeds(distanceFromSeeds);
   ITK_TEST_SET_GET_VALUE(distanceFromSeeds, segmentationModule->GetDistanceFromSeeds());
 
+  auto solver = SegmentationModuleType::HeapSolver;
+  if (argc > 6)
+  {
+    solver = static_cast<SegmentationModuleType::SolverType>(std::stoi(argv[6]));
+  }
+  segmentationModule->SetSolver(solver);
+  ITK_TEST_SET_GET_VALUE(solver, segmentationModule->GetSolver());
+
 
   ITK_TRY_EXPECT_NO_EXCEPTION(segmentationModule->Update());
 
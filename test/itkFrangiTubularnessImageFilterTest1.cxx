@@ -0,0 +1,92 @@
+/*=========================================================================
+
+  Program:   Lesion Sizing Toolkit
+  Module:    itkFrangiTubularnessImageFilterTest1.cxx
+
+  Copyright (c) Kitware Inc.
+  All rights reserved.
+  See Copyright.txt or https://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+
+#include "itkFrangiTubularnessImageFilter.h"
+#include "itkImage.h"
+#include "itkTestingMacros.h"
+
+
+int
+itkFrangiTubularnessImageFilterTest1(int itkNotUsed(argc), char * itkNotUsed(argv)[])
+{
+  constexpr unsigned int Dimension = 3;
+
+  using EigenValueArrayType = itk::FixedArray<double, Dimension>;
+  using EigenValueImageType = itk::Image<EigenValueArrayType, Dimension>;
+  using OutputImageType = itk::Image<float, Dimension>;
+
+  using TubularnessFilterType = itk::FrangiTubularnessImageFilter<EigenValueImageType, OutputImageType>;
+
+  //
+  // Two pixels: the eigenvalues of a bright tube over a dark background,
+  // and the ones of a dark tube over a bright background.
+  //
+  EigenValueImageType::SizeType size;
+  size.Fill(1);
+  size[0] = 2;
+
+  EigenValueImageType::Pointer eigenValues = EigenValueImageType::New();
+  eigenValues->SetRegions(size);
+  eigenValues->Allocate();
+
+  EigenValueImageType::IndexType brightTube = { { 0, 0, 0 } };
+  EigenValueImageType::IndexType darkTube = { { 1, 0, 0 } };
+
+  EigenValueArrayType values;
+  values[0] = -4.0;
+  values[1] = -4.0;
+  values[2] = 0.0;
+  eigenValues->SetPixel(brightTube, values);
+
+  values[0] = 0.0;
+  values[1] = 4.0;
+  values[2] = 4.0;
+  eigenValues->SetPixel(darkTube, values);
+
+  TubularnessFilterType::Pointer tubularness = TubularnessFilterType::New();
+
+  ITK_EXERCISE_BASIC_OBJECT_METHODS(tubularness, FrangiTubularnessImageFilter, UnaryFunctorImageFilter);
+
+  tubularness->SetInput(eigenValues);
+
+  // By default, the bright tubes are searched.
+  ITK_TRY_EXPECT_NO_EXCEPTION(tubularness->Update());
+
+  ITK_TEST_EXPECT_TRUE(tubularness->GetOutput()->GetPixel(brightTube) > 0.5f);
+  ITK_TEST_EXPECT_EQUAL(tubularness->GetOutput()->GetPixel(darkTube), 0.0f);
+
+  const float brightTubularness = tubularness->GetOutput()->GetPixel(brightTube);
+
+  // Over a bright background, the dark tubes are searched instead, with the
+  // same measure.
+  tubularness->SetBrightBackground(true);
+  tubularness->Modified();
+
+  ITK_TRY_EXPECT_NO_EXCEPTION(tubularness->Update());
+
+  ITK_TEST_EXPECT_EQUAL(tubularness->GetOutput()->GetPixel(brightTube), 0.0f);
+  ITK_TEST_EXPECT_EQUAL(tubularness->GetOutput()->GetPixel(darkTube), brightTubularness);
+
+  tubularness->SetBrightBackground(false);
+  tubularness->Modified();
+
+  ITK_TRY_EXPECT_NO_EXCEPTION(tubularness->Update());
+
+  ITK_TEST_EXPECT_EQUAL(tubularness->GetOutput()->GetPixel(brightTube), brightTubularness);
+  ITK_TEST_EXPECT_EQUAL(tubularness->GetOutput()->GetPixel(darkTube), 0.0f);
+
+  std::cout << "Test finished." << std::endl;
+  return EXIT_SUCCESS;
+}
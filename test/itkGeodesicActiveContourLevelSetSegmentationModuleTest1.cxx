@@ -19,8 +19,11 @@
 #include "itkImageSpatialObject.h"
 #include "itkImageFileReader.h"
 #include "itkImageFileWriter.h"
+#include "itkImageRegionConstIterator.h"
 #include "itkTestingMacros.h"
 
+#include <algorithm>
+
 
 int
 itkGeodesicActiveContourLevelSetSegmentationModuleTest1(int argc, char * argv[])
@@ -30,7 +33,8 @@ itkGeodesicActiveContourLevelSetSegmentationModuleTest1(int argc, char * argv[])
     std::cerr << "Missing parameters." << std::endl;
     std::cerr << "Usage: " << argv[0];
     std::cerr << " inputImage featureImage outputImage";
-    std::cerr << " [advectionScaling] [curvatureScaling] [propagationScaling] [maxIterations]" << std::endl;
+    std::cerr << " [advectionScaling] [curvatureScaling] [propagationScaling] [maxIterations] [useParallelSolver]";
+    std::cerr << " [maximumFrontVolume] [maximumElapsedTime]" << std::endl;
     return EXIT_FAILURE;
   }
 
@@ -110,9 +114,65 @@ itkGeodesicActiveContourLevelSetSegmentationModuleTest1(int argc, char * argv[])
   segmentationModule->SetMaximumNumberOfIterations(maximumNumberOfIterations);
   ITK_TEST_SET_GET_VALUE(maximumNumberOfIterations, segmentationModule->GetMaximumNumberOfIterations());
 
+  bool useParallelSolver = false;
+  if (argc > 8)
+  {
+    useParallelSolver = std::stoi(argv[8]);
+  }
+  ITK_TEST_SET_GET_BOOLEAN(segmentationModule, UseParallelSolver, useParallelSolver);
+
+  double maximumFrontVolume = 0.0;
+  if (argc > 9)
+  {
+    maximumFrontVolume = std::stod(argv[9]);
+  }
+  segmentationModule->SetMaximumFrontVolume(maximumFrontVolume);
+  ITK_TEST_SET_GET_VALUE(maximumFrontVolume, segmentationModule->GetMaximumFrontVolume());
+
+  double maximumElapsedTime = 0.0;
+  if (argc > 10)
+  {
+    maximumElapsedTime = std::stod(argv[10]);
+  }
+  segmentationModule->SetMaximumElapsedTime(maximumElapsedTime);
+  ITK_TEST_SET_GET_VALUE(maximumElapsedTime, segmentationModule->GetMaximumElapsedTime());
+
+  // Record the statistics of every iteration.
+  itk::SizeValueType numberOfIterationEvents = 0;
+  itk::SizeValueType lastIteration = 0;
+  bool               consistentIterations = true;
+  segmentationModule->AddObserver(itk::IterationEvent(), [&](const itk::EventObject &) {
+    ++numberOfIterationEvents;
+    consistentIterations = consistentIterations && segmentationModule->GetElapsedIterations() > lastIteration &&
+                           segmentationModule->GetActiveLayerSize() > 0 && segmentationModule->GetElapsedTime() >= 0.0;
+    lastIteration = segmentationModule->GetElapsedIterations();
+    std::cout << "Iteration " << lastIteration << ": RMS change = " << segmentationModule->GetRMSChange()
+              << ", active layer = " << segmentationModule->GetActiveLayerSize()
+              << ", elapsed time = " << segmentationModule->GetElapsedTime() << std::endl;
+  });
+
 
   ITK_TRY_EXPECT_NO_EXCEPTION(segmentationModule->Update());
 
+  std::cout << "Stop condition: " << segmentationModule->GetStopConditionDescription() << std::endl;
+
+  ITK_TEST_EXPECT_TRUE(numberOfIterationEvents > 0);
+  ITK_TEST_EXPECT_TRUE(consistentIterations);
+  ITK_TEST_EXPECT_EQUAL(segmentationModule->GetElapsedIterations(), lastIteration);
+
+  //
+  // The limits given to the test are small enough to be hit, the elapsed
+  // time being checked first.
+  //
+  if (maximumElapsedTime > 0.0)
+  {
+    ITK_TEST_EXPECT_EQUAL(segmentationModule->GetStopCondition(), SegmentationModuleType::MaximumElapsedTimeStop);
+  }
+  else if (maximumFrontVolume > 0.0)
+  {
+    ITK_TEST_EXPECT_EQUAL(segmentationModule->GetStopCondition(), SegmentationModuleType::MaximumFrontVolumeStop);
+  }
+
   using SpatialObjectType = SegmentationModuleType::SpatialObjectType;
   SpatialObjectType::ConstPointer segmentation = segmentationModule->GetOutput();
 
@@ -121,6 +181,57 @@ itkGeodesicActiveContourLevelSetSegmentationModuleTest1(int argc, char * argv[])
 
   OutputImageType::ConstPointer outputImage = outputObject->GetImage();
 
+  if (useParallelSolver)
+  {
+    //
+    // The parallel solver must segment the same region as the serial solver,
+    // except for the voxels on which the two evolutions differ within the
+    // RMS tolerance.
+    //
+    SegmentationModuleType::Pointer serialModule = SegmentationModuleType::New();
+    serialModule->SetInput(inputObject);
+    serialModule->SetFeature(featureObject);
+    serialModule->SetAdvectionScaling(advectionScaling);
+    serialModule->SetCurvatureScaling(curvatureScaling);
+    serialModule->SetPropagationScaling(propagationScaling);
+    serialModule->SetMaximumNumberOfIterations(maximumNumberOfIterations);
+    serialModule->UseParallelSolverOff();
+
+    ITK_TRY_EXPECT_NO_EXCEPTION(serialModule->Update());
+
+    const OutputImageType * serialImage =
+      dynamic_cast<const OutputSpatialObjectType *>(serialModule->GetOutput())->GetImage();
+
+    itk::ImageRegionConstIterator<OutputImageType> it(outputImage, outputImage->GetBufferedRegion());
+    itk::ImageRegionConstIterator<OutputImageType> sit(serialImage, serialImage->GetBufferedRegion());
+
+    itk::SizeValueType numberOfInsidePixels = 0;
+    itk::SizeValueType numberOfDifferentPixels = 0;
+    while (!it.IsAtEnd())
+    {
+      const bool inside = it.Get() > 0.0;
+      const bool serialInside = sit.Get() > 0.0;
+      numberOfInsidePixels += serialInside;
+      numberOfDifferentPixels += (inside != serialInside);
+      ++it;
+      ++sit;
+    }
+
+    const double differentFraction =
+      static_cast<double>(numberOfDifferentPixels) / std::max<itk::SizeValueType>(numberOfInsidePixels, 1);
+
+    std::cout << "Pixels segmented differently by the serial solver: " << numberOfDifferentPixels << " out of "
+              << numberOfInsidePixels << std::endl;
+
+    if (differentFraction > 0.01)
+    {
+      std::cerr << "Test failed!" << std::endl;
+      std::cerr << "The parallel solver differs from the serial solver on " << differentFraction * 100.0
+                << "% of the segmentation" << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+
   WriterType::Pointer writer = WriterType::New();
 
   writer->SetFileName(argv[3]);
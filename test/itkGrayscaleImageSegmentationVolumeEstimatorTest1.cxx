@@ -127,6 +127,57 @@ itkGrayscaleImageSegmentationVolumeEstimatorTest1(int itkNotUsed(argc), char * i
     testStatus = EXIT_FAILURE;
   }
 
+  //
+  // The volume does not depend on the number of threads.
+  //
+  volumeEstimator->SetNumberOfWorkUnits(1);
+
+  ITK_TRY_EXPECT_NO_EXCEPTION(volumeEstimator->Update());
+
+  if (itk::Math::NotExactlyEquals(volumeEstimator->GetVolume(), volume1))
+  {
+    std::cerr << "Test failed!" << std::endl;
+    std::cerr << "The volume computed with a single work unit " << volumeEstimator->GetVolume() << " differs from "
+              << volume1 << std::endl;
+    testStatus = EXIT_FAILURE;
+  }
+
+  //
+  // Restricting the scan to a box around the sphere, that contains some of
+  // the background, gives the same volume.
+  //
+  ITK_TEST_SET_GET_BOOLEAN(volumeEstimator, UseRegionOfInterest, true);
+
+  InputImageType::RegionType regionOfInterest;
+  for (unsigned int d = 0; d < Dimension; ++d)
+  {
+    const auto margin = static_cast<itk::IndexValueType>(radius / spacing[d]) + 2;
+    regionOfInterest.SetIndex(d, 50 - margin);
+    regionOfInterest.SetSize(d, 2 * margin + 1);
+  }
+
+  volumeEstimator->SetRegionOfInterest(regionOfInterest);
+  ITK_TEST_SET_GET_VALUE(regionOfInterest, volumeEstimator->GetRegionOfInterest());
+
+  ITK_TRY_EXPECT_NO_EXCEPTION(volumeEstimator->Update());
+
+  if (!itk::Math::FloatAlmostEqual(volumeEstimator->GetVolume(), volume1, 4, 1e-9 * volume1))
+  {
+    std::cerr << "Test failed!" << std::endl;
+    std::cerr << "The volume computed in the region of interest " << volumeEstimator->GetVolume() << " differs from "
+              << volume1 << std::endl;
+    testStatus = EXIT_FAILURE;
+  }
+
+  // A region of interest outside of the image.
+  InputImageType::RegionType outsideRegion = regionOfInterest;
+  outsideRegion.SetIndex(0, 500);
+  volumeEstimator->SetRegionOfInterest(outsideRegion);
+
+  ITK_TRY_EXPECT_EXCEPTION(volumeEstimator->Update());
+
+  volumeEstimator->SetRegionOfInterest(regionOfInterest);
+
   volumeEstimator->Print(std::cout);
 
   using WriterType = itk::ImageFileWriter<InputImageType>;
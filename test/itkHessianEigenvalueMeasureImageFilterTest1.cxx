@@ -0,0 +1,294 @@
+/*=========================================================================
+
+  Program:   Lesion Sizing Toolkit
+  Module:    itkHessianEigenvalueMeasureImageFilterTest1.cxx
+
+  Copyright (c) Kitware Inc.
+  All rights reserved.
+  See Copyright.txt or https://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+
+#include "itkHessianEigenvalueMeasureImageFilter.h"
+#include "itkDescoteauxSheetnessImageFilter.h"
+#include "itkFrangiTubularnessImageFilter.h"
+#include "itkLocalStructureImageFilter.h"
+#include "itkHessianRecursiveGaussianImageFilter.h"
+#include "itkSymmetricEigenAnalysisImageFilter.h"
+#include "itkImage.h"
+#include "itkImageFileReader.h"
+#include "itkImageFileWriter.h"
+#include "itkImageRegionConstIterator.h"
+#include "itkTestingMacros.h"
+
+#include <algorithm>
+#include <cmath>
+
+
+namespace
+{
+
+constexpr unsigned int Dimension = 3;
+
+using InputPixelType = signed short;
+using OutputPixelType = float;
+
+using InputImageType = itk::Image<InputPixelType, Dimension>;
+using OutputImageType = itk::Image<OutputPixelType, Dimension>;
+
+using HessianFilterType = itk::HessianRecursiveGaussianImageFilter<InputImageType>;
+using HessianImageType = HessianFilterType::OutputImageType;
+using HessianPixelType = HessianImageType::PixelType;
+
+using EigenValueArrayType = itk::FixedArray<double, HessianPixelType::Dimension>;
+using EigenValueImageType = itk::Image<EigenValueArrayType, Dimension>;
+
+using EigenAnalysisFilterType = itk::SymmetricEigenAnalysisImageFilter<HessianImageType, EigenValueImageType>;
+
+
+// Largest difference between two images, relative to the magnitude of the
+// values of the first image when that magnitude is larger than one.
+double
+MaximumRelativeDifference(const OutputImageType * image1, const OutputImageType * image2)
+{
+  itk::ImageRegionConstIterator<OutputImageType> it1(image1, image1->GetBufferedRegion());
+  itk::ImageRegionConstIterator<OutputImageType> it2(image2, image2->GetBufferedRegion());
+
+  double maximumDifference = 0.0;
+
+  while (!it1.IsAtEnd())
+  {
+    const auto   value1 = static_cast<double>(it1.Get());
+    const auto   value2 = static_cast<double>(it2.Get());
+    const double scale = std::max(1.0, itk::Math::abs(value1));
+    const double difference = itk::Math::abs(value1 - value2) / scale;
+    if (difference > maximumDifference)
+    {
+      maximumDifference = difference;
+    }
+    ++it1;
+    ++it2;
+  }
+
+  return maximumDifference;
+}
+
+
+// Compare the fused filter against the two stage pipeline made of the
+// eigen analysis filter followed by the functor image filter.
+template <typename TMeasureFilter>
+int
+CompareWithTwoStagePipeline(const HessianImageType *  hessian,
+                            const EigenValueImageType * eigenValues,
+                            const char *               measureName,
+                            OutputImageType::Pointer & fusedOutput)
+{
+  using MeasureType = typename TMeasureFilter::FunctorType;
+  using FusedFilterType = itk::HessianEigenvalueMeasureImageFilter<HessianImageType, OutputImageType, MeasureType>;
+
+  auto measureFilter = TMeasureFilter::New();
+  measureFilter->SetInput(eigenValues);
+
+  auto fusedFilter = FusedFilterType::New();
+
+  ITK_EXERCISE_BASIC_OBJECT_METHODS(fusedFilter, HessianEigenvalueMeasureImageFilter, ImageToImageFilter);
+
+  fusedFilter->SetInput(hessian);
+  fusedFilter->SetMeasure(measureFilter->GetFunctor());
+
+  ITK_TRY_EXPECT_NO_EXCEPTION(measureFilter->Update());
+  ITK_TRY_EXPECT_NO_EXCEPTION(fusedFilter->Update());
+
+  const double tolerance = 1e-4;
+  const double difference = MaximumRelativeDifference(measureFilter->GetOutput(), fusedFilter->GetOutput());
+
+  std::cout << measureName << " maximum difference = " << difference << std::endl;
+
+  if (difference > tolerance)
+  {
+    std::cerr << "Test failed!" << std::endl;
+    std::cerr << "The fused " << measureName << " differs from the two stage pipeline by " << difference
+              << " which is more than " << tolerance << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  fusedOutput = fusedFilter->GetOutput();
+
+  return EXIT_SUCCESS;
+}
+
+} // namespace
+
+
+int
+itkHessianEigenvalueMeasureImageFilterTest1(int argc, char * argv[])
+{
+  if (argc < 3)
+  {
+    std::cerr << "Missing parameters." << std::endl;
+    std::cerr << "Usage: " << argv[0];
+    std::cerr << " inputImage outputImage [sigma]" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  using ReaderType = itk::ImageFileReader<InputImageType>;
+  using WriterType = itk::ImageFileWriter<OutputImageType>;
+
+  ReaderType::Pointer reader = ReaderType::New();
+
+  reader->SetFileName(argv[1]);
+
+  ITK_TRY_EXPECT_NO_EXCEPTION(reader->Update());
+
+  HessianFilterType::Pointer hessian = HessianFilterType::New();
+
+  double sigma = 1.0;
+  if (argc > 3)
+  {
+    sigma = std::stod(argv[3]);
+  }
+  hessian->SetSigma(sigma);
+  hessian->SetInput(reader->GetOutput());
+
+  ITK_TRY_EXPECT_NO_EXCEPTION(hessian->Update());
+
+  EigenAnalysisFilterType::Pointer eigen = EigenAnalysisFilterType::New();
+  eigen->SetInput(hessian->GetOutput());
+  eigen->SetDimension(Dimension);
+
+  ITK_TRY_EXPECT_NO_EXCEPTION(eigen->Update());
+
+  //
+  // Closed form eigenvalues of a diagonal and of a degenerate tensor.
+  //
+  using SheetnessFunctionType = itk::Function::Sheetness<EigenValueArrayType, OutputPixelType>;
+  using FusedSheetnessFilterType =
+    itk::HessianEigenvalueMeasureImageFilter<HessianImageType, OutputImageType, SheetnessFunctionType>;
+
+  HessianPixelType    tensor;
+  EigenValueArrayType values;
+
+  tensor.Fill(0.0);
+  tensor(0, 0) = 3.0;
+  tensor(1, 1) = -2.0;
+  tensor(2, 2) = 1.0;
+
+  FusedSheetnessFilterType::ComputeEigenValues(tensor, values);
+
+  if (itk::Math::abs(values[0] + 2.0) > 1e-9 || itk::Math::abs(values[1] - 1.0) > 1e-9 ||
+      itk::Math::abs(values[2] - 3.0) > 1e-9)
+  {
+    std::cerr << "Test failed!" << std::endl;
+    std::cerr << "Wrong eigenvalues of a diagonal tensor: " << values << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  tensor.Fill(0.0);
+  tensor(0, 0) = 5.0;
+  tensor(1, 1) = 5.0;
+  tensor(2, 2) = 5.0;
+
+  FusedSheetnessFilterType::ComputeEigenValues(tensor, values);
+
+  if (itk::Math::abs(values[0] - 5.0) > 1e-9 || itk::Math::abs(values[2] - 5.0) > 1e-9)
+  {
+    std::cerr << "Test failed!" << std::endl;
+    std::cerr << "Wrong eigenvalues of an isotropic tensor: " << values << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  //
+  // Compare against the two stage pipelines on the input image.
+  //
+  using SheetnessFilterType = itk::DescoteauxSheetnessImageFilter<EigenValueImageType, OutputImageType>;
+  using TubularnessFilterType = itk::FrangiTubularnessImageFilter<EigenValueImageType, OutputImageType>;
+  using LocalStructureFilterType = itk::LocalStructureImageFilter<EigenValueImageType, OutputImageType>;
+
+  OutputImageType::Pointer sheetnessOutput;
+  OutputImageType::Pointer tubularnessOutput;
+  OutputImageType::Pointer localStructureOutput;
+
+  if (CompareWithTwoStagePipeline<SheetnessFilterType>(
+        hessian->GetOutput(), eigen->GetOutput(), "Sheetness", sheetnessOutput) == EXIT_FAILURE)
+  {
+    return EXIT_FAILURE;
+  }
+
+  if (CompareWithTwoStagePipeline<TubularnessFilterType>(
+        hessian->GetOutput(), eigen->GetOutput(), "Tubularness", tubularnessOutput) == EXIT_FAILURE)
+  {
+    return EXIT_FAILURE;
+  }
+
+  if (CompareWithTwoStagePipeline<LocalStructureFilterType>(
+        hessian->GetOutput(), eigen->GetOutput(), "LocalStructure", localStructureOutput) == EXIT_FAILURE)
+  {
+    return EXIT_FAILURE;
+  }
+
+  //
+  // The fast approximation of the exponentials must stay close to the exact
+  // evaluation.
+  //
+  for (double x = -50.0; x <= 0.0; x += 0.01)
+  {
+    const double exact = std::exp(x);
+    const double approximation = itk::Function::ExponentialApproximation(x);
+    if (itk::Math::abs(approximation - exact) > 1e-9 * exact)
+    {
+      std::cerr << "Test failed!" << std::endl;
+      std::cerr << "Exponential approximation at " << x << " = " << approximation << " instead of " << exact
+                << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+
+  for (double gamma : { 0.5, 1.0, 2.0, 2.5, -1.5, 0.3 })
+  {
+    itk::Function::PowerWithFixedExponent power;
+    power.SetExponent(gamma);
+    for (double base = 0.0; base <= 4.0; base += 0.125)
+    {
+      const double exact = std::pow(base, gamma);
+      if (itk::Math::abs(power(base) - exact) > 1e-12 * std::max(1.0, itk::Math::abs(exact)))
+      {
+        std::cerr << "Test failed!" << std::endl;
+        std::cerr << "Power " << gamma << " of " << base << " = " << power(base) << " instead of " << exact
+                  << std::endl;
+        return EXIT_FAILURE;
+      }
+    }
+  }
+
+  auto fastSheetnessFilter = FusedSheetnessFilterType::New();
+  fastSheetnessFilter->SetInput(hessian->GetOutput());
+  fastSheetnessFilter->GetMeasure().SetUseFastApproximation(true);
+
+  ITK_TRY_EXPECT_NO_EXCEPTION(fastSheetnessFilter->Update());
+
+  const double fastDifference = MaximumRelativeDifference(sheetnessOutput, fastSheetnessFilter->GetOutput());
+
+  std::cout << "Fast Sheetness maximum difference = " << fastDifference << std::endl;
+
+  if (fastDifference > 1e-6)
+  {
+    std::cerr << "Test failed!" << std::endl;
+    std::cerr << "The fast approximation of the sheetness differs by " << fastDifference << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  WriterType::Pointer writer = WriterType::New();
+
+  writer->SetFileName(argv[2]);
+  writer->SetInput(sheetnessOutput);
+  writer->UseCompressionOn();
+
+  ITK_TRY_EXPECT_NO_EXCEPTION(writer->Update());
+
+  std::cout << "Test finished." << std::endl;
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,226 @@
+/*=========================================================================
+
+  Program:   Lesion Sizing Toolkit
+  Module:    itkIsoSurfaceMeshSourceTest1.cxx
+
+  Copyright (c) Kitware Inc.
+  All rights reserved.
+  See Copyright.txt or https://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+
+#include "itkIsoSurfaceMeshSource.h"
+#include "itkIsoSurfaceSegmentationVolumeEstimator.h"
+#include "itkTriangleMeshFileWriter.h"
+#include "itkImage.h"
+#include "itkImageRegionIteratorWithIndex.h"
+#include "itkMesh.h"
+#include "itkMath.h"
+#include "itkTestingMacros.h"
+#include "itksys/SystemTools.hxx"
+
+#include <set>
+#include <utility>
+
+
+int
+itkIsoSurfaceMeshSourceTest1(int argc, char * argv[])
+{
+  if (argc < 3)
+  {
+    std::cerr << "Missing parameters." << std::endl;
+    std::cerr << "Usage: " << argv[0];
+    std::cerr << " outputSTLFile outputPLYFile" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  constexpr unsigned int Dimension = 3;
+
+  using ImageType = itk::Image<float, Dimension>;
+  using MeshType = itk::Mesh<float, Dimension>;
+  using MeshSourceType = itk::IsoSurfaceMeshSource<ImageType, MeshType>;
+
+  //
+  // Signed distance to a sphere, positive inside, whose center is not on the
+  // grid.
+  //
+  ImageType::SpacingType spacing;
+  spacing[0] = 0.7;
+  spacing[1] = 0.7;
+  spacing[2] = 1.25;
+
+  ImageType::PointType origin;
+  origin[0] = -40.0;
+  origin[1] = 12.0;
+  origin[2] = 100.0;
+
+  ImageType::SizeType size;
+  size[0] = 64;
+  size[1] = 64;
+  size[2] = 40;
+
+  ImageType::Pointer image = ImageType::New();
+  image->SetSpacing(spacing);
+  image->SetOrigin(origin);
+  image->SetRegions(ImageType::RegionType(size));
+  image->Allocate();
+
+  ImageType::PointType center;
+  center[0] = origin[0] + 31.3 * spacing[0];
+  center[1] = origin[1] + 30.6 * spacing[1];
+  center[2] = origin[2] + 19.2 * spacing[2];
+
+  constexpr double radius = 12.0;
+
+  itk::ImageRegionIteratorWithIndex<ImageType> itr(image, image->GetBufferedRegion());
+  ImageType::PointType                         point;
+  for (itr.GoToBegin(); !itr.IsAtEnd(); ++itr)
+  {
+    image->TransformIndexToPhysicalPoint(itr.GetIndex(), point);
+    itr.Set(radius - point.EuclideanDistanceTo(center));
+  }
+
+  MeshSourceType::Pointer meshSource = MeshSourceType::New();
+
+  ITK_EXERCISE_BASIC_OBJECT_METHODS(meshSource, IsoSurfaceMeshSource, ImageToMeshFilter);
+
+  meshSource->SetInput(image);
+
+  const double isoValue = 0.0;
+  meshSource->SetIsoValue(isoValue);
+  ITK_TEST_SET_GET_VALUE(isoValue, meshSource->GetIsoValue());
+
+  ITK_TRY_EXPECT_NO_EXCEPTION(meshSource->Update());
+
+  MeshType::Pointer mesh = meshSource->GetOutput();
+
+  const itk::SizeValueType numberOfPoints = mesh->GetNumberOfPoints();
+  const itk::SizeValueType numberOfTriangles = mesh->GetNumberOfCells();
+
+  std::cout << "Points: " << numberOfPoints << std::endl;
+  std::cout << "Triangles: " << numberOfTriangles << std::endl;
+
+  //
+  // The surface of the sphere is closed, with each edge shared by two
+  // triangles of opposite orientations, and its Euler characteristic is 2.
+  //
+  std::set<std::pair<itk::IdentifierType, itk::IdentifierType>> orientedEdges;
+
+  double enclosedVolume = 0.0;
+  bool   duplicatedEdge = false;
+
+  for (auto cellIt = mesh->GetCells()->Begin(); cellIt != mesh->GetCells()->End(); ++cellIt)
+  {
+    const itk::IdentifierType * pointIds = cellIt.Value()->PointIdsBegin();
+
+    for (unsigned int i = 0; i < 3; ++i)
+    {
+      duplicatedEdge |= !orientedEdges.emplace(pointIds[i], pointIds[(i + 1) % 3]).second;
+    }
+
+    // Divergence theorem, relative to the center to limit the rounding.
+    itk::Vector<double, Dimension> v[3];
+    for (unsigned int i = 0; i < 3; ++i)
+    {
+      const MeshType::PointType & p = mesh->GetPoints()->ElementAt(pointIds[i]);
+      for (unsigned int d = 0; d < Dimension; ++d)
+      {
+        v[i][d] = p[d] - center[d];
+      }
+    }
+    enclosedVolume += v[0] * itk::CrossProduct(v[1], v[2]) / 6.0;
+  }
+
+  bool unpairedEdge = false;
+  for (const auto & edge : orientedEdges)
+  {
+    unpairedEdge |= (orientedEdges.count(std::make_pair(edge.second, edge.first)) == 0);
+  }
+
+  const long eulerCharacteristic = static_cast<long>(numberOfPoints) -
+                                   static_cast<long>(orientedEdges.size() / 2) +
+                                   static_cast<long>(numberOfTriangles);
+
+  if (numberOfTriangles == 0 || duplicatedEdge || unpairedEdge || eulerCharacteristic != 2)
+  {
+    std::cerr << "Test failed!" << std::endl;
+    std::cerr << "The surface is not closed and consistently oriented, Euler characteristic " << eulerCharacteristic
+              << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  //
+  // The volume enclosed by the outward oriented surface is the one of the
+  // volume estimator.
+  //
+  using VolumeEstimatorType = itk::IsoSurfaceSegmentationVolumeEstimator<Dimension>;
+  using ImageSpatialObjectType = VolumeEstimatorType::InputImageSpatialObjectType;
+
+  ImageSpatialObjectType::Pointer imageObject = ImageSpatialObjectType::New();
+  imageObject->SetImage(image);
+
+  VolumeEstimatorType::Pointer volumeEstimator = VolumeEstimatorType::New();
+  volumeEstimator->SetInput(imageObject);
+  volumeEstimator->SetIsoValue(isoValue);
+
+  ITK_TRY_EXPECT_NO_EXCEPTION(volumeEstimator->Update());
+
+  std::cout << "Enclosed volume: " << enclosedVolume << std::endl;
+  std::cout << "Estimated volume: " << volumeEstimator->GetVolume() << std::endl;
+
+  if (itk::Math::abs(enclosedVolume - volumeEstimator->GetVolume()) > 1e-4 * volumeEstimator->GetVolume())
+  {
+    std::cerr << "Test failed!" << std::endl;
+    std::cerr << "The volume enclosed by the surface differs from the estimated volume" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  //
+  // The mesh does not depend on the number of threads.
+  //
+  MeshSourceType::Pointer singleThreadedMeshSource = MeshSourceType::New();
+  singleThreadedMeshSource->SetInput(image);
+  singleThreadedMeshSource->SetIsoValue(isoValue);
+  singleThreadedMeshSource->SetNumberOfWorkUnits(1);
+
+  ITK_TRY_EXPECT_NO_EXCEPTION(singleThreadedMeshSource->Update());
+
+  ITK_TEST_EXPECT_EQUAL(singleThreadedMeshSource->GetOutput()->GetNumberOfPoints(), numberOfPoints);
+  ITK_TEST_EXPECT_EQUAL(singleThreadedMeshSource->GetOutput()->GetNumberOfCells(), numberOfTriangles);
+
+  //
+  // Binary STL and PLY files.
+  //
+  using WriterType = itk::TriangleMeshFileWriter<MeshType>;
+  WriterType::Pointer writer = WriterType::New();
+
+  ITK_EXERCISE_BASIC_OBJECT_METHODS(writer, TriangleMeshFileWriter, ProcessObject);
+
+  writer->SetInput(mesh);
+
+  writer->SetFileName("unknownExtension.vtk");
+  ITK_TRY_EXPECT_EXCEPTION(writer->Update());
+
+  writer->SetFileName(argv[1]);
+  ITK_TEST_SET_GET_VALUE(std::string(argv[1]), writer->GetFileName());
+  ITK_TRY_EXPECT_NO_EXCEPTION(writer->Update());
+
+  ITK_TEST_EXPECT_EQUAL(itksys::SystemTools::FileLength(argv[1]), 84 + 50 * numberOfTriangles);
+
+  writer->SetFileName(argv[2]);
+  ITK_TRY_EXPECT_NO_EXCEPTION(writer->Update());
+
+  if (itksys::SystemTools::FileLength(argv[2]) <= 12 * numberOfPoints + 13 * numberOfTriangles)
+  {
+    std::cerr << "Test failed!" << std::endl;
+    std::cerr << "The PLY file is too short" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  std::cout << "Test finished." << std::endl;
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,206 @@
+/*=========================================================================
+
+  Program:   Lesion Sizing Toolkit
+  Module:    itkIsoSurfaceSegmentationMorphometryEstimatorTest1.cxx
+
+  Copyright (c) Kitware Inc.
+  All rights reserved.
+  See Copyright.txt or https://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+
+#include "itkIsoSurfaceSegmentationMorphometryEstimator.h"
+#include "itkImage.h"
+#include "itkImageSpatialObject.h"
+#include "itkImageRegionIteratorWithIndex.h"
+#include "itkMath.h"
+#include "itkTestingMacros.h"
+
+#include <cmath>
+
+
+namespace
+{
+
+// Whether the value is within the tolerance of the expected value.
+bool
+IsClose(const char * name, double value, double expected, double tolerance)
+{
+  std::cout << name << ": " << value << " (expected " << expected << ")" << std::endl;
+  if (itk::Math::abs(value - expected) > tolerance)
+  {
+    std::cerr << "Test failed!" << std::endl;
+    std::cerr << "The " << name << " " << value << " differs from " << expected << std::endl;
+    return false;
+  }
+  return true;
+}
+
+} // namespace
+
+
+int
+itkIsoSurfaceSegmentationMorphometryEstimatorTest1(int itkNotUsed(argc), char * itkNotUsed(argv)[])
+{
+  constexpr unsigned int Dimension = 3;
+
+  using MorphometryEstimatorType = itk::IsoSurfaceSegmentationMorphometryEstimator<Dimension>;
+
+  MorphometryEstimatorType::Pointer morphometryEstimator = MorphometryEstimatorType::New();
+
+  ITK_EXERCISE_BASIC_OBJECT_METHODS(
+    morphometryEstimator, IsoSurfaceSegmentationMorphometryEstimator, IsoSurfaceSegmentationVolumeEstimator);
+
+  morphometryEstimator->SetIsoValue(0.0);
+
+  using InputImageType = MorphometryEstimatorType::InputImageType;
+  using InputImageSpatialObjectType = MorphometryEstimatorType::InputImageSpatialObjectType;
+
+  InputImageType::Pointer image = InputImageType::New();
+
+  InputImageSpatialObjectType::Pointer inputImageSpatialObject = InputImageSpatialObjectType::New();
+  inputImageSpatialObject->SetImage(image);
+
+  morphometryEstimator->SetInput(inputImageSpatialObject);
+
+  InputImageType::SpacingType spacing;
+  spacing[0] = 0.5;
+  spacing[1] = 0.5;
+  spacing[2] = 0.8;
+
+  InputImageType::PointType origin;
+  origin[0] = -120.0;
+  origin[1] = 35.0;
+  origin[2] = 210.0;
+
+  InputImageType::SizeType size;
+  size.Fill(101);
+
+  image->SetSpacing(spacing);
+  image->SetOrigin(origin);
+  image->SetRegions(InputImageType::RegionType(size));
+  image->Allocate();
+
+  InputImageType::PointType center;
+  for (unsigned int d = 0; d < Dimension; ++d)
+  {
+    center[d] = origin[d] + 50.0 * spacing[d];
+  }
+
+  //
+  // Signed distance to a sphere, positive inside.
+  //
+  constexpr double radius = 15.0;
+
+  itk::ImageRegionIteratorWithIndex<InputImageType> itr(image, image->GetBufferedRegion());
+  InputImageType::PointType                         point;
+
+  for (itr.GoToBegin(); !itr.IsAtEnd(); ++itr)
+  {
+    image->TransformIndexToPhysicalPoint(itr.GetIndex(), point);
+    itr.Set(radius - point.EuclideanDistanceTo(center));
+  }
+  image->Modified();
+
+  ITK_TRY_EXPECT_NO_EXCEPTION(morphometryEstimator->Update());
+
+  const MorphometryEstimatorType::MorphometryType sphere = morphometryEstimator->GetMorphometry();
+
+  morphometryEstimator->Print(std::cout);
+
+  bool passed = true;
+
+  const double sphereVolume = 4.0 / 3.0 * itk::Math::pi * radius * radius * radius;
+  const double sphereArea = 4.0 * itk::Math::pi * radius * radius;
+  const double sphereMoment = radius * radius / 5.0;
+
+  passed &= IsClose("volume", sphere.Volume, sphereVolume, 0.002 * sphereVolume);
+  passed &= IsClose("surface area", sphere.SurfaceArea, sphereArea, 0.005 * sphereArea);
+  passed &= IsClose("maximum diameter", sphere.MaximumDiameter, 2.0 * radius, 0.01 * radius);
+  passed &= IsClose("sphericity", sphere.Sphericity, 1.0, 0.01);
+  for (unsigned int d = 0; d < Dimension; ++d)
+  {
+    passed &= IsClose("centroid", sphere.Centroid[d], center[d], 0.01);
+    passed &= IsClose("bounding box minimum", sphere.BoundingBoxMinimum[d], center[d] - radius, 0.1);
+    passed &= IsClose("bounding box maximum", sphere.BoundingBoxMaximum[d], center[d] + radius, 0.1);
+    passed &= IsClose("principal moment", sphere.PrincipalMoments[d], sphereMoment, 0.01 * sphereMoment);
+  }
+
+  ITK_TEST_EXPECT_TRUE(itk::Math::ExactlyEquals(morphometryEstimator->GetVolume(), sphere.Volume));
+
+  //
+  // The measures do not depend on the number of threads.
+  //
+  morphometryEstimator->SetNumberOfWorkUnits(1);
+
+  ITK_TRY_EXPECT_NO_EXCEPTION(morphometryEstimator->Update());
+
+  if (morphometryEstimator->GetMorphometry() != sphere)
+  {
+    std::cerr << "Test failed!" << std::endl;
+    std::cerr << "The measures computed with a single work unit differ" << std::endl;
+    passed = false;
+  }
+
+  //
+  // Ellipsoid elongated along the x axis.
+  //
+  const double semiAxes[Dimension] = { 12.0, 8.0, 6.0 };
+
+  for (itr.GoToBegin(); !itr.IsAtEnd(); ++itr)
+  {
+    image->TransformIndexToPhysicalPoint(itr.GetIndex(), point);
+    double normalizedDistance = 0.0;
+    for (unsigned int d = 0; d < Dimension; ++d)
+    {
+      normalizedDistance += itk::Math::sqr((point[d] - center[d]) / semiAxes[d]);
+    }
+    itr.Set(semiAxes[Dimension - 1] * (1.0 - std::sqrt(normalizedDistance)));
+  }
+  image->Modified();
+
+  ITK_TRY_EXPECT_NO_EXCEPTION(morphometryEstimator->Update());
+
+  const MorphometryEstimatorType::MorphometryType ellipsoid = morphometryEstimator->GetMorphometry();
+
+  const double ellipsoidVolume = 4.0 / 3.0 * itk::Math::pi * semiAxes[0] * semiAxes[1] * semiAxes[2];
+
+  passed &= IsClose("ellipsoid volume", ellipsoid.Volume, ellipsoidVolume, 0.01 * ellipsoidVolume);
+  passed &= IsClose("ellipsoid maximum diameter", ellipsoid.MaximumDiameter, 2.0 * semiAxes[0], 0.01 * semiAxes[0]);
+  for (unsigned int d = 0; d < Dimension; ++d)
+  {
+    // The moments are in increasing order, the smallest along the z axis.
+    const double moment = itk::Math::sqr(semiAxes[Dimension - 1 - d]) / 5.0;
+    passed &= IsClose("ellipsoid principal moment", ellipsoid.PrincipalMoments[d], moment, 0.02 * moment);
+  }
+  passed &= IsClose("ellipsoid major axis", itk::Math::abs(ellipsoid.PrincipalAxes(Dimension - 1, 0)), 1.0, 1e-3);
+
+  if (ellipsoid.Sphericity >= 1.0)
+  {
+    std::cerr << "Test failed!" << std::endl;
+    std::cerr << "The sphericity of the ellipsoid " << ellipsoid.Sphericity << " is not smaller than one" << std::endl;
+    passed = false;
+  }
+
+  //
+  // No pixel inside the segmentation.
+  //
+  image->FillBuffer(-4.0);
+  image->Modified();
+
+  ITK_TRY_EXPECT_NO_EXCEPTION(morphometryEstimator->Update());
+  ITK_TEST_EXPECT_TRUE(itk::Math::ExactlyEquals(morphometryEstimator->GetMorphometry().Volume, 0.0));
+  ITK_TEST_EXPECT_TRUE(itk::Math::ExactlyEquals(morphometryEstimator->GetMorphometry().SurfaceArea, 0.0));
+
+  if (!passed)
+  {
+    return EXIT_FAILURE;
+  }
+
+  std::cout << "Test finished." << std::endl;
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,165 @@
+/*=========================================================================
+
+  Program:   Lesion Sizing Toolkit
+  Module:    itkIsoSurfaceSegmentationVolumeEstimatorTest1.cxx
+
+  Copyright (c) Kitware Inc.
+  All rights reserved.
+  See Copyright.txt or https://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+
+#include "itkIsoSurfaceSegmentationVolumeEstimator.h"
+#include "itkImage.h"
+#include "itkImageSpatialObject.h"
+#include "itkImageRegionIteratorWithIndex.h"
+#include "itkMath.h"
+#include "itkTestingMacros.h"
+
+
+int
+itkIsoSurfaceSegmentationVolumeEstimatorTest1(int itkNotUsed(argc), char * itkNotUsed(argv)[])
+{
+  constexpr unsigned int Dimension = 3;
+
+  using VolumeEstimatorType = itk::IsoSurfaceSegmentationVolumeEstimator<Dimension>;
+
+  VolumeEstimatorType::Pointer volumeEstimator = VolumeEstimatorType::New();
+
+  ITK_EXERCISE_BASIC_OBJECT_METHODS(
+    volumeEstimator, IsoSurfaceSegmentationVolumeEstimator, SegmentationVolumeEstimator);
+
+  using ImageSpatialObjectType = itk::ImageSpatialObject<Dimension>;
+
+  ImageSpatialObjectType::Pointer inputObject = ImageSpatialObjectType::New();
+
+  volumeEstimator->SetInput(inputObject);
+
+  ITK_TRY_EXPECT_EXCEPTION(volumeEstimator->Update());
+
+  const double isoValue = 0.0;
+  volumeEstimator->SetIsoValue(isoValue);
+  ITK_TEST_SET_GET_VALUE(isoValue, volumeEstimator->GetIsoValue());
+
+
+  using InputImageType = VolumeEstimatorType::InputImageType;
+
+  InputImageType::Pointer image = InputImageType::New();
+
+  using InputImageSpatialObjectType = VolumeEstimatorType::InputImageSpatialObjectType;
+
+  InputImageSpatialObjectType::Pointer inputImageSpatialObject = InputImageSpatialObjectType::New();
+
+  volumeEstimator->SetInput(inputImageSpatialObject);
+
+  inputImageSpatialObject->SetImage(image);
+
+  InputImageType::SpacingType spacing;
+
+  spacing[0] = 0.5;
+  spacing[1] = 0.5;
+  spacing[2] = 0.8;
+
+  image->SetSpacing(spacing);
+
+  InputImageType::SizeType size;
+  size[0] = 101;
+  size[1] = 101;
+  size[2] = 101;
+
+  InputImageType::RegionType region;
+  region.SetSize(size);
+
+  image->SetRegions(region);
+  image->Allocate();
+
+  //
+  // No pixel inside the segmentation.
+  //
+  image->FillBuffer(-4.0);
+
+  ITK_TRY_EXPECT_NO_EXCEPTION(volumeEstimator->Update());
+  ITK_TEST_EXPECT_TRUE(itk::Math::ExactlyEquals(volumeEstimator->GetVolume(), 0.0));
+
+  //
+  // Populate the image with the signed distance to a sphere, positive inside.
+  //
+  InputImageType::PointType center;
+
+  center[0] = 50.0 * spacing[0];
+  center[1] = 50.0 * spacing[1];
+  center[2] = 50.0 * spacing[2];
+
+  constexpr double radius = 15.0;
+
+  itk::ImageRegionIteratorWithIndex<InputImageType> itr(image, region);
+
+  InputImageType::PointType point;
+
+  while (!itr.IsAtEnd())
+  {
+    image->TransformIndexToPhysicalPoint(itr.GetIndex(), point);
+    itr.Set(radius - point.EuclideanDistanceTo(center));
+    ++itr;
+  }
+  image->Modified();
+
+  ITK_TRY_EXPECT_NO_EXCEPTION(volumeEstimator->Update());
+
+  const VolumeEstimatorType::RealType volume = volumeEstimator->GetVolume();
+
+  const double expectedVolume = (4.0 / 3.0) * itk::Math::pi * (radius * radius * radius);
+
+  const double percentage = 100.0 * itk::Math::abs(volume - expectedVolume) / expectedVolume;
+
+  std::cout << "Expected volume " << expectedVolume << std::endl;
+  std::cout << "Computed volume " << volume << " (" << percentage << "%)" << std::endl;
+
+  if (percentage > 0.2)
+  {
+    std::cerr << "Test failed!" << std::endl;
+    std::cerr << "Error in volume computation" << std::endl;
+    std::cerr << "Expected value " << expectedVolume << " differs from " << volume << " by " << percentage << "%"
+              << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  //
+  // The volume does not depend on the number of threads.
+  //
+  volumeEstimator->SetNumberOfWorkUnits(1);
+
+  ITK_TRY_EXPECT_NO_EXCEPTION(volumeEstimator->Update());
+
+  if (itk::Math::NotExactlyEquals(volumeEstimator->GetVolume(), volume))
+  {
+    std::cerr << "Test failed!" << std::endl;
+    std::cerr << "The volume computed with a single work unit " << volumeEstimator->GetVolume() << " differs from "
+              << volume << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  //
+  // A larger iso-value shrinks the sphere.
+  //
+  volumeEstimator->SetIsoValue(5.0);
+
+  ITK_TRY_EXPECT_NO_EXCEPTION(volumeEstimator->Update());
+
+  const double smallerRadius = radius - 5.0;
+  const double smallerVolume = (4.0 / 3.0) * itk::Math::pi * (smallerRadius * smallerRadius * smallerRadius);
+
+  if (itk::Math::abs(volumeEstimator->GetVolume() - smallerVolume) > 0.005 * smallerVolume)
+  {
+    std::cerr << "Test failed!" << std::endl;
+    std::cerr << "Expected value " << smallerVolume << " differs from " << volumeEstimator->GetVolume() << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  std::cout << "Test finished." << std::endl;
+  return EXIT_SUCCESS;
+}
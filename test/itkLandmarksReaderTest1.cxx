@@ -26,7 +26,7 @@ itkLandmarksReaderTest1(int argc, char * argv[])
   {
     std::cerr << "Missing parameters." << std::endl;
     std::cerr << "Usage: " << argv[0];
-    std::cerr << " landmarksFile ";
+    std::cerr << " landmarksFile [landmarksFile ...]";
     return EXIT_FAILURE;
   }
 
@@ -130,8 +130,57 @@ itkLandmarksReaderTest1(int argc, char * argv[])
       std::cerr << " differs from" << points1[i].GetPositionInObjectSpace() << std::endl;
       return EXIT_FAILURE;
     }
+    if (points1[i].GetColor() != points2[i].GetColor())
+    {
+      std::cerr << "Test failed!" << std::endl;
+      std::cerr << "Error : point " << i << " has different colors" << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+
+  delete groupChildren;
+
+  //
+  // Reading all the landmarks files at once, along with a missing file.
+  //
+  LandmarksReaderType::FileNameContainerType fileNames;
+  for (int i = 1; i < argc; ++i)
+  {
+    fileNames.emplace_back(argv[i]);
+  }
+
+  LandmarksReaderType::LandmarkPointListContainerType batchPoints;
+
+  ITK_TRY_EXPECT_NO_EXCEPTION(LandmarksReaderType::ReadLandmarks(fileNames, batchPoints));
+
+  ITK_TEST_EXPECT_EQUAL(batchPoints.size(), fileNames.size());
+
+  for (unsigned int f = 0; f < fileNames.size(); ++f)
+  {
+    LandmarksReaderType::Pointer fileReader = LandmarksReaderType::New();
+    fileReader->SetFileName(fileNames[f]);
+
+    ITK_TRY_EXPECT_NO_EXCEPTION(fileReader->Update());
+
+    const LandmarkPointListType & filePoints = fileReader->GetOutput()->GetPoints();
+
+    ITK_TEST_EXPECT_EQUAL(batchPoints[f].size(), filePoints.size());
+
+    for (unsigned int i = 0; i < filePoints.size(); ++i)
+    {
+      if (batchPoints[f][i].GetPositionInObjectSpace() != filePoints[i].GetPositionInObjectSpace())
+      {
+        std::cerr << "Test failed!" << std::endl;
+        std::cerr << "Error : point " << i << " of " << fileNames[f] << " differs in the batch" << std::endl;
+        return EXIT_FAILURE;
+      }
+    }
   }
 
+  fileNames.push_back(inputFileName + ".missing");
+
+  ITK_TRY_EXPECT_EXCEPTION(LandmarksReaderType::ReadLandmarks(fileNames, batchPoints));
+
 
   std::cout << "Test finished." << std::endl;
   return EXIT_SUCCESS;
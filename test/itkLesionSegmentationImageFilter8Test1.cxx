@@ -0,0 +1,142 @@
+/*=========================================================================
+
+  Program:   Lesion Sizing Toolkit
+  Module:    itkLesionSegmentationImageFilter8Test1.cxx
+
+  Copyright (c) Kitware Inc.
+  All rights reserved.
+  See Copyright.txt or https://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+
+// The test segments a lesion in the whole region of interest, then in an
+// adaptive region of interest grown around the seeds, and compares both
+// segmentations.
+
+#include "itkLesionSegmentationImageFilter8.h"
+#include "itkImage.h"
+#include "itkImageFileReader.h"
+#include "itkImageRegionConstIterator.h"
+#include "itkLandmarksReader.h"
+#include "itkMath.h"
+#include "itkMinimumMaximumImageCalculator.h"
+#include "itkTestingMacros.h"
+
+#include <string>
+
+
+int
+itkLesionSegmentationImageFilter8Test1(int argc, char * argv[])
+{
+  if (argc < 3)
+  {
+    std::cerr << "Missing parameters." << std::endl;
+    std::cerr << "Usage: " << argv[0];
+    std::cerr << " landmarksFile inputImage [initialRegionOfInterestRadius]" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  constexpr unsigned int Dimension = 3;
+
+  using InputImageType = itk::Image<signed short, Dimension>;
+  using OutputImageType = itk::Image<float, Dimension>;
+  using FilterType = itk::LesionSegmentationImageFilter8<InputImageType, OutputImageType>;
+  using LandmarksReaderType = itk::LandmarksReader<Dimension>;
+
+  FilterType::LandmarkPointListType seeds;
+  ITK_TRY_EXPECT_NO_EXCEPTION(LandmarksReaderType::ReadLandmarks(argv[1], seeds));
+
+  using InputImageReaderType = itk::ImageFileReader<InputImageType>;
+  InputImageReaderType::Pointer inputImageReader = InputImageReaderType::New();
+  inputImageReader->SetFileName(argv[2]);
+
+  ITK_TRY_EXPECT_NO_EXCEPTION(inputImageReader->Update());
+
+  const InputImageType * inputImage = inputImageReader->GetOutput();
+
+  const double initialRegionOfInterestRadius = (argc > 3) ? std::stod(argv[3]) : 10.0;
+
+  //
+  // Segmentation in the whole region of interest.
+  //
+  FilterType::Pointer fullFilter = FilterType::New();
+  fullFilter->SetInput(inputImage);
+  fullFilter->SetSeeds(seeds);
+  fullFilter->SetRegionOfInterest(inputImage->GetLargestPossibleRegion());
+  ITK_TEST_SET_GET_BOOLEAN(fullFilter, AdaptiveRegionOfInterest, false);
+
+  ITK_TRY_EXPECT_NO_EXCEPTION(fullFilter->Update());
+
+  //
+  // Segmentation in a region of interest grown around the seeds.
+  //
+  FilterType::Pointer adaptiveFilter = FilterType::New();
+  adaptiveFilter->SetInput(inputImage);
+  adaptiveFilter->SetSeeds(seeds);
+  adaptiveFilter->SetRegionOfInterest(inputImage->GetLargestPossibleRegion());
+  adaptiveFilter->SetInitialRegionOfInterestRadius(initialRegionOfInterestRadius);
+  ITK_TEST_SET_GET_VALUE(initialRegionOfInterestRadius, adaptiveFilter->GetInitialRegionOfInterestRadius());
+  ITK_TEST_SET_GET_BOOLEAN(adaptiveFilter, AdaptiveRegionOfInterest, true);
+
+  ITK_TRY_EXPECT_NO_EXCEPTION(adaptiveFilter->Update());
+
+  const OutputImageType * fullOutput = fullFilter->GetOutput();
+  const OutputImageType * adaptiveOutput = adaptiveFilter->GetOutput();
+
+  //
+  // Both outputs are on the same grid.
+  //
+  ITK_TEST_EXPECT_EQUAL(fullOutput->GetLargestPossibleRegion(), adaptiveOutput->GetLargestPossibleRegion());
+  ITK_TEST_EXPECT_EQUAL(fullOutput->GetBufferedRegion(), adaptiveOutput->GetBufferedRegion());
+  ITK_TEST_EXPECT_TRUE(fullOutput->GetOrigin() == adaptiveOutput->GetOrigin());
+  ITK_TEST_EXPECT_TRUE(fullOutput->GetSpacing() == adaptiveOutput->GetSpacing());
+  ITK_TEST_EXPECT_TRUE(fullOutput->GetDirection() == adaptiveOutput->GetDirection());
+
+  //
+  // Both outputs are normalized over the whole region of interest.
+  //
+  using CalculatorType = itk::MinimumMaximumImageCalculator<OutputImageType>;
+  CalculatorType::Pointer calculator = CalculatorType::New();
+
+  calculator->SetImage(fullOutput);
+  calculator->Compute();
+  ITK_TEST_EXPECT_TRUE(itk::Math::FloatAlmostEqual(calculator->GetMinimum(), -4.0f));
+  ITK_TEST_EXPECT_TRUE(itk::Math::FloatAlmostEqual(calculator->GetMaximum(), 4.0f));
+
+  calculator->SetImage(adaptiveOutput);
+  calculator->Compute();
+  ITK_TEST_EXPECT_TRUE(itk::Math::FloatAlmostEqual(calculator->GetMinimum(), -4.0f));
+  ITK_TEST_EXPECT_TRUE(itk::Math::FloatAlmostEqual(calculator->GetMaximum(), 4.0f));
+
+  //
+  // The lesions match, up to the features near the faces of the adaptive
+  // region of interest, which see less context.
+  //
+  itk::SizeValueType lesionPixels = 0;
+  itk::SizeValueType differentPixels = 0;
+
+  itk::ImageRegionConstIterator<OutputImageType> fit(fullOutput, fullOutput->GetBufferedRegion());
+  itk::ImageRegionConstIterator<OutputImageType> ait(adaptiveOutput, adaptiveOutput->GetBufferedRegion());
+  while (!fit.IsAtEnd())
+  {
+    const bool fullIsInside = fit.Get() > 0.0f;
+    const bool adaptiveIsInside = ait.Get() > 0.0f;
+    lesionPixels += fullIsInside;
+    differentPixels += (fullIsInside != adaptiveIsInside);
+    ++fit;
+    ++ait;
+  }
+
+  std::cout << "Lesion pixels: " << lesionPixels << std::endl;
+  std::cout << "Different pixels: " << differentPixels << std::endl;
+
+  ITK_TEST_EXPECT_TRUE(lesionPixels > 0);
+  ITK_TEST_EXPECT_TRUE(100 * differentPixels <= lesionPixels);
+
+  std::cout << "Test finished." << std::endl;
+  return EXIT_SUCCESS;
+}
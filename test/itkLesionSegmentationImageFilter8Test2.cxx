@@ -0,0 +1,163 @@
+/*=========================================================================
+
+  Program:   Lesion Sizing Toolkit
+  Module:    itkLesionSegmentationImageFilter8Test2.cxx
+
+  Copyright (c) Kitware Inc.
+  All rights reserved.
+  See Copyright.txt or https://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+
+// The test segments a lesion in a small region of interest of a large
+// input, checks that only the region of interest of the input is requested
+// and computed upstream, and compares the segmentation with the one of the
+// same region of interest of a fully buffered input.
+
+#include "itkLesionSegmentationImageFilter8.h"
+#include "itkConstantPadImageFilter.h"
+#include "itkImage.h"
+#include "itkImageFileReader.h"
+#include "itkImageRegionConstIterator.h"
+#include "itkLandmarksReader.h"
+#include "itkMath.h"
+#include "itkTestingMacros.h"
+
+
+int
+itkLesionSegmentationImageFilter8Test2(int argc, char * argv[])
+{
+  if (argc < 3)
+  {
+    std::cerr << "Missing parameters." << std::endl;
+    std::cerr << "Usage: " << argv[0];
+    std::cerr << " landmarksFile inputImage" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  constexpr unsigned int Dimension = 3;
+
+  using InputImageType = itk::Image<signed short, Dimension>;
+  using OutputImageType = itk::Image<float, Dimension>;
+  using FilterType = itk::LesionSegmentationImageFilter8<InputImageType, OutputImageType>;
+  using PadFilterType = itk::ConstantPadImageFilter<InputImageType, InputImageType>;
+  using LandmarksReaderType = itk::LandmarksReader<Dimension>;
+  using RegionType = InputImageType::RegionType;
+
+  FilterType::LandmarkPointListType seeds;
+  ITK_TRY_EXPECT_NO_EXCEPTION(LandmarksReaderType::ReadLandmarks(argv[1], seeds));
+  ITK_TEST_EXPECT_TRUE(!seeds.empty());
+
+  using InputImageReaderType = itk::ImageFileReader<InputImageType>;
+  InputImageReaderType::Pointer inputImageReader = InputImageReaderType::New();
+  inputImageReader->SetFileName(argv[2]);
+
+  ITK_TRY_EXPECT_NO_EXCEPTION(inputImageReader->Update());
+
+  //
+  // Large input: the image surrounded by air. The padding filter computes
+  // only the region requested downstream.
+  //
+  InputImageType::SizeType padding;
+  padding[0] = 128;
+  padding[1] = 128;
+  padding[2] = 32;
+
+  auto createLargeInput = [&]() {
+    PadFilterType::Pointer padFilter = PadFilterType::New();
+    padFilter->SetInput(inputImageReader->GetOutput());
+    padFilter->SetPadLowerBound(padding);
+    padFilter->SetPadUpperBound(padding);
+    padFilter->SetConstant(-1000);
+    return padFilter;
+  };
+
+  PadFilterType::Pointer streamedInput = createLargeInput();
+  ITK_TRY_EXPECT_NO_EXCEPTION(streamedInput->UpdateOutputInformation());
+
+  const RegionType largestRegion = streamedInput->GetOutput()->GetLargestPossibleRegion();
+
+  //
+  // Small region of interest around the first seed.
+  //
+  const InputImageType::IndexType seedIndex =
+    streamedInput->GetOutput()->TransformPhysicalPointToIndex(seeds[0].GetPositionInObjectSpace());
+
+  InputImageType::SizeType seedSize;
+  seedSize.Fill(1);
+
+  RegionType regionOfInterest(seedIndex, seedSize);
+  regionOfInterest.PadByRadius(20);
+
+  const bool regionOfInterestIsInside = regionOfInterest.Crop(largestRegion);
+  ITK_TEST_EXPECT_TRUE(regionOfInterestIsInside);
+
+  std::cout << "Largest possible region: " << largestRegion << std::endl;
+  std::cout << "Region of interest: " << regionOfInterest << std::endl;
+
+  ITK_TEST_EXPECT_TRUE(100 * regionOfInterest.GetNumberOfPixels() < largestRegion.GetNumberOfPixels());
+
+  //
+  // Only the region of interest of the input is requested.
+  //
+  FilterType::Pointer streamedFilter = FilterType::New();
+  streamedFilter->SetInput(streamedInput->GetOutput());
+  streamedFilter->SetSeeds(seeds);
+  streamedFilter->SetRegionOfInterest(regionOfInterest);
+
+  ITK_TRY_EXPECT_NO_EXCEPTION(streamedFilter->UpdateOutputInformation());
+  ITK_TRY_EXPECT_NO_EXCEPTION(streamedFilter->PropagateRequestedRegion(streamedFilter->GetOutput()));
+
+  ITK_TEST_EXPECT_EQUAL(streamedInput->GetOutput()->GetRequestedRegion(), regionOfInterest);
+
+  ITK_TRY_EXPECT_NO_EXCEPTION(streamedFilter->Update());
+
+  ITK_TEST_EXPECT_EQUAL(streamedInput->GetOutput()->GetBufferedRegion(), regionOfInterest);
+
+  //
+  // Same region of interest of the fully buffered input.
+  //
+  PadFilterType::Pointer bufferedInput = createLargeInput();
+  ITK_TRY_EXPECT_NO_EXCEPTION(bufferedInput->UpdateLargestPossibleRegion());
+
+  ITK_TEST_EXPECT_EQUAL(bufferedInput->GetOutput()->GetBufferedRegion(), largestRegion);
+
+  FilterType::Pointer bufferedFilter = FilterType::New();
+  bufferedFilter->SetInput(bufferedInput->GetOutput());
+  bufferedFilter->SetSeeds(seeds);
+  bufferedFilter->SetRegionOfInterest(regionOfInterest);
+
+  ITK_TRY_EXPECT_NO_EXCEPTION(bufferedFilter->Update());
+
+  //
+  // Both segmentations are the same.
+  //
+  const OutputImageType * streamedOutput = streamedFilter->GetOutput();
+  const OutputImageType * bufferedOutput = bufferedFilter->GetOutput();
+
+  ITK_TEST_EXPECT_EQUAL(streamedOutput->GetBufferedRegion(), bufferedOutput->GetBufferedRegion());
+  ITK_TEST_EXPECT_TRUE(streamedOutput->GetOrigin() == bufferedOutput->GetOrigin());
+  ITK_TEST_EXPECT_TRUE(streamedOutput->GetSpacing() == bufferedOutput->GetSpacing());
+
+  itk::SizeValueType differentPixels = 0;
+
+  itk::ImageRegionConstIterator<OutputImageType> sit(streamedOutput, streamedOutput->GetBufferedRegion());
+  itk::ImageRegionConstIterator<OutputImageType> bit(bufferedOutput, bufferedOutput->GetBufferedRegion());
+  while (!sit.IsAtEnd())
+  {
+    differentPixels += !itk::Math::FloatAlmostEqual(sit.Get(), bit.Get(), 4, 1e-5f);
+    ++sit;
+    ++bit;
+  }
+
+  std::cout << "Different pixels: " << differentPixels << std::endl;
+
+  ITK_TEST_EXPECT_TRUE(differentPixels == 0);
+
+  std::cout << "Test finished." << std::endl;
+  return EXIT_SUCCESS;
+}
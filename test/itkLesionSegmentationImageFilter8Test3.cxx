@@ -0,0 +1,149 @@
+/*=========================================================================
+
+  Program:   Lesion Sizing Toolkit
+  Module:    itkLesionSegmentationImageFilter8Test3.cxx
+
+  Copyright (c) Kitware Inc.
+  All rights reserved.
+  See Copyright.txt or https://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+
+// The test segments a lesion of thick-slice data on the resampled grid,
+// then on the native grid of the data, with the final level set upsampled
+// to the resampled grid, and compares the volumes of both segmentations.
+
+#include "itkLesionSegmentationImageFilter8.h"
+#include "itkImage.h"
+#include "itkImageFileReader.h"
+#include "itkImageRegionConstIterator.h"
+#include "itkLandmarksReader.h"
+#include "itkMath.h"
+#include "itkTestingMacros.h"
+
+#include <algorithm>
+#include <string>
+
+
+int
+itkLesionSegmentationImageFilter8Test3(int argc, char * argv[])
+{
+  if (argc < 3)
+  {
+    std::cerr << "Missing parameters." << std::endl;
+    std::cerr << "Usage: " << argv[0];
+    std::cerr << " landmarksFile inputImage [volumeTolerance]" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  constexpr unsigned int Dimension = 3;
+
+  using InputImageType = itk::Image<signed short, Dimension>;
+  using OutputImageType = itk::Image<float, Dimension>;
+  using FilterType = itk::LesionSegmentationImageFilter8<InputImageType, OutputImageType>;
+  using LandmarksReaderType = itk::LandmarksReader<Dimension>;
+
+  FilterType::LandmarkPointListType seeds;
+  ITK_TRY_EXPECT_NO_EXCEPTION(LandmarksReaderType::ReadLandmarks(argv[1], seeds));
+
+  using InputImageReaderType = itk::ImageFileReader<InputImageType>;
+  InputImageReaderType::Pointer inputImageReader = InputImageReaderType::New();
+  inputImageReader->SetFileName(argv[2]);
+
+  ITK_TRY_EXPECT_NO_EXCEPTION(inputImageReader->Update());
+
+  const InputImageType * inputImage = inputImageReader->GetOutput();
+
+  // Relative difference allowed between the volumes of both segmentations.
+  const double volumeTolerance = (argc > 3) ? std::stod(argv[3]) : 0.1;
+
+  //
+  // The native grid is used only for anisotropic data.
+  //
+  const InputImageType::SpacingType & spacing = inputImage->GetSpacing();
+  double                              minimumSpacing = spacing[0];
+  double                              maximumSpacing = spacing[0];
+  for (unsigned int d = 1; d < Dimension; ++d)
+  {
+    minimumSpacing = std::min(minimumSpacing, static_cast<double>(spacing[d]));
+    maximumSpacing = std::max(maximumSpacing, static_cast<double>(spacing[d]));
+  }
+
+  auto createFilter = [&](bool segmentOnNativeGrid) {
+    FilterType::Pointer filter = FilterType::New();
+    filter->SetInput(inputImage);
+    filter->SetSeeds(seeds);
+    filter->SetRegionOfInterest(inputImage->GetLargestPossibleRegion());
+    filter->SetResampleThickSliceData(true);
+    filter->SetSegmentOnNativeGrid(segmentOnNativeGrid);
+    return filter;
+  };
+
+  //
+  // Segmentation on the resampled grid.
+  //
+  FilterType::Pointer resampledGridFilter = createFilter(false);
+  ITK_TEST_EXPECT_TRUE(maximumSpacing / minimumSpacing > resampledGridFilter->GetAnisotropyThreshold());
+  ITK_TEST_EXPECT_TRUE(!resampledGridFilter->GetSegmentOnNativeGrid());
+
+  ITK_TRY_EXPECT_NO_EXCEPTION(resampledGridFilter->Update());
+
+  //
+  // Segmentation on the native grid.
+  //
+  FilterType::Pointer nativeGridFilter = createFilter(true);
+  ITK_TEST_EXPECT_TRUE(nativeGridFilter->GetSegmentOnNativeGrid());
+
+  ITK_TRY_EXPECT_NO_EXCEPTION(nativeGridFilter->Update());
+
+  const OutputImageType * resampledGridOutput = resampledGridFilter->GetOutput();
+  const OutputImageType * nativeGridOutput = nativeGridFilter->GetOutput();
+
+  //
+  // Both outputs are on the resampled grid.
+  //
+  ITK_TEST_EXPECT_EQUAL(resampledGridOutput->GetBufferedRegion(), nativeGridOutput->GetBufferedRegion());
+  ITK_TEST_EXPECT_TRUE(resampledGridOutput->GetOrigin() == nativeGridOutput->GetOrigin());
+  ITK_TEST_EXPECT_TRUE(resampledGridOutput->GetSpacing() == nativeGridOutput->GetSpacing());
+  ITK_TEST_EXPECT_TRUE(resampledGridOutput->GetDirection() == nativeGridOutput->GetDirection());
+
+  //
+  // The volumes of the lesions match within the tolerance.
+  //
+  itk::SizeValueType resampledGridPixels = 0;
+  itk::SizeValueType nativeGridPixels = 0;
+
+  itk::ImageRegionConstIterator<OutputImageType> rit(resampledGridOutput, resampledGridOutput->GetBufferedRegion());
+  itk::ImageRegionConstIterator<OutputImageType> nit(nativeGridOutput, nativeGridOutput->GetBufferedRegion());
+  while (!rit.IsAtEnd())
+  {
+    resampledGridPixels += (rit.Get() > 0.0f);
+    nativeGridPixels += (nit.Get() > 0.0f);
+    ++rit;
+    ++nit;
+  }
+
+  const OutputImageType::SpacingType & outputSpacing = resampledGridOutput->GetSpacing();
+  double                               pixelVolume = 1.0;
+  for (unsigned int d = 0; d < Dimension; ++d)
+  {
+    pixelVolume *= outputSpacing[d];
+  }
+
+  const double resampledGridVolume = pixelVolume * resampledGridPixels;
+  const double nativeGridVolume = pixelVolume * nativeGridPixels;
+
+  std::cout << "Volume on the resampled grid: " << resampledGridVolume << " mm3" << std::endl;
+  std::cout << "Volume on the native grid: " << nativeGridVolume << " mm3" << std::endl;
+
+  ITK_TEST_EXPECT_TRUE(resampledGridPixels > 0);
+  ITK_TEST_EXPECT_TRUE(itk::Math::abs(nativeGridVolume - resampledGridVolume) <=
+                       volumeTolerance * resampledGridVolume);
+
+  std::cout << "Test finished." << std::endl;
+  return EXIT_SUCCESS;
+}
@@ -34,15 +34,19 @@ itkLesionSegmentationMethodTest8b(int argc, char * argv[])
     std::cerr << "Missing parameters." << std::endl;
     std::cerr << "Usage: " << argv[0];
     std::cerr << " landmarksFile inputImage outputImage";
-    std::cerr << " [SigmoidBeta] [-ResampleThickSliceData] [-UseVesselEnhancingDiffusion]" << std::endl;
+    std::cerr << " [SigmoidBeta] [-ResampleThickSliceData] [-UseVesselEnhancingDiffusion] [-SegmentOnNativeGrid]";
+    std::cerr << " [-UseParallelLevelSetSolver]" << std::endl;
     return EXIT_FAILURE;
   }
 
-  bool useVesselEnhancingDiffusion = false, resampleThickSliceData = false;
+  bool useVesselEnhancingDiffusion = false, resampleThickSliceData = false, segmentOnNativeGrid = false;
+  bool useParallelLevelSetSolver = false;
   for (int i = 1; i < argc; i++)
   {
     useVesselEnhancingDiffusion |= (strcmp("-UseVesselEnhancingDiffusion", argv[i]) == 0);
     resampleThickSliceData |= (strcmp("-ResampleThickSliceData", argv[i]) == 0);
+    segmentOnNativeGrid |= (strcmp("-SegmentOnNativeGrid", argv[i]) == 0);
+    useParallelLevelSetSolver |= (strcmp("-UseParallelLevelSetSolver", argv[i]) == 0);
   }
 
   constexpr unsigned int Dimension = 3;
@@ -90,6 +94,10 @@ itkLesionSegmentationMethodTest8b(int argc, char * argv[])
 
   segmentationMethod->SetResampleThickSliceData(resampleThickSliceData);
   segmentationMethod->SetUseVesselEnhancingDiffusion(useVesselEnhancingDiffusion);
+  segmentationMethod->SetSegmentOnNativeGrid(segmentOnNativeGrid);
+  ITK_TEST_SET_GET_VALUE(segmentOnNativeGrid, segmentationMethod->GetSegmentOnNativeGrid());
+  segmentationMethod->SetUseParallelLevelSetSolver(useParallelLevelSetSolver);
+  ITK_TEST_SET_GET_VALUE(useParallelLevelSetSolver, segmentationMethod->GetUseParallelLevelSetSolver());
 
   ITK_TRY_EXPECT_NO_EXCEPTION(segmentationMethod->Update());
 
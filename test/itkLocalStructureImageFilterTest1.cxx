@@ -19,8 +19,11 @@
 #include "itkImage.h"
 #include "itkImageFileReader.h"
 #include "itkImageFileWriter.h"
+#include "itkMath.h"
 #include "itkTestingMacros.h"
 
+#include <cmath>
+
 
 int
 itkLocalStructureImageFilterTest1(int argc, char * argv[])
@@ -96,6 +99,28 @@ itkLocalStructureImageFilterTest1(int argc, char * argv[])
 
   eigen->SetDimension(Dimension);
 
+  //
+  // Weight of a positive eigenvalue ls over a sheet of eigenvalue lt: it is
+  // (1 - alpha ls / |lt|)^gamma for 0 < ls < |lt| / alpha, and 0 above.
+  //
+  using LocalStructureFunctionType = LocalStructureFilterType::FunctorType;
+
+  LocalStructureFunctionType function;
+  function.SetAlpha(0.25);
+  function.SetGamma(2.0);
+
+  EigenValueArrayType eigenValues;
+  eigenValues[0] = -4.0;
+  eigenValues[1] = 0.0;
+  eigenValues[2] = 3.0;
+
+  const double expectedStructure = 4.0 * std::pow(1.0 - 0.25 * 3.0 / 4.0, 2.0);
+  const double structure = function(eigenValues);
+  ITK_TEST_EXPECT_TRUE(itk::Math::FloatAlmostEqual(structure, expectedStructure, 4, 1e-6));
+
+  function.SetAlpha(2.0);
+  ITK_TEST_EXPECT_EQUAL(function(eigenValues), 0.0f);
+
   WriterType::Pointer writer = WriterType::New();
 
   writer->SetFileName(argv[2]);
@@ -29,7 +29,7 @@ itkLungWallFeatureGeneratorTest1(int argc, char * argv[])
   {
     std::cerr << "Missing parameters." << std::endl;
     std::cerr << "Usage: " << argv[0];
-    std::cerr << " inputImage outputImage [lungThreshold]" << std::endl;
+    std::cerr << " inputImage outputImage [lungThreshold] [useImageSpacing]" << std::endl;
     return EXIT_FAILURE;
   }
 
@@ -79,6 +79,13 @@ itkLungWallFeatureGeneratorTest1(int argc, char * argv[])
   featureGenerator->SetLungThreshold(lungThreshold);
   ITK_TEST_SET_GET_VALUE(lungThreshold, featureGenerator->GetLungThreshold());
 
+  bool useImageSpacing = false;
+  if (argc > 4)
+  {
+    useImageSpacing = std::stoi(argv[4]);
+  }
+  ITK_TEST_SET_GET_BOOLEAN(featureGenerator, UseImageSpacing, useImageSpacing);
+
   ITK_TRY_EXPECT_NO_EXCEPTION(featureGenerator->Update());
 
 
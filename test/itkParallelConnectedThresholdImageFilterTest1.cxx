@@ -0,0 +1,194 @@
+/*=========================================================================
+
+  Program:   Lesion Sizing Toolkit
+  Module:    itkParallelConnectedThresholdImageFilterTest1.cxx
+
+  Copyright (c) Kitware Inc.
+  All rights reserved.
+  See Copyright.txt or https://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+
+#include "itkParallelConnectedThresholdImageFilter.h"
+#include "itkConnectedThresholdImageFilter.h"
+#include "itkImage.h"
+#include "itkImageRegionConstIterator.h"
+#include "itkImageRegionIteratorWithIndex.h"
+#include "itkMath.h"
+#include "itkTestingMacros.h"
+
+#include <cmath>
+
+
+int
+itkParallelConnectedThresholdImageFilterTest1(int itkNotUsed(argc), char * itkNotUsed(argv)[])
+{
+  constexpr unsigned int Dimension = 3;
+
+  using InputImageType = itk::Image<float, Dimension>;
+  using MaskImageType = itk::Image<unsigned char, Dimension>;
+  using LevelSetImageType = itk::Image<float, Dimension>;
+
+  //
+  // Oscillating intensities, whose connected components within the
+  // interval have convoluted shapes.
+  //
+  InputImageType::SizeType size;
+  size[0] = 96;
+  size[1] = 80;
+  size[2] = 64;
+
+  InputImageType::IndexType start;
+  start[0] = -10;
+  start[1] = 5;
+  start[2] = 0;
+
+  InputImageType::Pointer inputImage = InputImageType::New();
+  inputImage->SetRegions(InputImageType::RegionType(start, size));
+  inputImage->Allocate();
+
+  itk::ImageRegionIteratorWithIndex<InputImageType> iit(inputImage, inputImage->GetBufferedRegion());
+  while (!iit.IsAtEnd())
+  {
+    const InputImageType::IndexType & index = iit.GetIndex();
+    iit.Set(100.0 * std::sin(0.21 * index[0]) * std::cos(0.17 * index[1]) + 40.0 * std::sin(0.3 * index[2]));
+    ++iit;
+  }
+
+  const float lower = -20.0;
+  const float upper = 60.0;
+
+  InputImageType::IndexType seed1;
+  seed1[0] = 0;
+  seed1[1] = 9;
+  seed1[2] = 0;
+
+  InputImageType::IndexType seed2;
+  seed2[0] = 60;
+  seed2[1] = 50;
+  seed2[2] = 40;
+
+  using FilterType = itk::ParallelConnectedThresholdImageFilter<InputImageType, MaskImageType>;
+  FilterType::Pointer filter = FilterType::New();
+
+  ITK_EXERCISE_BASIC_OBJECT_METHODS(filter, ParallelConnectedThresholdImageFilter, ImageToImageFilter);
+
+  filter->SetInput(inputImage);
+  filter->SetSeed(seed1);
+  filter->AddSeed(seed2);
+  ITK_TEST_EXPECT_EQUAL(filter->GetSeeds().size(), 2u);
+
+  filter->SetLower(lower);
+  ITK_TEST_SET_GET_VALUE(lower, filter->GetLower());
+
+  filter->SetUpper(upper);
+  ITK_TEST_SET_GET_VALUE(upper, filter->GetUpper());
+
+  const MaskImageType::PixelType replaceValue = 255;
+  filter->SetReplaceValue(replaceValue);
+  ITK_TEST_SET_GET_VALUE(replaceValue, filter->GetReplaceValue());
+
+  ITK_TRY_EXPECT_NO_EXCEPTION(filter->Update());
+
+  using ReferenceFilterType = itk::ConnectedThresholdImageFilter<InputImageType, MaskImageType>;
+  ReferenceFilterType::Pointer referenceFilter = ReferenceFilterType::New();
+  referenceFilter->SetInput(inputImage);
+  referenceFilter->AddSeed(seed1);
+  referenceFilter->AddSeed(seed2);
+  referenceFilter->SetLower(lower);
+  referenceFilter->SetUpper(upper);
+  referenceFilter->SetReplaceValue(replaceValue);
+
+  ITK_TRY_EXPECT_NO_EXCEPTION(referenceFilter->Update());
+
+  //
+  // The region must be the one of the ConnectedThresholdImageFilter.
+  //
+  itk::ImageRegionConstIterator<MaskImageType> it(filter->GetOutput(), filter->GetOutput()->GetBufferedRegion());
+  itk::ImageRegionConstIterator<MaskImageType> rit(referenceFilter->GetOutput(),
+                                                   referenceFilter->GetOutput()->GetBufferedRegion());
+
+  itk::SizeValueType numberOfRegionPixels = 0;
+  itk::SizeValueType numberOfDifferentPixels = 0;
+  while (!it.IsAtEnd())
+  {
+    numberOfRegionPixels += (rit.Get() == replaceValue);
+    numberOfDifferentPixels += (it.Get() != rit.Get());
+    ++it;
+    ++rit;
+  }
+
+  std::cout << "Region pixels: " << numberOfRegionPixels << std::endl;
+
+  if (numberOfRegionPixels == 0 || numberOfDifferentPixels != 0)
+  {
+    std::cerr << "Test failed!" << std::endl;
+    std::cerr << numberOfDifferentPixels << " pixels differ from the ConnectedThresholdImageFilter" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  ITK_TEST_EXPECT_EQUAL(filter->GetNumberOfRegionPixels(), numberOfRegionPixels);
+
+  //
+  // The values of a level set are written directly, and do not depend on the
+  // number of threads.
+  //
+  using LevelSetFilterType = itk::ParallelConnectedThresholdImageFilter<InputImageType, LevelSetImageType>;
+  LevelSetFilterType::Pointer levelSetFilter = LevelSetFilterType::New();
+  levelSetFilter->SetInput(inputImage);
+  levelSetFilter->SetSeed(seed1);
+  levelSetFilter->AddSeed(seed2);
+  levelSetFilter->SetLower(lower);
+  levelSetFilter->SetUpper(upper);
+  levelSetFilter->SetNumberOfWorkUnits(1);
+
+  const LevelSetImageType::PixelType insideValue = 4.0;
+  levelSetFilter->SetReplaceValue(insideValue);
+  ITK_TEST_SET_GET_VALUE(insideValue, levelSetFilter->GetReplaceValue());
+
+  const LevelSetImageType::PixelType outsideValue = -4.0;
+  levelSetFilter->SetOutsideValue(outsideValue);
+  ITK_TEST_SET_GET_VALUE(outsideValue, levelSetFilter->GetOutsideValue());
+
+  ITK_TRY_EXPECT_NO_EXCEPTION(levelSetFilter->Update());
+
+  itk::ImageRegionConstIterator<LevelSetImageType> lit(levelSetFilter->GetOutput(),
+                                                       levelSetFilter->GetOutput()->GetBufferedRegion());
+  rit.GoToBegin();
+
+  numberOfDifferentPixels = 0;
+  while (!lit.IsAtEnd())
+  {
+    const LevelSetImageType::PixelType expectedValue = (rit.Get() == replaceValue) ? insideValue : outsideValue;
+    numberOfDifferentPixels += itk::Math::NotExactlyEquals(lit.Get(), expectedValue);
+    ++lit;
+    ++rit;
+  }
+
+  if (numberOfDifferentPixels != 0)
+  {
+    std::cerr << "Test failed!" << std::endl;
+    std::cerr << numberOfDifferentPixels << " level set pixels differ with a single work unit" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  //
+  // Seeds outside of the interval are ignored.
+  //
+  filter->ClearSeeds();
+  ITK_TEST_EXPECT_EQUAL(filter->GetSeeds().size(), 0u);
+
+  filter->SetLower(1000.0);
+  filter->SetUpper(2000.0);
+  filter->SetSeed(seed1);
+
+  ITK_TRY_EXPECT_NO_EXCEPTION(filter->Update());
+  ITK_TEST_EXPECT_EQUAL(filter->GetNumberOfRegionPixels(), 0u);
+
+  std::cout << "Test finished." << std::endl;
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,232 @@
+/*=========================================================================
+
+  Program:   Lesion Sizing Toolkit
+  Module:    itkSeparableBSplineResampleImageFilterTest1.cxx
+
+  Copyright (c) Kitware Inc.
+  All rights reserved.
+  See Copyright.txt or https://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+
+#include "itkSeparableBSplineResampleImageFilter.h"
+#include "itkResampleImageFilter.h"
+#include "itkIdentityTransform.h"
+#include "itkBSplineInterpolateImageFunction.h"
+#include "itkImage.h"
+#include "itkImageFileReader.h"
+#include "itkImageFileWriter.h"
+#include "itkImageRegionConstIterator.h"
+#include "itkTestingMacros.h"
+
+
+namespace
+{
+
+using PixelType = signed short;
+using ImageType = itk::Image<PixelType, 3>;
+
+// Largest difference between the output of the separable resampler and the
+// output of the ResampleImageFilter with a cubic BSpline interpolator, on the
+// same grid. Both filters compute the same interpolation in a different
+// order, and rounding errors may only change the truncated values by one.
+int
+MaximumDifferenceWithResampleImageFilter(const ImageType * inputImage, const ImageType * outputImage)
+{
+  using ReferenceResampleFilterType = itk::ResampleImageFilter<ImageType, ImageType>;
+  using TransformType = itk::IdentityTransform<double, ImageType::ImageDimension>;
+  using BSplineInterpolatorType = itk::BSplineInterpolateImageFunction<ImageType, double>;
+
+  TransformType::Pointer transform = TransformType::New();
+  transform->SetIdentity();
+
+  BSplineInterpolatorType::Pointer bsplineInterpolator = BSplineInterpolatorType::New();
+  bsplineInterpolator->SetSplineOrder(3);
+
+  ReferenceResampleFilterType::Pointer referenceResampler = ReferenceResampleFilterType::New();
+  referenceResampler->SetTransform(transform);
+  referenceResampler->SetInterpolator(bsplineInterpolator);
+  referenceResampler->SetDefaultPixelValue(-1024);
+  referenceResampler->SetOutputSpacing(outputImage->GetSpacing());
+  referenceResampler->SetOutputOrigin(inputImage->GetOrigin());
+  referenceResampler->SetOutputDirection(inputImage->GetDirection());
+  referenceResampler->SetSize(outputImage->GetLargestPossibleRegion().GetSize());
+  referenceResampler->SetInput(inputImage);
+  referenceResampler->Update();
+
+  const ImageType * referenceImage = referenceResampler->GetOutput();
+
+  itk::ImageRegionConstIterator<ImageType> it(outputImage, outputImage->GetBufferedRegion());
+  itk::ImageRegionConstIterator<ImageType> rit(referenceImage, referenceImage->GetBufferedRegion());
+
+  int maximumDifference = 0;
+  while (!it.IsAtEnd())
+  {
+    const int difference = itk::Math::abs(static_cast<int>(it.Get()) - static_cast<int>(rit.Get()));
+    if (difference > maximumDifference)
+    {
+      maximumDifference = difference;
+    }
+    ++it;
+    ++rit;
+  }
+
+  return maximumDifference;
+}
+
+} // namespace
+
+
+int
+itkSeparableBSplineResampleImageFilterTest1(int argc, char * argv[])
+{
+  if (argc < 3)
+  {
+    std::cerr << "Missing parameters." << std::endl;
+    std::cerr << "Usage: " << argv[0];
+    std::cerr << " inputImage outputImage [outputSpacing]" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  constexpr unsigned int Dimension = ImageType::ImageDimension;
+
+  using ReaderType = itk::ImageFileReader<ImageType>;
+  using WriterType = itk::ImageFileWriter<ImageType>;
+
+  ReaderType::Pointer reader = ReaderType::New();
+
+  reader->SetFileName(argv[1]);
+
+  ITK_TRY_EXPECT_NO_EXCEPTION(reader->Update());
+
+  const ImageType *              inputImage = reader->GetOutput();
+  const ImageType::SpacingType & inputSpacing = inputImage->GetSpacing();
+  const ImageType::SizeType &    inputSize = inputImage->GetLargestPossibleRegion().GetSize();
+
+  double outputSpacingValue = 0.4;
+  if (argc > 3)
+  {
+    outputSpacingValue = std::stod(argv[3]);
+  }
+
+  ImageType::SpacingType outputSpacing;
+  outputSpacing.Fill(outputSpacingValue);
+
+  ImageType::SizeType outputSize;
+  for (unsigned int i = 0; i < Dimension; ++i)
+  {
+    outputSize[i] = static_cast<itk::SizeValueType>(inputSize[i] * inputSpacing[i] / outputSpacing[i]);
+  }
+
+  const PixelType defaultPixelValue = -1024;
+
+  using ResampleFilterType = itk::SeparableBSplineResampleImageFilter<ImageType, ImageType>;
+
+  ResampleFilterType::Pointer resampler = ResampleFilterType::New();
+
+  ITK_EXERCISE_BASIC_OBJECT_METHODS(resampler, SeparableBSplineResampleImageFilter, ImageToImageFilter);
+
+  resampler->SetOutputSpacing(outputSpacing);
+  ITK_TEST_SET_GET_VALUE(outputSpacing, resampler->GetOutputSpacing());
+
+  resampler->SetSize(outputSize);
+  ITK_TEST_SET_GET_VALUE(outputSize, resampler->GetSize());
+
+  resampler->SetDefaultPixelValue(defaultPixelValue);
+  ITK_TEST_SET_GET_VALUE(defaultPixelValue, resampler->GetDefaultPixelValue());
+
+  resampler->SetInput(inputImage);
+
+  ITK_TRY_EXPECT_NO_EXCEPTION(resampler->Update());
+
+  const ImageType * outputImage = resampler->GetOutput();
+
+  ITK_TEST_EXPECT_EQUAL(outputImage->GetLargestPossibleRegion().GetSize(), outputSize);
+  ITK_TEST_EXPECT_EQUAL(outputImage->GetOrigin(), inputImage->GetOrigin());
+  ITK_TEST_EXPECT_EQUAL(outputImage->GetDirection(), inputImage->GetDirection());
+
+
+  int maximumDifference = MaximumDifferenceWithResampleImageFilter(inputImage, outputImage);
+
+  std::cout << "Maximum difference with the ResampleImageFilter = " << maximumDifference << std::endl;
+
+  if (maximumDifference > 1)
+  {
+    std::cerr << "Test failed!" << std::endl;
+    std::cerr << "The separable resampler differs from the ResampleImageFilter by " << maximumDifference
+              << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  //
+  // Thick-slice configuration: only the z axis is resampled, the in-plane
+  // axes keep their spacing and are copied.
+  //
+  ImageType::SpacingType thickSliceSpacing = inputSpacing;
+  ImageType::SizeType    thickSliceSize = inputSize;
+  thickSliceSpacing[2] = inputSpacing[0];
+  thickSliceSize[2] = static_cast<itk::SizeValueType>(inputSize[2] * inputSpacing[2] / thickSliceSpacing[2]);
+
+  ResampleFilterType::Pointer thickSliceResampler = ResampleFilterType::New();
+  thickSliceResampler->SetOutputSpacing(thickSliceSpacing);
+  thickSliceResampler->SetSize(thickSliceSize);
+  thickSliceResampler->SetDefaultPixelValue(defaultPixelValue);
+  thickSliceResampler->SetInput(inputImage);
+
+  ITK_TRY_EXPECT_NO_EXCEPTION(thickSliceResampler->Update());
+
+  maximumDifference = MaximumDifferenceWithResampleImageFilter(inputImage, thickSliceResampler->GetOutput());
+
+  std::cout << "Maximum difference with the ResampleImageFilter along z = " << maximumDifference << std::endl;
+
+  if (maximumDifference > 1)
+  {
+    std::cerr << "Test failed!" << std::endl;
+    std::cerr << "The separable resampler differs from the ResampleImageFilter along z by " << maximumDifference
+              << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  //
+  // Unchanged spacing: the input must be reproduced exactly.
+  //
+  ResampleFilterType::Pointer identityResampler = ResampleFilterType::New();
+  identityResampler->SetOutputSpacing(inputSpacing);
+  identityResampler->SetSize(inputSize);
+  identityResampler->SetInput(inputImage);
+
+  ITK_TRY_EXPECT_NO_EXCEPTION(identityResampler->Update());
+
+  itk::ImageRegionConstIterator<ImageType> it(identityResampler->GetOutput(),
+                                              identityResampler->GetOutput()->GetBufferedRegion());
+  itk::ImageRegionConstIterator<ImageType> iit(inputImage, inputImage->GetBufferedRegion());
+  while (!it.IsAtEnd())
+  {
+    if (it.Get() != iit.Get())
+    {
+      std::cerr << "Test failed!" << std::endl;
+      std::cerr << "Resampling with an unchanged spacing modified the pixel " << iit.GetIndex() << ": "
+                << it.Get() << " instead of " << iit.Get() << std::endl;
+      return EXIT_FAILURE;
+    }
+    ++it;
+    ++iit;
+  }
+
+
+  WriterType::Pointer writer = WriterType::New();
+
+  writer->SetFileName(argv[2]);
+  writer->SetInput(outputImage);
+  writer->UseCompressionOn();
+
+  ITK_TRY_EXPECT_NO_EXCEPTION(writer->Update());
+
+
+  std::cout << "Test finished." << std::endl;
+  return EXIT_SUCCESS;
+}
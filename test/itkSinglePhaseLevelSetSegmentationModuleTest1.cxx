@@ -62,6 +62,25 @@ itkSinglePhaseLevelSetSegmentationModuleTest1(int itkNotUsed(argc), char * itkNo
   segmentationModule->SetMaximumNumberOfIterations(maximumNumberOfIterations);
   ITK_TEST_SET_GET_VALUE(maximumNumberOfIterations, segmentationModule->GetMaximumNumberOfIterations());
 
+  constexpr bool useParallelSolver = true;
+  ITK_TEST_SET_GET_BOOLEAN(segmentationModule, UseParallelSolver, useParallelSolver);
+
+  constexpr double maximumElapsedTime = 2.5;
+  segmentationModule->SetMaximumElapsedTime(maximumElapsedTime);
+  ITK_TEST_SET_GET_VALUE(maximumElapsedTime, segmentationModule->GetMaximumElapsedTime());
+
+  constexpr double maximumFrontVolume = 4000.0;
+  segmentationModule->SetMaximumFrontVolume(maximumFrontVolume);
+  ITK_TEST_SET_GET_VALUE(maximumFrontVolume, segmentationModule->GetMaximumFrontVolume());
+
+  ITK_TEST_SET_GET_NULL_VALUE(segmentationModule->GetInitialLevelSet());
+
+  constexpr bool initialLevelSetIsMask = true;
+  ITK_TEST_SET_GET_BOOLEAN(segmentationModule, InitialLevelSetIsMask, initialLevelSetIsMask);
+
+  ITK_TEST_EXPECT_EQUAL(segmentationModule->GetStopCondition(), SegmentationModuleType::ConvergenceStop);
+  std::cout << "Stop condition: " << segmentationModule->GetStopConditionDescription() << std::endl;
+
 
   ITK_TRY_EXPECT_NO_EXCEPTION(segmentationModule->Update());
 
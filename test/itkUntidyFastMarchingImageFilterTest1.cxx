@@ -0,0 +1,170 @@
+/*=========================================================================
+
+  Program:   Lesion Sizing Toolkit
+  Module:    itkUntidyFastMarchingImageFilterTest1.cxx
+
+  Copyright (c) Kitware Inc.
+  All rights reserved.
+  See Copyright.txt or https://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+
+#include "itkUntidyFastMarchingImageFilter.h"
+#include "itkFastMarchingImageFilter.h"
+#include "itkImage.h"
+#include "itkImageRegionConstIterator.h"
+#include "itkImageRegionIteratorWithIndex.h"
+#include "itkTestingMacros.h"
+
+#include <algorithm>
+#include <cmath>
+
+
+int
+itkUntidyFastMarchingImageFilterTest1(int itkNotUsed(argc), char * itkNotUsed(argv)[])
+{
+  constexpr unsigned int Dimension = 3;
+
+  using PixelType = float;
+  using ImageType = itk::Image<PixelType, Dimension>;
+
+  //
+  // Smoothly varying speed on an anisotropic grid.
+  //
+  ImageType::SizeType size;
+  size.Fill(64);
+
+  ImageType::SpacingType spacing;
+  spacing[0] = 0.7;
+  spacing[1] = 0.7;
+  spacing[2] = 1.25;
+
+  ImageType::Pointer speedImage = ImageType::New();
+  speedImage->SetRegions(ImageType::RegionType(size));
+  speedImage->SetSpacing(spacing);
+  speedImage->Allocate();
+
+  itk::ImageRegionIteratorWithIndex<ImageType> sit(speedImage, speedImage->GetBufferedRegion());
+  while (!sit.IsAtEnd())
+  {
+    const ImageType::IndexType & index = sit.GetIndex();
+    sit.Set(1.0 + 0.5 * std::sin(0.2 * index[0]) * std::cos(0.15 * index[1]) + 0.3 * (index[2] % 7) / 7.0);
+    ++sit;
+  }
+
+  const double stoppingValue = 15.0;
+  const double distanceFromSeeds = 0.5;
+
+  ImageType::IndexType seedIndex;
+  seedIndex[0] = 32;
+  seedIndex[1] = 30;
+  seedIndex[2] = 28;
+
+  using UntidyFilterType = itk::UntidyFastMarchingImageFilter<ImageType, ImageType>;
+  using HeapFilterType = itk::FastMarchingImageFilter<ImageType, ImageType>;
+
+  UntidyFilterType::NodeType untidySeed;
+  untidySeed.SetIndex(seedIndex);
+  untidySeed.SetValue(-distanceFromSeeds);
+
+  UntidyFilterType::NodeContainer::Pointer untidySeeds = UntidyFilterType::NodeContainer::New();
+  untidySeeds->InsertElement(0, untidySeed);
+
+  UntidyFilterType::Pointer untidyFilter = UntidyFilterType::New();
+
+  ITK_EXERCISE_BASIC_OBJECT_METHODS(untidyFilter, UntidyFastMarchingImageFilter, ImageToImageFilter);
+
+  untidyFilter->SetInput(speedImage);
+  untidyFilter->SetTrialPoints(untidySeeds);
+
+  untidyFilter->SetStoppingValue(stoppingValue);
+  ITK_TEST_SET_GET_VALUE(stoppingValue, untidyFilter->GetStoppingValue());
+
+  const double normalizationFactor = 1.0;
+  untidyFilter->SetNormalizationFactor(normalizationFactor);
+  ITK_TEST_SET_GET_VALUE(normalizationFactor, untidyFilter->GetNormalizationFactor());
+
+  const double bucketWidth = 0.0;
+  untidyFilter->SetBucketWidth(bucketWidth);
+  ITK_TEST_SET_GET_VALUE(bucketWidth, untidyFilter->GetBucketWidth());
+
+  ITK_TRY_EXPECT_NO_EXCEPTION(untidyFilter->Update());
+
+  HeapFilterType::NodeType heapSeed;
+  heapSeed.SetIndex(seedIndex);
+  heapSeed.SetValue(-distanceFromSeeds);
+
+  HeapFilterType::NodeContainer::Pointer heapSeeds = HeapFilterType::NodeContainer::New();
+  heapSeeds->InsertElement(0, heapSeed);
+
+  HeapFilterType::Pointer heapFilter = HeapFilterType::New();
+  heapFilter->SetInput(speedImage);
+  heapFilter->SetTrialPoints(heapSeeds);
+  heapFilter->SetStoppingValue(stoppingValue);
+
+  ITK_TRY_EXPECT_NO_EXCEPTION(heapFilter->Update());
+
+  //
+  // The arrival times must agree within the time needed to cross a pixel,
+  // and the zero sets must be the same.
+  //
+  itk::ImageRegionConstIterator<ImageType> uit(untidyFilter->GetOutput(),
+                                               untidyFilter->GetOutput()->GetBufferedRegion());
+  itk::ImageRegionConstIterator<ImageType> hit(heapFilter->GetOutput(), heapFilter->GetOutput()->GetBufferedRegion());
+
+  double             maximumDifference = 0.0;
+  itk::SizeValueType numberOfReachedPixels = 0;
+  itk::SizeValueType numberOfDifferentPixels = 0;
+  while (!uit.IsAtEnd())
+  {
+    const double untidyValue = uit.Get();
+    const double heapValue = hit.Get();
+    if (untidyValue < stoppingValue && heapValue < stoppingValue)
+    {
+      maximumDifference = std::max(maximumDifference, itk::Math::abs(untidyValue - heapValue));
+      ++numberOfReachedPixels;
+    }
+    numberOfDifferentPixels += ((untidyValue < 5.0) != (heapValue < 5.0));
+    ++uit;
+    ++hit;
+  }
+
+  std::cout << "Reached pixels: " << numberOfReachedPixels << std::endl;
+  std::cout << "Processed pixels: " << untidyFilter->GetNumberOfProcessedPixels() << std::endl;
+  std::cout << "Maximum difference with the FastMarchingImageFilter = " << maximumDifference << std::endl;
+  std::cout << "Pixels on a different side of the 5.0 level = " << numberOfDifferentPixels << std::endl;
+
+  const double crossingTime = spacing[0] / 1.8;
+
+  if (maximumDifference > crossingTime)
+  {
+    std::cerr << "Test failed!" << std::endl;
+    std::cerr << "The arrival times differ from the ones of the FastMarchingImageFilter by " << maximumDifference
+              << " which is more than " << crossingTime << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  if (numberOfDifferentPixels > numberOfReachedPixels / 100)
+  {
+    std::cerr << "Test failed!" << std::endl;
+    std::cerr << numberOfDifferentPixels << " pixels are on a different side of the level set" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  //
+  // Only the pixels within the stopping value may be processed.
+  //
+  if (untidyFilter->GetNumberOfProcessedPixels() >= speedImage->GetBufferedRegion().GetNumberOfPixels())
+  {
+    std::cerr << "Test failed!" << std::endl;
+    std::cerr << "The whole image was processed" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  std::cout << "Test finished." << std::endl;
+  return EXIT_SUCCESS;
+}